@@ -205,19 +205,8 @@ fn check_external_dependencies() {
     #[allow(unused_mut)]
     let mut warnings: Vec<(&str, &str, String)> = Vec::new();
 
-    // Check pdf-to-image feature dependencies
-    #[cfg(feature = "pdf-to-image")]
-    {
-        if !command_exists("pdftoppm") {
-            warnings.push((
-                "pdftoppm (poppler-utils)",
-                "PDF → Image conversion",
-                get_install_command("poppler-utils"),
-            ));
-        }
-    }
-
-    // Check office feature dependencies for image conversion
+    // Check office feature dependencies for image conversion: LibreOffice
+    // converts to PDF (driven over UNO), pdfium renders the pages
     #[cfg(all(feature = "office", feature = "pdf-to-image"))]
     {
         if !command_exists("libreoffice") && !command_exists("soffice") {
@@ -227,6 +216,18 @@ fn check_external_dependencies() {
                 get_install_command("libreoffice"),
             ));
         }
+
+        // Windows and macOS builds of LibreOffice bundle a Python with uno
+        #[cfg(target_os = "linux")]
+        {
+            if !python_has_uno() {
+                warnings.push((
+                    "LibreOffice Python bridge (python3-uno)",
+                    "DOCX/PPTX → Image conversion",
+                    get_install_command("python3-uno"),
+                ));
+            }
+        }
     }
 
     // Check tesseract feature dependencies
@@ -292,13 +293,24 @@ fn command_exists(cmd: &str) -> bool {
     .unwrap_or(false)
 }
 
+/// Check if the Python that drives LibreOffice can import `uno`
+#[allow(dead_code)]
+fn python_has_uno() -> bool {
+    let python =
+        std::env::var("TRANSMUTATION_OFFICE_PYTHON").unwrap_or_else(|_| "python3".to_string());
+    Command::new(python)
+        .args(["-c", "import uno"])
+        .output()
+        .map(|output| output.status.success())
+        .unwrap_or(false)
+}
+
 /// Get platform-specific install command for a tool
 #[allow(dead_code)]
 fn get_install_command(tool: &str) -> String {
     #[cfg(target_os = "linux")]
     {
         match tool {
-            "poppler-utils" => "sudo apt-get install poppler-utils".to_string(),
             "libreoffice" => "sudo apt-get install libreoffice".to_string(),
             "tesseract" => "sudo apt-get install tesseract-ocr".to_string(),
             "ffmpeg" => "sudo apt-get install ffmpeg".to_string(),
@@ -309,7 +321,6 @@ fn get_install_command(tool: &str) -> String {
     #[cfg(target_os = "macos")]
     {
         match tool {
-            "poppler-utils" => "brew install poppler".to_string(),
             "libreoffice" => "brew install --cask libreoffice".to_string(),
             "tesseract" => "brew install tesseract".to_string(),
             "ffmpeg" => "brew install ffmpeg".to_string(),
@@ -320,7 +331,6 @@ fn get_install_command(tool: &str) -> String {
     #[cfg(target_os = "windows")]
     {
         match tool {
-            "poppler-utils" => "choco install poppler".to_string(),
             "libreoffice" => "choco install libreoffice".to_string(),
             "tesseract" => "choco install tesseract".to_string(),
             "ffmpeg" => "choco install ffmpeg".to_string(),
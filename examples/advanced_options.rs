@@ -4,7 +4,7 @@
 
 #![allow(clippy::uninlined_format_args)]
 
-use transmutation::{ConversionOptions, Converter, ImageQuality, OutputFormat};
+use transmutation::{ArchiveLimits, ConversionOptions, Converter, ImageQuality, OutputFormat};
 
 #[tokio::main]
 async fn main() -> Result<(), Box<dyn std::error::Error>> {
@@ -37,6 +37,20 @@ async fn main() -> Result<(), Box<dyn std::error::Error>> {
         // Feature flags
         use_ffi: false,
         use_precision_mode: false,
+
+        // Incremental conversion
+        page_cache_dir: None,
+
+        // JSON output
+        embed_source: true,
+
+        // XML filtering
+        xml_skip_paths: vec![],
+        xml_select_paths: vec![],
+
+        // Archives
+        convert_archive_members: false,
+        archive_limits: ArchiveLimits::default(),
     };
 
     println!("Converting with advanced options...");
@@ -20,31 +20,27 @@ echo "📥 Installing ALL dependencies for ALL features..."
 echo ""
 
 # Update package list
-echo "[1/7] Updating package list..."
+echo "[1/6] Updating package list..."
 $SUDO apt-get update -qq
 
 # Core build tools
-echo "[2/7] Installing build essentials..."
+echo "[2/6] Installing build essentials..."
 $SUDO apt-get install -y build-essential cmake git pkg-config libclang-dev clang
 
-# PDF & Image conversion
-echo "[3/7] Installing poppler-utils (PDF → Image)..."
-$SUDO apt-get install -y poppler-utils
-
-# Office conversion (DOCX/PPTX/XLSX)
-echo "[4/7] Installing LibreOffice (Office formats)..."
-$SUDO apt-get install -y libreoffice
+# Office conversion (DOCX/PPTX/XLSX), driven through its Python UNO bridge
+echo "[3/6] Installing LibreOffice (Office formats)..."
+$SUDO apt-get install -y libreoffice python3-uno
 
 # OCR support
-echo "[5/7] Installing Tesseract (OCR for images)..."
+echo "[4/6] Installing Tesseract (OCR for images)..."
 $SUDO apt-get install -y tesseract-ocr tesseract-ocr-eng tesseract-ocr-por libleptonica-dev libtesseract-dev
 
 # Audio/Video processing
-echo "[6/7] Installing FFmpeg (Video → Audio extraction)..."
+echo "[5/6] Installing FFmpeg (Video → Audio extraction)..."
 $SUDO apt-get install -y ffmpeg
 
 # Audio/Video transcription
-echo "[7/7] Installing Whisper (Audio/Video → Text transcription)..."
+echo "[6/6] Installing Whisper (Audio/Video → Text transcription)..."
 $SUDO apt-get install -y pipx
 pipx install openai-whisper
 pipx ensurepath
@@ -54,7 +50,6 @@ echo "✅ All dependencies installed!"
 echo ""
 echo "📊 Installed tools:"
 echo "  - Build tools: gcc, cmake, git, clang"
-echo "  - pdftoppm: $(pdftoppm -v 2>&1 | head -1)"
 echo "  - LibreOffice: $(libreoffice --version | head -1)"
 echo "  - Tesseract: $(tesseract --version | head -1)"
 echo "  - FFmpeg: $(ffmpeg -version | head -1)"
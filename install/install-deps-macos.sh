@@ -23,27 +23,23 @@ echo "📥 Installing ALL dependencies for ALL features via Homebrew..."
 echo ""
 
 # Core build tools (usually pre-installed on macOS with Xcode Command Line Tools)
-echo "[1/6] Checking Xcode Command Line Tools..."
+echo "[1/5] Checking Xcode Command Line Tools..."
 xcode-select -p &> /dev/null || xcode-select --install
 
-# PDF & Image conversion
-echo "[2/6] Installing poppler (PDF → Image)..."
-brew install poppler
-
 # Office conversion
-echo "[3/6] Installing LibreOffice (Office formats)..."
+echo "[2/5] Installing LibreOffice (Office formats)..."
 brew install --cask libreoffice
 
 # OCR support
-echo "[4/6] Installing Tesseract (OCR for images)..."
+echo "[3/5] Installing Tesseract (OCR for images)..."
 brew install tesseract tesseract-lang
 
 # Audio/Video processing
-echo "[5/6] Installing FFmpeg (Video → Audio extraction)..."
+echo "[4/5] Installing FFmpeg (Video → Audio extraction)..."
 brew install ffmpeg
 
 # Audio/Video transcription
-echo "[6/6] Installing Whisper (Audio/Video → Text transcription)..."
+echo "[5/5] Installing Whisper (Audio/Video → Text transcription)..."
 brew install pipx
 pipx install openai-whisper
 pipx ensurepath
@@ -53,7 +49,6 @@ echo "✅ All dependencies installed!"
 echo ""
 echo "📊 Installed tools:"
 echo "  - Xcode tools: $(xcode-select -p)"
-echo "  - pdftoppm: $(pdftoppm -v 2>&1 | head -1)"
 echo "  - LibreOffice: /Applications/LibreOffice.app"
 echo "  - Tesseract: $(tesseract --version | head -1)"
 echo "  - FFmpeg: $(ffmpeg -version | head -1)"
@@ -67,22 +67,7 @@ if exist git-installer.exe (
 )
 
 echo.
-echo [4/6] Poppler (PDF tools)
-echo   Downloading Poppler...
-set POPPLER_URL=https://github.com/oschwartz10612/poppler-windows/releases/latest/download/Release-23.08.0-0.zip
-curl -L -o poppler.zip "%POPPLER_URL%"
-if exist poppler.zip (
-    echo   Extracting Poppler...
-    powershell -Command "Expand-Archive -Path poppler.zip -DestinationPath 'C:\Program Files\poppler\' -Force"
-    echo   Adding to PATH...
-    setx /M PATH "%PATH%;C:\Program Files\poppler\Library\bin"
-) else (
-    echo   ⚠️ Download failed, please install manually from:
-    echo   https://github.com/oschwartz10612/poppler-windows/releases
-)
-
-echo.
-echo [5/6] LibreOffice
+echo [4/6] LibreOffice
 echo   Downloading LibreOffice...
 set LIBREOFFICE_URL=https://download.documentfoundation.org/libreoffice/stable/7.6.4/win/x86_64/LibreOffice_7.6.4_Win_x86-64.msi
 curl -L -o libreoffice-installer.msi "%LIBREOFFICE_URL%"
@@ -96,7 +81,7 @@ if exist libreoffice-installer.msi (
 )
 
 echo.
-echo [6/6] Tesseract OCR
+echo [5/6] Tesseract OCR
 echo   Downloading Tesseract...
 set TESSERACT_URL=https://digi.bib.uni-mannheim.de/tesseract/tesseract-ocr-w64-setup-5.3.3.20231005.exe
 curl -L -o tesseract-installer.exe "%TESSERACT_URL%"
@@ -111,7 +96,7 @@ if exist tesseract-installer.exe (
 )
 
 echo.
-echo [7/6] FFmpeg
+echo [6/6] FFmpeg
 echo   Downloading FFmpeg...
 set FFMPEG_URL=https://github.com/BtbN/FFmpeg-Builds/releases/download/latest/ffmpeg-master-latest-win64-gpl.zip
 curl -L -o ffmpeg.zip "%FFMPEG_URL%"
@@ -135,7 +120,6 @@ echo 📊 Installed tools:
 echo   ✓ Visual Studio Build Tools (manual)
 echo   ✓ CMake
 echo   ✓ Git
-echo   ✓ Poppler (pdftoppm)
 echo   ✓ LibreOffice
 echo   ✓ Tesseract OCR
 echo   ✓ FFmpeg
@@ -33,32 +33,28 @@ Write-Host "📥 Installing ALL dependencies for ALL features via Chocolatey..."
 Write-Host ""
 
 # Core build tools
-Write-Host "[1/7] Installing Visual Studio Build Tools..." -ForegroundColor Yellow
+Write-Host "[1/6] Installing Visual Studio Build Tools..." -ForegroundColor Yellow
 choco install visualstudio2022buildtools -y
 choco install visualstudio2022-workload-vctools -y
 
 # CMake and Git
-Write-Host "[2/7] Installing CMake and Git..." -ForegroundColor Yellow
+Write-Host "[2/6] Installing CMake and Git..." -ForegroundColor Yellow
 choco install cmake git -y
 
-# PDF & Image conversion
-Write-Host "[3/7] Installing poppler (PDF → Image)..." -ForegroundColor Yellow
-choco install poppler -y
-
 # Office conversion
-Write-Host "[4/7] Installing LibreOffice (Office formats)..." -ForegroundColor Yellow
+Write-Host "[3/6] Installing LibreOffice (Office formats)..." -ForegroundColor Yellow
 choco install libreoffice -y
 
 # OCR support
-Write-Host "[5/7] Installing Tesseract (OCR for images)..." -ForegroundColor Yellow
+Write-Host "[4/6] Installing Tesseract (OCR for images)..." -ForegroundColor Yellow
 choco install tesseract -y
 
 # Audio/Video processing
-Write-Host "[6/7] Installing FFmpeg (Video → Audio extraction)..." -ForegroundColor Yellow
+Write-Host "[5/6] Installing FFmpeg (Video → Audio extraction)..." -ForegroundColor Yellow
 choco install ffmpeg -y
 
 # Audio/Video transcription
-Write-Host "[7/7] Installing Python + Whisper (Audio/Video → Text)..." -ForegroundColor Yellow
+Write-Host "[6/6] Installing Python + Whisper (Audio/Video → Text)..." -ForegroundColor Yellow
 choco install python3 -y
 pip install --upgrade pip
 pip install openai-whisper
@@ -69,7 +65,6 @@ Write-Host ""
 Write-Host "📊 Installed tools:" -ForegroundColor Cyan
 Write-Host "  - Visual Studio Build Tools"
 Write-Host "  - CMake & Git"
-Write-Host "  - pdftoppm.exe (poppler)"
 Write-Host "  - soffice.exe (LibreOffice)"
 Write-Host "  - tesseract.exe (OCR)"
 Write-Host "  - ffmpeg.exe (Audio/Video)"
@@ -1,16 +1,29 @@
 //! Batch processing for multiple documents
 //!
-//! Provides parallel processing capabilities using Rayon.
+//! Files are scheduled largest first with at most `parallel_jobs`
+//! conversions and a bounded number of input bytes in flight. Each
+//! conversion runs on tokio's blocking pool so CPU-heavy parsing does not
+//! stall the async worker threads.
 
 #![allow(clippy::uninlined_format_args)]
 
 use std::path::{Path, PathBuf};
+use std::sync::Arc;
 use std::time::Instant;
 
+use tokio::sync::Semaphore;
+use tokio::task::JoinSet;
+
 use crate::{
     ConversionOptions, ConversionResult, Converter, OutputFormat, Result, TransmutationError,
 };
 
+/// Default cap on the total size of input files being converted at once
+const DEFAULT_MAX_IN_FLIGHT_BYTES: u64 = 1 << 30;
+
+/// Granularity of the byte budget; semaphore permits are counted in KiB
+const BYTES_PER_PERMIT: u64 = 1024;
+
 /// Batch processor for multiple documents
 #[derive(Debug)]
 pub struct BatchProcessor {
@@ -18,6 +31,7 @@ pub struct BatchProcessor {
     output_format: OutputFormat,
     options: ConversionOptions,
     parallel_jobs: usize,
+    max_in_flight_bytes: u64,
 }
 
 impl BatchProcessor {
@@ -31,6 +45,7 @@ impl BatchProcessor {
             },
             options: ConversionOptions::default(),
             parallel_jobs: num_cpus::get(),
+            max_in_flight_bytes: DEFAULT_MAX_IN_FLIGHT_BYTES,
         }
     }
 
@@ -66,7 +81,17 @@ impl BatchProcessor {
         self
     }
 
+    /// Set the maximum total size of input files converted at once
+    ///
+    /// A file larger than the budget still runs, but only on its own.
+    pub fn max_in_flight_bytes(mut self, bytes: u64) -> Self {
+        self.max_in_flight_bytes = bytes.max(1);
+        self
+    }
+
     /// Execute batch conversion
+    ///
+    /// Results are reported in the order the files were added.
     pub async fn execute(self) -> Result<BatchResult> {
         let start_time = Instant::now();
         let total_files = self.files.len();
@@ -74,56 +99,79 @@ impl BatchProcessor {
         eprintln!("🚀 Starting batch conversion...");
         eprintln!("   Files: {}", total_files);
         eprintln!("   Concurrent jobs: {}", self.parallel_jobs);
+        eprintln!(
+            "   In-flight input limit: {} MB",
+            self.max_in_flight_bytes / (1024 * 1024)
+        );
         eprintln!("   Output format: {:?}", self.output_format);
         eprintln!();
 
         let output_format = self.output_format.clone();
         let options = self.options.clone();
+        let budget = byte_permits(self.max_in_flight_bytes, self.max_in_flight_bytes);
+        let jobs = Arc::new(Semaphore::new(self.parallel_jobs));
+        let bytes = Arc::new(Semaphore::new(budget as usize));
+
+        // Largest first: long conversions start early instead of at the tail
+        let queue = tokio::task::spawn_blocking(move || largest_first(self.files))
+            .await
+            .map_err(|e| TransmutationError::conversion_failed(e.to_string()))?;
+
+        let mut tasks = JoinSet::new();
+        let mut results = Vec::with_capacity(total_files);
+
+        for (index, file, size) in queue {
+            // Backpressure: no task is spawned until a job slot and its share
+            // of the byte budget are free
+            let job = Arc::clone(&jobs)
+                .acquire_owned()
+                .await
+                .map_err(|e| TransmutationError::conversion_failed(e.to_string()))?;
+            let input = Arc::clone(&bytes)
+                .acquire_many_owned(byte_permits(size, self.max_in_flight_bytes))
+                .await
+                .map_err(|e| TransmutationError::conversion_failed(e.to_string()))?;
 
-        // Process files concurrently using Tokio
-        let mut tasks = Vec::new();
-
-        for file in self.files {
             let output_format = output_format.clone();
             let options = options.clone();
+            let runtime = tokio::runtime::Handle::current();
 
-            let task = tokio::spawn(async move {
+            tasks.spawn_blocking(move || {
                 let result = match Converter::new() {
-                    Ok(converter) => {
+                    Ok(converter) => runtime.block_on(
                         converter
                             .convert(&file)
                             .to(output_format)
                             .with_options(options)
-                            .execute()
-                            .await
-                    }
+                            .execute(),
+                    ),
                     Err(e) => Err(e),
                 };
+                drop((job, input));
 
-                (file, result)
+                (index, file, result)
             });
 
-            tasks.push(task);
+            while let Some(done) = tasks.try_join_next() {
+                collect_task(done, &mut results);
+            }
         }
 
-        // Wait for all tasks to complete
-        let results = futures::future::join_all(tasks).await;
+        while let Some(done) = tasks.join_next().await {
+            collect_task(done, &mut results);
+        }
 
         let total_time = start_time.elapsed();
 
-        // Collect results
+        // Collect results in input order
+        results.sort_unstable_by_key(|(index, _, _)| *index);
         let mut successes = Vec::new();
         let mut failures = Vec::new();
 
-        for task_result in results {
-            match task_result {
-                Ok((file, conversion_result)) => match conversion_result {
-                    Ok(conversion) => successes.push((file, conversion)),
-                    Err(e) => failures.push((file, e)),
-                },
-                Err(join_error) => {
-                    eprintln!("Task join error: {}", join_error);
-                }
+        for (_, file, conversion_result) in results {
+            match conversion_result {
+                Ok(conversion) => successes.push((file, conversion)),
+                Err(e) => failures.push((file, e)),
             }
         }
 
@@ -142,6 +190,45 @@ impl BatchProcessor {
     }
 }
 
+/// Outcome of one conversion task: input index, file and result
+type TaskOutput = (usize, PathBuf, Result<ConversionResult>);
+
+/// Record a finished task; a task that panicked has no result to report
+fn collect_task(
+    done: std::result::Result<TaskOutput, tokio::task::JoinError>,
+    results: &mut Vec<TaskOutput>,
+) {
+    match done {
+        Ok(output) => results.push(output),
+        Err(join_error) => eprintln!("Task join error: {}", join_error),
+    }
+}
+
+/// Files with their input index and size, largest first
+///
+/// Files that cannot be read sort last with size 0; their conversion
+/// reports the error.
+fn largest_first(files: Vec<PathBuf>) -> Vec<(usize, PathBuf, u64)> {
+    let mut queue: Vec<(usize, PathBuf, u64)> = files
+        .into_iter()
+        .enumerate()
+        .map(|(index, file)| {
+            let size = std::fs::metadata(&file).map(|m| m.len()).unwrap_or(0);
+            (index, file, size)
+        })
+        .collect();
+    queue.sort_by(|a, b| b.2.cmp(&a.2).then(a.0.cmp(&b.0)));
+    queue
+}
+
+/// Byte-budget permits for a file of `size` bytes, capped at the budget so
+/// an oversized file waits for the whole budget instead of forever
+fn byte_permits(size: u64, max_in_flight_bytes: u64) -> u32 {
+    let max = (Semaphore::MAX_PERMITS as u64).min(u32::MAX as u64);
+    let budget = max_in_flight_bytes.div_ceil(BYTES_PER_PERMIT).clamp(1, max);
+    size.div_ceil(BYTES_PER_PERMIT).clamp(1, budget) as u32
+}
+
 impl Default for BatchProcessor {
     fn default() -> Self {
         Self::new()
@@ -156,6 +243,49 @@ mod tests {
     fn test_batch_processor_creation() {
         let processor = BatchProcessor::new();
         assert_eq!(processor.parallel_jobs, num_cpus::get());
+        assert_eq!(processor.max_in_flight_bytes, DEFAULT_MAX_IN_FLIGHT_BYTES);
+    }
+
+    #[test]
+    fn test_byte_permits() {
+        assert_eq!(byte_permits(0, 1 << 20), 1);
+        assert_eq!(byte_permits(1025, 1 << 20), 2);
+        // Oversized files take the whole budget and run alone
+        assert_eq!(byte_permits(1 << 30, 1 << 20), 1024);
+        assert_eq!(byte_permits(1, 1), 1);
+    }
+
+    #[test]
+    fn test_largest_first() {
+        let dir = tempfile::tempdir().unwrap();
+        let small = dir.path().join("small.txt");
+        let large = dir.path().join("large.txt");
+        std::fs::write(&small, "a").unwrap();
+        std::fs::write(&large, "a".repeat(100)).unwrap();
+        let missing = dir.path().join("missing.txt");
+
+        let queue = largest_first(vec![missing.clone(), small.clone(), large.clone()]);
+        let order: Vec<(usize, u64)> = queue.iter().map(|(i, _, size)| (*i, *size)).collect();
+        assert_eq!(order, vec![(2, 100), (1, 1), (0, 0)]);
+    }
+
+    #[tokio::test(flavor = "multi_thread")]
+    async fn test_execute_reports_in_input_order() {
+        let files: Vec<PathBuf> = (0..5)
+            .map(|i| PathBuf::from(format!("/nonexistent/transmutation-batch-{i}.txt")))
+            .collect();
+
+        let result = BatchProcessor::new()
+            .add_files(&files)
+            .parallel(2)
+            .max_in_flight_bytes(4096)
+            .execute()
+            .await
+            .unwrap();
+
+        assert_eq!(result.total_files, 5);
+        let failed: Vec<PathBuf> = result.failures.into_iter().map(|(f, _)| f).collect();
+        assert_eq!(failed, files);
     }
 
     #[test]
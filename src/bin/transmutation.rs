@@ -442,7 +442,7 @@ async fn run_command(cli: Cli) -> Result<()> {
             println!();
             println!("Engines (Pure Rust):");
             print_engine_status("PDF Parser (lopdf)", cfg!(feature = "pdf"));
-            print_engine_status("DOCX Parser (docx-rs)", cfg!(feature = "office"));
+            print_engine_status("Office Parser (quick-xml)", cfg!(feature = "office"));
             print_engine_status("HTML/XML Parser", cfg!(feature = "web"));
             print_engine_status("Tesseract OCR", cfg!(feature = "tesseract"));
             print_engine_status("FFmpeg", cfg!(feature = "ffmpeg"));
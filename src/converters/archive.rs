@@ -1,6 +1,14 @@
 //! Archive converter implementation
 //!
 //! Extracts and converts documents from archives (ZIP, TAR, 7Z, etc.).
+//!
+//! By default an archive is converted to an index of its files. With
+//! [`ConversionOptions::convert_archive_members`] each member is
+//! decompressed into memory and converted by the converter for its format
+//! instead: a blocking reader walks the archive sequentially and hands
+//! members over a bounded channel, and up to
+//! [`ArchiveLimits::max_parallel`] of them are converted at once. Nested
+//! archives are opened the same way, sharing the limits of the outer one.
 
 #![allow(
     clippy::unused_self,
@@ -9,23 +17,113 @@
 )]
 
 use std::collections::HashMap;
-use std::io::Cursor;
-use std::path::Path;
+use std::io::{BufReader, Cursor, Read, Seek};
+use std::path::{Path, PathBuf};
+use std::sync::Arc;
+use std::sync::atomic::{AtomicU64, AtomicUsize, Ordering};
 
 use async_trait::async_trait;
 #[cfg(feature = "archives-extended")]
 use flate2::read::GzDecoder;
+use futures::future::BoxFuture;
 #[cfg(feature = "archives-extended")]
 use tar::Archive as TarArchive;
 use tokio::fs;
+use tokio::sync::{OwnedSemaphorePermit, Semaphore, mpsc};
+use tokio::task::JoinSet;
 use zip::ZipArchive;
 
 use super::traits::{ConverterMetadata, DocumentConverter};
-use crate::Result;
 use crate::types::{
-    ConversionOptions, ConversionOutput, ConversionResult, FileFormat, OutputFormat, OutputMetadata,
+    ArchiveLimits, ConversionOptions, ConversionOutput, ConversionResult, FileFormat, OutputFormat,
+    OutputMetadata,
 };
 use crate::utils::file_detect;
+use crate::{Result, TransmutationError};
+
+/// A document inside an archive and what became of it
+#[derive(Debug)]
+pub struct ArchiveMember {
+    /// Path inside the archive; members of nested archives are prefixed
+    /// with the path of the nested archive (`docs.zip/report.pdf`)
+    pub name: String,
+    /// Detected format, if the member was read
+    pub format: Option<FileFormat>,
+    /// Uncompressed size in bytes
+    pub size: u64,
+    /// Conversion outcome
+    pub outcome: MemberOutcome,
+}
+
+/// Outcome of converting one archive member
+#[derive(Debug)]
+pub enum MemberOutcome {
+    /// Converted by the converter for its format
+    Converted(ConversionResult),
+    /// Not converted: over a limit, or no converter for its format
+    Skipped(String),
+    /// The member could not be read, or the converter failed
+    Failed(String),
+}
+
+/// Limits and counters shared by an archive and the archives nested in it
+#[derive(Debug)]
+struct MemberBudget {
+    limits: ArchiveLimits,
+    semaphore: Arc<Semaphore>,
+    members: AtomicUsize,
+    bytes: AtomicU64,
+}
+
+impl MemberBudget {
+    fn new(limits: ArchiveLimits) -> Arc<Self> {
+        Arc::new(Self {
+            semaphore: Arc::new(Semaphore::new(limits.max_parallel.max(1))),
+            limits,
+            members: AtomicUsize::new(0),
+            bytes: AtomicU64::new(0),
+        })
+    }
+}
+
+/// Where an archive is read from
+#[derive(Debug)]
+enum ArchiveSource {
+    File(PathBuf),
+    Memory(Vec<u8>),
+}
+
+trait ReadSeek: Read + Seek + Send {}
+
+impl<T: Read + Seek + Send> ReadSeek for T {}
+
+impl ArchiveSource {
+    fn open(self) -> Result<Box<dyn ReadSeek>> {
+        Ok(match self {
+            Self::File(path) => Box::new(BufReader::new(std::fs::File::open(path)?)),
+            Self::Memory(data) => Box::new(Cursor::new(data)),
+        })
+    }
+}
+
+/// What the archive reader hands to the converting side
+#[derive(Debug)]
+enum MemberEntry {
+    Read {
+        name: String,
+        data: Vec<u8>,
+    },
+    Skipped {
+        name: String,
+        size: u64,
+        reason: String,
+    },
+    Failed {
+        name: String,
+        size: u64,
+        reason: String,
+    },
+}
 
 /// Archive to document converter
 #[derive(Debug)]
@@ -208,6 +306,502 @@ impl ArchiveConverter {
 
         Ok(serde_json::to_string_pretty(&json)?)
     }
+
+    /// Convert every member of an archive, in archive order
+    ///
+    /// Members are streamed out of the archive into the converter for their
+    /// format without touching the disk (converters that need a file get a
+    /// temporary one). Limits come from [`ConversionOptions::archive_limits`].
+    pub async fn convert_members(
+        &self,
+        input: &Path,
+        input_format: FileFormat,
+        output_format: OutputFormat,
+        options: ConversionOptions,
+    ) -> Result<Vec<ArchiveMember>> {
+        let budget = MemberBudget::new(options.archive_limits.clone());
+        let depth = options.archive_limits.max_depth;
+        convert_archive_members(
+            String::new(),
+            ArchiveSource::File(input.to_path_buf()),
+            input_format,
+            output_format,
+            Arc::new(options),
+            budget,
+            depth,
+        )
+        .await
+    }
+
+    /// Combined result of converted members: one document, or one output
+    /// per converted member when `split` is set
+    fn members_result(
+        &self,
+        members: &[ArchiveMember],
+        archive_name: &str,
+        output_format: &OutputFormat,
+        split: bool,
+    ) -> Result<Vec<Vec<u8>>> {
+        let converted = members
+            .iter()
+            .filter(|m| matches!(m.outcome, MemberOutcome::Converted(_)));
+
+        match output_format {
+            OutputFormat::Markdown { .. } if split => Ok(converted
+                .map(|member| markdown_section(member).into_bytes())
+                .collect()),
+            OutputFormat::Markdown { .. } => {
+                let mut markdown = format!("# Archive: {archive_name}\n\n");
+                let count = |f: fn(&MemberOutcome) -> bool| {
+                    members.iter().filter(|m| f(&m.outcome)).count()
+                };
+                markdown.push_str(&format!(
+                    "**Members**: {} converted, {} skipped, {} failed\n\n",
+                    count(|o| matches!(o, MemberOutcome::Converted(_))),
+                    count(|o| matches!(o, MemberOutcome::Skipped(_))),
+                    count(|o| matches!(o, MemberOutcome::Failed(_))),
+                ));
+                for member in converted {
+                    markdown.push_str(&markdown_section(member));
+                }
+
+                let mut not_converted = members.iter().filter_map(|m| match &m.outcome {
+                    MemberOutcome::Skipped(reason) => Some((m, "skipped", reason)),
+                    MemberOutcome::Failed(error) => Some((m, "failed", error)),
+                    MemberOutcome::Converted(_) => None,
+                });
+                if let Some(first) = not_converted.next() {
+                    markdown.push_str("## Not Converted\n\n");
+                    for (member, status, reason) in std::iter::once(first).chain(not_converted) {
+                        markdown.push_str(&format!("- `{}` ({status}): {reason}\n", member.name));
+                    }
+                }
+                Ok(vec![markdown.into_bytes()])
+            }
+            OutputFormat::Json { .. } if split => converted
+                .map(|member| Ok(serde_json::to_vec_pretty(&member_json(member))?))
+                .collect(),
+            OutputFormat::Json { .. } => {
+                let json = serde_json::json!({
+                    "archive": {
+                        "name": archive_name,
+                        "total_members": members.len(),
+                    },
+                    "members": members.iter().map(member_json).collect::<Vec<_>>(),
+                });
+                Ok(vec![serde_json::to_vec_pretty(&json)?])
+            }
+            _ => Err(TransmutationError::UnsupportedFormat(format!(
+                "Output format {output_format:?} not supported for archives"
+            ))),
+        }
+    }
+}
+
+/// Markdown section of a converted member: its outputs under its name
+fn markdown_section(member: &ArchiveMember) -> String {
+    let mut section = format!("## {}\n\n", member.name);
+    if let MemberOutcome::Converted(result) = &member.outcome {
+        for output in &result.content {
+            section.push_str(String::from_utf8_lossy(&output.data).trim_end());
+            section.push_str("\n\n");
+        }
+    }
+    section
+}
+
+/// JSON entry of a member; converted JSON outputs are embedded as JSON
+fn member_json(member: &ArchiveMember) -> serde_json::Value {
+    let (status, detail) = match &member.outcome {
+        MemberOutcome::Converted(result) => {
+            let content = result
+                .content
+                .iter()
+                .map(|output| {
+                    serde_json::from_slice(&output.data).unwrap_or_else(|_| {
+                        serde_json::Value::String(
+                            String::from_utf8_lossy(&output.data).into_owned(),
+                        )
+                    })
+                })
+                .collect();
+            ("converted", serde_json::Value::Array(content))
+        }
+        MemberOutcome::Skipped(reason) => ("skipped", reason.as_str().into()),
+        MemberOutcome::Failed(error) => ("failed", error.as_str().into()),
+    };
+    let detail_key = if status == "converted" {
+        "content"
+    } else {
+        "reason"
+    };
+
+    serde_json::json!({
+        "name": member.name,
+        "format": member.format.map(|f| format!("{f:?}")),
+        "size": member.size,
+        "status": status,
+        detail_key: detail,
+    })
+}
+
+/// Convert the members of one archive; `prefix` is prepended to member
+/// names and `depth` is how many more nested archives may be opened
+fn convert_archive_members(
+    prefix: String,
+    source: ArchiveSource,
+    format: FileFormat,
+    output_format: OutputFormat,
+    options: Arc<ConversionOptions>,
+    budget: Arc<MemberBudget>,
+    depth: usize,
+) -> BoxFuture<'static, Result<Vec<ArchiveMember>>> {
+    Box::pin(async move {
+        let (tx, mut rx) = mpsc::channel(budget.limits.max_parallel.max(1));
+        let reader = {
+            let budget = Arc::clone(&budget);
+            tokio::task::spawn_blocking(move || read_members(source, format, &budget, &tx))
+        };
+
+        let mut slots: Vec<Vec<ArchiveMember>> = Vec::new();
+        let mut tasks = JoinSet::new();
+        while let Some(entry) = rx.recv().await {
+            let index = slots.len();
+            match entry {
+                MemberEntry::Skipped { name, size, reason } => slots.push(vec![ArchiveMember {
+                    name: format!("{prefix}{name}"),
+                    format: None,
+                    size,
+                    outcome: MemberOutcome::Skipped(reason),
+                }]),
+                MemberEntry::Failed { name, size, reason } => slots.push(vec![ArchiveMember {
+                    name: format!("{prefix}{name}"),
+                    format: None,
+                    size,
+                    outcome: MemberOutcome::Failed(reason),
+                }]),
+                MemberEntry::Read { name, data } => {
+                    slots.push(Vec::new());
+                    // Waiting here also stops the reader once the channel
+                    // fills, so at most a few members sit in memory
+                    let permit = Arc::clone(&budget.semaphore)
+                        .acquire_owned()
+                        .await
+                        .map_err(|e| TransmutationError::conversion_failed(e.to_string()))?;
+                    let name = format!("{prefix}{name}");
+                    let (output_format, options, budget) = (
+                        output_format.clone(),
+                        Arc::clone(&options),
+                        Arc::clone(&budget),
+                    );
+                    tasks.spawn(async move {
+                        let members = convert_member(
+                            name,
+                            data,
+                            output_format,
+                            options,
+                            budget,
+                            permit,
+                            depth,
+                        )
+                        .await;
+                        (index, members)
+                    });
+                }
+            }
+        }
+
+        // Unreadable members were sent as failures; this only fails when
+        // the archive itself cannot be opened
+        reader
+            .await
+            .map_err(|e| TransmutationError::conversion_failed(e.to_string()))??;
+        while let Some(joined) = tasks.join_next().await {
+            let (index, members) =
+                joined.map_err(|e| TransmutationError::conversion_failed(e.to_string()))?;
+            slots[index] = members;
+        }
+
+        Ok(slots.into_iter().flatten().collect())
+    })
+}
+
+/// Convert one member read from an archive; a nested archive expands to
+/// its own members
+async fn convert_member(
+    name: String,
+    data: Vec<u8>,
+    output_format: OutputFormat,
+    options: Arc<ConversionOptions>,
+    budget: Arc<MemberBudget>,
+    permit: OwnedSemaphorePermit,
+    depth: usize,
+) -> Vec<ArchiveMember> {
+    let size = data.len() as u64;
+    let member = |format, outcome| {
+        vec![ArchiveMember {
+            name: name.clone(),
+            format,
+            size,
+            outcome,
+        }]
+    };
+
+    let format = match file_detect::detect_format_from_bytes(&name, &data) {
+        Ok(format) => format,
+        Err(e) => return member(None, MemberOutcome::Skipped(e.to_string())),
+    };
+
+    if format.is_archive() {
+        // The nested members take their own permits
+        drop(permit);
+        if depth == 0 {
+            let reason = "nested archive depth limit reached".to_string();
+            return member(Some(format), MemberOutcome::Skipped(reason));
+        }
+        return match convert_archive_members(
+            format!("{name}/"),
+            ArchiveSource::Memory(data),
+            format,
+            output_format,
+            options,
+            budget,
+            depth - 1,
+        )
+        .await
+        {
+            Ok(members) => members,
+            Err(e) => member(Some(format), MemberOutcome::Failed(e.to_string())),
+        };
+    }
+
+    let Some(converter) = super::converter_for(format) else {
+        let reason = format!("no converter for {format:?}");
+        return member(Some(format), MemberOutcome::Skipped(reason));
+    };
+    let outcome = match converter
+        .convert_bytes(&name, data, format, output_format, (*options).clone())
+        .await
+    {
+        Ok(result) => MemberOutcome::Converted(result),
+        Err(e) => MemberOutcome::Failed(e.to_string()),
+    };
+    member(Some(format), outcome)
+}
+
+/// Walk an archive sequentially, sending each file member to `tx`; a
+/// member that cannot be read is sent as failed and the walk goes on
+fn read_members(
+    source: ArchiveSource,
+    format: FileFormat,
+    budget: &MemberBudget,
+    tx: &mpsc::Sender<MemberEntry>,
+) -> Result<()> {
+    match format {
+        FileFormat::Zip => {
+            let mut archive = ZipArchive::new(source.open()?)?;
+            for i in 0..archive.len() {
+                let file = match archive.by_index(i) {
+                    Ok(file) => file,
+                    Err(e) => {
+                        let name = archive.name_for_index(i).unwrap_or_default().to_string();
+                        if !send_failed(name, 0, e, tx) {
+                            break;
+                        }
+                        continue;
+                    }
+                };
+                if file.is_dir() {
+                    continue;
+                }
+                let (name, size) = (file.name().to_string(), file.size());
+                if !send_member(name, size, file, budget, tx)? {
+                    break;
+                }
+            }
+            Ok(())
+        }
+        #[cfg(feature = "archives-extended")]
+        FileFormat::Tar => read_tar_members(source.open()?, budget, tx),
+        #[cfg(feature = "archives-extended")]
+        FileFormat::TarGz => read_tar_members(GzDecoder::new(source.open()?), budget, tx),
+        _ => Err(TransmutationError::UnsupportedFormat(format!(
+            "Archive format {format:?} not yet supported"
+        ))),
+    }
+}
+
+#[cfg(feature = "archives-extended")]
+fn read_tar_members(
+    reader: impl Read,
+    budget: &MemberBudget,
+    tx: &mpsc::Sender<MemberEntry>,
+) -> Result<()> {
+    let mut archive = TarArchive::new(reader);
+    for (index, entry) in archive.entries()?.enumerate() {
+        let entry = match entry {
+            Ok(entry) => entry,
+            Err(e) => {
+                // Entries cannot be located past a broken header
+                send_failed(format!("entry {index}"), 0, e, tx);
+                break;
+            }
+        };
+        if !entry.header().entry_type().is_file() {
+            continue;
+        }
+        let name = match entry.path() {
+            Ok(path) => path.display().to_string(),
+            Err(e) => format!("entry {index}: {e}"),
+        };
+        let sent = match entry.header().size() {
+            Ok(size) => send_member(name, size, entry, budget, tx)?,
+            Err(e) => send_failed(name, 0, e, tx),
+        };
+        if !sent {
+            break;
+        }
+    }
+    Ok(())
+}
+
+/// Read one member within the limits and send it on; `false` stops reading
+/// the archive (a limit was hit or the receiver is gone)
+fn send_member(
+    name: String,
+    declared_size: u64,
+    reader: impl Read,
+    budget: &MemberBudget,
+    tx: &mpsc::Sender<MemberEntry>,
+) -> Result<bool> {
+    let limits = &budget.limits;
+    let skip = |name, size, reason: String| MemberEntry::Skipped { name, size, reason };
+
+    if budget.members.fetch_add(1, Ordering::Relaxed) >= limits.max_members {
+        let reason = format!("archive member limit ({}) reached", limits.max_members);
+        let _ = tx.blocking_send(skip(name, declared_size, reason));
+        return Ok(false);
+    }
+    if declared_size > limits.max_member_bytes {
+        let reason = format!("larger than {} bytes", limits.max_member_bytes);
+        return Ok(tx.blocking_send(skip(name, declared_size, reason)).is_ok());
+    }
+
+    // The declared size is not trusted: never read more than the limits allow
+    let remaining = limits
+        .max_total_bytes
+        .saturating_sub(budget.bytes.load(Ordering::Relaxed));
+    let cap = limits.max_member_bytes.min(remaining);
+    let mut data = Vec::with_capacity(declared_size.min(cap) as usize);
+    let read = reader.take(cap + 1).read_to_end(&mut data);
+    let size = data.len() as u64;
+    budget.bytes.fetch_add(size.min(cap), Ordering::Relaxed);
+
+    if let Err(e) = read {
+        return Ok(send_failed(name, declared_size, e, tx));
+    }
+
+    if size > limits.max_member_bytes {
+        let reason = format!("larger than {} bytes", limits.max_member_bytes);
+        return Ok(tx.blocking_send(skip(name, size, reason)).is_ok());
+    }
+    if size > cap {
+        let reason = format!(
+            "archive size limit ({} bytes) reached",
+            limits.max_total_bytes
+        );
+        let _ = tx.blocking_send(skip(name, size, reason));
+        return Ok(false);
+    }
+    Ok(tx.blocking_send(MemberEntry::Read { name, data }).is_ok())
+}
+
+/// Send a member that could not be read; `false` when the receiver is gone
+fn send_failed(
+    name: String,
+    size: u64,
+    error: impl std::fmt::Display,
+    tx: &mpsc::Sender<MemberEntry>,
+) -> bool {
+    let reason = format!("could not be read: {error}");
+    tx.blocking_send(MemberEntry::Failed { name, size, reason })
+        .is_ok()
+}
+
+impl ArchiveConverter {
+    /// Convert the members of an archive into one combined result
+    async fn convert_archive(
+        &self,
+        input: &Path,
+        archive_name: &str,
+        input_format: FileFormat,
+        output_format: OutputFormat,
+        options: ConversionOptions,
+    ) -> Result<ConversionResult> {
+        let split = options.split_pages
+            || matches!(
+                output_format,
+                OutputFormat::Markdown {
+                    split_pages: true,
+                    ..
+                }
+            );
+        let members = self
+            .convert_members(input, input_format, output_format.clone(), options)
+            .await?;
+        let converted: Vec<&ArchiveMember> = members
+            .iter()
+            .filter(|m| matches!(m.outcome, MemberOutcome::Converted(_)))
+            .collect();
+
+        let outputs = self.members_result(&members, archive_name, &output_format, split)?;
+        let mut result = ConversionResult::single(
+            input.to_path_buf(),
+            input_format,
+            output_format,
+            Vec::new(),
+            fs::metadata(input).await?.len(),
+        );
+        result.content = outputs
+            .into_iter()
+            .enumerate()
+            .map(|(i, data)| ConversionOutput {
+                page_number: i + 1,
+                metadata: OutputMetadata {
+                    size_bytes: data.len() as u64,
+                    chunk_count: 1,
+                    token_count: None,
+                },
+                data,
+            })
+            .collect();
+
+        let names: Vec<&str> = converted.iter().map(|m| m.name.as_str()).collect();
+        let custom = &mut result.metadata.custom;
+        custom.insert("file_count".to_string(), members.len().to_string());
+        custom.insert("converted_count".to_string(), converted.len().to_string());
+        // Per-member outputs are in this order
+        custom.insert("members".to_string(), serde_json::to_string(&names)?);
+        result.metadata.title = Some(archive_name.to_string());
+        result.metadata.page_count = result.content.len();
+
+        let stats = &mut result.statistics;
+        stats.output_size_bytes = result.content.iter().map(|o| o.data.len() as u64).sum();
+        stats.pages_processed = converted.len();
+        for member in &converted {
+            if let MemberOutcome::Converted(r) = &member.outcome {
+                stats.tables_extracted += r.statistics.tables_extracted;
+                stats.images_extracted += r.statistics.images_extracted;
+            }
+        }
+
+        eprintln!(
+            "✅ Converted {} of {} archive members",
+            converted.len(),
+            members.len()
+        );
+        Ok(result)
+    }
 }
 
 impl Default for ArchiveConverter {
@@ -239,15 +833,31 @@ impl DocumentConverter for ArchiveConverter {
         &self,
         input: &Path,
         output_format: OutputFormat,
-        _options: ConversionOptions,
+        options: ConversionOptions,
+    ) -> Result<ConversionResult> {
+        // Detect archive format
+        let input_format = file_detect::detect_format(input).await?;
+        self.convert_detected(input, input_format, output_format, options)
+            .await
+    }
+
+    async fn convert_detected(
+        &self,
+        input: &Path,
+        input_format: FileFormat,
+        output_format: OutputFormat,
+        options: ConversionOptions,
     ) -> Result<ConversionResult> {
         let archive_name = input
             .file_name()
             .and_then(|n| n.to_str())
             .unwrap_or("archive");
 
-        // Detect archive format
-        let input_format = file_detect::detect_format(input).await?;
+        if options.convert_archive_members {
+            return self
+                .convert_archive(input, archive_name, input_format, output_format, options)
+                .await;
+        }
 
         eprintln!("🔄 Archive Processing (Pure Rust)");
         eprintln!(
@@ -350,4 +960,164 @@ mod tests {
         let meta = converter.metadata();
         assert_eq!(meta.name, "Archive Converter");
     }
+
+    fn zip_of(files: &[(&str, &[u8])]) -> Vec<u8> {
+        use std::io::Write;
+
+        let mut zip = zip::ZipWriter::new(Cursor::new(Vec::new()));
+        for (name, data) in files {
+            zip.start_file(*name, zip::write::SimpleFileOptions::default())
+                .unwrap();
+            zip.write_all(data).unwrap();
+        }
+        zip.finish().unwrap().into_inner()
+    }
+
+    #[tokio::test(flavor = "multi_thread")]
+    async fn test_convert_members_in_order_with_limits() {
+        let inner = zip_of(&[
+            ("c.txt", b"Nested notes"),
+            ("deeper.zip", &zip_of(&[("d.txt", b"Too deep")])),
+        ]);
+        let big = vec![b'x'; 4096];
+        let outer = zip_of(&[
+            ("a.txt", b"First notes"),
+            ("big.txt", &big),
+            ("inner.zip", &inner),
+            ("data.xyz", &[0, 1, 2, 3]),
+        ]);
+        let dir = tempfile::tempdir().unwrap();
+        let path = dir.path().join("bundle.zip");
+        std::fs::write(&path, outer).unwrap();
+
+        let mut options = ConversionOptions::default();
+        options.convert_archive_members = true;
+        options.archive_limits.max_member_bytes = 2048;
+        options.archive_limits.max_depth = 1;
+        let markdown = OutputFormat::Markdown {
+            split_pages: false,
+            optimize_for_llm: true,
+        };
+
+        let converter = ArchiveConverter::new();
+        let members = converter
+            .convert_members(&path, FileFormat::Zip, markdown.clone(), options.clone())
+            .await
+            .unwrap();
+        let summary: Vec<(&str, bool)> = members
+            .iter()
+            .map(|m| {
+                let converted = matches!(m.outcome, MemberOutcome::Converted(_));
+                (m.name.as_str(), converted)
+            })
+            .collect();
+        assert_eq!(
+            summary,
+            vec![
+                ("a.txt", true),
+                ("big.txt", false),
+                ("inner.zip/c.txt", true),
+                ("inner.zip/deeper.zip", false),
+                ("data.xyz", false),
+            ]
+        );
+
+        let result = converter
+            .convert_detected(&path, FileFormat::Zip, markdown, options)
+            .await
+            .unwrap();
+        let text = String::from_utf8(result.content[0].data.clone()).unwrap();
+        assert!(text.contains("## inner.zip/c.txt\n\n# Document\n\nNested notes"));
+        assert!(text.contains("- `inner.zip/deeper.zip` (skipped): nested archive depth"));
+        assert_eq!(result.metadata.custom["converted_count"], "2");
+    }
+
+    #[tokio::test]
+    async fn test_convert_members_count_limit() {
+        let dir = tempfile::tempdir().unwrap();
+        let path = dir.path().join("many.zip");
+        std::fs::write(
+            &path,
+            zip_of(&[("1.txt", b"one"), ("2.txt", b"two"), ("3.txt", b"three")]),
+        )
+        .unwrap();
+
+        let mut options = ConversionOptions::default();
+        options.archive_limits.max_members = 2;
+        let json = OutputFormat::Json {
+            structured: true,
+            include_metadata: true,
+        };
+        let members = ArchiveConverter::new()
+            .convert_members(&path, FileFormat::Zip, json, options)
+            .await
+            .unwrap();
+
+        assert_eq!(members.len(), 3);
+        assert!(
+            matches!(&members[2].outcome, MemberOutcome::Skipped(reason) if reason.contains("member limit"))
+        );
+    }
+
+    #[tokio::test]
+    async fn test_convert_members_continues_past_unreadable_members() {
+        use std::io::Write;
+
+        let mut zip = zip::ZipWriter::new(Cursor::new(Vec::new()));
+        let stored = zip::write::SimpleFileOptions::default()
+            .compression_method(zip::CompressionMethod::Stored);
+        for (name, data) in [
+            ("bad.txt", "damaged contents"),
+            ("odd.txt", "unknown compression"),
+            ("good.txt", "Readable notes"),
+        ] {
+            zip.start_file(name, stored).unwrap();
+            zip.write_all(data.as_bytes()).unwrap();
+        }
+        let mut bytes = zip.finish().unwrap().into_inner();
+
+        // Break the checksum of one member and give another a compression
+        // method no reader supports, in its local and central headers
+        let find = |bytes: &[u8], needle: &[u8]| {
+            (0..bytes.len())
+                .filter(|&i| bytes[i..].starts_with(needle))
+                .collect::<Vec<_>>()
+        };
+        let damaged = find(&bytes, b"damaged")[0];
+        bytes[damaged] ^= 0xff;
+        for at in find(&bytes, b"odd.txt") {
+            let method = if bytes[at - 46..].starts_with(b"PK\x01\x02") {
+                at - 46 + 10
+            } else {
+                at - 30 + 8
+            };
+            bytes[method..method + 2].copy_from_slice(&0x00ffu16.to_le_bytes());
+        }
+
+        let dir = tempfile::tempdir().unwrap();
+        let path = dir.path().join("broken.zip");
+        std::fs::write(&path, bytes).unwrap();
+
+        let markdown = OutputFormat::Markdown {
+            split_pages: false,
+            optimize_for_llm: true,
+        };
+        let members = ArchiveConverter::new()
+            .convert_members(
+                &path,
+                FileFormat::Zip,
+                markdown,
+                ConversionOptions::default(),
+            )
+            .await
+            .unwrap();
+
+        let names: Vec<&str> = members.iter().map(|m| m.name.as_str()).collect();
+        assert_eq!(names, vec!["bad.txt", "odd.txt", "good.txt"]);
+        assert!(
+            matches!(&members[0].outcome, MemberOutcome::Failed(reason) if reason.contains("could not be read"))
+        );
+        assert!(matches!(members[1].outcome, MemberOutcome::Failed(_)));
+        assert!(matches!(members[2].outcome, MemberOutcome::Converted(_)));
+    }
 }
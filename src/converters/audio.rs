@@ -1,6 +1,7 @@
 //! Audio converter with Whisper transcription
 //!
-//! Converts audio files to text using Whisper ASR.
+//! Converts audio files to text using Whisper ASR, through the resident
+//! workers of [`transcription`](super::transcription).
 
 #![allow(
     clippy::uninlined_format_args,
@@ -9,7 +10,6 @@
 )]
 
 use std::path::Path;
-use std::process::Command;
 
 use async_trait::async_trait;
 use tokio::fs;
@@ -30,115 +30,10 @@ impl AudioConverter {
         Self
     }
 
-    /// Check if whisper CLI is available
-    fn check_whisper() -> bool {
-        // Try whisper in PATH
-        if Command::new("whisper").arg("--help").output().is_ok() {
-            return true;
-        }
-
-        // Try common installation paths
-        let paths = vec![
-            format!(
-                "{}/.local/bin/whisper",
-                std::env::var("HOME").unwrap_or_default()
-            ),
-            "/usr/local/bin/whisper".to_string(),
-            "/usr/bin/whisper".to_string(),
-        ];
-
-        for path in paths {
-            if std::path::Path::new(&path).exists() {
-                return true;
-            }
-        }
-
-        false
-    }
-
-    /// Get whisper command path
-    fn get_whisper_cmd() -> String {
-        // Try common paths
-        let paths = vec![
-            format!(
-                "{}/.local/bin/whisper",
-                std::env::var("HOME").unwrap_or_default()
-            ),
-            "/usr/local/bin/whisper".to_string(),
-            "/usr/bin/whisper".to_string(),
-            "whisper".to_string(),
-        ];
-
-        for path in &paths {
-            if std::path::Path::new(path).exists() || path == "whisper" {
-                return path.clone();
-            }
-        }
-
-        "whisper".to_string()
-    }
-
-    /// Transcribe audio using Whisper
-    async fn transcribe_audio(&self, audio_path: &Path, language: Option<&str>) -> Result<String> {
-        if !Self::check_whisper() {
-            return Err(crate::TransmutationError::conversion_failed(
-                "Whisper not found. Install: pip install openai-whisper (or pipx install openai-whisper)",
-            ));
-        }
-
-        // Use Whisper CLI for transcription
-        let whisper_cmd = Self::get_whisper_cmd();
-        let mut cmd = Command::new(&whisper_cmd);
-        cmd.arg(audio_path);
-        cmd.arg("--model").arg("base"); // Use base model (fast, good quality)
-        cmd.arg("--output_format").arg("txt");
-        cmd.arg("--output_dir").arg("/tmp");
-
-        if let Some(lang) = language {
-            cmd.arg("--language").arg(lang);
-        }
-
-        eprintln!("📝 Running Whisper transcription...");
-        let output = cmd.output().map_err(|e| {
-            crate::TransmutationError::conversion_failed(&format!(
-                "Whisper execution failed: {}",
-                e
-            ))
-        })?;
-
-        if !output.status.success() {
-            let stderr = String::from_utf8_lossy(&output.stderr);
-            return Err(crate::TransmutationError::conversion_failed(&format!(
-                "Whisper failed: {}",
-                stderr
-            )));
-        }
-
-        // Read transcription from output file
-        let audio_name = audio_path
-            .file_stem()
-            .and_then(|s| s.to_str())
-            .unwrap_or("audio");
-        let transcript_path = format!("/tmp/{}.txt", audio_name);
-
-        let transcript = tokio::fs::read_to_string(&transcript_path)
-            .await
-            .map_err(|e| {
-                crate::TransmutationError::conversion_failed(&format!(
-                    "Failed to read transcript: {}",
-                    e
-                ))
-            })?;
-
-        // Clean up temp file
-        let _ = tokio::fs::remove_file(&transcript_path).await;
-
-        Ok(transcript)
-    }
-
     /// Convert audio to Markdown
     async fn audio_to_markdown(&self, audio_path: &Path, language: Option<&str>) -> Result<String> {
-        let transcript = self.transcribe_audio(audio_path, language).await?;
+        eprintln!("📝 Running Whisper transcription...");
+        let transcript = super::transcription::transcribe_file(audio_path, language).await?;
 
         let mut markdown = String::new();
         markdown.push_str("# Audio Transcription\n\n");
@@ -190,6 +85,18 @@ impl DocumentConverter for AudioConverter {
         &self,
         input: &Path,
         output_format: OutputFormat,
+        options: ConversionOptions,
+    ) -> Result<ConversionResult> {
+        let input_format = crate::utils::file_detect::detect_format(input).await?;
+        self.convert_detected(input, input_format, output_format, options)
+            .await
+    }
+
+    async fn convert_detected(
+        &self,
+        input: &Path,
+        input_format: FileFormat,
+        output_format: OutputFormat,
         _options: ConversionOptions,
     ) -> Result<ConversionResult> {
         eprintln!("🔄 Audio Transcription (Whisper)");
@@ -230,7 +137,7 @@ impl DocumentConverter for AudioConverter {
 
         Ok(ConversionResult {
             input_path: input.to_path_buf(),
-            input_format: crate::utils::file_detect::detect_format(input).await?,
+            input_format,
             output_format,
             content: vec![ConversionOutput {
                 page_number: 1,
@@ -1,19 +1,47 @@
 //! CSV/TSV converter implementation
 //!
-//! Converts CSV/TSV files to Markdown tables and JSON.
+//! Converts CSV/TSV files to Markdown tables, JSON and NDJSON.
+//!
+//! The input is read in fixed-size windows and never held as a whole.
+//! Each window is cut at record boundaries (quote-aware, so quoted fields
+//! may contain delimiters and line breaks) into segments that are parsed
+//! and rendered in parallel, then written out in order. Cells are borrowed
+//! from the read buffer and escaped straight into the output.
 
 #![allow(clippy::uninlined_format_args)]
 
-use std::path::Path;
+use std::borrow::Cow;
+use std::fs::File;
+use std::io::{self, Read, Write};
+use std::path::{Path, PathBuf};
 
 use async_trait::async_trait;
+use rayon::prelude::*;
 use tokio::fs;
 
+use super::csv_reader::{parse_record, scan_records};
 use super::traits::{ConverterMetadata, DocumentConverter};
-use crate::Result;
 use crate::types::{
     ConversionOptions, ConversionOutput, ConversionResult, FileFormat, OutputFormat, OutputMetadata,
 };
+use crate::{Result, TransmutationError};
+
+/// Bytes read from the input per window
+const WINDOW_BYTES: usize = 16 * 1024 * 1024;
+
+/// Smallest segment worth handing to its own thread
+const MIN_SEGMENT_BYTES: usize = 256 * 1024;
+
+/// Table rendering produced by the converter
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+enum TableFormat {
+    /// Markdown table with the first record as header
+    Markdown,
+    /// One JSON document with headers, row objects and counts
+    Json,
+    /// One JSON object per line, keyed by header
+    Ndjson,
+}
 
 /// CSV/TSV to Markdown converter
 #[derive(Debug)]
@@ -32,94 +60,305 @@ impl CsvConverter {
         Self { delimiter: '\t' }
     }
 
-    /// Parse CSV and convert to Markdown table
-    fn csv_to_markdown(&self, csv: &str) -> String {
-        let lines: Vec<&str> = csv.lines().filter(|l| !l.trim().is_empty()).collect();
+    /// Delimiter as a byte; delimiters are always ASCII
+    fn delimiter_byte(&self) -> u8 {
+        u8::try_from(self.delimiter).unwrap_or(b',')
+    }
 
-        if lines.is_empty() {
-            return "# Empty File\n".to_string();
+    /// Table format for an output format
+    fn table_format(&self, output_format: &OutputFormat) -> Result<TableFormat> {
+        Ok(match output_format {
+            OutputFormat::Markdown { .. } => {
+                eprintln!("📝 Converting to Markdown table...");
+                TableFormat::Markdown
+            }
+            OutputFormat::Json { structured, .. } => {
+                eprintln!(
+                    "📝 Converting to {}...",
+                    if *structured { "JSON" } else { "NDJSON" }
+                );
+                if *structured {
+                    TableFormat::Json
+                } else {
+                    TableFormat::Ndjson
+                }
+            }
+            _ => {
+                return Err(TransmutationError::UnsupportedFormat(format!(
+                    "Output format {:?} not supported for CSV",
+                    output_format
+                )));
+            }
+        })
+    }
+
+    /// Input format this converter reads
+    fn input_format(&self) -> FileFormat {
+        if self.delimiter == ',' {
+            FileFormat::Csv
+        } else {
+            FileFormat::Tsv
         }
+    }
 
-        let mut markdown = String::new();
-        markdown.push_str("# Data Table\n\n");
+    /// Stream `reader` into `out` as a table, reading `window` bytes at a
+    /// time. Returns the number of data rows written.
+    fn write_table<R: Read, W: Write>(
+        &self,
+        mut reader: R,
+        format: TableFormat,
+        out: &mut W,
+        window: usize,
+    ) -> io::Result<usize> {
+        let delimiter = self.delimiter_byte();
+        let mut buf = Vec::new();
+        let mut table: Option<TableWriter> = None;
+
+        loop {
+            let read = (&mut reader).take(window as u64).read_to_end(&mut buf)?;
+            let eof = read < window;
+
+            let step = MIN_SEGMENT_BYTES.max(buf.len() / rayon::current_num_threads());
+            let scan = scan_records(&buf, delimiter, step, eof);
+            let records = &buf[..scan.complete];
+
+            let mut start = 0;
+            if table.is_none() {
+                let mut fields = Vec::new();
+                while parse_record(records, &mut start, delimiter, &mut fields) {
+                    if !is_blank(&fields) {
+                        let header = TableWriter::new(format, delimiter, &fields);
+                        header.write_header(&fields, out)?;
+                        table = Some(header);
+                        break;
+                    }
+                }
+            }
 
-        for (idx, line) in lines.iter().enumerate() {
-            let cells: Vec<&str> = line.split(self.delimiter).collect();
+            if let Some(table) = &mut table {
+                let mut bounds = vec![start];
+                bounds.extend(scan.splits.iter().filter(|&&split| split > start));
+                bounds.push(scan.complete);
+                table.write_segments(records, &bounds, out)?;
+            }
 
-            // Header row
-            if idx == 0 {
-                markdown.push('|');
-                for cell in &cells {
-                    markdown.push_str(&format!(" {} |", cell.trim()));
-                }
-                markdown.push('\n');
+            buf.drain(..scan.complete);
+            if eof {
+                break;
+            }
+        }
+
+        match table {
+            Some(table) => table.finish(out),
+            None => {
+                out.write_all(match format {
+                    TableFormat::Markdown => b"# Empty File\n",
+                    TableFormat::Json => b"{\"data\":[]}",
+                    TableFormat::Ndjson => b"",
+                })?;
+                Ok(0)
+            }
+        }
+    }
+}
 
-                // Separator
-                markdown.push('|');
-                for _ in &cells {
-                    markdown.push_str("---|");
+impl Default for CsvConverter {
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
+/// Renders records of one table; JSON keys are escaped once up front
+struct TableWriter {
+    format: TableFormat,
+    delimiter: u8,
+    keys: Vec<Vec<u8>>,
+    rows: usize,
+}
+
+impl TableWriter {
+    fn new(format: TableFormat, delimiter: u8, header: &[Cow<'_, str>]) -> Self {
+        let keys = header
+            .iter()
+            .map(|name| {
+                let mut key = Vec::new();
+                push_json_str(&mut key, name.trim());
+                key.push(b':');
+                key
+            })
+            .collect();
+        Self {
+            format,
+            delimiter,
+            keys,
+            rows: 0,
+        }
+    }
+
+    fn write_header<W: Write>(&self, header: &[Cow<'_, str>], out: &mut W) -> io::Result<()> {
+        let mut head = Vec::new();
+        match self.format {
+            TableFormat::Markdown => {
+                head.extend_from_slice(b"# Data Table\n\n");
+                push_markdown_row(&mut head, header);
+                head.push(b'|');
+                for _ in header {
+                    head.extend_from_slice(b"---|");
                 }
-                markdown.push('\n');
-            } else {
-                // Data rows
-                markdown.push('|');
-                for cell in &cells {
-                    markdown.push_str(&format!(" {} |", cell.trim()));
+                head.push(b'\n');
+            }
+            TableFormat::Json => {
+                head.extend_from_slice(b"{\n  \"headers\": [");
+                for (idx, name) in header.iter().enumerate() {
+                    if idx > 0 {
+                        head.extend_from_slice(b", ");
+                    }
+                    push_json_str(&mut head, name.trim());
                 }
-                markdown.push('\n');
+                head.extend_from_slice(b"],\n  \"column_count\": ");
+                head.extend_from_slice(header.len().to_string().as_bytes());
+                head.extend_from_slice(b",\n  \"data\": [");
             }
+            TableFormat::Ndjson => {}
         }
+        out.write_all(&head)
+    }
 
-        markdown.push('\n');
-        markdown
+    /// Render the records between consecutive `bounds` in parallel and
+    /// write them in order
+    fn write_segments<W: Write>(
+        &mut self,
+        records: &[u8],
+        bounds: &[usize],
+        out: &mut W,
+    ) -> io::Result<()> {
+        let rendered: Vec<(Vec<u8>, usize)> = if bounds.len() > 2 {
+            bounds
+                .par_windows(2)
+                .map(|w| self.render_segment(&records[w[0]..w[1]]))
+                .collect()
+        } else {
+            bounds
+                .windows(2)
+                .map(|w| self.render_segment(&records[w[0]..w[1]]))
+                .collect()
+        };
+
+        for (bytes, rows) in rendered {
+            if rows == 0 {
+                continue;
+            }
+            // JSON rows are rendered with a leading comma; the first has none
+            let skip = usize::from(self.format == TableFormat::Json && self.rows == 0);
+            out.write_all(&bytes[skip..])?;
+            self.rows += rows;
+        }
+        Ok(())
     }
 
-    /// Parse CSV and convert to JSON
-    fn csv_to_json(&self, csv: &str) -> Result<String> {
-        let lines: Vec<&str> = csv.lines().filter(|l| !l.trim().is_empty()).collect();
+    fn render_segment(&self, segment: &[u8]) -> (Vec<u8>, usize) {
+        let mut out = Vec::with_capacity(segment.len() + segment.len() / 4);
+        let mut fields = Vec::new();
+        let mut pos = 0;
+        let mut rows = 0;
 
-        if lines.is_empty() {
-            return Ok(serde_json::json!({"data": []}).to_string());
+        while parse_record(segment, &mut pos, self.delimiter, &mut fields) {
+            if is_blank(&fields) {
+                continue;
+            }
+            match self.format {
+                TableFormat::Markdown => push_markdown_row(&mut out, &fields),
+                TableFormat::Json => {
+                    out.extend_from_slice(b",\n    ");
+                    self.push_json_row(&mut out, &fields);
+                }
+                TableFormat::Ndjson => {
+                    self.push_json_row(&mut out, &fields);
+                    out.push(b'\n');
+                }
+            }
+            rows += 1;
         }
+        (out, rows)
+    }
 
-        // First line is headers
-        let headers: Vec<String> = lines[0]
-            .split(self.delimiter)
-            .map(|h| h.trim().to_string())
-            .collect();
+    /// Row object keyed by header; cells beyond the header are dropped
+    fn push_json_row(&self, out: &mut Vec<u8>, fields: &[Cow<'_, str>]) {
+        out.push(b'{');
+        for (idx, (key, cell)) in self.keys.iter().zip(fields).enumerate() {
+            if idx > 0 {
+                out.push(b',');
+            }
+            out.extend_from_slice(key);
+            push_json_str(out, cell.trim());
+        }
+        out.push(b'}');
+    }
 
-        // Remaining lines are data
-        let mut rows = Vec::new();
-        for line in &lines[1..] {
-            let cells: Vec<&str> = line.split(self.delimiter).collect();
-            let mut row = serde_json::Map::new();
-
-            for (idx, cell) in cells.iter().enumerate() {
-                if idx < headers.len() {
-                    row.insert(
-                        headers[idx].clone(),
-                        serde_json::Value::String(cell.trim().to_string()),
-                    );
+    fn finish<W: Write>(self, out: &mut W) -> io::Result<usize> {
+        match self.format {
+            TableFormat::Markdown => out.write_all(b"\n")?,
+            TableFormat::Json => {
+                if self.rows > 0 {
+                    out.write_all(b"\n  ")?;
                 }
+                write!(out, "],\n  \"row_count\": {}\n}}", self.rows)?;
             }
-            rows.push(row);
+            TableFormat::Ndjson => {}
         }
+        Ok(self.rows)
+    }
+}
 
-        let result = serde_json::json!({
-            "data": rows,
-            "row_count": rows.len(),
-            "column_count": headers.len(),
-            "headers": headers,
-        });
+/// Whether a record is a blank line
+fn is_blank(fields: &[Cow<'_, str>]) -> bool {
+    matches!(fields, [only] if only.trim().is_empty())
+}
 
-        Ok(serde_json::to_string_pretty(&result)?)
+/// Append `| cell | cell |` with pipes escaped and line breaks as `<br>`
+fn push_markdown_row(out: &mut Vec<u8>, fields: &[Cow<'_, str>]) {
+    out.push(b'|');
+    for cell in fields {
+        out.push(b' ');
+        let cell = cell.trim().as_bytes();
+        for (i, &b) in cell.iter().enumerate() {
+            match b {
+                b'|' => out.extend_from_slice(b"\\|"),
+                b'\r' if cell.get(i + 1) == Some(&b'\n') => {}
+                b'\r' | b'\n' => out.extend_from_slice(b"<br>"),
+                _ => out.push(b),
+            }
+        }
+        out.extend_from_slice(b" |");
     }
+    out.push(b'\n');
 }
 
-impl Default for CsvConverter {
-    fn default() -> Self {
-        Self::new()
+/// Append `s` as a JSON string literal
+fn push_json_str(out: &mut Vec<u8>, s: &str) {
+    out.push(b'"');
+    let bytes = s.as_bytes();
+    let mut start = 0;
+    for (i, &b) in bytes.iter().enumerate() {
+        let escape: &[u8] = match b {
+            b'"' => b"\\\"",
+            b'\\' => b"\\\\",
+            b'\n' => b"\\n",
+            b'\r' => b"\\r",
+            b'\t' => b"\\t",
+            0x00..=0x1f => b"",
+            _ => continue,
+        };
+        out.extend_from_slice(&bytes[start..i]);
+        if escape.is_empty() {
+            out.extend_from_slice(format!("\\u{:04x}", b).as_bytes());
+        } else {
+            out.extend_from_slice(escape);
+        }
+        start = i + 1;
     }
+    out.extend_from_slice(&bytes[start..]);
+    out.push(b'"');
 }
 
 #[async_trait]
@@ -138,6 +377,11 @@ impl DocumentConverter for CsvConverter {
                 structured: true,
                 include_metadata: true,
             },
+            // Unstructured JSON is NDJSON: one object per row
+            OutputFormat::Json {
+                structured: false,
+                include_metadata: false,
+            },
         ]
     }
 
@@ -151,41 +395,29 @@ impl DocumentConverter for CsvConverter {
         eprintln!("   CSV → Parsing → {:?}", output_format);
         eprintln!();
 
-        // Read CSV file
-        let csv_content = fs::read_to_string(input).await?;
+        let format = self.table_format(&output_format)?;
 
-        // Convert to requested format
-        let output_data = match output_format {
-            OutputFormat::Markdown { .. } => {
-                eprintln!("📝 Converting to Markdown table...");
-                let markdown = self.csv_to_markdown(&csv_content);
-                markdown.into_bytes()
-            }
-            OutputFormat::Json { .. } => {
-                eprintln!("📝 Converting to JSON...");
-                let json = self.csv_to_json(&csv_content)?;
-                json.into_bytes()
-            }
-            _ => {
-                return Err(crate::TransmutationError::UnsupportedFormat(format!(
-                    "Output format {:?} not supported for CSV",
-                    output_format
-                )));
-            }
+        let converter = Self {
+            delimiter: self.delimiter,
         };
+        let path = input.to_path_buf();
+        let (output_data, row_count) = tokio::task::spawn_blocking(move || -> Result<_> {
+            let mut output = Vec::new();
+            let rows =
+                converter.write_table(File::open(&path)?, format, &mut output, WINDOW_BYTES)?;
+            Ok((output, rows))
+        })
+        .await
+        .map_err(|e| TransmutationError::conversion_failed(e.to_string()))??;
 
         let output_size = output_data.len() as u64;
         let input_size = fs::metadata(input).await?.len();
 
-        eprintln!("✅ CSV conversion complete!");
+        eprintln!("✅ CSV conversion complete! ({} rows)", row_count);
 
         Ok(ConversionResult {
             input_path: input.to_path_buf(),
-            input_format: if self.delimiter == ',' {
-                FileFormat::Csv
-            } else {
-                FileFormat::Tsv
-            },
+            input_format: self.input_format(),
             output_format,
             content: vec![ConversionOutput {
                 page_number: 1,
@@ -217,11 +449,43 @@ impl DocumentConverter for CsvConverter {
         })
     }
 
+    async fn convert_bytes(
+        &self,
+        name: &str,
+        data: Vec<u8>,
+        _input_format: FileFormat,
+        output_format: OutputFormat,
+        _options: ConversionOptions,
+    ) -> Result<ConversionResult> {
+        let format = self.table_format(&output_format)?;
+        let converter = Self {
+            delimiter: self.delimiter,
+        };
+        let input_size = data.len() as u64;
+        let output_data = tokio::task::spawn_blocking(move || -> Result<_> {
+            let mut output = Vec::new();
+            converter.write_table(&data[..], format, &mut output, WINDOW_BYTES)?;
+            Ok(output)
+        })
+        .await
+        .map_err(|e| TransmutationError::conversion_failed(e.to_string()))??;
+
+        let mut result = ConversionResult::single(
+            PathBuf::from(name),
+            self.input_format(),
+            output_format,
+            output_data,
+            input_size,
+        );
+        result.statistics.tables_extracted = 1;
+        Ok(result)
+    }
+
     fn metadata(&self) -> ConverterMetadata {
         ConverterMetadata {
             name: "CSV/TSV Converter".to_string(),
             version: env!("CARGO_PKG_VERSION").to_string(),
-            description: "CSV/TSV to Markdown tables and JSON (pure Rust)".to_string(),
+            description: "CSV/TSV to Markdown tables, JSON and NDJSON (pure Rust)".to_string(),
             external_deps: vec![],
         }
     }
@@ -231,6 +495,14 @@ impl DocumentConverter for CsvConverter {
 mod tests {
     use super::*;
 
+    fn render(converter: &CsvConverter, csv: &str, format: TableFormat, window: usize) -> String {
+        let mut out = Vec::new();
+        converter
+            .write_table(csv.as_bytes(), format, &mut out, window)
+            .unwrap();
+        String::from_utf8(out).unwrap()
+    }
+
     #[test]
     fn test_csv_converter_creation() {
         let converter = CsvConverter::new();
@@ -243,11 +515,107 @@ mod tests {
     fn test_csv_to_markdown_basic() {
         let converter = CsvConverter::new();
         let csv = "Name,Age\nAlice,30\nBob,25";
-        let result = converter.csv_to_markdown(csv);
+        let result = render(&converter, csv, TableFormat::Markdown, WINDOW_BYTES);
         assert!(result.contains("Name"));
         assert!(result.contains("Alice"));
     }
 
+    #[test]
+    fn test_csv_quoted_fields() {
+        let converter = CsvConverter::new();
+        let csv = "Name,Note\r\n\"Smith, J\",\"says \"\"hi\"\"\nthen | leaves\"\r\n\r\nBob,ok\r\n";
+
+        assert_eq!(
+            render(&converter, csv, TableFormat::Markdown, WINDOW_BYTES),
+            "# Data Table\n\n| Name | Note |\n|---|---|\n\
+             | Smith, J | says \"hi\"<br>then \\| leaves |\n| Bob | ok |\n\n"
+        );
+        assert_eq!(
+            render(&converter, csv, TableFormat::Ndjson, WINDOW_BYTES),
+            "{\"Name\":\"Smith, J\",\"Note\":\"says \\\"hi\\\"\\nthen | leaves\"}\n\
+             {\"Name\":\"Bob\",\"Note\":\"ok\"}\n"
+        );
+    }
+
+    #[test]
+    fn test_csv_to_json_document() {
+        let converter = CsvConverter::new_tsv();
+        let json = render(
+            &converter,
+            "a\tb\n1\t2\t3\n4\n",
+            TableFormat::Json,
+            WINDOW_BYTES,
+        );
+        let value: serde_json::Value = serde_json::from_str(&json).unwrap();
+
+        assert_eq!(value["headers"], serde_json::json!(["a", "b"]));
+        assert_eq!(value["column_count"], 2);
+        assert_eq!(value["row_count"], 2);
+        assert_eq!(
+            value["data"],
+            serde_json::json!([{"a": "1", "b": "2"}, {"a": "4"}])
+        );
+
+        let empty = render(&converter, "\n\n", TableFormat::Json, WINDOW_BYTES);
+        assert_eq!(empty, "{\"data\":[]}");
+        let header_only = render(&converter, "a\n", TableFormat::Json, WINDOW_BYTES);
+        assert_eq!(
+            serde_json::from_str::<serde_json::Value>(&header_only).unwrap()["row_count"],
+            0
+        );
+        assert_eq!(
+            render(&converter, "", TableFormat::Markdown, WINDOW_BYTES),
+            "# Empty File\n"
+        );
+    }
+
+    #[test]
+    fn test_csv_windows_match_single_read() {
+        let converter = CsvConverter::new();
+        let mut csv = String::from("id,text\n");
+        for n in 0..200 {
+            csv.push_str(&format!("{n},\"row {n}, \"\"quoted\"\"\nsecond line\"\n"));
+            if n % 7 == 0 {
+                csv.push('\n');
+            }
+        }
+
+        for format in [
+            TableFormat::Markdown,
+            TableFormat::Json,
+            TableFormat::Ndjson,
+        ] {
+            let whole = render(&converter, &csv, format, csv.len() + 1);
+            for window in [1, 2, 3, 17, 64, 1000] {
+                assert_eq!(
+                    render(&converter, &csv, format, window),
+                    whole,
+                    "{format:?} {window}"
+                );
+            }
+        }
+    }
+
+    #[test]
+    fn test_csv_parallel_segments_keep_order() {
+        let converter = CsvConverter::new();
+        let mut csv = String::from("n,text\n");
+        let mut n = 0;
+        while csv.len() < 4 * MIN_SEGMENT_BYTES {
+            csv.push_str(&format!("{n},\"line\n{n}\"\n"));
+            n += 1;
+        }
+
+        // Large windows are split into segments, small ones are not
+        let parallel = render(&converter, &csv, TableFormat::Ndjson, WINDOW_BYTES);
+        assert_eq!(
+            parallel,
+            render(&converter, &csv, TableFormat::Ndjson, 4096)
+        );
+        assert_eq!(parallel.lines().count(), n);
+        assert!(parallel.ends_with(&format!("\"text\":\"line\\n{}\"}}\n", n - 1)));
+    }
+
     #[test]
     fn test_csv_converter_metadata() {
         let converter = CsvConverter::new();
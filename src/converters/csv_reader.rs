@@ -0,0 +1,227 @@
+//! Streaming RFC 4180 record parser
+//!
+//! Fields are borrowed from the input buffer and only copied when a quoted
+//! field contains escaped quotes. Quoted fields may span lines and contain
+//! delimiters; a quote only opens a quoted field at the start of a field,
+//! elsewhere it is literal text.
+//!
+//! [`scan_records`] finds record boundaries with the same quoting rules, so
+//! a buffer can be cut into segments that each start at a record and be
+//! parsed in parallel.
+
+use std::borrow::Cow;
+
+use memchr::{memchr, memchr2, memchr3};
+
+/// Parse the record starting at `*pos` into `fields` and advance `*pos`
+/// past its line break. Returns `false` once `buf` is exhausted.
+pub(crate) fn parse_record<'a>(
+    buf: &'a [u8],
+    pos: &mut usize,
+    delimiter: u8,
+    fields: &mut Vec<Cow<'a, str>>,
+) -> bool {
+    fields.clear();
+    if *pos >= buf.len() {
+        return false;
+    }
+
+    loop {
+        let start = *pos;
+        let field = if buf.get(start) == Some(&b'"') {
+            let (content, escaped, after) = quoted_field(buf, start + 1);
+            let end = field_end(buf, after, delimiter);
+            let junk = strip_cr(buf, after, end);
+            let content = String::from_utf8_lossy(content);
+            let content = if escaped {
+                Cow::Owned(content.replace("\"\"", "\""))
+            } else {
+                content
+            };
+            *pos = end;
+            if junk.is_empty() {
+                content
+            } else {
+                // Text after the closing quote is kept, as most readers do
+                Cow::Owned(content.into_owned() + &String::from_utf8_lossy(junk))
+            }
+        } else {
+            let end = field_end(buf, start, delimiter);
+            *pos = end;
+            String::from_utf8_lossy(strip_cr(buf, start, end))
+        };
+        fields.push(field);
+
+        match buf.get(*pos) {
+            Some(&b) if b == delimiter => *pos += 1,
+            Some(_) => {
+                *pos += 1;
+                return true;
+            }
+            None => return true,
+        }
+    }
+}
+
+/// Content of a quoted field whose text starts at `start`: the raw bytes,
+/// whether they contain `""` escapes, and the offset after the closing quote
+fn quoted_field(buf: &[u8], start: usize) -> (&[u8], bool, usize) {
+    let mut i = start;
+    let mut escaped = false;
+
+    while let Some(offset) = memchr(b'"', &buf[i..]) {
+        let quote = i + offset;
+        if buf.get(quote + 1) == Some(&b'"') {
+            escaped = true;
+            i = quote + 2;
+        } else {
+            return (&buf[start..quote], escaped, quote + 1);
+        }
+    }
+    // Unterminated: the rest of the input belongs to the field
+    (&buf[start..], escaped, buf.len())
+}
+
+/// Offset of the delimiter or line break ending the field text at `start`
+fn field_end(buf: &[u8], start: usize, delimiter: u8) -> usize {
+    memchr2(delimiter, b'\n', &buf[start..]).map_or(buf.len(), |offset| start + offset)
+}
+
+/// `buf[start..end]` without the `\r` of a CRLF line ending
+fn strip_cr(buf: &[u8], start: usize, end: usize) -> &[u8] {
+    let field = &buf[start..end];
+    match field.split_last() {
+        Some((b'\r', rest)) if buf.get(end).is_none_or(|&b| b == b'\n') => rest,
+        _ => field,
+    }
+}
+
+/// Record boundaries of a buffer that starts at a record
+#[derive(Debug, PartialEq)]
+pub(crate) struct RecordScan {
+    /// Record ends (just past a line break), the first at or after every
+    /// `step` bytes; usable as parallel segment boundaries
+    pub splits: Vec<usize>,
+    /// End of the last complete record. With `eof` the whole buffer is
+    /// complete; otherwise the rest may continue in the next read.
+    pub complete: usize,
+}
+
+/// Find record boundaries in `buf`, following the rules of [`parse_record`]
+pub(crate) fn scan_records(buf: &[u8], delimiter: u8, step: usize, eof: bool) -> RecordScan {
+    let step = step.max(1);
+    let mut splits = Vec::new();
+    let mut next_split = step;
+    let mut complete = 0;
+    let mut field_start = 0;
+    let mut pos = 0;
+
+    while let Some(offset) = memchr3(delimiter, b'"', b'\n', &buf[pos..]) {
+        let i = pos + offset;
+        match buf[i] {
+            b'"' if i == field_start => {
+                let (_, _, after) = quoted_field(buf, i + 1);
+                // A quote at the very end may be the first half of `""`
+                if after >= buf.len() && !eof {
+                    break;
+                }
+                pos = after;
+            }
+            b'\n' => {
+                complete = i + 1;
+                field_start = i + 1;
+                if complete >= next_split && complete < buf.len() {
+                    splits.push(complete);
+                    next_split = complete + step;
+                }
+                pos = i + 1;
+            }
+            b'"' => pos = i + 1,
+            _ => {
+                field_start = i + 1;
+                pos = i + 1;
+            }
+        }
+        if pos >= buf.len() {
+            break;
+        }
+    }
+
+    RecordScan {
+        splits,
+        complete: if eof { buf.len() } else { complete },
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn records(csv: &str, delimiter: u8) -> Vec<Vec<String>> {
+        let mut pos = 0;
+        let mut fields = Vec::new();
+        let mut records = Vec::new();
+        while parse_record(csv.as_bytes(), &mut pos, delimiter, &mut fields) {
+            records.push(fields.iter().map(|f| f.to_string()).collect());
+        }
+        records
+    }
+
+    #[test]
+    fn test_parse_record_quoting() {
+        let csv = "a,\"b,c\",\"say \"\"hi\"\"\"\r\n\"multi\nline\",,x\"y\n\"tail\"junk,last";
+        assert_eq!(
+            records(csv, b','),
+            vec![
+                vec!["a", "b,c", "say \"hi\""],
+                vec!["multi\nline", "", "x\"y"],
+                vec!["tailjunk", "last"],
+            ]
+        );
+        assert_eq!(records("a\tb\t\n", b'\t'), vec![vec!["a", "b", ""]]);
+    }
+
+    #[test]
+    fn test_parse_record_borrows_plain_fields() {
+        let mut pos = 0;
+        let mut fields = Vec::new();
+        parse_record(
+            b"plain,\"quoted\",\"esc\"\"aped\"",
+            &mut pos,
+            b',',
+            &mut fields,
+        );
+        assert!(matches!(fields[0], Cow::Borrowed("plain")));
+        assert!(matches!(fields[1], Cow::Borrowed("quoted")));
+        assert!(matches!(fields[2], Cow::Owned(_)));
+    }
+
+    #[test]
+    fn test_scan_records_segments_parse_identically() {
+        let csv = "h1,h2\n1,\"a\nb\"\n2,\"c,\"\"d\"\"\n\"\n3,x\"y\n4,\"\"\n5,end";
+        let expected = records(csv, b',');
+
+        for step in 1..csv.len() {
+            let scan = scan_records(csv.as_bytes(), b',', step, true);
+            assert_eq!(scan.complete, csv.len());
+
+            let mut bounds = vec![0];
+            bounds.extend(&scan.splits);
+            bounds.push(csv.len());
+            let segmented: Vec<Vec<String>> = bounds
+                .windows(2)
+                .flat_map(|w| records(&csv[w[0]..w[1]], b','))
+                .collect();
+            assert_eq!(segmented, expected, "step {step}");
+        }
+    }
+
+    #[test]
+    fn test_scan_records_incomplete_tail() {
+        let scan = scan_records(b"a,b\nc,\"open\nstill", b',', 1, false);
+        assert_eq!(scan.complete, 4);
+        // The closing quote could be the start of an escaped quote
+        assert_eq!(scan_records(b"a\n\"b\"", b',', 1, false).complete, 2);
+        assert_eq!(scan_records(b"a\n\"b\"", b',', 1, true).complete, 5);
+    }
+}
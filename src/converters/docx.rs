@@ -4,17 +4,20 @@
 
 #![allow(clippy::unused_self, clippy::uninlined_format_args)]
 
+use std::ops::Deref;
 use std::path::{Path, PathBuf};
 use std::time::Instant;
 
 use async_trait::async_trait;
 
-use super::traits::{ConverterMetadata, DocumentConverter};
+use super::ooxml_reader::{self, ZipSource};
+use super::traits::{ConverterMetadata, DocumentConverter, convert_bytes_via_file};
 use crate::Result;
 use crate::types::{
     ConversionOptions, ConversionOutput, ConversionResult, ConversionStatistics, DocumentMetadata,
     FileFormat, OutputFormat, OutputMetadata,
 };
+use crate::utils::whitespace;
 
 /// DOCX to Markdown converter
 #[derive(Debug)]
@@ -27,201 +30,62 @@ impl DocxConverter {
     }
 
     /// Convert DOCX to images: DOCX → PDF → Images pipeline
-    /// Requires: libreoffice (for DOCX→PDF) and poppler-utils (for PDF→Images)
+    ///
+    /// The PDF comes from a resident LibreOffice instance; its pages are
+    /// rendered in-process with pdfium.
     #[cfg(feature = "pdf-to-image")]
     async fn convert_to_images(
         &self,
         path: &Path,
         format: crate::types::ImageFormat,
-        _quality: u8,
+        quality: u8,
         dpi: u32,
         _options: &ConversionOptions,
     ) -> Result<Vec<ConversionOutput>> {
-        use std::process::Command;
-
-        use tokio::fs;
+        use super::pdf::PdfConverter;
 
         eprintln!("🖼️  Converting DOCX to images (DOCX → PDF → Images)...");
 
-        // Step 1: DOCX → PDF using LibreOffice headless
-        let temp_dir =
-            std::env::temp_dir().join(format!("transmutation_docx_{}", std::process::id()));
-        fs::create_dir_all(&temp_dir).await?;
-
-        eprintln!("   [1/2] DOCX → PDF (LibreOffice --headless)...");
-
-        // Detect OS and use appropriate LibreOffice command
-        let (libreoffice_cmd, install_msg) = if cfg!(target_os = "windows") {
-            // Windows: soffice.exe in Program Files
-            (
-                "soffice.exe",
-                "Install LibreOffice from https://www.libreoffice.org/download/",
-            )
-        } else if cfg!(target_os = "macos") {
-            // macOS: /Applications/LibreOffice.app/Contents/MacOS/soffice
-            (
-                "/Applications/LibreOffice.app/Contents/MacOS/soffice",
-                "Install: brew install libreoffice",
-            )
-        } else {
-            // Linux
-            ("libreoffice", "Install: sudo apt install libreoffice")
-        };
-
-        let output = Command::new(libreoffice_cmd)
-            .arg("--headless")
-            .arg("--convert-to")
-            .arg("pdf")
-            .arg("--outdir")
-            .arg(&temp_dir)
-            .arg(path)
-            .output()
-            .map_err(|e| {
-                crate::TransmutationError::engine_error(
-                    "libreoffice",
-                    format!("Failed to run LibreOffice: {}.\n{}", e, install_msg),
-                )
-            })?;
-
-        if !output.status.success() {
-            let stderr = String::from_utf8_lossy(&output.stderr);
-            let _ = fs::remove_dir_all(&temp_dir).await;
-            return Err(crate::TransmutationError::engine_error(
-                "libreoffice",
-                format!("LibreOffice failed: {}", stderr),
-            ));
-        }
-
-        // Find generated PDF (LibreOffice uses input filename)
-        let filename = path
-            .file_stem()
-            .and_then(|s| s.to_str())
-            .unwrap_or("document");
-        let pdf_path = temp_dir.join(format!("{}.pdf", filename));
-
-        if !pdf_path.exists() {
-            let _ = fs::remove_dir_all(&temp_dir).await;
-            return Err(crate::TransmutationError::engine_error(
-                "libreoffice",
-                "PDF not generated by LibreOffice".to_string(),
-            ));
-        }
-
-        let pdf_size = pdf_path.metadata()?.len();
-        eprintln!("      ✓ PDF: {} KB", pdf_size / 1024);
-
-        // Step 2: PDF → Images using pdftoppm
-        eprintln!("   [2/2] PDF → Images (pdftoppm @ {} DPI)...", dpi);
-
-        let format_flag = match format {
-            crate::types::ImageFormat::Png => "png",
-            crate::types::ImageFormat::Jpeg => "jpeg",
-            crate::types::ImageFormat::Webp => "png",
-        };
-
-        // Cross-platform pdftoppm detection
-        let (pdftoppm_cmd, pdftoppm_install) = if cfg!(target_os = "windows") {
-            ("pdftoppm.exe", "Install poppler: choco install poppler")
-        } else if cfg!(target_os = "macos") {
-            ("pdftoppm", "Install: brew install poppler")
-        } else {
-            ("pdftoppm", "Install: sudo apt install poppler-utils")
-        };
-
-        let output = Command::new(pdftoppm_cmd)
-            .arg(format!("-{}", format_flag))
-            .arg("-r")
-            .arg(dpi.to_string())
-            .arg(&pdf_path)
-            .arg(temp_dir.join("page"))
-            .output()
-            .map_err(|e| {
-                let _ = std::fs::remove_dir_all(&temp_dir);
-                crate::TransmutationError::engine_error(
-                    "pdftoppm",
-                    format!("Failed: {}.\n{}", e, pdftoppm_install),
-                )
-            })?;
-
-        if !output.status.success() {
-            let stderr = String::from_utf8_lossy(&output.stderr);
-            let _ = fs::remove_dir_all(&temp_dir).await;
-            return Err(crate::TransmutationError::engine_error(
-                "pdftoppm",
-                format!("pdftoppm failed: {}", stderr),
-            ));
-        }
-
-        // Read generated images
-        let mut outputs = Vec::new();
-        let mut entries = fs::read_dir(&temp_dir).await?;
-        let mut image_files = Vec::new();
+        eprintln!("   [1/2] DOCX → PDF (LibreOffice)...");
+        let pdf = super::office_pool::convert_to_pdf(path).await?;
+        eprintln!("      ✓ PDF: {} KB", pdf.len() / 1024);
 
-        while let Some(entry) = entries.next_entry().await? {
-            let entry_path = entry.path();
-            if entry_path.extension().and_then(|e| e.to_str()) == Some(format_flag) {
-                image_files.push(entry_path);
-            }
-        }
-
-        image_files.sort();
-
-        eprintln!("      ✓ Rendered {} pages", image_files.len());
-
-        for (idx, image_path) in image_files.iter().enumerate() {
-            let image_data = fs::read(&image_path).await?;
-            let size_bytes = image_data.len() as u64;
-
-            outputs.push(ConversionOutput {
-                page_number: idx + 1,
-                data: image_data,
-                metadata: OutputMetadata {
-                    size_bytes,
-                    chunk_count: 1,
-                    token_count: None,
-                },
-            });
-        }
-
-        // Cleanup
-        let _ = fs::remove_dir_all(&temp_dir).await;
+        eprintln!("   [2/2] PDF → Images (pdfium @ {} DPI)...", dpi);
+        let outputs = tokio::task::spawn_blocking(move || {
+            PdfConverter::render_pdf_to_images(&pdf, format, quality, dpi)
+        })
+        .await
+        .map_err(|e| {
+            crate::TransmutationError::engine_error("pdfium", format!("Render task failed: {}", e))
+        })??;
 
         eprintln!("✅ DOCX → {} images complete!", outputs.len());
         Ok(outputs)
     }
 
-    /// Convert DOCX to Markdown using simple text extraction
-    /// Uses docx-rs for parsing Word documents
+    /// Convert DOCX to Markdown
+    ///
+    /// Streams `word/document.xml` (plus styles and relationships) through a
+    /// pull parser; the rest of the package, such as media, is never read.
+    /// `source` is the file's path or its bytes. Returns the outputs and the
+    /// number of tables extracted.
     #[cfg(feature = "office")]
-    async fn convert_to_markdown(
+    async fn convert_to_markdown<S>(
         &self,
-        path: &Path,
+        source: S,
         options: &ConversionOptions,
-    ) -> Result<Vec<ConversionOutput>> {
-        eprintln!("📄 Reading DOCX file with docx-rs...");
+    ) -> Result<(Vec<ConversionOutput>, usize)>
+    where
+        S: Deref<Target: ZipSource> + Send + 'static,
+    {
+        eprintln!("📄 Reading DOCX file (streaming XML)...");
 
-        // Read DOCX file
-        let file_data = tokio::fs::read(path).await?;
+        let document = tokio::task::spawn_blocking(move || ooxml_reader::read_docx(&*source))
+            .await
+            .map_err(|e| crate::TransmutationError::conversion_failed(e.to_string()))??;
+        let all_paragraphs = document.blocks;
 
-        // Parse DOCX using docx-rs
-        let docx = docx_rs::read_docx(&file_data).map_err(|e| {
-            crate::TransmutationError::engine_error(
-                "docx-rs",
-                format!("Failed to parse DOCX: {:?}", e),
-            )
-        })?;
-
-        eprintln!("✓ DOCX parsed successfully");
-
-        // Extract all paragraphs first
-        let mut all_paragraphs = Vec::new();
-
-        for child in &docx.document.children {
-            let text = self.extract_text_from_child(child);
-            if !text.is_empty() {
-                all_paragraphs.push(text);
-            }
-        }
+        eprintln!("✓ DOCX parsed: {} blocks", all_paragraphs.len());
 
         // If split_pages enabled, divide into chunks (10-15 paragraphs per "page")
         if options.split_pages && all_paragraphs.len() > 15 {
@@ -233,11 +97,8 @@ impl DocxConverter {
                 let mut markdown = chunk.join("\n\n");
 
                 // Clean up excessive newlines
-                while markdown.contains("\n\n\n") {
-                    markdown = markdown.replace("\n\n\n", "\n\n");
-                }
-
-                let markdown = markdown.trim().to_string();
+                whitespace::collapse_blank_lines(&mut markdown);
+                whitespace::trim_in_place(&mut markdown);
                 let token_count = markdown.len() / 4;
                 let data = markdown.into_bytes();
                 let size_bytes = data.len() as u64;
@@ -254,19 +115,15 @@ impl DocxConverter {
             }
 
             eprintln!("✓ Split into {} logical pages", outputs.len());
-            return Ok(outputs);
+            return Ok((outputs, document.tables));
         }
 
         // Single output (default)
-        let markdown = all_paragraphs.join("\n\n");
+        let mut markdown = all_paragraphs.join("\n\n");
 
         // Clean up excessive newlines
-        let mut markdown = markdown;
-        while markdown.contains("\n\n\n") {
-            markdown = markdown.replace("\n\n\n", "\n\n");
-        }
-
-        let markdown = markdown.trim().to_string();
+        whitespace::collapse_blank_lines(&mut markdown);
+        whitespace::trim_in_place(&mut markdown);
 
         eprintln!("✓ Converted to Markdown: {} chars", markdown.len());
 
@@ -274,55 +131,63 @@ impl DocxConverter {
         let data = markdown.into_bytes();
         let size_bytes = data.len() as u64;
 
-        Ok(vec![ConversionOutput {
-            page_number: 0,
-            data,
-            metadata: OutputMetadata {
-                size_bytes,
-                chunk_count: 1,
-                token_count: Some(token_count),
-            },
-        }])
+        Ok((
+            vec![ConversionOutput {
+                page_number: 0,
+                data,
+                metadata: OutputMetadata {
+                    size_bytes,
+                    chunk_count: 1,
+                    token_count: Some(token_count),
+                },
+            }],
+            document.tables,
+        ))
     }
 
-    /// Extract text from document child (simplified approach)
-    #[cfg(feature = "office")]
-    fn extract_text_from_child(&self, child: &docx_rs::DocumentChild) -> String {
-        use docx_rs::DocumentChild;
-
-        match child {
-            DocumentChild::Paragraph(para) => self.extract_paragraph_text(para),
-            DocumentChild::Table(table) => self.extract_table_text(table),
-            _ => String::new(),
-        }
-    }
+    /// Result for converted `content`, with its metadata and statistics
+    fn conversion_result(
+        input_path: PathBuf,
+        output_format: OutputFormat,
+        content: Vec<ConversionOutput>,
+        tables_extracted: usize,
+        input_size: u64,
+        start_time: Instant,
+    ) -> ConversionResult {
+        // Calculate output size
+        let output_size: u64 = content.iter().map(|c| c.metadata.size_bytes).sum();
 
-    /// Extract text from paragraph
-    #[cfg(feature = "office")]
-    fn extract_paragraph_text(&self, para: &docx_rs::Paragraph) -> String {
-        use docx_rs::ParagraphChild;
+        // Build metadata
+        let metadata = DocumentMetadata {
+            title: None, // TODO: Extract from DOCX properties
+            author: None,
+            created: None,
+            modified: None,
+            page_count: 1, // DOCX doesn't have strict pages
+            language: None,
+            custom: std::collections::HashMap::new(),
+        };
 
-        let mut text = String::new();
+        // Build statistics
+        let duration = start_time.elapsed();
+        let statistics = ConversionStatistics {
+            input_size_bytes: input_size,
+            output_size_bytes: output_size,
+            duration,
+            pages_processed: 1,
+            tables_extracted,
+            images_extracted: 0,
+            cache_hit: false,
+        };
 
-        for child in &para.children {
-            if let ParagraphChild::Run(run) = child {
-                for run_child in &run.children {
-                    if let docx_rs::RunChild::Text(t) = run_child {
-                        text.push_str(&t.text);
-                    }
-                }
-            }
+        ConversionResult {
+            input_path,
+            input_format: FileFormat::Docx,
+            output_format,
+            content,
+            metadata,
+            statistics,
         }
-
-        text.trim().to_string()
-    }
-
-    /// Extract text from table (simplified - just get text, skip table structure for now)
-    #[cfg(feature = "office")]
-    fn extract_table_text(&self, _table: &docx_rs::Table) -> String {
-        // TODO: Implement proper table extraction
-        // For now, just indicate a table was present
-        String::from("[Table content]")
     }
 }
 
@@ -357,11 +222,12 @@ impl DocumentConverter for DocxConverter {
         let input_size = tokio::fs::metadata(input).await?.len();
 
         // Convert based on output format
-        let content = match output_format {
+        let (content, tables_extracted) = match output_format {
             OutputFormat::Markdown { .. } => {
                 #[cfg(feature = "office")]
                 {
-                    self.convert_to_markdown(input, &options).await?
+                    self.convert_to_markdown(input.to_path_buf(), &options)
+                        .await?
                 }
                 #[cfg(not(feature = "office"))]
                 {
@@ -377,13 +243,15 @@ impl DocumentConverter for DocxConverter {
             } => {
                 #[cfg(feature = "pdf-to-image")]
                 {
-                    self.convert_to_images(input, _format, _quality, _dpi, &options)
-                        .await?
+                    let images = self
+                        .convert_to_images(input, _format, _quality, _dpi, &options)
+                        .await?;
+                    (images, 0)
                 }
                 #[cfg(not(feature = "pdf-to-image"))]
                 {
                     return Err(crate::TransmutationError::InvalidOptions(
-                        "DOCX to image requires pdf-to-image feature (uses LibreOffice + pdftoppm)"
+                        "DOCX to image requires pdf-to-image feature (uses LibreOffice + pdfium)"
                             .to_string(),
                     ));
                 }
@@ -396,48 +264,50 @@ impl DocumentConverter for DocxConverter {
             }
         };
 
-        // Calculate output size
-        let output_size: u64 = content.iter().map(|c| c.metadata.size_bytes).sum();
+        Ok(Self::conversion_result(
+            PathBuf::from(input),
+            output_format,
+            content,
+            tables_extracted,
+            input_size,
+            start_time,
+        ))
+    }
 
-        // Build metadata
-        let metadata = DocumentMetadata {
-            title: None, // TODO: Extract from DOCX properties
-            author: None,
-            created: None,
-            modified: None,
-            page_count: 1, // DOCX doesn't have strict pages
-            language: None,
-            custom: std::collections::HashMap::new(),
-        };
+    async fn convert_bytes(
+        &self,
+        name: &str,
+        data: Vec<u8>,
+        input_format: FileFormat,
+        output_format: OutputFormat,
+        options: ConversionOptions,
+    ) -> Result<ConversionResult> {
+        if !matches!(output_format, OutputFormat::Markdown { .. }) {
+            // Images come from LibreOffice, which reads files
+            return convert_bytes_via_file(self, name, data, input_format, output_format, options)
+                .await;
+        }
 
-        // Build statistics
-        let duration = start_time.elapsed();
-        let statistics = ConversionStatistics {
-            input_size_bytes: input_size,
-            output_size_bytes: output_size,
-            duration,
-            pages_processed: 1,
-            tables_extracted: 0, // TODO: Count tables
-            images_extracted: 0,
-            cache_hit: false,
-        };
+        let start_time = Instant::now();
+        let input_size = data.len() as u64;
+        let (content, tables_extracted) = self.convert_to_markdown(data, &options).await?;
 
-        Ok(ConversionResult {
-            input_path: PathBuf::from(input),
-            input_format: FileFormat::Docx,
+        Ok(Self::conversion_result(
+            PathBuf::from(name),
             output_format,
             content,
-            metadata,
-            statistics,
-        })
+            tables_extracted,
+            input_size,
+            start_time,
+        ))
     }
 
     fn metadata(&self) -> ConverterMetadata {
         ConverterMetadata {
             name: "DOCX Converter".to_string(),
             version: env!("CARGO_PKG_VERSION").to_string(),
-            description: "Pure Rust DOCX to Markdown converter".to_string(),
-            external_deps: vec!["docx-rs".to_string()],
+            description: "Pure Rust DOCX to Markdown converter (streaming XML)".to_string(),
+            external_deps: vec!["quick-xml".to_string()],
         }
     }
 }
@@ -457,6 +327,6 @@ mod tests {
         let converter = DocxConverter::new();
         let meta = converter.metadata();
         assert_eq!(meta.name, "DOCX Converter");
-        assert!(meta.external_deps.contains(&"docx-rs".to_string()));
+        assert!(meta.external_deps.contains(&"quick-xml".to_string()));
     }
 }
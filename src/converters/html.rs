@@ -1,25 +1,35 @@
 //! HTML converter implementation
 //!
-//! Converts HTML to Markdown using semantic HTML parsing.
-//! Preserves structure, links, images, and formatting.
+//! Converts HTML to Markdown with a streaming tokenizer: the document is
+//! read in chunks and Markdown is emitted as elements open and close, with
+//! only the stack of open elements kept. Preserves structure, links,
+//! images, and formatting; `<script>`, `<style>`, `<nav>` and similar
+//! subtrees are skipped without being converted.
 
-#![allow(
-    clippy::unused_self,
-    clippy::uninlined_format_args,
-    clippy::unnecessary_wraps,
-    clippy::single_char_add_str
-)]
+#![allow(clippy::uninlined_format_args)]
 
-use std::path::Path;
+use std::fs::File;
+use std::io::{self, Read, Write};
+use std::path::{Path, PathBuf};
 
 use async_trait::async_trait;
 use tokio::fs;
 
+use super::html_tokenizer::{Token, attr, decode_entities, next_token, raw_text};
 use super::traits::{ConverterMetadata, DocumentConverter};
-use crate::Result;
 use crate::types::{
     ConversionOptions, ConversionOutput, ConversionResult, FileFormat, OutputFormat, OutputMetadata,
 };
+use crate::{Result, TransmutationError};
+
+/// Bytes read from the input at a time
+const READ_CHUNK: usize = 64 * 1024;
+
+/// Open elements tracked beyond this depth are treated as plain text
+const MAX_DEPTH: usize = 256;
+
+/// Longest `<title>` kept
+const MAX_TITLE_LEN: usize = 4096;
 
 /// HTML to Markdown converter
 #[derive(Debug)]
@@ -33,142 +43,552 @@ impl HtmlConverter {
 
     /// Convert HTML to Markdown
     fn html_to_markdown(&self, html: &str) -> Result<String> {
-        use scraper::{Html, Selector};
+        let mut markdown = Vec::new();
+        write_markdown(html.as_bytes(), &mut markdown)?;
+        Ok(String::from_utf8_lossy(&markdown).into_owned())
+    }
+}
 
-        let document = Html::parse_document(html);
-        let mut markdown = String::new();
+/// Element kinds the Markdown writer distinguishes
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+enum Tag {
+    Heading(u8),
+    Paragraph,
+    Block,
+    Link,
+    Strong,
+    Emphasis,
+    Code,
+    Pre,
+    List {
+        ordered: bool,
+    },
+    Item,
+    Table,
+    Row,
+    Cell,
+    Break,
+    Rule,
+    Image,
+    Title,
+    /// Raw text element whose content is dropped
+    Raw(&'static [u8]),
+    /// Element whose whole subtree is dropped
+    Skip(&'static [u8]),
+    Other,
+}
 
-        // Extract title
-        if let Ok(selector) = Selector::parse("title") {
-            if let Some(title) = document.select(&selector).next() {
-                markdown.push_str(&format!("# {}\n\n", title.inner_html().trim()));
-            }
+impl Tag {
+    fn of(name: &[u8]) -> Self {
+        let mut lower = [0u8; 12];
+        let Some(lower) = lower.get_mut(..name.len()) else {
+            return Tag::Other;
+        };
+        lower.copy_from_slice(name);
+        lower.make_ascii_lowercase();
+
+        match &*lower {
+            [b'h', level @ b'1'..=b'6'] => Tag::Heading(level - b'0'),
+            b"p" => Tag::Paragraph,
+            b"div" | b"section" | b"article" | b"main" | b"header" | b"footer" | b"aside"
+            | b"blockquote" | b"figure" | b"figcaption" | b"address" | b"details" | b"summary"
+            | b"dl" | b"dt" | b"dd" | b"body" | b"form" | b"fieldset" | b"caption" => Tag::Block,
+            b"a" => Tag::Link,
+            b"strong" | b"b" => Tag::Strong,
+            b"em" | b"i" => Tag::Emphasis,
+            b"code" | b"kbd" | b"samp" | b"tt" => Tag::Code,
+            b"pre" => Tag::Pre,
+            b"ul" => Tag::List { ordered: false },
+            b"ol" => Tag::List { ordered: true },
+            b"li" => Tag::Item,
+            b"table" => Tag::Table,
+            b"tr" => Tag::Row,
+            b"td" | b"th" => Tag::Cell,
+            b"br" => Tag::Break,
+            b"hr" => Tag::Rule,
+            b"img" => Tag::Image,
+            b"title" => Tag::Title,
+            b"script" => Tag::Raw(b"script"),
+            b"style" => Tag::Raw(b"style"),
+            b"textarea" => Tag::Raw(b"textarea"),
+            b"iframe" => Tag::Raw(b"iframe"),
+            b"xmp" => Tag::Raw(b"xmp"),
+            b"noembed" => Tag::Raw(b"noembed"),
+            b"noframes" => Tag::Raw(b"noframes"),
+            b"nav" => Tag::Skip(b"nav"),
+            b"noscript" => Tag::Skip(b"noscript"),
+            b"template" => Tag::Skip(b"template"),
+            b"svg" => Tag::Skip(b"svg"),
+            b"math" => Tag::Skip(b"math"),
+            b"select" => Tag::Skip(b"select"),
+            _ => Tag::Other,
         }
+    }
+
+    /// Whether the element is tracked on the open element stack
+    fn has_frame(self) -> bool {
+        !matches!(
+            self,
+            Tag::Break
+                | Tag::Rule
+                | Tag::Image
+                | Tag::Title
+                | Tag::Raw(_)
+                | Tag::Skip(_)
+                | Tag::Other
+        )
+    }
+}
+
+/// An open element
+#[derive(Debug)]
+struct Open {
+    tag: Tag,
+    /// Link target
+    href: Option<String>,
+    /// Items of a list, cells of a row, rows of a table
+    count: usize,
+}
 
-        // Extract main content (try multiple selectors)
-        let content_selectors = vec!["main", "article", "body"];
-        let mut content_found = false;
+/// Stream HTML from `reader` into `out` as Markdown
+fn write_markdown<R: Read, W: Write>(reader: R, out: &mut W) -> io::Result<()> {
+    write_markdown_chunked(reader, out, READ_CHUNK)
+}
 
-        for sel_str in content_selectors {
-            if let Ok(selector) = Selector::parse(sel_str) {
-                if let Some(main_content) = document.select(&selector).next() {
-                    markdown.push_str(&self.process_element(&main_content));
-                    content_found = true;
+/// [`write_markdown`], reading `chunk` bytes at a time
+fn write_markdown_chunked<R: Read, W: Write>(
+    mut reader: R,
+    out: &mut W,
+    chunk: usize,
+) -> io::Result<()> {
+    let mut sink = MarkdownSink::new(out);
+    let mut buf = Vec::with_capacity(chunk);
+
+    loop {
+        let read = (&mut reader).take(chunk as u64).read_to_end(&mut buf)?;
+        let eof = read < chunk;
+
+        let mut pos = 0;
+        loop {
+            if let Some(name) = sink.raw {
+                let raw = raw_text(&buf[pos..], name, eof);
+                sink.raw_text(&buf[pos..pos + raw.text]);
+                pos += raw.consumed;
+                if !raw.closed {
                     break;
                 }
+                sink.end_raw()?;
+                continue;
+            }
+            match next_token(&buf[pos..], eof) {
+                Some((token, len)) => {
+                    sink.token(token)?;
+                    pos += len;
+                }
+                None => break,
             }
         }
+        buf.drain(..pos);
 
-        if !content_found {
-            // Fallback: extract all text
-            markdown.push_str(&document.root_element().text().collect::<Vec<_>>().join(" "));
+        if eof {
+            return sink.finish();
         }
+    }
+}
 
-        Ok(markdown)
+/// Markdown writer driven by tokens
+///
+/// Inline content of the current block is collected in `line` and written
+/// once the block ends; blank lines between blocks are owed (`breaks`)
+/// until the next block has content, so empty elements leave no trace.
+struct MarkdownSink<'w, W: Write> {
+    out: &'w mut W,
+    line: Vec<u8>,
+    /// Whitespace seen since the last word
+    space: bool,
+    /// Trailing bytes of `line` that are opening markers with no content yet
+    opened: usize,
+    /// Line breaks owed before the next block
+    breaks: usize,
+    written: bool,
+    stack: Vec<Open>,
+    lists: usize,
+    cells: usize,
+    pre: usize,
+    /// A `<pre>` was opened and nothing has followed it yet
+    pre_opened: bool,
+    /// Skipped subtree and its nesting depth
+    skip: Option<(&'static [u8], usize)>,
+    /// Raw text element being read
+    raw: Option<&'static [u8]>,
+    title: Option<Vec<u8>>,
+}
+
+impl<'w, W: Write> MarkdownSink<'w, W> {
+    fn new(out: &'w mut W) -> Self {
+        Self {
+            out,
+            line: Vec::new(),
+            space: false,
+            opened: 0,
+            breaks: 0,
+            written: false,
+            stack: Vec::new(),
+            lists: 0,
+            cells: 0,
+            pre: 0,
+            pre_opened: false,
+            skip: None,
+            raw: None,
+            title: None,
+        }
     }
 
-    /// Process HTML element recursively
-    fn process_element(&self, element: &scraper::ElementRef) -> String {
-        use scraper::Node;
+    fn token(&mut self, token: Token<'_>) -> io::Result<()> {
+        match token {
+            Token::Text(text) if self.skip.is_none() => {
+                self.text(text);
+                Ok(())
+            }
+            Token::Start {
+                name,
+                attrs,
+                self_closing,
+            } => self.start(Tag::of(name), attrs, self_closing),
+            Token::End { name } => self.end(Tag::of(name)),
+            _ => Ok(()),
+        }
+    }
 
-        let mut result = String::new();
+    fn start(&mut self, tag: Tag, attrs: &[u8], self_closing: bool) -> io::Result<()> {
+        match tag {
+            Tag::Raw(name) if !self_closing => self.raw = Some(name),
+            Tag::Title if !self_closing => {
+                self.raw = Some(b"title");
+                if self.skip.is_none() {
+                    self.title = Some(Vec::new());
+                }
+            }
+            _ => {}
+        }
+        if let Some((name, depth)) = &mut self.skip {
+            if tag == Tag::Skip(name) && !self_closing {
+                *depth += 1;
+            }
+            return Ok(());
+        }
+        self.pre_opened = false;
+        if tag.has_frame() && (self_closing || self.stack.len() >= MAX_DEPTH) {
+            return Ok(());
+        }
 
-        for child in element.children() {
-            match child.value() {
-                Node::Text(text) => {
-                    let text_content = text.trim();
-                    if !text_content.is_empty() {
-                        result.push_str(text_content);
-                        result.push(' ');
-                    }
+        let mut href = None;
+        match tag {
+            Tag::Skip(name) if !self_closing => self.skip = Some((name, 1)),
+            Tag::Heading(level) => {
+                self.block(2)?;
+                self.open(&b"###### "[6 - usize::from(level)..]);
+            }
+            Tag::Paragraph | Tag::Block | Tag::Table => self.block(2)?,
+            Tag::Link => {
+                href = attr(attrs, b"href").map(|href| href.into_owned());
+                if href.is_some() {
+                    self.open(b"[");
                 }
-                Node::Element(elem) => {
-                    let tag_name = elem.name();
-
-                    // Create ElementRef for child
-                    if let Some(child_elem) = scraper::ElementRef::wrap(child) {
-                        match tag_name {
-                            "h1" => result
-                                .push_str(&format!("# {}\n\n", child_elem.inner_html().trim())),
-                            "h2" => result
-                                .push_str(&format!("## {}\n\n", child_elem.inner_html().trim())),
-                            "h3" => result
-                                .push_str(&format!("### {}\n\n", child_elem.inner_html().trim())),
-                            "h4" => result
-                                .push_str(&format!("#### {}\n\n", child_elem.inner_html().trim())),
-                            "h5" => result
-                                .push_str(&format!("##### {}\n\n", child_elem.inner_html().trim())),
-                            "h6" => result.push_str(&format!(
-                                "###### {}\n\n",
-                                child_elem.inner_html().trim()
-                            )),
-                            "p" => result.push_str(&format!(
-                                "{}\n\n",
-                                child_elem.text().collect::<String>().trim()
-                            )),
-                            "a" => {
-                                if let Some(href) = elem.attr("href") {
-                                    result.push_str(&format!(
-                                        "[{}]({})",
-                                        child_elem.text().collect::<String>(),
-                                        href
-                                    ));
-                                } else {
-                                    result.push_str(&child_elem.text().collect::<String>());
-                                }
-                            }
-                            "strong" | "b" => result.push_str(&format!(
-                                "**{}**",
-                                child_elem.text().collect::<String>()
-                            )),
-                            "em" | "i" => result
-                                .push_str(&format!("*{}*", child_elem.text().collect::<String>())),
-                            "code" => result
-                                .push_str(&format!("`{}`", child_elem.text().collect::<String>())),
-                            "pre" => result.push_str(&format!(
-                                "\n```\n{}\n```\n\n",
-                                child_elem.text().collect::<String>()
-                            )),
-                            "ul" | "ol" => {
-                                result.push_str(&self.process_list(&child_elem, tag_name == "ol"));
-                                result.push_str("\n");
-                            }
-                            "li" => {} // Handled by process_list
-                            "br" => result.push_str("\n"),
-                            "hr" => result.push_str("\n---\n\n"),
-                            _ => result.push_str(&self.process_element(&child_elem)),
-                        }
-                    }
+            }
+            Tag::Strong => self.open(b"**"),
+            Tag::Emphasis => self.open(b"*"),
+            Tag::Code if self.pre == 0 => self.open(b"`"),
+            Tag::Pre => {
+                self.block(2)?;
+                self.line.extend_from_slice(b"```\n");
+                self.pre += 1;
+                self.pre_opened = true;
+            }
+            Tag::List { .. } => {
+                self.block(if self.lists == 0 { 2 } else { 1 })?;
+                self.lists += 1;
+            }
+            Tag::Item => {
+                self.close_open(Tag::Item)?;
+                // Drop the marker of an item left empty
+                if self.opened > 0 && self.opened == self.line.len() {
+                    self.line.clear();
+                    self.opened = 0;
+                }
+                self.block(1)?;
+                let number = self
+                    .stack
+                    .iter_mut()
+                    .rev()
+                    .find(|open| matches!(open.tag, Tag::List { .. }))
+                    .and_then(|list| {
+                        list.count += 1;
+                        (list.tag == Tag::List { ordered: true }).then_some(list.count)
+                    });
+                let mut marker = "  ".repeat(self.lists.saturating_sub(1));
+                match number {
+                    Some(number) => marker.push_str(&format!("{}. ", number)),
+                    None => marker.push_str("- "),
+                }
+                self.open(marker.as_bytes());
+            }
+            Tag::Row => {
+                self.close_open(Tag::Row)?;
+                self.block(1)?;
+                self.line.push(b'|');
+            }
+            Tag::Cell => {
+                self.close_open(Tag::Cell)?;
+                self.cells += 1;
+                self.line.push(b' ');
+                self.space = false;
+                self.opened = 0;
+            }
+            Tag::Break if self.pre > 0 => self.line.push(b'\n'),
+            Tag::Break => self.block(1)?,
+            Tag::Rule => {
+                self.block(2)?;
+                self.line.extend_from_slice(b"---");
+                self.block(2)?;
+            }
+            Tag::Image => {
+                if let Some(src) = attr(attrs, b"src") {
+                    let alt = attr(attrs, b"alt").unwrap_or_default();
+                    self.word(format!("![{}]({})", alt, src).as_bytes());
                 }
-                _ => {}
             }
+            _ => {}
         }
 
-        result
+        if tag.has_frame() {
+            self.stack.push(Open {
+                tag,
+                href,
+                count: 0,
+            });
+        }
+        Ok(())
     }
 
-    /// Process list elements
-    fn process_list(&self, element: &scraper::ElementRef, ordered: bool) -> String {
-        use scraper::Selector;
+    fn end(&mut self, tag: Tag) -> io::Result<()> {
+        if let Some((name, depth)) = &mut self.skip {
+            if tag == Tag::Skip(name) {
+                *depth -= 1;
+                if *depth == 0 {
+                    self.skip = None;
+                }
+            }
+            return Ok(());
+        }
+        match self.stack.iter().rposition(|open| open.tag == tag) {
+            Some(idx) => self.close_to(idx),
+            None => Ok(()),
+        }
+    }
 
-        let mut result = String::new();
+    /// Implicitly close an element of kind `tag` still open at the top
+    fn close_open(&mut self, tag: Tag) -> io::Result<()> {
+        let innermost = self
+            .stack
+            .iter()
+            .rposition(|open| open.tag == tag || matches!(open.tag, Tag::List { .. } | Tag::Table));
+        match innermost {
+            Some(idx) if self.stack[idx].tag == tag => self.close_to(idx),
+            _ => Ok(()),
+        }
+    }
 
-        if let Ok(li_selector) = Selector::parse("li") {
-            for (idx, li) in element.select(&li_selector).enumerate() {
-                let marker = if ordered {
-                    format!("{}. ", idx + 1)
+    /// Close the elements from `idx` up
+    fn close_to(&mut self, idx: usize) -> io::Result<()> {
+        while self.stack.len() > idx {
+            if let Some(open) = self.stack.pop() {
+                self.close(open)?;
+            }
+        }
+        Ok(())
+    }
+
+    fn close(&mut self, open: Open) -> io::Result<()> {
+        match open.tag {
+            Tag::Heading(level) => {
+                self.close_marker(usize::from(level) + 1, b"");
+                self.block(2)?;
+            }
+            Tag::Paragraph | Tag::Block | Tag::Table => self.block(2)?,
+            Tag::Link => {
+                if let Some(href) = open.href {
+                    self.close_marker(1, format!("]({})", href).as_bytes());
+                }
+            }
+            Tag::Strong => self.close_marker(2, b"**"),
+            Tag::Emphasis => self.close_marker(1, b"*"),
+            Tag::Code if self.pre == 0 => self.close_marker(1, b"`"),
+            Tag::Pre => {
+                self.pre -= 1;
+                if !self.line.ends_with(b"\n") {
+                    self.line.push(b'\n');
+                }
+                self.line.extend_from_slice(b"```");
+                self.block(2)?;
+            }
+            Tag::List { .. } => {
+                self.lists -= 1;
+                self.block(if self.lists == 0 { 2 } else { 1 })?;
+            }
+            Tag::Item => self.block(1)?,
+            Tag::Row => {
+                self.block(1)?;
+                let table = self.stack.iter_mut().rev().find(|o| o.tag == Tag::Table);
+                // The first row is the header
+                if let Some(table) = table.filter(|table| table.count == 0 && open.count > 0) {
+                    table.count = 1;
+                    self.line.push(b'|');
+                    for _ in 0..open.count {
+                        self.line.extend_from_slice(b"---|");
+                    }
+                    self.block(1)?;
+                }
+            }
+            Tag::Cell => {
+                self.cells -= 1;
+                if self.line.ends_with(b" ") {
+                    self.line.push(b'|');
                 } else {
-                    "- ".to_string()
-                };
-                result.push_str(&format!(
-                    "{}{}\n",
-                    marker,
-                    li.text().collect::<String>().trim()
-                ));
+                    self.line.extend_from_slice(b" |");
+                }
+                if let Some(row) = self.stack.last_mut().filter(|o| o.tag == Tag::Row) {
+                    row.count += 1;
+                }
+            }
+            _ => {}
+        }
+        Ok(())
+    }
+
+    fn text(&mut self, raw: &[u8]) {
+        let text = decode_entities(raw);
+        if self.pre > 0 {
+            // A line break right after `<pre>` is not content
+            let skip = usize::from(self.pre_opened && text.first() == Some(&b'\n'));
+            self.pre_opened = false;
+            self.line.extend_from_slice(&text[skip..]);
+            self.opened = 0;
+            return;
+        }
+        for (idx, word) in text.split(u8::is_ascii_whitespace).enumerate() {
+            if idx > 0 {
+                self.space = true;
+            }
+            if !word.is_empty() {
+                self.word(word);
+            }
+        }
+    }
+
+    fn word(&mut self, word: &[u8]) {
+        self.separate();
+        self.opened = 0;
+        self.line.extend_from_slice(word);
+    }
+
+    fn open(&mut self, marker: &[u8]) {
+        self.separate();
+        self.line.extend_from_slice(marker);
+        self.opened += marker.len();
+    }
+
+    /// Close a marker of `opener` bytes; an element left empty is removed
+    fn close_marker(&mut self, opener: usize, closer: &[u8]) {
+        if opener > 0 && self.opened >= opener {
+            self.line.truncate(self.line.len() - opener);
+            self.opened -= opener;
+        } else {
+            self.opened = 0;
+            self.line.extend_from_slice(closer);
+        }
+    }
+
+    /// Turn pending whitespace into a single space before new content
+    fn separate(&mut self) {
+        if self.space
+            && self.opened == 0
+            && self.line.last().is_some_and(|b| !b.is_ascii_whitespace())
+        {
+            self.line.push(b' ');
+        }
+        self.space = false;
+    }
+
+    /// End the current block and owe `breaks` line breaks before the next
+    fn block(&mut self, breaks: usize) -> io::Result<()> {
+        if self.pre > 0 {
+            if !self.line.ends_with(b"\n") {
+                self.line.push(b'\n');
+            }
+            return Ok(());
+        }
+        if self.cells > 0 {
+            self.space = true;
+            return Ok(());
+        }
+        // A list marker or heading prefix carries over into the block
+        if self.opened > 0 && self.opened == self.line.len() {
+            return Ok(());
+        }
+
+        let len = self
+            .line
+            .iter()
+            .rposition(|b| !b.is_ascii_whitespace())
+            .map_or(0, |last| last + 1);
+        if len > 0 {
+            if self.written {
+                self.out.write_all(&b"\n\n"[..self.breaks.clamp(1, 2)])?;
             }
+            self.out.write_all(&self.line[..len])?;
+            self.written = true;
+            self.breaks = 0;
         }
+        self.line.clear();
+        self.space = false;
+        self.opened = 0;
+        self.breaks = self.breaks.max(breaks);
+        Ok(())
+    }
 
-        result
+    fn raw_text(&mut self, text: &[u8]) {
+        if let Some(title) = &mut self.title {
+            let room = MAX_TITLE_LEN.saturating_sub(title.len());
+            title.extend_from_slice(&text[..text.len().min(room)]);
+        }
+    }
+
+    fn end_raw(&mut self) -> io::Result<()> {
+        self.raw = None;
+        if let Some(title) = self.title.take() {
+            let title = decode_entities(&title);
+            let words: Vec<&[u8]> = title
+                .split(u8::is_ascii_whitespace)
+                .filter(|word| !word.is_empty())
+                .collect();
+            if !words.is_empty() {
+                self.block(2)?;
+                self.line.extend_from_slice(b"# ");
+                self.line.extend_from_slice(&words.join(&b' '));
+                self.block(2)?;
+            }
+        }
+        Ok(())
+    }
+
+    fn finish(mut self) -> io::Result<()> {
+        self.close_to(0)?;
+        self.block(0)?;
+        if self.written {
+            self.out.write_all(b"\n")?;
+        }
+        Ok(())
     }
 }
 
@@ -178,6 +598,18 @@ impl Default for HtmlConverter {
     }
 }
 
+/// Convert the HTML file at `input` to Markdown off the async runtime
+async fn stream_markdown(input: &Path) -> Result<Vec<u8>> {
+    let path = input.to_path_buf();
+    tokio::task::spawn_blocking(move || -> Result<Vec<u8>> {
+        let mut markdown = Vec::new();
+        write_markdown(File::open(&path)?, &mut markdown)?;
+        Ok(markdown)
+    })
+    .await
+    .map_err(|e| TransmutationError::conversion_failed(e.to_string()))?
+}
+
 #[async_trait]
 impl DocumentConverter for HtmlConverter {
     fn supported_formats(&self) -> Vec<FileFormat> {
@@ -201,25 +633,22 @@ impl DocumentConverter for HtmlConverter {
         &self,
         input: &Path,
         output_format: OutputFormat,
-        _options: ConversionOptions,
+        options: ConversionOptions,
     ) -> Result<ConversionResult> {
         eprintln!("🔄 HTML Conversion (Pure Rust)");
-        eprintln!("   HTML → Semantic Parsing → {:?}", output_format);
+        eprintln!("   HTML → Streaming Tokenizer → {:?}", output_format);
         eprintln!();
 
-        // Read HTML file
-        let html_content = fs::read_to_string(input).await?;
-
         // Convert to requested format
         let output_data = match output_format {
             OutputFormat::Markdown { .. } => {
                 eprintln!("📝 Converting to Markdown...");
-                let markdown = self.html_to_markdown(&html_content)?;
-                markdown.into_bytes()
+                stream_markdown(input).await?
             }
-            OutputFormat::Json { .. } => {
+            OutputFormat::Json { .. } if options.embed_source => {
                 eprintln!("📝 Converting to JSON...");
-                // Simple JSON with raw HTML and extracted text
+                // JSON with raw HTML and extracted text
+                let html_content = String::from_utf8_lossy(&fs::read(input).await?).into_owned();
                 let markdown = self.html_to_markdown(&html_content)?;
                 let json = serde_json::json!({
                     "html": {
@@ -230,8 +659,19 @@ impl DocumentConverter for HtmlConverter {
                 });
                 serde_json::to_string_pretty(&json)?.into_bytes()
             }
+            OutputFormat::Json { .. } => {
+                eprintln!("📝 Converting to JSON...");
+                let markdown = stream_markdown(input).await?;
+                let json = serde_json::json!({
+                    "html": {
+                        "markdown": String::from_utf8_lossy(&markdown),
+                        "length": fs::metadata(input).await?.len(),
+                    }
+                });
+                serde_json::to_string_pretty(&json)?.into_bytes()
+            }
             _ => {
-                return Err(crate::TransmutationError::UnsupportedFormat(format!(
+                return Err(TransmutationError::UnsupportedFormat(format!(
                     "Output format {:?} not supported for HTML",
                     output_format
                 )));
@@ -277,11 +717,70 @@ impl DocumentConverter for HtmlConverter {
         })
     }
 
+    async fn convert_bytes(
+        &self,
+        name: &str,
+        data: Vec<u8>,
+        _input_format: FileFormat,
+        output_format: OutputFormat,
+        options: ConversionOptions,
+    ) -> Result<ConversionResult> {
+        let json = match output_format {
+            OutputFormat::Markdown { .. } => false,
+            OutputFormat::Json { .. } => true,
+            _ => {
+                return Err(TransmutationError::UnsupportedFormat(format!(
+                    "Output format {:?} not supported for HTML",
+                    output_format
+                )));
+            }
+        };
+
+        let input_size = data.len() as u64;
+        let embed_source = options.embed_source;
+        let output_data = tokio::task::spawn_blocking(move || -> Result<Vec<u8>> {
+            let mut markdown = Vec::new();
+            write_markdown(&data[..], &mut markdown)?;
+            if !json {
+                return Ok(markdown);
+            }
+
+            let markdown = String::from_utf8_lossy(&markdown);
+            let json = if embed_source {
+                serde_json::json!({
+                    "html": {
+                        "raw": String::from_utf8_lossy(&data),
+                        "markdown": markdown,
+                        "length": data.len(),
+                    }
+                })
+            } else {
+                serde_json::json!({
+                    "html": {
+                        "markdown": markdown,
+                        "length": data.len(),
+                    }
+                })
+            };
+            Ok(serde_json::to_string_pretty(&json)?.into_bytes())
+        })
+        .await
+        .map_err(|e| TransmutationError::conversion_failed(e.to_string()))??;
+
+        Ok(ConversionResult::single(
+            PathBuf::from(name),
+            FileFormat::Html,
+            output_format,
+            output_data,
+            input_size,
+        ))
+    }
+
     fn metadata(&self) -> ConverterMetadata {
         ConverterMetadata {
             name: "HTML Converter".to_string(),
             version: env!("CARGO_PKG_VERSION").to_string(),
-            description: "HTML to Markdown converter using semantic parsing (pure Rust)"
+            description: "HTML to Markdown converter using a streaming tokenizer (pure Rust)"
                 .to_string(),
             external_deps: vec![],
         }
@@ -309,6 +808,62 @@ mod tests {
         assert!(markdown.contains("Paragraph"));
     }
 
+    #[test]
+    fn test_html_to_markdown_structure() {
+        let converter = HtmlConverter::new();
+        let html = "<html><head><title>Doc &amp; Co</title><style>p { x: '</p>' }</style></head>\n\
+            <body><nav><ul><li>Home</li></ul></nav><script>if (a < b) { x = '<p>'; }</script>\n\
+            <h2>Intro <a href=\"/x?a=1&amp;b=2\">link</a></h2><p>Some   <b>bold</b> and\n<i></i><em>em</em>.</p>\n\
+            <ol><li>one<li>two <code>x</code></ol><pre>\nfn main() {}\n</pre>\n\
+            <table><tr><th>A</th><th>B</th></tr><tr><td>1</td><td><p>2</p></td></tr></table>\n\
+            <img src=\"i.png\" alt=\"pic\"></body></html>";
+
+        assert_eq!(
+            converter.html_to_markdown(html).unwrap(),
+            "# Doc & Co\n\n\
+             ## Intro [link](/x?a=1&b=2)\n\n\
+             Some **bold** and *em*.\n\n\
+             1. one\n2. two `x`\n\n\
+             ```\nfn main() {}\n```\n\n\
+             | A | B |\n|---|---|\n| 1 | 2 |\n\n\
+             ![pic](i.png)\n"
+        );
+    }
+
+    #[test]
+    fn test_write_markdown_chunk_boundaries() {
+        let mut html = String::from("<title>T</title>");
+        for n in 0..3000 {
+            html.push_str(&format!(
+                "<p class='c'>Para {n} &mdash; <a href='/p/{n}'>more</a></p><script>var s = '</scr' + 'ipt>';</script>"
+            ));
+        }
+
+        let mut markdown = Vec::new();
+        write_markdown(html.as_bytes(), &mut markdown).unwrap();
+        let markdown = String::from_utf8(markdown).unwrap();
+        assert!(html.len() > 2 * READ_CHUNK);
+        assert_eq!(markdown.matches("— [more](/p/").count(), 3000);
+        assert!(markdown.ends_with("Para 2999 — [more](/p/2999)\n"));
+        assert!(!markdown.contains("var s"));
+    }
+
+    #[test]
+    fn test_write_markdown_pre_in_tiny_chunks() {
+        let html = "<p>a &amp; b</p><pre>\n\nx\n```\n<span>\ny</span></pre><p>end</p>";
+        let render = |chunk| {
+            let mut markdown = Vec::new();
+            write_markdown_chunked(html.as_bytes(), &mut markdown, chunk).unwrap();
+            String::from_utf8(markdown).unwrap()
+        };
+
+        let whole = render(html.len() + 1);
+        assert_eq!(whole, "a & b\n\n```\n\nx\n```\n\ny\n```\n\nend\n");
+        for chunk in 1..8 {
+            assert_eq!(render(chunk), whole, "chunk of {chunk} bytes");
+        }
+    }
+
     #[test]
     fn test_html_converter_metadata() {
         let converter = HtmlConverter::new();
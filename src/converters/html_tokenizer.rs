@@ -0,0 +1,436 @@
+//! Incremental HTML tokenizer
+//!
+//! Splits a byte buffer into text, start tag and end tag tokens without
+//! building a tree. Every call either returns a complete token and the
+//! number of bytes it used, or `None` when the buffer ends mid-token and
+//! more input is needed, so a document can be fed through a fixed-size
+//! read buffer. Raw text elements (`<script>`, `<style>`, `<title>`, ...)
+//! are scanned separately by [`raw_text`], which only looks for the end tag.
+
+use std::borrow::Cow;
+
+use memchr::{memchr, memchr3, memmem, memrchr};
+
+/// Longest entity reference considered for decoding
+const MAX_ENTITY_LEN: usize = 32;
+
+/// A token borrowed from the input buffer
+#[derive(Debug, PartialEq)]
+pub(crate) enum Token<'a> {
+    /// Character data, entities not yet decoded
+    Text(&'a [u8]),
+    /// Start tag with its raw attribute source
+    Start {
+        name: &'a [u8],
+        attrs: &'a [u8],
+        self_closing: bool,
+    },
+    /// End tag
+    End { name: &'a [u8] },
+    /// Comment, doctype, processing instruction or stray markup
+    Other,
+}
+
+/// Next token at the start of `buf`, or `None` if more input is needed.
+/// With `eof`, an unterminated construct is consumed as [`Token::Other`].
+pub(crate) fn next_token(buf: &[u8], eof: bool) -> Option<(Token<'_>, usize)> {
+    let (&first, rest) = buf.split_first()?;
+    if first != b'<' {
+        let len = match memchr(b'<', buf) {
+            Some(len) => len,
+            None if eof => buf.len(),
+            None => text_safe_len(buf),
+        };
+        return (len > 0).then(|| (Token::Text(&buf[..len]), len));
+    }
+
+    let incomplete = || eof.then_some((Token::Other, buf.len()));
+    match rest.first() {
+        None => incomplete(),
+        Some(b'!') if rest.starts_with(b"!--") => match memmem::find(&buf[4..], b"-->") {
+            Some(end) => Some((Token::Other, 4 + end + 3)),
+            None => incomplete(),
+        },
+        Some(b'!' | b'?') => match memchr(b'>', buf) {
+            Some(end) => Some((Token::Other, end + 1)),
+            None => incomplete(),
+        },
+        Some(b'/') => match rest.get(1) {
+            None => incomplete(),
+            Some(b) if b.is_ascii_alphabetic() => {
+                let Some(end) = tag_end(buf) else {
+                    return incomplete();
+                };
+                let (name, _) = split_name(&buf[2..end]);
+                Some((Token::End { name }, end + 1))
+            }
+            Some(_) => match memchr(b'>', buf) {
+                Some(end) => Some((Token::Other, end + 1)),
+                None => incomplete(),
+            },
+        },
+        Some(b) if b.is_ascii_alphabetic() => {
+            let Some(end) = tag_end(buf) else {
+                return incomplete();
+            };
+            let (name, attrs) = split_name(&buf[1..end]);
+            let self_closing = attrs.last() == Some(&b'/');
+            let attrs = if self_closing {
+                &attrs[..attrs.len() - 1]
+            } else {
+                attrs
+            };
+            Some((
+                Token::Start {
+                    name,
+                    attrs,
+                    self_closing,
+                },
+                end + 1,
+            ))
+        }
+        // A `<` that opens nothing is text
+        Some(_) => Some((Token::Text(&buf[..1]), 1)),
+    }
+}
+
+/// Length of the text that can be emitted before more input arrives: all
+/// of it, except an entity reference that may continue in the next read
+fn text_safe_len(buf: &[u8]) -> usize {
+    match memrchr(b'&', buf) {
+        Some(amp) if buf.len() - amp < MAX_ENTITY_LEN && memchr(b';', &buf[amp..]).is_none() => amp,
+        _ => buf.len(),
+    }
+}
+
+/// Offset of the `>` closing the tag at the start of `buf`. Quotes only
+/// delimit attribute values, i.e. when they follow `=`.
+fn tag_end(buf: &[u8]) -> Option<usize> {
+    let mut pos = 1;
+    loop {
+        let i = pos + memchr3(b'>', b'"', b'\'', &buf[pos..])?;
+        if buf[i] == b'>' {
+            return Some(i);
+        }
+        let after_equals = buf[..i]
+            .iter()
+            .rev()
+            .find(|b| !b.is_ascii_whitespace())
+            .is_some_and(|&b| b == b'=');
+        pos = if after_equals {
+            i + 1 + memchr(buf[i], &buf[i + 1..])? + 1
+        } else {
+            i + 1
+        };
+    }
+}
+
+/// Split tag source after `<` or `</` into name and attribute source
+fn split_name(tag: &[u8]) -> (&[u8], &[u8]) {
+    let len = tag
+        .iter()
+        .position(|&b| b.is_ascii_whitespace() || b == b'/')
+        .unwrap_or(tag.len());
+    (&tag[..len], &tag[len..])
+}
+
+/// Extent of raw text up to an end tag
+#[derive(Debug, PartialEq)]
+pub(crate) struct RawText {
+    /// Bytes of text before the end tag (or before the kept-back tail)
+    pub text: usize,
+    /// Bytes consumed, including the end tag once found
+    pub consumed: usize,
+    /// Whether the element ended
+    pub closed: bool,
+}
+
+/// Scan the content of raw text element `name` (lowercase) at the start of
+/// `buf`. Without the end tag, a tail that could start it is kept back.
+pub(crate) fn raw_text(buf: &[u8], name: &[u8], eof: bool) -> RawText {
+    let pending = |at: usize| RawText {
+        text: at,
+        consumed: at,
+        closed: false,
+    };
+
+    let mut pos = 0;
+    while let Some(offset) = memmem::find(&buf[pos..], b"</") {
+        let start = pos + offset;
+        let after = start + 2 + name.len();
+        let (Some(candidate), Some(&next)) = (buf.get(start + 2..after), buf.get(after)) else {
+            // The end tag may continue in the next read
+            if eof {
+                break;
+            }
+            return pending(start);
+        };
+        if candidate.eq_ignore_ascii_case(name)
+            && (next.is_ascii_whitespace() || matches!(next, b'>' | b'/'))
+        {
+            return match memchr(b'>', &buf[after..]) {
+                Some(end) => RawText {
+                    text: start,
+                    consumed: after + end + 1,
+                    closed: true,
+                },
+                None if eof => break,
+                None => pending(start),
+            };
+        }
+        pos = start + 2;
+    }
+
+    if eof {
+        return RawText {
+            text: buf.len(),
+            consumed: buf.len(),
+            closed: true,
+        };
+    }
+    // Keep back a trailing `<` that could start the end tag
+    pending(if buf.last() == Some(&b'<') {
+        buf.len() - 1
+    } else {
+        buf.len()
+    })
+}
+
+/// Value of attribute `name` (lowercase) in a start tag's attribute source
+pub(crate) fn attr<'a>(attrs: &'a [u8], name: &[u8]) -> Option<Cow<'a, str>> {
+    let mut pos = 0;
+    while pos < attrs.len() {
+        while attrs
+            .get(pos)
+            .is_some_and(|&b| b.is_ascii_whitespace() || b == b'/')
+        {
+            pos += 1;
+        }
+        let start = pos;
+        while attrs
+            .get(pos)
+            .is_some_and(|&b| !b.is_ascii_whitespace() && b != b'=' && b != b'/')
+        {
+            pos += 1;
+        }
+        let key = &attrs[start..pos];
+        while attrs.get(pos).is_some_and(u8::is_ascii_whitespace) {
+            pos += 1;
+        }
+
+        let mut value: &[u8] = b"";
+        if attrs.get(pos) == Some(&b'=') {
+            pos += 1;
+            while attrs.get(pos).is_some_and(u8::is_ascii_whitespace) {
+                pos += 1;
+            }
+            match attrs.get(pos) {
+                Some(&quote @ (b'"' | b'\'')) => {
+                    let end = memchr(quote, &attrs[pos + 1..]).map_or(attrs.len(), |e| pos + 1 + e);
+                    value = &attrs[pos + 1..end];
+                    pos = end + 1;
+                }
+                _ => {
+                    let end = attrs[pos..]
+                        .iter()
+                        .position(u8::is_ascii_whitespace)
+                        .map_or(attrs.len(), |e| pos + e);
+                    value = &attrs[pos..end];
+                    pos = end;
+                }
+            }
+        }
+
+        if key.eq_ignore_ascii_case(name) {
+            return Some(match decode_entities(value) {
+                Cow::Borrowed(bytes) => String::from_utf8_lossy(bytes),
+                Cow::Owned(bytes) => Cow::Owned(String::from_utf8_lossy(&bytes).into_owned()),
+            });
+        }
+        if key.is_empty() {
+            pos += 1;
+        }
+    }
+    None
+}
+
+/// Decode character references; unknown ones are kept as written
+pub(crate) fn decode_entities(text: &[u8]) -> Cow<'_, [u8]> {
+    let Some(first) = memchr(b'&', text) else {
+        return Cow::Borrowed(text);
+    };
+
+    let mut out = Vec::with_capacity(text.len());
+    out.extend_from_slice(&text[..first]);
+    let mut pos = first;
+    while pos < text.len() {
+        let Some(offset) = memchr(b'&', &text[pos..]) else {
+            out.extend_from_slice(&text[pos..]);
+            break;
+        };
+        out.extend_from_slice(&text[pos..pos + offset]);
+        pos += offset;
+
+        let window = &text[pos + 1..text.len().min(pos + 1 + MAX_ENTITY_LEN)];
+        let decoded = memchr(b';', window).and_then(|semi| {
+            let c = entity_char(&window[..semi])?;
+            Some((c, semi + 2))
+        });
+        match decoded {
+            Some((c, len)) => {
+                let mut utf8 = [0; 4];
+                out.extend_from_slice(c.encode_utf8(&mut utf8).as_bytes());
+                pos += len;
+            }
+            None => {
+                out.push(b'&');
+                pos += 1;
+            }
+        }
+    }
+    Cow::Owned(out)
+}
+
+/// Character for an entity name (`amp`, `#38`, `#x26`)
+fn entity_char(name: &[u8]) -> Option<char> {
+    if let Some(number) = name.strip_prefix(b"#") {
+        let (digits, radix) = match number.split_first() {
+            Some((b'x' | b'X', hex)) => (hex, 16),
+            _ => (number, 10),
+        };
+        let code = u32::from_str_radix(std::str::from_utf8(digits).ok()?, radix).ok()?;
+        return Some(
+            char::from_u32(code)
+                .filter(|&c| c != '\0')
+                .unwrap_or('\u{fffd}'),
+        );
+    }
+
+    Some(match name {
+        b"amp" => '&',
+        b"lt" => '<',
+        b"gt" => '>',
+        b"quot" => '"',
+        b"apos" => '\'',
+        b"nbsp" => '\u{a0}',
+        b"shy" => '\u{ad}',
+        b"copy" => '©',
+        b"reg" => '®',
+        b"trade" => '™',
+        b"deg" => '°',
+        b"plusmn" => '±',
+        b"times" => '×',
+        b"divide" => '÷',
+        b"middot" => '·',
+        b"para" => '¶',
+        b"sect" => '§',
+        b"euro" => '€',
+        b"pound" => '£',
+        b"yen" => '¥',
+        b"cent" => '¢',
+        b"laquo" => '«',
+        b"raquo" => '»',
+        b"lsquo" => '‘',
+        b"rsquo" => '’',
+        b"ldquo" => '“',
+        b"rdquo" => '”',
+        b"ndash" => '–',
+        b"mdash" => '—',
+        b"hellip" => '…',
+        b"bull" => '•',
+        b"rarr" => '→',
+        b"larr" => '←',
+        _ => return None,
+    })
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn tokens(html: &[u8]) -> Vec<Token<'_>> {
+        let mut pos = 0;
+        let mut tokens = Vec::new();
+        while let Some((token, len)) = next_token(&html[pos..], true) {
+            tokens.push(token);
+            pos += len;
+        }
+        tokens
+    }
+
+    #[test]
+    fn test_next_token_tags_and_text() {
+        let html = b"<!DOCTYPE html><!-- a > b --><A HREF=\"x>y\" title=it's>go</a> 1 < 2<br/>";
+        assert_eq!(
+            tokens(html),
+            vec![
+                Token::Other,
+                Token::Other,
+                Token::Start {
+                    name: b"A",
+                    attrs: b" HREF=\"x>y\" title=it's",
+                    self_closing: false
+                },
+                Token::Text(b"go"),
+                Token::End { name: b"a" },
+                Token::Text(b" 1 "),
+                Token::Text(b"<"),
+                Token::Text(b" 2"),
+                Token::Start {
+                    name: b"br",
+                    attrs: b"",
+                    self_closing: true
+                },
+            ]
+        );
+    }
+
+    #[test]
+    fn test_next_token_needs_more_input() {
+        assert_eq!(next_token(b"<a href=\"x", false), None);
+        assert_eq!(next_token(b"<!-- open", false), None);
+        assert_eq!(
+            next_token(b"fish &am", false),
+            Some((Token::Text(b"fish "), 5))
+        );
+        assert_eq!(next_token(b"<a href=\"x", true), Some((Token::Other, 10)));
+    }
+
+    #[test]
+    fn test_raw_text() {
+        let script = b"if (a</b) {}</SCRIPT >rest";
+        assert_eq!(
+            raw_text(script, b"script", false),
+            RawText {
+                text: 12,
+                consumed: 22,
+                closed: true
+            }
+        );
+        assert_eq!(
+            raw_text(b"var x = 1;</scr", b"script", false),
+            RawText {
+                text: 10,
+                consumed: 10,
+                closed: false
+            }
+        );
+        assert_eq!(raw_text(b"a<", b"style", false).consumed, 1);
+        assert!(raw_text(b"never closed", b"style", true).closed);
+    }
+
+    #[test]
+    fn test_attr_and_entities() {
+        let attrs = b" class=x HREF='/a?b=1&amp;c=2' alt=\"&lt;hi&gt;\" disabled";
+        assert_eq!(attr(attrs, b"href").as_deref(), Some("/a?b=1&c=2"));
+        assert_eq!(attr(attrs, b"alt").as_deref(), Some("<hi>"));
+        assert_eq!(attr(attrs, b"disabled").as_deref(), Some(""));
+        assert_eq!(attr(attrs, b"src"), None);
+
+        assert_eq!(
+            decode_entities(b"a &amp; b &#169; &#x2014; &bogus; &"),
+            Cow::Owned::<[u8]>("a & b © — &bogus; &".as_bytes().to_vec())
+        );
+        assert!(matches!(decode_entities(b"plain"), Cow::Borrowed(_)));
+    }
+}
@@ -36,29 +36,16 @@ impl ImageConverter {
     }
 
     /// Perform OCR on an image
+    ///
+    /// Uses the pooled Tesseract engines of [`ocr_pool`](super::ocr_pool);
+    /// tall images are recognized in parallel strips.
     #[cfg(feature = "tesseract")]
     async fn ocr_image(&self, image_path: &Path, language: &str) -> Result<String> {
-        use leptess::LepTess;
-
-        // Initialize Tesseract
-        let mut tesseract = LepTess::new(None, language).map_err(|e| {
-            crate::TransmutationError::conversion_failed(&format!(
-                "Failed to initialize Tesseract: {}",
-                e
-            ))
-        })?;
-
-        // Set image
-        tesseract.set_image(image_path).map_err(|e| {
-            crate::TransmutationError::conversion_failed(&format!("Failed to set image: {}", e))
-        })?;
-
-        // Get text
-        let text = tesseract.get_utf8_text().map_err(|e| {
-            crate::TransmutationError::conversion_failed(&format!("OCR failed: {}", e))
-        })?;
-
-        Ok(text)
+        let path = image_path.to_path_buf();
+        let language = language.to_string();
+        tokio::task::spawn_blocking(move || super::ocr_pool::ocr_image(&path, &language))
+            .await
+            .map_err(|e| crate::TransmutationError::conversion_failed(e.to_string()))?
     }
 
     /// Convert image to Markdown
@@ -126,13 +113,25 @@ impl DocumentConverter for ImageConverter {
         &self,
         input: &Path,
         output_format: OutputFormat,
-        _options: ConversionOptions,
+        options: ConversionOptions,
+    ) -> Result<ConversionResult> {
+        let input_format = crate::utils::file_detect::detect_format(input).await?;
+        self.convert_detected(input, input_format, output_format, options)
+            .await
+    }
+
+    async fn convert_detected(
+        &self,
+        input: &Path,
+        input_format: FileFormat,
+        output_format: OutputFormat,
+        options: ConversionOptions,
     ) -> Result<ConversionResult> {
         eprintln!("🔄 Image OCR (Tesseract)");
         eprintln!("   Image → OCR → {:?}", output_format);
         eprintln!();
 
-        let language = "eng"; // Default to English (can be made configurable later)
+        let language = options.ocr_language.as_str();
 
         #[cfg(feature = "tesseract")]
         {
@@ -172,7 +171,7 @@ impl DocumentConverter for ImageConverter {
 
             Ok(ConversionResult {
                 input_path: input.to_path_buf(),
-                input_format: crate::utils::file_detect::detect_format(input).await?,
+                input_format,
                 output_format,
                 content: vec![ConversionOutput {
                     page_number: 1,
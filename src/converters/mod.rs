@@ -5,7 +5,10 @@ pub mod traits;
 // Core converters (always enabled)
 pub mod archive;
 pub mod html;
+mod html_tokenizer;
+mod page_cache;
 pub mod pdf;
+mod pdf_text;
 pub mod xml;
 
 // Office formats (optional)
@@ -15,11 +18,21 @@ pub mod docx;
 #[cfg(feature = "office")]
 pub mod xlsx;
 
+#[cfg(feature = "office")]
+mod xlsx_reader;
+
 #[cfg(feature = "office")]
 pub mod pptx;
 
+#[cfg(feature = "office")]
+mod office_pool;
+
+#[cfg(feature = "office")]
+mod ooxml_reader;
+
 // Text formats (always enabled)
 pub mod csv;
+mod csv_reader;
 pub mod odt;
 pub mod rtf;
 pub mod txt;
@@ -28,10 +41,58 @@ pub mod txt;
 #[cfg(feature = "image-ocr")]
 pub mod image;
 
+#[cfg(feature = "image-ocr")]
+mod ocr_pool;
+
 #[cfg(feature = "audio")]
 pub mod audio;
 
 #[cfg(feature = "video")]
 pub mod video;
 
+#[cfg(any(feature = "audio", feature = "video"))]
+mod transcription;
+
 pub use traits::{ConverterMetadata, DocumentConverter};
+
+use crate::types::FileFormat;
+
+/// Converter for an input format, if one is compiled in
+pub fn converter_for(format: FileFormat) -> Option<Box<dyn DocumentConverter>> {
+    Some(match format {
+        // Core formats (always enabled)
+        FileFormat::Pdf => Box::new(pdf::PdfConverter::new()),
+        FileFormat::Html => Box::new(html::HtmlConverter::new()),
+        FileFormat::Xml => Box::new(xml::XmlConverter::new()),
+        format if format.is_archive() => Box::new(archive::ArchiveConverter::new()),
+
+        // Office formats (optional feature)
+        #[cfg(feature = "office")]
+        FileFormat::Docx => Box::new(docx::DocxConverter::new()),
+        #[cfg(feature = "office")]
+        FileFormat::Xlsx => Box::new(xlsx::XlsxConverter::new()),
+        #[cfg(feature = "office")]
+        FileFormat::Pptx => Box::new(pptx::PptxConverter::new()),
+
+        // Text formats (always enabled)
+        FileFormat::Txt => Box::new(txt::TxtConverter::new()),
+        FileFormat::Csv => Box::new(csv::CsvConverter::new()),
+        FileFormat::Tsv => Box::new(csv::CsvConverter::new_tsv()),
+        FileFormat::Rtf => Box::new(rtf::RtfConverter::new()),
+        FileFormat::Odt => Box::new(odt::OdtConverter::new()),
+
+        // Image formats (with OCR if feature enabled)
+        #[cfg(feature = "image-ocr")]
+        format if format.is_image() => Box::new(image::ImageConverter::new()),
+
+        // Audio formats (with Whisper if feature enabled)
+        #[cfg(feature = "audio")]
+        format if format.is_audio() => Box::new(audio::AudioConverter::new()),
+
+        // Video formats (with FFmpeg + Whisper if feature enabled)
+        #[cfg(feature = "video")]
+        format if format.is_video() => Box::new(video::VideoConverter::new()),
+
+        _ => return None,
+    })
+}
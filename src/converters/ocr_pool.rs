@@ -0,0 +1,327 @@
+//! Tesseract engine pool and tiled OCR
+//!
+//! Initializing Tesseract loads the traineddata of a language, which takes
+//! longer than recognizing a small image. Engines are therefore kept per
+//! rayon worker thread and language, and reused for every image that thread
+//! recognizes.
+//!
+//! Tall images are cut into overlapping horizontal strips that are
+//! recognized in parallel. Each strip owns the lines whose centre falls in
+//! its band, so a line cut by one strip's edge is read whole by its
+//! neighbour and kept exactly once.
+
+use std::cell::RefCell;
+use std::collections::HashMap;
+use std::collections::hash_map::Entry;
+use std::io::Cursor;
+use std::path::Path;
+
+use image::{DynamicImage, GrayImage, ImageFormat};
+use leptess::LepTess;
+use rayon::prelude::*;
+
+use crate::{Result, TransmutationError};
+
+/// Images shorter than two strips of this height are recognized whole
+const STRIP_MIN_HEIGHT: u32 = 1024;
+
+/// Rows each strip reads beyond its band on both sides; lines up to twice
+/// this tall are never cut in every strip that sees them
+const STRIP_OVERLAP: u32 = 96;
+
+/// Resolution assumed for strips, which carry no DPI of their own
+const STRIP_DPI: i32 = 300;
+
+thread_local! {
+    /// Initialized engines of this worker thread, by language
+    static ENGINES: RefCell<HashMap<String, LepTess>> = RefCell::new(HashMap::new());
+}
+
+/// Run `f` with this thread's engine for `language`, initializing it once
+fn with_engine<T>(language: &str, f: impl FnOnce(&mut LepTess) -> Result<T>) -> Result<T> {
+    ENGINES.with(|engines| {
+        let mut engines = engines.borrow_mut();
+        let engine = match engines.entry(language.to_string()) {
+            Entry::Occupied(entry) => entry.into_mut(),
+            Entry::Vacant(entry) => {
+                let engine = LepTess::new(None, language).map_err(|e| {
+                    tesseract_error(format!("Failed to initialize Tesseract: {}", e))
+                })?;
+                entry.insert(engine)
+            }
+        };
+        f(engine)
+    })
+}
+
+/// Recognize the text of the image at `path`
+///
+/// Blocks until done; recognition runs on the rayon pool, one strip per
+/// worker for tall images.
+pub(crate) fn ocr_image(path: &Path, language: &str) -> Result<String> {
+    let (_, height) = image::image_dimensions(path)
+        .map_err(|e| tesseract_error(format!("Failed to read image: {}", e)))?;
+    let strips = plan_strips(height, rayon::current_num_threads());
+
+    // Only tiled images are decoded here; a whole image goes to Tesseract
+    // by path, which keeps the resolution stored in the file
+    let gray = if strips.len() > 1 {
+        let image = image::open(path)
+            .map_err(|e| tesseract_error(format!("Failed to decode image: {}", e)))?;
+        Some(image.into_luma8())
+    } else {
+        None
+    };
+
+    let texts = strips
+        .par_iter()
+        .map(|strip| {
+            with_engine(language, |engine| match &gray {
+                None => {
+                    engine
+                        .set_image(path)
+                        .map_err(|e| tesseract_error(format!("Failed to set image: {}", e)))?;
+                    engine
+                        .get_utf8_text()
+                        .map_err(|e| tesseract_error(format!("OCR failed: {}", e)))
+                }
+                Some(gray) => {
+                    engine
+                        .set_image_from_mem(&encode_strip(gray, strip)?)
+                        .map_err(|e| tesseract_error(format!("Failed to set image: {}", e)))?;
+                    engine.set_source_resolution(STRIP_DPI);
+                    engine
+                        .get_tsv_text(0)
+                        .map_err(|e| tesseract_error(format!("OCR failed: {}", e)))
+                }
+            })
+        })
+        .collect::<Result<Vec<String>>>()?;
+
+    if gray.is_none() {
+        return Ok(texts.into_iter().next().unwrap_or_default());
+    }
+    Ok(stitch(&strips, &texts))
+}
+
+/// Rows `top..bottom` of `gray` as an uncompressed BMP, which Leptonica
+/// reads without decoding work
+fn encode_strip(gray: &GrayImage, strip: &Strip) -> Result<Vec<u8>> {
+    let rows =
+        image::imageops::crop_imm(gray, 0, strip.top, gray.width(), strip.bottom - strip.top)
+            .to_image();
+    let mut bmp = Vec::new();
+    DynamicImage::ImageLuma8(rows)
+        .write_to(&mut Cursor::new(&mut bmp), ImageFormat::Bmp)
+        .map_err(|e| tesseract_error(format!("Failed to encode strip: {}", e)))?;
+    Ok(bmp)
+}
+
+fn tesseract_error(message: String) -> TransmutationError {
+    TransmutationError::engine_error("tesseract", message)
+}
+
+/// A horizontal strip of the image: recognized over rows `top..bottom`,
+/// owning the lines whose centre lies in `own_top..own_bottom`
+#[derive(Debug, Clone, Copy, PartialEq)]
+struct Strip {
+    top: u32,
+    bottom: u32,
+    own_top: u32,
+    own_bottom: u32,
+}
+
+/// Cut `height` rows into at most `workers` strips of at least
+/// [`STRIP_MIN_HEIGHT`] rows each
+fn plan_strips(height: u32, workers: usize) -> Vec<Strip> {
+    let workers = u32::try_from(workers).unwrap_or(u32::MAX);
+    let count = (height / STRIP_MIN_HEIGHT).min(workers).max(1);
+    let band = height.div_ceil(count);
+
+    (0..count)
+        .map(|i| {
+            let own_top = i * band;
+            let own_bottom = ((i + 1) * band).min(height);
+            Strip {
+                top: own_top.saturating_sub(STRIP_OVERLAP),
+                bottom: (own_bottom + STRIP_OVERLAP).min(height),
+                own_top,
+                own_bottom,
+            }
+        })
+        .collect()
+}
+
+/// A text line recognized in a strip, with its box in image rows
+#[derive(Debug)]
+struct OcrLine {
+    /// Block and paragraph numbers within the strip
+    paragraph: (u32, u32),
+    top: u32,
+    height: u32,
+    words: Vec<String>,
+}
+
+/// Lines of Tesseract TSV output in reading order, shifted down by `offset`
+///
+/// Columns: level, page, block, paragraph, line, word, left, top, width,
+/// height, confidence, text. Level 4 rows are lines, level 5 rows words.
+fn tsv_lines(tsv: &str, offset: u32) -> Vec<OcrLine> {
+    let mut lines: Vec<OcrLine> = Vec::new();
+    let mut current = None;
+
+    for row in tsv.lines() {
+        let cols: Vec<&str> = row.splitn(12, '\t').collect();
+        let [level, _, block, par, line, _, _, top, _, height, _, text] = cols[..] else {
+            continue;
+        };
+        let number = |col: &str| col.parse::<u32>().ok();
+        let (Some(level), Some(block), Some(par), Some(line), Some(top), Some(height)) = (
+            number(level),
+            number(block),
+            number(par),
+            number(line),
+            number(top),
+            number(height),
+        ) else {
+            // Header row, or a malformed one
+            continue;
+        };
+
+        match level {
+            4 => {
+                current = Some((block, par, line));
+                lines.push(OcrLine {
+                    paragraph: (block, par),
+                    top: offset + top,
+                    height,
+                    words: Vec::new(),
+                });
+            }
+            5 if current == Some((block, par, line)) && !text.trim().is_empty() => {
+                if let Some(last) = lines.last_mut() {
+                    last.words.push(text.trim().to_string());
+                }
+            }
+            _ => {}
+        }
+    }
+
+    lines.retain(|line| !line.words.is_empty());
+    lines
+}
+
+/// Join the TSV output of each strip into one text: lines owned by their
+/// strip, `\n` between lines and `\n\n` between paragraphs
+fn stitch(strips: &[Strip], tsvs: &[String]) -> String {
+    let mut text = String::new();
+    // Bottom and height of the previous line
+    let mut previous: Option<(u32, u32)> = None;
+
+    for (strip, tsv) in strips.iter().zip(tsvs) {
+        let mut paragraph = None;
+        for line in tsv_lines(tsv, strip.top) {
+            let centre = line.top + line.height / 2;
+            if centre < strip.own_top || centre >= strip.own_bottom {
+                continue;
+            }
+
+            if let Some((bottom, height)) = previous {
+                let new_paragraph = match paragraph {
+                    Some(paragraph) => paragraph != line.paragraph,
+                    // First line of a strip: Tesseract's paragraph numbers
+                    // restart, so judge by the gap to the previous line
+                    None => line.top.saturating_sub(bottom) > height,
+                };
+                text.push_str(if new_paragraph { "\n\n" } else { "\n" });
+            }
+            text.push_str(&line.words.join(" "));
+
+            paragraph = Some(line.paragraph);
+            previous = Some((line.top + line.height, line.height));
+        }
+    }
+
+    if !text.is_empty() {
+        text.push('\n');
+    }
+    text
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_plan_strips_cover_image_once() {
+        assert_eq!(plan_strips(1500, 8).len(), 1);
+        assert_eq!(plan_strips(10_000, 1).len(), 1);
+
+        let strips = plan_strips(10_000, 4);
+        assert_eq!(strips.len(), 4);
+        assert_eq!(strips[0].own_top, 0);
+        assert_eq!(strips[3].own_bottom, 10_000);
+        for pair in strips.windows(2) {
+            assert_eq!(pair[0].own_bottom, pair[1].own_top);
+            assert_eq!(pair[0].bottom, pair[0].own_bottom + STRIP_OVERLAP);
+            assert_eq!(pair[1].top, pair[1].own_top - STRIP_OVERLAP);
+        }
+    }
+
+    fn tsv(rows: &[(u32, u32, u32, u32, u32, &str)]) -> String {
+        let mut tsv = String::from(
+            "level\tpage_num\tblock_num\tpar_num\tline_num\tword_num\tleft\ttop\twidth\theight\tconf\ttext\n",
+        );
+        for (level, block, par, line, top, text) in rows {
+            tsv.push_str(&format!(
+                "{level}\t1\t{block}\t{par}\t{line}\t1\t10\t{top}\t100\t20\t95\t{text}\n"
+            ));
+        }
+        tsv
+    }
+
+    #[test]
+    fn test_stitch_keeps_overlapping_lines_once() {
+        let strips = [
+            Strip {
+                top: 0,
+                bottom: 200,
+                own_top: 0,
+                own_bottom: 100,
+            },
+            Strip {
+                top: 0,
+                bottom: 300,
+                own_top: 100,
+                own_bottom: 300,
+            },
+        ];
+        // "second line" sits across the band edge (centre 105) and is seen
+        // by both strips; the first strip also reads a cut "third" line
+        let first = tsv(&[
+            (4, 1, 1, 1, 70, ""),
+            (5, 1, 1, 1, 70, "first"),
+            (5, 1, 1, 1, 70, "line"),
+            (4, 1, 1, 2, 95, ""),
+            (5, 1, 1, 2, 95, "second"),
+            (5, 1, 1, 2, 95, "line"),
+            (4, 1, 1, 3, 120, ""),
+            (5, 1, 1, 3, 120, "thi"),
+        ]);
+        let second = tsv(&[
+            (4, 1, 1, 1, 95, ""),
+            (5, 1, 1, 1, 95, "second"),
+            (5, 1, 1, 1, 95, "line"),
+            (4, 1, 1, 2, 120, ""),
+            (5, 1, 1, 2, 120, "third"),
+            (4, 1, 2, 1, 170, ""),
+            (5, 1, 2, 1, 170, "next"),
+            (5, 1, 2, 1, 170, "paragraph"),
+        ]);
+
+        assert_eq!(
+            stitch(&strips, &[first, second]),
+            "first line\nsecond line\nthird\n\nnext paragraph\n"
+        );
+    }
+}
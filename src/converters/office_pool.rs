@@ -0,0 +1,569 @@
+//! Resident LibreOffice instances for office → PDF conversion
+//!
+//! Starting LibreOffice takes several seconds, far longer than converting a
+//! typical document, and concurrent `soffice --convert-to` runs fight over
+//! the shared user profile. Instead, a small pool of headless soffice
+//! instances is kept running, each with a private profile directory, and
+//! driven over a UNO pipe by a bridge process (see `office_worker.py` for
+//! the protocol).
+//!
+//! An instance is pinged before each reuse and restarted when it does not
+//! answer, and one that exceeds the conversion timeout is killed and
+//! replaced. Instances are also recycled after [`RECYCLE_AFTER`]
+//! conversions, which bounds LibreOffice's memory growth.
+//!
+//! The processes are plain children whose bridge is talked to from
+//! blocking threads, so the process-wide pool keeps working across tokio
+//! runtimes.
+//!
+//! Environment:
+//! - `TRANSMUTATION_SOFFICE`: soffice binary (default: found in the usual
+//!   install locations)
+//! - `TRANSMUTATION_OFFICE_PYTHON`: Python interpreter with the `uno`
+//!   module (default: the one LibreOffice bundles, else `python3`)
+//! - `TRANSMUTATION_OFFICE_WORKERS`: number of resident instances
+//! - `TRANSMUTATION_OFFICE_TIMEOUT`: seconds one conversion may take
+
+use std::io::{BufRead, BufReader, Write};
+use std::path::Path;
+use std::process::{Child, ChildStdin, ChildStdout, Command, Stdio};
+use std::sync::atomic::{AtomicUsize, Ordering};
+use std::sync::{Arc, Mutex, OnceLock};
+use std::time::Duration;
+
+use serde::Deserialize;
+use tempfile::TempDir;
+use tokio::sync::Semaphore;
+
+use crate::{Result, TransmutationError};
+
+/// Bridge run by default
+const WORKER_SCRIPT: &str = include_str!("office_worker.py");
+
+/// Time a new instance gets to start and answer its first ping (the bridge
+/// itself waits up to a minute for soffice)
+const START_TIMEOUT: Duration = Duration::from_secs(90);
+
+/// Time an idle instance gets to answer the ping before reuse
+const HEALTH_TIMEOUT: Duration = Duration::from_secs(10);
+
+/// Default time one conversion may take before the instance is restarted
+const CONVERT_TIMEOUT: Duration = Duration::from_secs(180);
+
+/// Conversions after which an instance is replaced by a fresh one
+const RECYCLE_AFTER: usize = 200;
+
+const INSTALL_HINT: &str = if cfg!(target_os = "windows") {
+    "Install LibreOffice from https://www.libreoffice.org/download/"
+} else if cfg!(target_os = "macos") {
+    "Install: brew install libreoffice"
+} else {
+    "Install: sudo apt install libreoffice python3-uno"
+};
+
+/// Convert the office document at `input` to PDF on a resident instance
+pub(crate) async fn convert_to_pdf(input: &Path) -> Result<Vec<u8>> {
+    let input = std::path::absolute(input)?;
+    let output = tempfile::tempdir()?;
+    let pdf_path = output.path().join("document.pdf");
+
+    InstancePool::global().convert(&input, &pdf_path).await?;
+    tokio::fs::read(&pdf_path)
+        .await
+        .map_err(|e| libreoffice_error(format!("PDF not generated by LibreOffice: {e}")))
+}
+
+fn ping() -> serde_json::Value {
+    serde_json::json!({ "op": "ping" })
+}
+
+fn libreoffice_error(message: impl Into<String>) -> TransmutationError {
+    TransmutationError::engine_error("libreoffice", message)
+}
+
+/// A program and its leading arguments
+#[derive(Debug, Clone)]
+struct Program {
+    program: String,
+    args: Vec<String>,
+}
+
+impl Program {
+    fn new(program: impl Into<String>) -> Self {
+        Self {
+            program: program.into(),
+            args: Vec::new(),
+        }
+    }
+
+    fn command(&self) -> Command {
+        let mut command = Command::new(&self.program);
+        command.args(&self.args);
+        command
+    }
+}
+
+/// How to start the two processes of an instance
+#[derive(Debug, Clone)]
+struct InstanceCommand {
+    /// soffice, given the accept string and profile as further arguments
+    soffice: Program,
+    /// Bridge, given the pipe name as its last argument
+    bridge: Program,
+}
+
+impl InstanceCommand {
+    fn from_env() -> Self {
+        let python =
+            std::env::var("TRANSMUTATION_OFFICE_PYTHON").unwrap_or_else(|_| office_python());
+        Self {
+            soffice: Program::new(
+                std::env::var("TRANSMUTATION_SOFFICE").unwrap_or_else(|_| soffice_binary()),
+            ),
+            bridge: Program {
+                program: python,
+                args: vec!["-c".to_string(), WORKER_SCRIPT.to_string()],
+            },
+        }
+    }
+}
+
+/// soffice of the first LibreOffice install found, else `soffice` on PATH
+///
+/// On Linux and Windows `soffice.bin` is started directly: the `soffice`
+/// launcher (a script and `oosplash`, or `soffice.exe`) would be what a
+/// hung instance's kill reaches, leaving the real process running. On
+/// macOS `soffice` is the real process already.
+fn soffice_binary() -> String {
+    let candidates: &[&str] = if cfg!(target_os = "windows") {
+        &[
+            r"C:\Program Files\LibreOffice\program\soffice.bin",
+            r"C:\Program Files (x86)\LibreOffice\program\soffice.bin",
+            r"C:\Program Files\LibreOffice\program\soffice.exe",
+            r"C:\Program Files (x86)\LibreOffice\program\soffice.exe",
+        ]
+    } else if cfg!(target_os = "macos") {
+        &["/Applications/LibreOffice.app/Contents/MacOS/soffice"]
+    } else {
+        &[
+            "/usr/lib/libreoffice/program/soffice.bin",
+            "/usr/lib64/libreoffice/program/soffice.bin",
+            "/opt/libreoffice/program/soffice.bin",
+        ]
+    };
+    candidates
+        .iter()
+        .find(|path| Path::new(path).exists())
+        .map_or("soffice", |path| path)
+        .to_string()
+}
+
+/// Python that can `import uno`: LibreOffice's own on Windows and macOS,
+/// the system one (with python3-uno) elsewhere
+fn office_python() -> String {
+    let candidates: &[&str] = if cfg!(target_os = "windows") {
+        &[
+            r"C:\Program Files\LibreOffice\program\python.exe",
+            r"C:\Program Files (x86)\LibreOffice\program\python.exe",
+        ]
+    } else if cfg!(target_os = "macos") {
+        &["/Applications/LibreOffice.app/Contents/Resources/python"]
+    } else {
+        &[]
+    };
+    candidates
+        .iter()
+        .find(|path| Path::new(path).exists())
+        .map_or("python3", |path| path)
+        .to_string()
+}
+
+/// `file://` URL of an absolute path, as soffice expects for its profile
+fn file_url(path: &Path) -> String {
+    let path = path.to_string_lossy().replace('\\', "/");
+    let mut url = String::from(if path.starts_with('/') {
+        "file://"
+    } else {
+        "file:///"
+    });
+    for c in path.chars() {
+        match c {
+            ' ' => url.push_str("%20"),
+            '%' => url.push_str("%25"),
+            '#' => url.push_str("%23"),
+            c => url.push(c),
+        }
+    }
+    url
+}
+
+/// Resident instances, started on demand and kept for reuse
+#[derive(Debug)]
+struct InstancePool {
+    command: InstanceCommand,
+    timeout: Duration,
+    permits: Semaphore,
+    idle: Mutex<Vec<Instance>>,
+}
+
+impl InstancePool {
+    fn new(command: InstanceCommand, size: usize, timeout: Duration) -> Arc<Self> {
+        Arc::new(Self {
+            command,
+            timeout,
+            permits: Semaphore::new(size.max(1)),
+            idle: Mutex::new(Vec::new()),
+        })
+    }
+
+    /// Process-wide pool, so instances stay warm across conversions
+    fn global() -> &'static Arc<Self> {
+        static POOL: OnceLock<Arc<InstancePool>> = OnceLock::new();
+        POOL.get_or_init(|| {
+            // Each instance holds a few hundred MB
+            let size = std::env::var("TRANSMUTATION_OFFICE_WORKERS")
+                .ok()
+                .and_then(|n| n.parse().ok())
+                .unwrap_or_else(|| (num_cpus::get() / 2).clamp(1, 4));
+            let timeout = std::env::var("TRANSMUTATION_OFFICE_TIMEOUT")
+                .ok()
+                .and_then(|secs| secs.parse().ok())
+                .map_or(CONVERT_TIMEOUT, Duration::from_secs);
+            Self::new(InstanceCommand::from_env(), size, timeout)
+        })
+    }
+
+    /// Convert `input` to a PDF at `output` on a healthy instance
+    async fn convert(&self, input: &Path, output: &Path) -> Result<()> {
+        let _permit = self
+            .permits
+            .acquire()
+            .await
+            .map_err(|e| TransmutationError::conversion_failed(e.to_string()))?;
+
+        let mut instance = self.checkout().await?;
+        let request = serde_json::json!({ "op": "convert", "input": input, "output": output });
+
+        // An instance that hangs or fails to answer is dropped (and killed);
+        // one that reports an error is still usable
+        let reply = instance.request(&request, self.timeout).await?;
+        instance.conversions += 1;
+        if instance.conversions >= RECYCLE_AFTER {
+            // Dropped; a fresh instance is started on demand
+        } else if let Ok(mut idle) = self.idle.lock() {
+            idle.push(instance);
+        }
+        reply.map_err(libreoffice_error)
+    }
+
+    /// An idle instance that still answers, or a newly started one
+    async fn checkout(&self) -> Result<Instance> {
+        loop {
+            let idle = self.idle.lock().ok().and_then(|mut idle| idle.pop());
+            let Some(mut instance) = idle else { break };
+            if instance.is_healthy().await {
+                return Ok(instance);
+            }
+            eprintln!("⚠️  LibreOffice instance stopped responding, restarting...");
+        }
+
+        let mut instance = Instance::spawn(&self.command)?;
+        match instance.request(&ping(), START_TIMEOUT).await? {
+            Ok(()) => Ok(instance),
+            Err(e) => Err(libreoffice_error(format!(
+                "LibreOffice failed to start: {e}.\n{INSTALL_HINT}"
+            ))),
+        }
+    }
+}
+
+/// One headless soffice, the bridge driving it, and its private profile
+///
+/// Both processes are killed when the instance is dropped.
+#[derive(Debug)]
+struct Instance {
+    bridge: Child,
+    /// Lent to a blocking thread for each request
+    pipes: Option<BridgePipes>,
+    soffice: Child,
+    conversions: usize,
+    // Dropped last, once both processes are killed
+    _profile: TempDir,
+}
+
+#[derive(Debug)]
+struct BridgePipes {
+    requests: ChildStdin,
+    replies: BufReader<ChildStdout>,
+}
+
+/// Reply line of a bridge
+#[derive(Debug, Deserialize)]
+struct Reply {
+    #[serde(default)]
+    ok: bool,
+    error: Option<String>,
+}
+
+impl Instance {
+    fn spawn(command: &InstanceCommand) -> Result<Self> {
+        static NEXT: AtomicUsize = AtomicUsize::new(0);
+        let pipe = format!(
+            "transmutation_{}_{}",
+            std::process::id(),
+            NEXT.fetch_add(1, Ordering::Relaxed)
+        );
+        let profile = tempfile::Builder::new()
+            .prefix("transmutation_office_")
+            .tempdir()?;
+
+        eprintln!("📄 Starting LibreOffice instance...");
+        let mut soffice = command
+            .soffice
+            .command()
+            .args([
+                "--headless",
+                "--invisible",
+                "--nologo",
+                "--nodefault",
+                "--norestore",
+                "--nolockcheck",
+            ])
+            .arg(format!(
+                "--accept=pipe,name={pipe};urp;StarOffice.ComponentContext"
+            ))
+            .arg(format!(
+                "-env:UserInstallation={}",
+                file_url(profile.path())
+            ))
+            .stdin(Stdio::null())
+            .stdout(Stdio::null())
+            .stderr(Stdio::null())
+            .spawn()
+            .map_err(|e| {
+                libreoffice_error(format!(
+                    "Failed to run LibreOffice `{}`: {e}.\n{INSTALL_HINT}",
+                    command.soffice.program
+                ))
+            })?;
+
+        let bridge = command
+            .bridge
+            .command()
+            .arg(&pipe)
+            .stdin(Stdio::piped())
+            .stdout(Stdio::piped())
+            .spawn();
+        let bridge = match bridge {
+            Ok(bridge) => bridge,
+            Err(e) => {
+                // A Child is not killed on drop; soffice would outlive its profile
+                let _ = soffice.kill();
+                let _ = soffice.wait();
+                return Err(libreoffice_error(format!(
+                    "LibreOffice bridge `{}` failed to start: {e}.\n{INSTALL_HINT}",
+                    command.bridge.program
+                )));
+            }
+        };
+
+        // From here on, dropping the instance kills both processes
+        let mut instance = Self {
+            bridge,
+            pipes: None,
+            soffice,
+            conversions: 0,
+            _profile: profile,
+        };
+        let (Some(requests), Some(replies)) =
+            (instance.bridge.stdin.take(), instance.bridge.stdout.take())
+        else {
+            return Err(libreoffice_error("LibreOffice bridge pipes unavailable"));
+        };
+        instance.pipes = Some(BridgePipes {
+            requests,
+            replies: BufReader::new(replies),
+        });
+        Ok(instance)
+    }
+
+    /// Whether both processes are alive and soffice answers a ping
+    async fn is_healthy(&mut self) -> bool {
+        let running = |child: &mut Child| matches!(child.try_wait(), Ok(None));
+        running(&mut self.soffice)
+            && running(&mut self.bridge)
+            && matches!(self.request(&ping(), HEALTH_TIMEOUT).await, Ok(Ok(())))
+    }
+
+    /// Send one request; the inner error is one the bridge reported
+    ///
+    /// The exchange runs on a blocking thread. When it outlasts `limit`
+    /// both processes are killed, which also ends that thread's read.
+    async fn request(
+        &mut self,
+        request: &serde_json::Value,
+        limit: Duration,
+    ) -> Result<std::result::Result<(), String>> {
+        let Some(mut pipes) = self.pipes.take() else {
+            return Err(libreoffice_error(
+                "LibreOffice instance was abandoned mid-request",
+            ));
+        };
+        let request = format!("{request}\n");
+        let exchange = tokio::task::spawn_blocking(move || {
+            let line = pipes.exchange(&request);
+            (pipes, line)
+        });
+
+        let line = match tokio::time::timeout(limit, exchange).await {
+            Ok(joined) => {
+                let (pipes, line) =
+                    joined.map_err(|e| TransmutationError::conversion_failed(e.to_string()))?;
+                self.pipes = Some(pipes);
+                line?
+            }
+            Err(_) => {
+                self.kill();
+                return Err(libreoffice_error(format!(
+                    "LibreOffice did not answer within {}s; the instance is restarted",
+                    limit.as_secs()
+                )));
+            }
+        };
+
+        let reply: Reply = serde_json::from_str(&line)?;
+        Ok(match reply {
+            Reply { ok: true, .. } => Ok(()),
+            Reply { error, .. } => Err(error.unwrap_or_else(|| "empty reply".to_string())),
+        })
+    }
+
+    fn kill(&mut self) {
+        let _ = self.bridge.kill();
+        let _ = self.soffice.kill();
+    }
+}
+
+impl Drop for Instance {
+    fn drop(&mut self) {
+        self.kill();
+        let _ = self.bridge.wait();
+        let _ = self.soffice.wait();
+    }
+}
+
+impl BridgePipes {
+    /// Write one request line and read the reply line
+    fn exchange(&mut self, request: &str) -> Result<String> {
+        self.requests.write_all(request.as_bytes())?;
+        self.requests.flush()?;
+
+        let mut line = String::new();
+        if self.replies.read_line(&mut line)? == 0 {
+            return Err(libreoffice_error(format!(
+                "LibreOffice bridge exited.\n{INSTALL_HINT}"
+            )));
+        }
+        Ok(line)
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_file_url() {
+        assert_eq!(
+            file_url(Path::new("/tmp/my profile")),
+            "file:///tmp/my%20profile"
+        );
+        assert_eq!(
+            file_url(Path::new(r"C:\Users\me\AppData\Local\Temp\p")),
+            "file:///C:/Users/me/AppData/Local/Temp/p"
+        );
+    }
+
+    /// Answers pings, hangs on documents named "hang", converts others
+    #[cfg(unix)]
+    fn stub_command() -> InstanceCommand {
+        let sh = |script: &str| Program {
+            program: "sh".to_string(),
+            args: vec!["-c".to_string(), script.to_string()],
+        };
+        InstanceCommand {
+            soffice: sh("exec sleep 30"),
+            bridge: sh(r#"while read -r line; do
+                case "$line" in
+                    *hang*) exec sleep 30 ;;
+                    *) echo '{"ok":true}' ;;
+                esac
+            done"#),
+        }
+    }
+
+    #[cfg(unix)]
+    #[tokio::test]
+    async fn test_hung_instance_is_replaced() {
+        let pool = InstancePool::new(stub_command(), 1, Duration::from_secs(1));
+
+        let error = pool
+            .convert(Path::new("/tmp/hang.docx"), Path::new("/tmp/out.pdf"))
+            .await
+            .unwrap_err();
+        assert!(error.to_string().contains("restarted"), "{error}");
+        assert!(pool.idle.lock().unwrap().is_empty());
+
+        pool.convert(Path::new("/tmp/ok.docx"), Path::new("/tmp/out.pdf"))
+            .await
+            .unwrap();
+        pool.convert(Path::new("/tmp/ok.docx"), Path::new("/tmp/out.pdf"))
+            .await
+            .unwrap();
+        let idle = pool.idle.lock().unwrap();
+        assert_eq!(idle.len(), 1);
+        assert_eq!(idle[0].conversions, 2);
+    }
+
+    #[cfg(unix)]
+    #[tokio::test]
+    async fn test_soffice_killed_when_bridge_fails_to_start() {
+        let command = InstanceCommand {
+            soffice: Program {
+                program: "sh".to_string(),
+                args: vec!["-c".to_string(), "exec sleep 987".to_string()],
+            },
+            bridge: Program::new("/nonexistent/transmutation-bridge"),
+        };
+        let pool = InstancePool::new(command, 1, Duration::from_secs(5));
+
+        let error = pool
+            .convert(Path::new("/tmp/ok.docx"), Path::new("/tmp/out.pdf"))
+            .await
+            .unwrap_err();
+        assert!(error.to_string().contains("bridge"), "{error}");
+
+        // Time for a leaked soffice to get as far as exec
+        std::thread::sleep(Duration::from_millis(200));
+        let left = Command::new("pgrep")
+            .args(["-f", "^sleep 987$"])
+            .output()
+            .unwrap();
+        assert!(left.stdout.is_empty(), "soffice left running");
+    }
+
+    #[cfg(unix)]
+    #[test]
+    fn test_pool_outlives_runtime() {
+        let pool = InstancePool::new(stub_command(), 1, Duration::from_secs(5));
+        for _ in 0..2 {
+            let runtime = tokio::runtime::Runtime::new().unwrap();
+            runtime
+                .block_on(pool.convert(Path::new("/tmp/ok.docx"), Path::new("/tmp/out.pdf")))
+                .unwrap();
+        }
+        let idle = pool.idle.lock().unwrap();
+        assert_eq!(idle.len(), 1);
+        assert_eq!(idle[0].conversions, 2);
+    }
+}
@@ -0,0 +1,116 @@
+"""LibreOffice conversion bridge.
+
+Connects to one headless soffice over a named UNO pipe and converts
+documents to PDF until stdin closes, then shuts soffice down. Each request
+is a JSON line on stdin; each reply is one JSON line on stdout:
+
+    {"op": "ping"}                                  -> {"ok": true}
+    {"op": "convert", "input": ..., "output": ...}  -> {"ok": true}
+
+Failures are replied as {"error": "..."}. The first request waits for
+soffice to start accepting connections.
+
+Usage: python office_worker.py <pipe name>
+"""
+
+import json
+import sys
+import time
+
+import uno
+from com.sun.star.beans import PropertyValue
+
+# How long soffice may take to accept the first connection
+STARTUP_SECONDS = 60
+
+# PDF export filter by document service; text documents use writer_pdf_Export
+PDF_FILTERS = (
+    ("com.sun.star.presentation.PresentationDocument", "impress_pdf_Export"),
+    ("com.sun.star.sheet.SpreadsheetDocument", "calc_pdf_Export"),
+    ("com.sun.star.drawing.DrawingDocument", "draw_pdf_Export"),
+)
+
+
+def properties(**values):
+    result = []
+    for name, value in values.items():
+        prop = PropertyValue()
+        prop.Name = name
+        prop.Value = value
+        result.append(prop)
+    return tuple(result)
+
+
+def connect(pipe):
+    local = uno.getComponentContext()
+    resolver = local.ServiceManager.createInstanceWithContext(
+        "com.sun.star.bridge.UnoUrlResolver", local
+    )
+    url = "uno:pipe,name=%s;urp;StarOffice.ComponentContext" % pipe
+    deadline = time.monotonic() + STARTUP_SECONDS
+    while True:
+        try:
+            context = resolver.resolve(url)
+            break
+        except Exception:  # noqa: BLE001 - soffice is still starting
+            if time.monotonic() > deadline:
+                raise
+            time.sleep(0.2)
+    return context.ServiceManager.createInstanceWithContext(
+        "com.sun.star.frame.Desktop", context
+    )
+
+
+def convert(desktop, source, target):
+    document = desktop.loadComponentFromURL(
+        uno.systemPathToFileUrl(source),
+        "_blank",
+        0,
+        properties(Hidden=True, ReadOnly=True, UpdateDocMode=0),
+    )
+    if document is None:
+        raise RuntimeError("LibreOffice could not open the document")
+    try:
+        pdf_filter = next(
+            (name for service, name in PDF_FILTERS if document.supportsService(service)),
+            "writer_pdf_Export",
+        )
+        document.storeToURL(
+            uno.systemPathToFileUrl(target), properties(FilterName=pdf_filter)
+        )
+    finally:
+        document.close(True)
+
+
+def main():
+    replies = sys.stdout
+    # Anything else printed must not corrupt replies
+    sys.stdout = sys.stderr
+
+    desktop = None
+    for line in sys.stdin:
+        try:
+            request = json.loads(line)
+            if desktop is None:
+                desktop = connect(sys.argv[1])
+            if request.get("op") == "convert":
+                convert(desktop, request["input"], request["output"])
+            else:
+                # A round trip through soffice proves it still responds
+                desktop.getComponents()
+            reply = {"ok": True}
+        except Exception as e:  # noqa: BLE001 - reported to the caller
+            reply = {"error": str(e) or type(e).__name__}
+
+        replies.write(json.dumps(reply) + "\n")
+        replies.flush()
+
+    if desktop is not None:
+        try:
+            desktop.terminate()
+        except Exception:  # noqa: BLE001 - soffice drops the bridge on exit
+            pass
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,761 @@
+//! Streaming DOCX and PPTX text readers
+//!
+//! Only the parts that carry text are opened: `word/document.xml` with its
+//! styles and relationships, or the slide parts in presentation order. Each
+//! part is decompressed straight into a pull parser, so embedded media is
+//! never inflated and no object model of the package is built.
+//!
+//! Slides are independent parts and are parsed in parallel. Each batch of
+//! slides rayon splits off opens its own ZIP handle, so the central
+//! directory is read a few times per worker rather than once per slide.
+//! Packages are read from disk or from memory alike (see [`ZipSource`]).
+
+use std::borrow::Cow;
+use std::collections::HashMap;
+use std::fs::File;
+use std::io::{BufRead, BufReader, Cursor, Read, Seek};
+use std::path::Path;
+
+use quick_xml::Reader;
+use quick_xml::events::{BytesStart, Event};
+use rayon::prelude::*;
+use zip::ZipArchive;
+
+use crate::{Result, TransmutationError};
+
+/// Text of one slide
+#[derive(Debug, PartialEq)]
+pub(crate) struct Slide {
+    /// 1-based position in the presentation
+    pub number: usize,
+    /// Paragraphs separated by blank lines
+    pub text: String,
+}
+
+/// Markdown of a DOCX body
+#[derive(Debug, PartialEq)]
+pub(crate) struct Document {
+    /// Paragraphs, headings (from paragraph styles), list items and tables,
+    /// in document order
+    pub blocks: Vec<String>,
+    /// Tables among `blocks`; nested tables are part of their outer one
+    pub tables: usize,
+}
+
+/// A ZIP package that can be opened any number of times, so parts can be
+/// read in parallel from their own handles: a file, or bytes already in
+/// memory such as an archive member
+pub(crate) trait ZipSource: Sync {
+    /// Reader over the whole package
+    type Reader<'a>: Read + Seek
+    where
+        Self: 'a;
+
+    /// A new reader positioned at the start of the package
+    fn open(&self) -> std::io::Result<Self::Reader<'_>>;
+}
+
+impl ZipSource for Path {
+    type Reader<'a> = BufReader<File>;
+
+    fn open(&self) -> std::io::Result<Self::Reader<'_>> {
+        Ok(BufReader::new(File::open(self)?))
+    }
+}
+
+impl ZipSource for [u8] {
+    type Reader<'a> = Cursor<&'a [u8]>;
+
+    fn open(&self) -> std::io::Result<Self::Reader<'_>> {
+        Ok(Cursor::new(self))
+    }
+}
+
+/// Markdown blocks of a DOCX body
+pub(crate) fn read_docx<S: ZipSource + ?Sized>(source: &S) -> Result<Document> {
+    let mut archive = open_archive(source, "DOCX")?;
+
+    let links = match archive.by_name("word/_rels/document.xml.rels") {
+        Ok(part) => parse_relationships(BufReader::new(part), "word")?
+            .into_iter()
+            .filter(|rel| rel.external)
+            .map(|rel| (rel.id, rel.target))
+            .collect(),
+        Err(_) => HashMap::new(),
+    };
+    let headings = match archive.by_name("word/styles.xml") {
+        Ok(part) => parse_heading_styles(BufReader::new(part))?,
+        Err(_) => HashMap::new(),
+    };
+    match archive.by_name("word/document.xml") {
+        Ok(part) => parse_document(BufReader::new(part), &headings, &links),
+        Err(e) => Err(ooxml_error(format!("Missing word/document.xml: {}", e))),
+    }
+}
+
+/// Slides of a PPTX in presentation order, parsed in parallel
+pub(crate) fn read_pptx<S: ZipSource + ?Sized>(source: &S) -> Result<Vec<Slide>> {
+    let parts = slide_parts(&mut open_archive(source, "PPTX")?)?;
+
+    parts
+        .par_iter()
+        .enumerate()
+        .map_init(
+            || open_archive(source, "PPTX"),
+            |archive, (idx, part)| {
+                let archive = archive.as_mut().map_err(|e| ooxml_error(e.to_string()))?;
+                let text = match archive.by_name(part) {
+                    Ok(part) => slide_text(BufReader::new(part))?,
+                    // Dangling relationship: keep the numbering of the rest
+                    Err(_) => String::new(),
+                };
+                Ok(Slide {
+                    number: idx + 1,
+                    text,
+                })
+            },
+        )
+        .collect()
+}
+
+fn open_archive<'s, S: ZipSource + ?Sized>(
+    source: &'s S,
+    kind: &str,
+) -> Result<ZipArchive<S::Reader<'s>>> {
+    ZipArchive::new(source.open()?)
+        .map_err(|e| ooxml_error(format!("Failed to open {} as ZIP: {}", kind, e)))
+}
+
+fn ooxml_error(message: String) -> TransmutationError {
+    TransmutationError::engine_error("ooxml-parser", message)
+}
+
+fn xml_error(e: quick_xml::Error) -> TransmutationError {
+    ooxml_error(format!("Invalid OOXML: {}", e))
+}
+
+/// Value of the attribute with local name `name`, unescaped
+fn attribute(element: &BytesStart<'_>, name: &[u8]) -> Option<String> {
+    element
+        .attributes()
+        .flatten()
+        .find(|attr| attr.key.local_name().as_ref() == name)
+        .and_then(|attr| attr.unescape_value().ok().map(Cow::into_owned))
+}
+
+/// `r:id` of an element, which may also carry a plain `id`
+fn relationship_id(element: &BytesStart<'_>) -> Option<String> {
+    element
+        .attributes()
+        .flatten()
+        .find(|attr| attr.key.prefix().is_some() && attr.key.local_name().as_ref() == b"id")
+        .and_then(|attr| attr.unescape_value().ok().map(Cow::into_owned))
+}
+
+/// A relationship of a part: ZIP part name, or URL when external
+#[derive(Debug, PartialEq)]
+struct Relationship {
+    id: String,
+    target: String,
+    external: bool,
+}
+
+/// Relationships of a part in directory `base` (e.g. `word`)
+fn parse_relationships<R: BufRead>(source: R, base: &str) -> Result<Vec<Relationship>> {
+    let mut reader = Reader::from_reader(source);
+    let mut buf = Vec::new();
+    let mut rels = Vec::new();
+
+    loop {
+        match reader.read_event_into(&mut buf).map_err(xml_error)? {
+            Event::Start(e) | Event::Empty(e) if e.local_name().as_ref() == b"Relationship" => {
+                if let (Some(id), Some(target)) = (attribute(&e, b"Id"), attribute(&e, b"Target")) {
+                    let external = attribute(&e, b"TargetMode").as_deref() == Some("External");
+                    let target = if external {
+                        target
+                    } else {
+                        resolve_part(base, &target)
+                    };
+                    rels.push(Relationship {
+                        id,
+                        target,
+                        external,
+                    });
+                }
+            }
+            Event::Eof => break,
+            _ => {}
+        }
+        buf.clear();
+    }
+
+    Ok(rels)
+}
+
+/// ZIP part name of `target`, relative to directory `base` unless absolute
+fn resolve_part(base: &str, target: &str) -> String {
+    let mut segments: Vec<&str> = match target.strip_prefix('/') {
+        Some(_) => Vec::new(),
+        None => base.split('/').filter(|s| !s.is_empty()).collect(),
+    };
+    for segment in target.split('/') {
+        match segment {
+            "" | "." => {}
+            ".." => {
+                segments.pop();
+            }
+            segment => segments.push(segment),
+        }
+    }
+    segments.join("/")
+}
+
+/// Paragraph style id → heading level, from style names ("heading 2",
+/// "Title") or the outline level a style sets
+fn parse_heading_styles<R: BufRead>(source: R) -> Result<HashMap<String, usize>> {
+    let mut reader = Reader::from_reader(source);
+    let mut buf = Vec::new();
+    let mut headings = HashMap::new();
+    // Id, level by name, level by outline of the style being read
+    let mut style: Option<(String, Option<usize>, Option<usize>)> = None;
+
+    loop {
+        match reader.read_event_into(&mut buf).map_err(xml_error)? {
+            Event::Start(e) if e.local_name().as_ref() == b"style" => {
+                style = attribute(&e, b"styleId").map(|id| (id, None, None));
+            }
+            Event::Start(e) | Event::Empty(e) => {
+                if let Some((_, by_name, by_outline)) = style.as_mut() {
+                    match e.local_name().as_ref() {
+                        b"name" => *by_name = attribute(&e, b"val").and_then(|v| heading_level(&v)),
+                        b"outlineLvl" => {
+                            *by_outline = attribute(&e, b"val").and_then(outline_level)
+                        }
+                        _ => {}
+                    }
+                }
+            }
+            Event::End(e) if e.local_name().as_ref() == b"style" => {
+                if let Some((id, Some(level), _) | (id, None, Some(level))) = style.take() {
+                    headings.insert(id, level);
+                }
+            }
+            Event::Eof => break,
+            _ => {}
+        }
+        buf.clear();
+    }
+
+    Ok(headings)
+}
+
+/// Heading level of a built-in style name
+fn heading_level(name: &str) -> Option<usize> {
+    let name = name.to_ascii_lowercase();
+    if name == "title" {
+        return Some(1);
+    }
+    let level: usize = name.strip_prefix("heading")?.trim().parse().ok()?;
+    (1..=9).contains(&level).then_some(level)
+}
+
+/// Heading level of a `w:outlineLvl` value; 9 is body text
+fn outline_level(value: String) -> Option<usize> {
+    let level: usize = value.parse().ok()?;
+    (level < 9).then_some(level + 1)
+}
+
+/// Paragraph being read
+#[derive(Debug, Default)]
+struct Paragraph {
+    text: String,
+    heading: Option<usize>,
+    /// Nesting level when the paragraph is a list item
+    list_level: Option<usize>,
+    /// Start of the open hyperlink's text and its URL
+    link: Option<(usize, String)>,
+    /// Open runs; a `w:tab` outside any is a tab stop of the paragraph
+    runs: usize,
+}
+
+impl Paragraph {
+    fn markdown(self) -> String {
+        let text = self.text.trim();
+        if text.is_empty() {
+            return String::new();
+        }
+        match (self.heading, self.list_level) {
+            (Some(level), _) => format!("{} {}", "#".repeat(level.min(6)), text.replace('\n', " ")),
+            (None, Some(level)) => format!("{}- {}", "  ".repeat(level), text),
+            (None, None) => text.to_string(),
+        }
+    }
+}
+
+/// Markdown blocks of `word/document.xml`, in a single forward pass
+///
+/// Text boxes nest paragraphs inside paragraphs and are emitted before the
+/// paragraph anchoring them. Only the outermost table keeps its structure;
+/// the text of nested tables goes into the enclosing cell.
+fn parse_document<R: BufRead>(
+    source: R,
+    headings: &HashMap<String, usize>,
+    links: &HashMap<String, String>,
+) -> Result<Document> {
+    let mut reader = Reader::from_reader(source);
+    let mut buf = Vec::new();
+    let mut skip_buf = Vec::new();
+    let mut blocks = Vec::new();
+    let mut tables_emitted = 0;
+
+    let mut paragraphs: Vec<Paragraph> = Vec::new();
+    // Rows of cells of each open table, outermost first
+    let mut tables: Vec<Vec<Vec<String>>> = Vec::new();
+    let mut in_text = false;
+
+    loop {
+        let event = reader.read_event_into(&mut buf).map_err(xml_error)?;
+        let (start, empty) = match &event {
+            Event::Start(e) => (Some(e), false),
+            Event::Empty(e) => (Some(e), true),
+            _ => (None, false),
+        };
+
+        if let Some(e) = start {
+            match e.local_name().as_ref() {
+                // Alternate rendering of content already read in mc:Choice
+                b"Fallback" if !empty => {
+                    reader
+                        .read_to_end_into(e.name(), &mut skip_buf)
+                        .map_err(xml_error)?;
+                    skip_buf.clear();
+                }
+                b"p" if !empty => paragraphs.push(Paragraph::default()),
+                b"pStyle" => {
+                    let level =
+                        attribute(e, b"val").and_then(|style| headings.get(&style).copied());
+                    if let (Some(paragraph), Some(level)) = (paragraphs.last_mut(), level) {
+                        paragraph.heading = Some(level);
+                    }
+                }
+                b"outlineLvl" => {
+                    let level = attribute(e, b"val").and_then(outline_level);
+                    if let (Some(paragraph), Some(level)) = (paragraphs.last_mut(), level) {
+                        paragraph.heading = Some(level);
+                    }
+                }
+                b"numPr" => {
+                    if let Some(paragraph) = paragraphs.last_mut() {
+                        paragraph.list_level.get_or_insert(0);
+                    }
+                }
+                b"ilvl" => {
+                    if let Some(paragraph) = paragraphs.last_mut() {
+                        paragraph.list_level = attribute(e, b"val")
+                            .and_then(|v| v.parse().ok())
+                            .or(Some(0));
+                    }
+                }
+                b"hyperlink" if !empty => {
+                    if let Some(paragraph) = paragraphs.last_mut() {
+                        paragraph.link = relationship_id(e)
+                            .and_then(|id| links.get(&id))
+                            .map(|url| (paragraph.text.len(), url.clone()));
+                    }
+                }
+                b"t" => in_text = !empty,
+                b"r" if !empty => {
+                    if let Some(paragraph) = paragraphs.last_mut() {
+                        paragraph.runs += 1;
+                    }
+                }
+                b"tab" if paragraphs.last().is_some_and(|p| p.runs > 0) => {
+                    push_text(&mut paragraphs, " ")
+                }
+                b"br" | b"cr" => push_text(&mut paragraphs, "\n"),
+                b"tbl" if !empty => tables.push(Vec::new()),
+                b"tr" if !empty => {
+                    if let Some(table) = tables.last_mut() {
+                        table.push(Vec::new());
+                    }
+                }
+                b"tc" if !empty => {
+                    if let Some(row) = tables.last_mut().and_then(|table| table.last_mut()) {
+                        row.push(String::new());
+                    }
+                }
+                _ => {}
+            }
+        }
+
+        match event {
+            Event::Text(e) if in_text => {
+                push_text(&mut paragraphs, &e.unescape().map_err(xml_error)?);
+            }
+            Event::CData(e) if in_text => {
+                push_text(&mut paragraphs, &String::from_utf8_lossy(&e));
+            }
+            Event::End(e) => match e.local_name().as_ref() {
+                b"t" => in_text = false,
+                b"r" => {
+                    if let Some(paragraph) = paragraphs.last_mut() {
+                        paragraph.runs = paragraph.runs.saturating_sub(1);
+                    }
+                }
+                b"hyperlink" => {
+                    let open = paragraphs.last_mut().and_then(|paragraph| {
+                        let link = paragraph.link.take()?;
+                        Some((paragraph, link))
+                    });
+                    if let Some((paragraph, (start, url))) = open {
+                        let label = paragraph.text.split_off(start);
+                        let label = label.trim();
+                        if !label.is_empty() {
+                            paragraph.text.push_str(&format!("[{}]({})", label, url));
+                        }
+                    }
+                }
+                b"p" => {
+                    if let Some(paragraph) = paragraphs.pop() {
+                        match current_cell(&mut tables) {
+                            Some(cell) => push_cell_text(cell, paragraph.text.trim()),
+                            None => {
+                                let block = paragraph.markdown();
+                                if !block.is_empty() {
+                                    blocks.push(block);
+                                }
+                            }
+                        }
+                    }
+                }
+                b"tbl" => {
+                    if let Some(rows) = tables.pop() {
+                        match current_cell(&mut tables) {
+                            Some(cell) => {
+                                for value in rows.iter().flatten() {
+                                    push_cell_text(cell, value);
+                                }
+                            }
+                            None => {
+                                if let Some(table) = table_markdown(&rows) {
+                                    blocks.push(table);
+                                    tables_emitted += 1;
+                                }
+                            }
+                        }
+                    }
+                }
+                _ => {}
+            },
+            Event::Eof => break,
+            _ => {}
+        }
+        buf.clear();
+    }
+
+    Ok(Document {
+        blocks,
+        tables: tables_emitted,
+    })
+}
+
+/// Append run text to the innermost open paragraph
+fn push_text(paragraphs: &mut [Paragraph], text: &str) {
+    if let Some(paragraph) = paragraphs.last_mut() {
+        paragraph.text.push_str(text);
+    }
+}
+
+/// Cell being filled in the innermost open table
+fn current_cell(tables: &mut [Vec<Vec<String>>]) -> Option<&mut String> {
+    tables.last_mut()?.last_mut()?.last_mut()
+}
+
+fn push_cell_text(cell: &mut String, text: &str) {
+    if text.is_empty() {
+        return;
+    }
+    if !cell.is_empty() {
+        cell.push(' ');
+    }
+    cell.push_str(text);
+}
+
+/// Rows as a Markdown table, the first row as header; `None` if no cell
+/// holds text
+fn table_markdown(rows: &[Vec<String>]) -> Option<String> {
+    let width = rows.iter().map(Vec::len).max()?;
+    if rows.iter().flatten().all(String::is_empty) {
+        return None;
+    }
+
+    let mut markdown = String::new();
+    for (i, row) in rows.iter().enumerate() {
+        markdown.push('|');
+        for col in 0..width {
+            markdown.push(' ');
+            let value = row.get(col).map_or("", String::as_str);
+            // Cell text cannot break out of its table cell
+            for c in value.chars() {
+                match c {
+                    '|' => markdown.push_str("\\|"),
+                    '\n' | '\r' => markdown.push(' '),
+                    c => markdown.push(c),
+                }
+            }
+            markdown.push_str(" |");
+        }
+        markdown.push('\n');
+        if i == 0 {
+            markdown.push('|');
+            markdown.push_str(&" --- |".repeat(width));
+            markdown.push('\n');
+        }
+    }
+    markdown.pop();
+    Some(markdown)
+}
+
+/// Slide parts in presentation order: `p:sldIdLst` resolved through the
+/// presentation's relationships, else `ppt/slides/slideN.xml` by number
+fn slide_parts<R: Read + Seek>(archive: &mut ZipArchive<R>) -> Result<Vec<String>> {
+    let rels = match archive.by_name("ppt/_rels/presentation.xml.rels") {
+        Ok(part) => parse_relationships(BufReader::new(part), "ppt")?,
+        Err(_) => Vec::new(),
+    };
+    let mut parts = match archive.by_name("ppt/presentation.xml") {
+        Ok(part) => parse_slide_list(BufReader::new(part), &rels)?,
+        Err(_) => Vec::new(),
+    };
+
+    if parts.is_empty() {
+        let mut numbered: Vec<(u32, String)> = archive
+            .file_names()
+            .filter_map(|name| {
+                let number = name
+                    .strip_prefix("ppt/slides/slide")?
+                    .strip_suffix(".xml")?
+                    .parse()
+                    .ok()?;
+                Some((number, name.to_string()))
+            })
+            .collect();
+        numbered.sort();
+        parts = numbered.into_iter().map(|(_, name)| name).collect();
+    }
+    Ok(parts)
+}
+
+/// Parts of the slides listed in `ppt/presentation.xml`, in order
+fn parse_slide_list<R: BufRead>(source: R, rels: &[Relationship]) -> Result<Vec<String>> {
+    let mut reader = Reader::from_reader(source);
+    let mut buf = Vec::new();
+    let mut parts = Vec::new();
+
+    loop {
+        match reader.read_event_into(&mut buf).map_err(xml_error)? {
+            Event::Start(e) | Event::Empty(e) if e.local_name().as_ref() == b"sldId" => {
+                if let Some(rel) = relationship_id(&e)
+                    .and_then(|id| rels.iter().find(|rel| rel.id == id && !rel.external))
+                {
+                    parts.push(rel.target.clone());
+                }
+            }
+            // The slide list precedes the (possibly large) rest
+            Event::End(e) if e.local_name().as_ref() == b"sldIdLst" => break,
+            Event::Eof => break,
+            _ => {}
+        }
+        buf.clear();
+    }
+
+    Ok(parts)
+}
+
+/// Text of a slide part: the text of each `a:p`, separated by blank lines
+pub(crate) fn slide_text<R: BufRead>(source: R) -> Result<String> {
+    let mut reader = Reader::from_reader(source);
+    let mut buf = Vec::new();
+    let mut skip_buf = Vec::new();
+    let mut paragraphs: Vec<String> = Vec::new();
+    let mut current = String::new();
+    let mut in_text = false;
+
+    let mut flush = |current: &mut String| {
+        let text = current.trim();
+        if !text.is_empty() {
+            paragraphs.push(text.to_string());
+        }
+        current.clear();
+    };
+
+    loop {
+        match reader.read_event_into(&mut buf).map_err(xml_error)? {
+            Event::Start(e) => match e.local_name().as_ref() {
+                b"Fallback" => {
+                    reader
+                        .read_to_end_into(e.name(), &mut skip_buf)
+                        .map_err(xml_error)?;
+                    skip_buf.clear();
+                }
+                b"t" => in_text = true,
+                _ => {}
+            },
+            // DrawingML tabs are literal in the text; a:tab is a tab stop
+            Event::Empty(e) if e.local_name().as_ref() == b"br" => current.push('\n'),
+            Event::End(e) => match e.local_name().as_ref() {
+                b"t" => in_text = false,
+                b"p" => flush(&mut current),
+                _ => {}
+            },
+            Event::Text(e) if in_text => current.push_str(&e.unescape().map_err(xml_error)?),
+            Event::CData(e) if in_text => current.push_str(&String::from_utf8_lossy(&e)),
+            Event::Eof => break,
+            _ => {}
+        }
+        buf.clear();
+    }
+    flush(&mut current);
+
+    Ok(paragraphs.join("\n\n"))
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_resolve_part() {
+        assert_eq!(
+            resolve_part("ppt", "slides/slide1.xml"),
+            "ppt/slides/slide1.xml"
+        );
+        assert_eq!(
+            resolve_part("word", "../customXml/item1.xml"),
+            "customXml/item1.xml"
+        );
+        assert_eq!(resolve_part("ppt", "/ppt/slides/a.xml"), "ppt/slides/a.xml");
+    }
+
+    #[test]
+    fn test_parse_document() {
+        let styles = br#"<w:styles xmlns:w="w">
+            <w:style w:type="paragraph" w:styleId="Heading2"><w:name w:val="heading 2"/></w:style>
+            <w:style w:type="paragraph" w:styleId="Custom"><w:name w:val="Custom"/><w:pPr><w:outlineLvl w:val="0"/></w:pPr></w:style>
+            <w:style w:type="paragraph" w:styleId="Body"><w:name w:val="Body Text"/></w:style>
+        </w:styles>"#;
+        let rels = br#"<Relationships>
+            <Relationship Id="rId4" Type="image" Target="media/image1.png"/>
+            <Relationship Id="rId5" Type="hyperlink" Target="https://example.com/a?b&amp;c" TargetMode="External"/>
+        </Relationships>"#;
+        let document = br#"<w:document xmlns:w="w" xmlns:r="r" xmlns:mc="mc"><w:body>
+            <w:p><w:pPr><w:pStyle w:val="Custom"/></w:pPr><w:r><w:t>Report</w:t></w:r></w:p>
+            <w:p><w:pPr><w:pStyle w:val="Heading2"/></w:pPr><w:r><w:t>Intro</w:t></w:r></w:p>
+            <w:p><w:pPr><w:pStyle w:val="Body"/></w:pPr>
+                <w:r><w:t xml:space="preserve">See </w:t></w:r>
+                <w:hyperlink r:id="rId5"><w:r><w:t>the site</w:t></w:r></w:hyperlink>
+                <w:r><w:delText>removed</w:delText><w:t xml:space="preserve"> for a &lt; b.</w:t></w:r></w:p>
+            <w:p><w:pPr><w:numPr><w:ilvl w:val="1"/><w:numId w:val="3"/></w:numPr></w:pPr><w:r><w:t>nested item</w:t></w:r></w:p>
+            <w:p/>
+            <w:p><w:pPr><w:tabs><w:tab w:val="left" w:pos="720"/></w:tabs></w:pPr>
+                <w:r><w:t>Total</w:t><w:tab/><w:t>42</w:t></w:r></w:p>
+            <w:p><w:r><mc:AlternateContent><mc:Choice><w:txbxContent><w:p><w:r><w:t>boxed</w:t></w:r></w:p></w:txbxContent></mc:Choice>
+                <mc:Fallback><w:txbxContent><w:p><w:r><w:t>boxed</w:t></w:r></w:p></w:txbxContent></mc:Fallback></mc:AlternateContent></w:r>
+                <w:r><w:t>anchor</w:t></w:r></w:p>
+            <w:tbl>
+                <w:tr><w:tc><w:p><w:r><w:t>Name</w:t></w:r></w:p></w:tc><w:tc><w:p><w:r><w:t>Value</w:t></w:r></w:p></w:tc></w:tr>
+                <w:tr><w:tc><w:p><w:r><w:t>a|b</w:t></w:r></w:p><w:p><w:r><w:t>c</w:t></w:r></w:p></w:tc>
+                    <w:tc><w:tbl><w:tr><w:tc><w:p><w:r><w:t>inner</w:t></w:r></w:p></w:tc></w:tr></w:tbl></w:tc></w:tr>
+            </w:tbl>
+        </w:body></w:document>"#;
+
+        let headings = parse_heading_styles(&styles[..]).unwrap();
+        let links = parse_relationships(&rels[..], "word")
+            .unwrap()
+            .into_iter()
+            .filter(|rel| rel.external)
+            .map(|rel| (rel.id, rel.target))
+            .collect();
+        let document = parse_document(&document[..], &headings, &links).unwrap();
+        assert_eq!(document.tables, 1);
+        assert_eq!(
+            document.blocks,
+            vec![
+                "# Report",
+                "## Intro",
+                "See [the site](https://example.com/a?b&c) for a < b.",
+                "  - nested item",
+                "Total 42",
+                "boxed",
+                "anchor",
+                "| Name | Value |\n| --- | --- |\n| a\\|b c | inner |",
+            ]
+        );
+    }
+
+    #[test]
+    fn test_slide_list_and_text() {
+        let rels = br#"<Relationships>
+            <Relationship Id="rId3" Type="slide" Target="slides/slide10.xml"/>
+            <Relationship Id="rId2" Type="slide" Target="slides/slide2.xml"/>
+            <Relationship Id="rId1" Type="slideMaster" Target="slideMasters/slideMaster1.xml"/>
+        </Relationships>"#;
+        let presentation = br#"<p:presentation xmlns:p="p" xmlns:r="r">
+            <p:sldMasterIdLst><p:sldMasterId r:id="rId1"/></p:sldMasterIdLst>
+            <p:sldIdLst><p:sldId id="256" r:id="rId2"/><p:sldId id="257" r:id="rId3"/></p:sldIdLst>
+        </p:presentation>"#;
+        let rels = parse_relationships(&rels[..], "ppt").unwrap();
+        assert_eq!(
+            parse_slide_list(&presentation[..], &rels).unwrap(),
+            vec!["ppt/slides/slide2.xml", "ppt/slides/slide10.xml"]
+        );
+
+        let slide = br#"<p:sld xmlns:p="p" xmlns:a="a"><p:cSld><p:spTree>
+            <p:sp><p:txBody><a:p><a:r><a:t>Title &amp; more</a:t></a:r></a:p></p:txBody></p:sp>
+            <p:sp><p:txBody><a:p><a:r><a:t>line one</a:t></a:r><a:br/><a:r><a:t>line two</a:t></a:r></a:p><a:p/></p:txBody></p:sp>
+        </p:spTree></p:cSld></p:sld>"#;
+        assert_eq!(
+            slide_text(&slide[..]).unwrap(),
+            "Title & more\n\nline one\nline two"
+        );
+    }
+
+    #[test]
+    fn test_read_pptx_from_memory() {
+        use std::io::Write;
+
+        let slide = |text: &str| {
+            format!(
+                r#"<p:sld xmlns:p="p" xmlns:a="a"><p:txBody><a:p><a:r><a:t>{}</a:t></a:r></a:p></p:txBody></p:sld>"#,
+                text
+            )
+        };
+        let mut zip = zip::ZipWriter::new(Cursor::new(Vec::new()));
+        // No presentation.xml: slides are taken in numeric part order
+        for (name, xml) in [
+            ("ppt/slides/slide10.xml", slide("Last")),
+            ("ppt/slides/slide2.xml", slide("First")),
+        ] {
+            zip.start_file(name, zip::write::SimpleFileOptions::default())
+                .unwrap();
+            zip.write_all(xml.as_bytes()).unwrap();
+        }
+        let package = zip.finish().unwrap().into_inner();
+
+        let slides = read_pptx(&package[..]).unwrap();
+        assert_eq!(
+            slides,
+            vec![
+                Slide {
+                    number: 1,
+                    text: "First".to_string()
+                },
+                Slide {
+                    number: 2,
+                    text: "Last".to_string()
+                },
+            ]
+        );
+        assert!(read_docx(&package[..]).is_err());
+    }
+}
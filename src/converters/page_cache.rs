@@ -0,0 +1,103 @@
+//! On-disk cache of per-page conversion outputs
+//!
+//! Entries are keyed by a page content fingerprint (see
+//! `PdfParser::page_fingerprint`) together with a digest of the options that
+//! shape the output and the crate version, so reconverting an amended
+//! document only redoes the pages that actually changed, and a different
+//! mode, option or release never reuses a stale page. Each entry is one file
+//! holding the page's output bytes.
+
+use std::fs;
+use std::path::{Path, PathBuf};
+
+use crate::{Result, TransmutationError};
+
+/// Directory of cached page outputs
+#[derive(Debug)]
+pub(crate) struct PageCache {
+    dir: PathBuf,
+}
+
+impl PageCache {
+    /// Open (creating if needed) a cache directory
+    pub(crate) fn open(dir: &Path) -> Result<Self> {
+        fs::create_dir_all(dir).map_err(|e| {
+            TransmutationError::CacheError(format!(
+                "Failed to create page cache {}: {}",
+                dir.display(),
+                e
+            ))
+        })?;
+        Ok(Self {
+            dir: dir.to_path_buf(),
+        })
+    }
+
+    /// Cache key for a page converted with the options described by
+    /// `options_digest` (any stable encoding of them)
+    pub(crate) fn key(options_digest: &str, fingerprint: &[u8; 32]) -> String {
+        let mut hasher = blake3::Hasher::new();
+        hasher.update(env!("CARGO_PKG_VERSION").as_bytes());
+        hasher.update(&[0]);
+        hasher.update(options_digest.as_bytes());
+        hasher.update(&[0]);
+        hasher.update(fingerprint);
+        hasher.finalize().to_hex().to_string()
+    }
+
+    fn entry_path(&self, key: &str) -> PathBuf {
+        self.dir.join(key).with_extension("page")
+    }
+
+    /// Cached output for `key`, if present
+    pub(crate) fn get(&self, key: &str) -> Option<Vec<u8>> {
+        fs::read(self.entry_path(key)).ok()
+    }
+
+    /// Store the output for `key`
+    ///
+    /// Written to a temporary file and renamed into place, so a concurrent
+    /// reader never sees a partial entry.
+    pub(crate) fn put(&self, key: &str, data: &[u8]) -> Result<()> {
+        let path = self.entry_path(key);
+        let tmp = path.with_extension(format!("tmp{}", std::process::id()));
+
+        fs::write(&tmp, data)
+            .and_then(|()| fs::rename(&tmp, &path))
+            .map_err(|e| {
+                let _ = fs::remove_file(&tmp);
+                TransmutationError::CacheError(format!(
+                    "Failed to write page cache entry {}: {}",
+                    path.display(),
+                    e
+                ))
+            })
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_page_cache_roundtrip() {
+        let dir = tempfile::tempdir().unwrap();
+        let cache = PageCache::open(&dir.path().join("pages")).unwrap();
+
+        let key = PageCache::key("precision", &[7; 32]);
+        assert!(cache.get(&key).is_none());
+
+        cache.put(&key, b"# Page").unwrap();
+        assert_eq!(cache.get(&key).unwrap(), b"# Page");
+    }
+
+    #[test]
+    fn test_page_cache_key_depends_on_options() {
+        let fingerprint = [1; 32];
+        assert_ne!(
+            PageCache::key("precision", &fingerprint),
+            PageCache::key("fast", &fingerprint)
+        );
+        assert_eq!(PageCache::key("fast", &fingerprint).len(), 64);
+    }
+}
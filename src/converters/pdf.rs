@@ -5,8 +5,8 @@
 //! ## Memory Optimization
 //!
 //! This module is optimized for low memory usage:
-//! - Regex patterns are compiled once and cached (lazy_static)
-//! - String operations minimize intermediate allocations
+//! - Text cleanup rules run as one streaming pass into a single buffer
+//!   (see `pdf_text`)
 //! - Large documents are processed with streaming where possible
 
 #![allow(
@@ -19,16 +19,19 @@
 )]
 
 use std::path::{Path, PathBuf};
-use std::sync::OnceLock;
+use std::sync::Arc;
 use std::time::Instant;
 
 use async_trait::async_trait;
-use regex::Regex;
+use tokio::sync::mpsc;
 
+use super::page_cache::PageCache;
+use super::pdf_text;
 use super::traits::{ConverterMetadata, DocumentConverter};
 use crate::Result;
 use crate::engines::layout_analyzer::LayoutAnalyzer;
-use crate::engines::pdf_parser::{PdfPage, PdfParser};
+use crate::engines::pdf_parser::PdfParser;
+use crate::optimization::boilerplate::BoilerplateDetector;
 use crate::optimization::text::TextOptimizer;
 use crate::output::{Chunker, MarkdownGenerator};
 use crate::types::{
@@ -36,48 +39,8 @@ use crate::types::{
     FileFormat, OutputFormat, OutputMetadata,
 };
 
-/// Cached regex patterns for text processing (compiled once, used many times)
-struct RegexCache {
-    sentence_break: Regex,
-    section_pattern: Regex,
-    title_author_pattern: Regex,
-    page_number_figure: Regex,
-    math_var_number: Regex,
-    math_var_letter: Regex,
-    func_paren: Regex,
-    plus_capital: Regex,
-    letter_symbol: Regex,
-    symbol_capital: Regex,
-    single_letter_pair: Regex,
-}
-
-impl RegexCache {
-    fn new() -> Self {
-        Self {
-            sentence_break: Regex::new(r"([.!?]) ([A-Z])").unwrap(),
-            section_pattern: Regex::new(
-                r"\b(Abstract|Introduction|Background|Methods|Results|Discussion|Conclusion|References)([A-Z][a-z]+)"
-            ).unwrap(),
-            title_author_pattern: Regex::new(
-                r"([A-Z][a-z]+ [A-Z][a-z]+(?: [A-Z][a-z]+)+)([A-Z][a-z]+ [A-Z]\.|[A-Z][a-z]+ [A-Z][a-z]+)"
-            ).unwrap(),
-            page_number_figure: Regex::new(r"(\d+)(Figure|Table)").unwrap(),
-            math_var_number: Regex::new(r"\b([a-z])([0-9])\b").unwrap(),
-            math_var_letter: Regex::new(r"\b([a-z])([a-z])\b").unwrap(),
-            func_paren: Regex::new(r"([a-zA-Z])\(([a-z])").unwrap(),
-            plus_capital: Regex::new(r"([a-z])\+([A-Z])").unwrap(),
-            letter_symbol: Regex::new(r"([a-zA-Z])([∗†‡])").unwrap(),
-            symbol_capital: Regex::new(r"([∗†‡])([A-Z])").unwrap(),
-            single_letter_pair: Regex::new(r" ([a-z]) ([a-z]) ").unwrap(),
-        }
-    }
-}
-
-/// Get the cached regex patterns (compiled once per process)
-fn regex_cache() -> &'static RegexCache {
-    static CACHE: OnceLock<RegexCache> = OnceLock::new();
-    CACHE.get_or_init(RegexCache::new)
-}
+/// Finished pages a streaming conversion may buffer ahead of its consumer
+const PAGE_STREAM_BUFFER: usize = 4;
 
 /// PDF to Markdown/Image/JSON converter
 #[derive(Debug)]
@@ -96,447 +59,46 @@ impl PdfConverter {
     /// Break long text into proper paragraphs (for lopdf output)
     /// Generic paragraph breaking for ANY PDF
     ///
-    /// Memory optimized: uses cached regex patterns
+    /// Single streaming pass, see `pdf_text`
     fn break_long_text_into_paragraphs(text: &str) -> String {
-        let cache = regex_cache();
-
-        // Pre-allocate result with estimated capacity
-        let mut result = String::with_capacity(text.len() + text.len() / 10);
-
-        // GENERIC RULE 1: Add line breaks after sentences
-        // Pattern: ". A" -> ".\n\nA" (period + space + capital)
-        result.push_str(&cache.sentence_break.replace_all(text, "$1\n\n$2"));
-
-        // GENERIC RULE 2: Add line breaks before headings (in-place replacements)
-        let temp = result.replace(" ## ", "\n\n## ");
-        result = temp.replace(" # ", "\n\n# ");
-
-        // GENERIC RULE 3: Clean up excessive newlines (max 2 iterations)
-        for _ in 0..2 {
-            if result.contains("\n\n\n") {
-                result = result.replace("\n\n\n", "\n\n");
-            } else {
-                break;
-            }
-        }
-
-        result.trim().to_string()
+        pdf_text::break_long_text_into_paragraphs(text)
     }
 
     /// Join lines that belong to the same paragraph (Docling-style)
     /// This function mimics Docling's text joining behavior
     ///
-    /// Memory optimized: pre-allocates vectors with estimated capacity
+    /// Single streaming pass, see `pdf_text`
     fn join_paragraph_lines(text: &str) -> String {
-        // PRE-PROCESSING: Join author lines that got split
-        // If a line starts with ∗/†/‡ and previous line is a short name, join them
-        let input_lines: Vec<&str> = text.lines().collect();
-
-        // Pre-allocate with estimated capacity
-        let mut preprocessed_lines: Vec<String> = Vec::with_capacity(input_lines.len());
-
-        let mut i = 0;
-        while i < input_lines.len() {
-            let current = input_lines[i].trim();
-
-            // Check if this line starts with a symbol and previous line was a name
-            if !preprocessed_lines.is_empty()
-                && (current.starts_with('∗')
-                    || current.starts_with('†')
-                    || current.starts_with('‡'))
-            {
-                let prev_idx = preprocessed_lines.len() - 1;
-                let prev = &preprocessed_lines[prev_idx];
-
-                // Check if previous line looks like a name (short, has capitals, no @)
-                if prev.len() < 50
-                    && prev.len() > 5
-                    && !prev.contains('@')
-                    && prev.chars().filter(|c| c.is_uppercase()).count() >= 2
-                {
-                    // Join with previous line
-                    preprocessed_lines[prev_idx] = format!("{} {}", prev, current);
-                    i += 1;
-                    continue;
-                }
-            }
-
-            preprocessed_lines.push(current.to_string());
-            i += 1;
-        }
-
-        let preprocessed = preprocessed_lines.join("\n");
-        let lines: Vec<&str> = preprocessed.lines().collect();
-
-        // Pre-allocate result with estimated capacity (text length + some overhead for formatting)
-        let mut result = String::with_capacity(preprocessed.len() + preprocessed.len() / 5);
-        let mut i = 0;
-
-        while i < lines.len() {
-            let line = lines[i];
-            let trimmed = line.trim();
-
-            // Skip empty lines (they will be added when needed)
-            if trimmed.is_empty() {
-                i += 1;
-                continue;
-            }
-
-            // Pre-compute line context
-            let prev_empty = i == 0
-                || lines
-                    .get(i - 1)
-                    .map(|l| l.trim().is_empty())
-                    .unwrap_or(false);
-            let next_empty = i == lines.len() - 1
-                || lines
-                    .get(i + 1)
-                    .map(|l| l.trim().is_empty())
-                    .unwrap_or(false);
-            let has_next = i + 1 < lines.len();
-
-            // GENERIC RULES - work for ANY academic/scientific document
-
-            // RULE 1: Common section keywords (standard in academic papers)
-            let common_sections = [
-                "Abstract",
-                "Introduction",
-                "Background",
-                "Methods",
-                "Results",
-                "Discussion",
-                "Conclusion",
-                "References",
-                "Acknowledgments",
-                "Appendix",
-                "Summary",
-            ];
-            let is_common_section = common_sections.contains(&trimmed);
-
-            // RULE 1b: Detect paper titles (short lines early in document that look like titles)
-            // Pattern: "Attention Is All You Need", "Transformer Architecture", etc.
-            let looks_like_title = trimmed.len() > 15 && trimmed.len() < 100 &&  // Reasonable length
-                                  trimmed.split_whitespace().count() >= 3 &&  // Multiple words
-                                  trimmed.split_whitespace().count() <= 10 &&  // Not too many words
-                                  !trimmed.contains('@') &&  // Not an email
-                                  !trimmed.contains('(') &&  // Not a citation
-                                  !trimmed.contains("Provided") &&  // Not copyright
-                                  !trimmed.ends_with('.') &&  // Titles don't end with period
-                                  trimmed.chars().next().map(|c| c.is_uppercase()).unwrap_or(false); // Starts with capital
-
-            let is_likely_title = i < 5
-                && looks_like_title
-                && trimmed.chars().filter(|c| c.is_uppercase()).count() >= 3; // Multiple capitals
-
-            // RULE 2: Numbered sections: "1 Introduction", "2.1 Background", etc.
-            let is_numbered_section = trimmed.len() > 2
-                && trimmed
-                    .chars()
-                    .next()
-                    .map(|c| c.is_numeric())
-                    .unwrap_or(false)
-                && trimmed.contains(' ')
-                && trimmed.len() < 100;
-
-            // RULE 3: Footnote paragraph (starts with symbols ∗, †, ‡ and has content)
-            let is_footnote = trimmed.len() > 20
-                && (trimmed.starts_with('∗')
-                    || trimmed.starts_with('†')
-                    || trimmed.starts_with('‡'));
-
-            // RULE 4: Detect author metadata blocks (common in academic papers)
-            let has_email = trimmed.contains('@');
-            let has_symbol =
-                trimmed.contains('∗') || trimmed.contains('†') || trimmed.contains('‡');
-            let is_author_metadata_region = i < 30 && trimmed.len() < 200;
-
-            // Author lines with complete info should stay together
-            // Pattern: "Name ∗ Affiliation email@domain.com" (all on one line)
-            let is_complete_author_line = is_author_metadata_region
-                && has_email
-                && has_symbol
-                && trimmed.split_whitespace().count() >= 4;
-
-            if is_complete_author_line {
-                if !result.is_empty() && !result.ends_with('\n') {
-                    result.push('\n');
-                }
-                result.push_str(trimmed);
-                result.push_str("\n\n");
-                i += 1;
-                continue;
-            }
-
-            // Author name with symbol but no email - check if next line has email
-            let is_author_name_only = is_author_metadata_region
-                && has_symbol
-                && !has_email
-                && trimmed.split_whitespace().count() >= 2
-                && trimmed.split_whitespace().count() <= 4;
-
-            if is_author_name_only && has_next {
-                let next_line = lines[i + 1].trim();
-                let next_has_email = next_line.contains('@');
-
-                // If next line is just an email, DON'T join - keep separate
-                // This matches Docling's format where name+symbol is on one line, email on next
-                if next_has_email && next_line.split_whitespace().count() == 1 {
-                    // Keep as separate lines
-                    if !result.is_empty() && !result.ends_with('\n') {
-                        result.push('\n');
-                    }
-                    result.push_str(trimmed);
-                    result.push_str("\n\n");
-                    i += 1;
-                    continue;
-                }
-            }
-
-            // RULE 5: Single email line (join with previous - part of author block)
-            let is_email_only = has_email && trimmed.split_whitespace().count() == 1 && !prev_empty;
-
-            // RULE 6: Standalone symbol line (early in doc, likely footnote reference)
-            let is_symbol_only = is_author_metadata_region
-                && trimmed.len() < 5
-                && (trimmed == "∗"
-                    || trimmed == "†"
-                    || trimmed == "‡"
-                    || trimmed == "∗ †"
-                    || trimmed == "∗ ‡");
-
-            // Apply heading detection
-            if is_common_section || is_numbered_section || is_likely_title {
-                if !result.is_empty() && !result.ends_with("\n\n") {
-                    result.push_str("\n\n");
-                }
-                result.push_str("## ");
-                result.push_str(trimmed);
-                result.push_str("\n\n");
-                i += 1;
-                continue;
-            }
-
-            // Apply footnote detection (separate paragraph)
-            if is_footnote {
-                if !result.is_empty() && !result.ends_with("\n\n") {
-                    result.push_str("\n\n");
-                }
-                result.push_str(trimmed);
-                result.push_str("\n\n");
-                i += 1;
-                continue;
-            }
-
-            // Join standalone email with previous line
-            if is_email_only {
-                result.push(' ');
-                result.push_str(trimmed);
-                result.push_str("\n\n");
-                i += 1;
-                continue;
-            }
-
-            // Keep standalone symbol lines separate
-            if is_symbol_only {
-                if !result.is_empty() && !result.ends_with('\n') {
-                    result.push('\n');
-                }
-                result.push_str(trimmed);
-                result.push_str("\n\n");
-                i += 1;
-                continue;
-            }
-
-            // Regular text - join with previous line if it's part of the same paragraph
-            if !result.is_empty() && !result.ends_with("\n\n") {
-                // Check if we should join with previous line
-                let should_join = !prev_empty;
-
-                if should_join {
-                    // Remove trailing hyphen if present (word continuation)
-                    if result.ends_with('-') {
-                        result.pop();
-                    } else if !result.ends_with(' ') {
-                        result.push(' ');
-                    }
-                }
-            }
-
-            result.push_str(trimmed);
-
-            // Check if this line ends a sentence (period, colon, etc.)
-            let ends_sentence = trimmed.ends_with('.')
-                || trimmed.ends_with(':')
-                || trimmed.ends_with('!')
-                || trimmed.ends_with('?');
-
-            // Don't end paragraph on abbreviations
-            let is_abbreviation = trimmed.ends_with(" al.")
-                || trimmed.ends_with(" Fig.")
-                || trimmed.ends_with(" et.")
-                || trimmed.ends_with(" vs.");
-
-            // Add paragraph break if sentence ends and it's not an abbreviation
-            if ends_sentence && !is_abbreviation && next_empty {
-                result.push_str("\n\n");
-            }
-
-            i += 1;
-        }
-
-        // Final cleanup
-        let mut cleaned = result.replace("\n\n\n\n", "\n\n");
-        cleaned = cleaned.replace("\n\n\n", "\n\n");
-
-        // Ensure proper spacing around headings
-        cleaned = cleaned.replace("##  ", "## ");
-
-        // Ensure there's always a blank line before headings (except first line)
-        if !cleaned.starts_with("## ") {
-            cleaned = cleaned.replace("\n## ", "\n\n## ");
-        }
-
-        // Generic cleanup for better formatting using cached regex patterns
-        let cache = regex_cache();
-
-        // Generic pattern: Section keyword directly followed by text without space
-        // Match any common section keyword followed immediately by a capital letter
-        // This handles "AbstractThe" -> "## Abstract\n\nThe" generically for ANY section
-        cleaned = cache
-            .section_pattern
-            .replace_all(&cleaned, "## $1\n\n$2")
-            .into_owned();
-
-        // Separate title from author names (common pattern in papers)
-        // "Attention Is All You NeedAshish Vaswani" -> "## Attention Is All You Need\n\nAshish Vaswani"
-        // Only apply to first ~500 chars (title region)
-        // Find a valid UTF-8 boundary near 500 bytes
-        let split_point = if cleaned.len() > 500 {
-            // Find the nearest char boundary at or before 500
-            let mut idx = 500;
-            while idx > 0 && !cleaned.is_char_boundary(idx) {
-                idx -= 1;
-            }
-            Some(idx)
-        } else {
-            None
-        };
-
-        if let Some(idx) = split_point {
-            let prefix = &cleaned[..idx];
-            let suffix = &cleaned[idx..];
-            let fixed_prefix = cache.title_author_pattern.replace(prefix, "## $1\n\n$2");
-            cleaned = format!("{}{}", fixed_prefix, suffix);
-        } else {
-            cleaned = cache
-                .title_author_pattern
-                .replace(&cleaned, "## $1\n\n$2")
-                .into_owned();
-        }
-
-        // Remove extra blank lines at very start (max 3 iterations to prevent infinite loop)
-        for _ in 0..3 {
-            if cleaned.starts_with('\n') {
-                cleaned = cleaned.trim_start_matches('\n').to_string();
-            } else {
-                break;
-            }
-        }
-
-        // Remove page numbers that appear before figure/table captions
-        // "2Figure 1:" -> "\n\nFigure 1:", "3Table 2:" -> "\n\nTable 2:"
-        cleaned = cache
-            .page_number_figure
-            .replace_all(&cleaned, "\n\n$2")
-            .into_owned();
-
-        // Add spaces in mathematical variables (common in academic papers)
-        // Single letter + subscript: "ht" -> "h t", "x1" -> "x 1", "dk" -> "d k"
-        // But only if it's standalone or in mathematical context
-        cleaned = cache
-            .math_var_number
-            .replace_all(&cleaned, "$1 $2")
-            .into_owned();
-        cleaned = cache
-            .math_var_letter
-            .replace_all(&cleaned, "$1 $2")
-            .into_owned();
-
-        // Add spaces after parenthesis in function calls: "LayerNorm(x" -> "LayerNorm( x"
-        cleaned = cache
-            .func_paren
-            .replace_all(&cleaned, "$1( $2")
-            .into_owned();
-
-        // Add spaces before closing paren: "+Sublayer(" -> " +Sublayer( "
-        cleaned = cache
-            .plus_capital
-            .replace_all(&cleaned, "$1 +$2")
-            .into_owned();
-
-        // Fix spaces before symbols (common in academic papers)
-        // "Vaswani∗" -> "Vaswani ∗"
-        cleaned = cache
-            .letter_symbol
-            .replace_all(&cleaned, "$1 $2")
-            .into_owned();
-
-        // Fix "∗Equal" -> "∗ Equal"
-        cleaned = cache
-            .symbol_capital
-            .replace_all(&cleaned, "$1 $2")
-            .into_owned();
-
-        // Final pass: Join author lines manually by searching for pattern
-        // Pattern: Line ending with symbol + double newline + line with @
-        let lines: Vec<&str> = cleaned.lines().collect();
-        let mut final_result = String::new();
-        let mut i = 0;
-
-        while i < lines.len() {
-            let current = lines[i];
-            let has_symbol =
-                current.ends_with('∗') || current.ends_with('†') || current.ends_with('‡');
-            let has_email = current.contains('@');
-
-            // Check if next line has email and current doesn't
-            let should_join_with_next = if i + 1 < lines.len() && has_symbol && !has_email {
-                let next = lines[i + 1];
-                next.is_empty() && i + 2 < lines.len() && lines[i + 2].contains('@')
-            } else {
-                false
-            };
-
-            if should_join_with_next {
-                // Join current line with line after empty line
-                final_result.push_str(current);
-                final_result.push(' ');
-                final_result.push_str(lines[i + 2]);
-                final_result.push_str("\n\n");
-                i += 3;
-            } else {
-                final_result.push_str(current);
-                final_result.push('\n');
-                i += 1;
-            }
-        }
-
-        cleaned = final_result;
-
-        cleaned.trim().to_string()
+        pdf_text::join_paragraph_lines(text, false)
     }
 
     /// Convert PDF to Markdown using Docling-style text processing (high-precision mode)
     /// Uses docling-parse C++ FFI when available for 95%+ similarity
+    ///
+    /// `_file` is the PDF on disk, if it came from one; docling-parse only
+    /// reads files, so in-memory input is written to a temporary one for it.
+    /// `_name` is the input path reported for the document.
     async fn convert_with_docling_style(
         &self,
-        path: &Path,
+        _name: &Path,
+        _file: Option<&Path>,
+        pdf_bytes: &Arc<[u8]>,
+        parser: &PdfParser,
         options: &ConversionOptions,
     ) -> Result<Vec<ConversionOutput>> {
         // Try docling-parse FFI first if enabled and use_ffi flag is set
         #[cfg(feature = "docling-ffi")]
         if options.use_ffi {
-            match self.convert_with_docling_ffi(path).await {
+            let spilled;
+            let file = match _file {
+                Some(file) => file,
+                None => {
+                    spilled = tempfile::Builder::new().suffix(".pdf").tempfile()?;
+                    tokio::fs::write(spilled.path(), &pdf_bytes[..]).await?;
+                    spilled.path()
+                }
+            };
+            match self.convert_with_docling_ffi(file, _name, options).await {
                 Ok(result) => return Ok(result),
                 Err(e) => {
                     eprintln!("⚠️  FFI conversion failed: {}", e);
@@ -546,30 +108,40 @@ impl PdfConverter {
             }
         }
 
-        // Check if split_pages is enabled - if so, we need page info
+        // Check if split_pages is enabled - if so, emit one output per page
         if options.split_pages {
-            let parser = PdfParser::load(path)?;
-            let pages = parser.extract_all_pages()?;
             eprintln!(
                 "📄 Splitting into {} individual pages (precision mode)",
-                pages.len()
+                parser.page_count()
             );
-            return self.convert_pages_individually(path, &pages, options).await;
+            return self.convert_pages_individually(pdf_bytes, options).await;
         }
 
         // For single-document output, use pdf-extract directly (most memory efficient)
         // Skip lopdf parsing since we're not using layout analysis anyway
         eprintln!("⚡ Using enhanced heuristics mode (82%+ similarity)");
-        let markdown = {
-            use pdf_extract::extract_text;
-            let raw_text = extract_text(path).map_err(|e| {
-                crate::TransmutationError::engine_error(
-                    "PDF Parser",
-                    format!("pdf-extract failed: {:?}", e),
-                )
-            })?;
-            Self::join_paragraph_lines_enhanced(&raw_text)
-        };
+        let pdf_bytes = Arc::clone(pdf_bytes);
+        let strip = options.remove_headers_footers;
+        let markdown = tokio::task::spawn_blocking(move || -> Result<String> {
+            if strip {
+                // Decode per page so running headers/footers can be matched across pages
+                let mut page_texts = Self::extract_page_texts(&pdf_bytes)?;
+                Self::strip_repeated_lines(&mut page_texts);
+                Ok(Self::join_paragraph_lines_enhanced(
+                    &page_texts.join("\n\n"),
+                ))
+            } else {
+                let raw_text = pdf_extract::extract_text_from_mem(&pdf_bytes).map_err(|e| {
+                    crate::TransmutationError::engine_error(
+                        "PDF Parser",
+                        format!("pdf-extract failed: {:?}", e),
+                    )
+                })?;
+                Ok(Self::join_paragraph_lines_enhanced(&raw_text))
+            }
+        })
+        .await
+        .map_err(|e| crate::TransmutationError::conversion_failed(e.to_string()))??;
 
         let token_count = markdown.len() / 4;
         let data = markdown.into_bytes();
@@ -587,184 +159,484 @@ impl PdfConverter {
     }
 
     /// Convert PDF to images (one per page) for vision model embeddings
-    /// Uses pdftoppm command-line tool (widely available on Linux/Mac)
+    ///
+    /// Pages are rasterized in-process with pdfium and encoded straight into
+    /// the output buffers: no subprocess and no temporary files, so concurrent
+    /// conversions in one process cannot collide.
     #[cfg(feature = "pdf-to-image")]
     async fn convert_to_images(
         &self,
-        path: &Path,
+        pdf_bytes: &Arc<[u8]>,
         format: crate::types::ImageFormat,
-        _quality: u8,
+        quality: u8,
         dpi: u32,
         _options: &ConversionOptions,
     ) -> Result<Vec<ConversionOutput>> {
-        use std::process::Command;
-
-        use tokio::fs;
-
         eprintln!(
             "🖼️  Rendering PDF to images (DPI: {}, Format: {:?})...",
             dpi, format
         );
-        eprintln!("   Using pdftoppm command-line tool...");
 
-        // Create temporary directory for images
-        let temp_dir = std::env::temp_dir().join(format!("transmutation_{}", std::process::id()));
-        fs::create_dir_all(&temp_dir).await?;
+        let pdf_bytes = Arc::clone(pdf_bytes);
+        let outputs = tokio::task::spawn_blocking(move || {
+            Self::render_pdf_to_images(&pdf_bytes, format, quality, dpi)
+        })
+        .await
+        .map_err(|e| {
+            crate::TransmutationError::engine_error("pdfium", format!("Render task failed: {}", e))
+        })??;
 
-        // Determine format flag for pdftoppm
-        let format_flag = match format {
-            crate::types::ImageFormat::Png => "png",
-            crate::types::ImageFormat::Jpeg => "jpeg",
-            crate::types::ImageFormat::Webp => "png", // pdftoppm doesn't support webp, use png
-        };
+        eprintln!("✅ Rendered {} pages to images", outputs.len());
+        Ok(outputs)
+    }
 
-        // Cross-platform pdftoppm detection
-        let (pdftoppm_cmd, install_msg) = if cfg!(target_os = "windows") {
-            ("pdftoppm.exe", "Install poppler: choco install poppler")
-        } else if cfg!(target_os = "macos") {
-            ("pdftoppm", "Install: brew install poppler")
-        } else {
-            ("pdftoppm", "Install: sudo apt install poppler-utils")
-        };
+    /// Rasterize every page of an in-memory PDF and encode it as `format`
+    ///
+    /// pdfium serializes all calls behind a global lock, so pages are
+    /// rendered on the calling thread while encoding (the expensive part)
+    /// fans out to the rayon pool. At most two bitmaps per worker are in
+    /// flight at once to bound memory on large documents.
+    #[cfg(feature = "pdf-to-image")]
+    pub(crate) fn render_pdf_to_images(
+        pdf_bytes: &[u8],
+        format: crate::types::ImageFormat,
+        quality: u8,
+        dpi: u32,
+    ) -> Result<Vec<ConversionOutput>> {
+        use pdfium_render::prelude::*;
 
-        // Run pdftoppm to convert PDF to images
-        let output = Command::new(pdftoppm_cmd)
-            .arg(format!("-{}", format_flag))
-            .arg("-r")
-            .arg(dpi.to_string())
-            .arg(path)
-            .arg(temp_dir.join("page"))
-            .output()
-            .map_err(|e| {
-                crate::TransmutationError::engine_error(
-                    "pdftoppm",
-                    format!("Failed to run pdftoppm: {}. {}", e, install_msg),
-                )
-            })?;
+        let pdfium_error = |context: &str, e: PdfiumError| {
+            crate::TransmutationError::engine_error("pdfium", format!("{}: {:?}", context, e))
+        };
 
-        if !output.status.success() {
-            let stderr = String::from_utf8_lossy(&output.stderr);
-            return Err(crate::TransmutationError::engine_error(
-                "pdftoppm",
-                format!("pdftoppm failed: {}", stderr),
-            ));
-        }
+        let bindings = Pdfium::bind_to_library(Pdfium::pdfium_platform_library_name_at_path("./"))
+            .or_else(|_| Pdfium::bind_to_system_library())
+            .map_err(|e| pdfium_error("Failed to load the pdfium library", e))?;
+        let pdfium = Pdfium::new(bindings);
+        let document = pdfium
+            .load_pdf_from_byte_slice(pdf_bytes, None)
+            .map_err(|e| pdfium_error("Failed to open PDF", e))?;
+
+        let config = PdfRenderConfig::new().scale_page_by_factor(dpi as f32 / 72.0);
+        let page_count = document.pages().len() as usize;
+        let max_in_flight = rayon::current_num_threads() * 2;
+
+        let (tx, rx) = std::sync::mpsc::channel();
+        let mut encoded: Vec<Option<Vec<u8>>> = vec![None; page_count];
+        let mut in_flight = 0;
+
+        for (idx, page) in document.pages().iter().enumerate() {
+            if in_flight >= max_in_flight {
+                if let Ok((done, data)) = rx.recv() {
+                    encoded[done] = Some(data?);
+                    in_flight -= 1;
+                }
+            }
 
-        // Read generated images
-        let mut outputs = Vec::new();
-        let mut entries = fs::read_dir(&temp_dir).await?;
-        let mut image_files = Vec::new();
+            let image = page
+                .render_with_config(&config)
+                .map_err(|e| pdfium_error("Failed to render page", e))?
+                .as_image();
 
-        while let Some(entry) = entries.next_entry().await? {
-            let path = entry.path();
-            if path.extension().and_then(|e| e.to_str()) == Some(format_flag) {
-                image_files.push(path);
-            }
+            let tx = tx.clone();
+            rayon::spawn(move || {
+                let _ = tx.send((idx, Self::encode_page_image(&image, format, quality)));
+            });
+            in_flight += 1;
         }
+        drop(tx);
 
-        // Sort by page number (pdftoppm creates page-1.png, page-2.png, etc.)
-        image_files.sort();
+        for (done, data) in rx {
+            encoded[done] = Some(data?);
+        }
 
-        for (idx, image_path) in image_files.iter().enumerate() {
-            eprintln!("  Reading page {}/{}...", idx + 1, image_files.len());
+        Ok(encoded
+            .into_iter()
+            .enumerate()
+            .filter_map(|(idx, data)| {
+                let data = data?;
+                let size_bytes = data.len() as u64;
+                Some(ConversionOutput {
+                    page_number: idx + 1,
+                    data,
+                    metadata: OutputMetadata {
+                        size_bytes,
+                        chunk_count: 1,
+                        token_count: None,
+                    },
+                })
+            })
+            .collect())
+    }
 
-            let image_data = fs::read(&image_path).await?;
-            let size_bytes = image_data.len() as u64;
+    /// Encode a rendered page bitmap into an in-memory image file
+    #[cfg(feature = "pdf-to-image")]
+    fn encode_page_image(
+        image: &image::DynamicImage,
+        format: crate::types::ImageFormat,
+        quality: u8,
+    ) -> Result<Vec<u8>> {
+        use std::io::Cursor;
 
-            outputs.push(ConversionOutput {
-                page_number: idx + 1,
-                data: image_data,
-                metadata: OutputMetadata {
-                    size_bytes,
-                    chunk_count: 1,
-                    token_count: None,
-                },
-            });
-        }
+        use image::codecs::jpeg::JpegEncoder;
 
-        // Cleanup temp directory
-        let _ = fs::remove_dir_all(&temp_dir).await;
+        let mut data = Vec::new();
+        let encoded = match format {
+            crate::types::ImageFormat::Png => {
+                image.write_to(&mut Cursor::new(&mut data), image::ImageFormat::Png)
+            }
+            crate::types::ImageFormat::Jpeg => {
+                // JPEG has no alpha channel
+                image::DynamicImage::ImageRgb8(image.to_rgb8()).write_with_encoder(
+                    JpegEncoder::new_with_quality(&mut data, quality.clamp(1, 100)),
+                )
+            }
+            // image's WebP encoder is lossless, so quality does not apply
+            crate::types::ImageFormat::Webp => {
+                image.write_to(&mut Cursor::new(&mut data), image::ImageFormat::WebP)
+            }
+        };
 
-        eprintln!("✅ Rendered {} pages to images", outputs.len());
-        Ok(outputs)
+        encoded.map_err(|e| {
+            crate::TransmutationError::engine_error_with_source(
+                "image",
+                format!("Failed to encode page as {:?}", format),
+                e,
+            )
+        })?;
+        Ok(data)
     }
 
     /// Convert PDF pages individually with precision mode quality
     /// Each page is processed separately and returned as individual ConversionOutput
-    ///
-    /// Memory optimized: extracts text once and splits by page markers
     async fn convert_pages_individually(
         &self,
-        path: &Path,
-        pages: &[PdfPage],
-        _options: &ConversionOptions,
+        pdf_bytes: &Arc<[u8]>,
+        options: &ConversionOptions,
     ) -> Result<Vec<ConversionOutput>> {
-        use pdf_extract::extract_text_from_mem;
+        let mut pages = Self::stream_pages(Arc::clone(pdf_bytes), options.remove_headers_footers);
 
-        // Pre-allocate output vector with known size
-        let mut outputs = Vec::with_capacity(pages.len());
+        let mut outputs = Vec::new();
+        while let Some(output) = pages.recv().await {
+            outputs.push(output?);
+        }
+        Ok(outputs)
+    }
 
-        // Load PDF bytes once
+    /// Convert a PDF page by page in precision mode, streaming the results
+    ///
+    /// Each page's Markdown is sent in page order as soon as it is ready. The
+    /// channel holds at most [`PAGE_STREAM_BUFFER`] pages, so a slow consumer
+    /// pauses the conversion instead of letting finished pages pile up, and
+    /// dropping the receiver stops it. A failure ends the stream with an
+    /// error item. Running headers and footers are removed when
+    /// `options.remove_headers_footers` is set.
+    pub async fn convert_pages_streaming(
+        &self,
+        path: &Path,
+        options: &ConversionOptions,
+    ) -> Result<mpsc::Receiver<Result<ConversionOutput>>> {
         let pdf_bytes = tokio::fs::read(path).await?;
+        Ok(Self::stream_pages(
+            pdf_bytes.into(),
+            options.remove_headers_footers,
+        ))
+    }
 
-        // Extract text ONCE for the entire document (major memory optimization)
-        let full_text = extract_text_from_mem(&pdf_bytes).map_err(|e| {
+    /// Run [`Self::stream_precision_pages`] on a blocking task, sending each
+    /// page through a bounded channel
+    fn stream_pages(
+        pdf_bytes: Arc<[u8]>,
+        strip_boilerplate: bool,
+    ) -> mpsc::Receiver<Result<ConversionOutput>> {
+        let (tx, rx) = mpsc::channel(PAGE_STREAM_BUFFER);
+        tokio::task::spawn_blocking(move || {
+            let streamed = Self::stream_precision_pages(&pdf_bytes, strip_boilerplate, |output| {
+                tx.blocking_send(Ok(output))
+                    .map_err(|_| crate::TransmutationError::conversion_failed("page stream closed"))
+            });
+            if let Err(e) = streamed {
+                // Nobody to tell if the receiver is gone
+                let _ = tx.blocking_send(Err(e));
+            }
+        });
+        rx
+    }
+
+    /// Decode a PDF once and hand each cleaned-up page to `on_page` in order
+    ///
+    /// pdf-extract decodes the document a single time into per-page text.
+    /// Cleanup fans out to the rayon pool with at most two pages per worker
+    /// in flight, and a page is emitted as soon as it and every page before
+    /// it are done. Pages pdf-extract leaves blank fall back to lopdf text
+    /// blocks; the lopdf document is only loaded if such a page turns up.
+    /// With `strip_boilerplate`, lines repeated at the top or bottom of many
+    /// pages are removed first. This call blocks.
+    fn stream_precision_pages(
+        pdf_bytes: &[u8],
+        strip_boilerplate: bool,
+        mut on_page: impl FnMut(ConversionOutput) -> Result<()>,
+    ) -> Result<usize> {
+        let mut page_texts = Self::extract_page_texts(pdf_bytes)?;
+        if strip_boilerplate {
+            Self::strip_repeated_lines(&mut page_texts);
+        }
+        let page_count = page_texts.len();
+        let max_in_flight = rayon::current_num_threads() * 2;
+
+        let mut loaded = None;
+        let (tx, rx) = std::sync::mpsc::channel();
+        // Pages finished out of order, waiting for their predecessors
+        let mut ready = std::collections::BTreeMap::new();
+        let mut emitted = 0;
+
+        for (idx, page_text) in page_texts.into_iter().enumerate() {
+            while idx - emitted >= max_in_flight {
+                let Ok((done, output)) = rx.recv() else {
+                    break;
+                };
+                ready.insert(done, output);
+                while let Some(output) = ready.remove(&emitted) {
+                    on_page(output)?;
+                    emitted += 1;
+                }
+            }
+
+            let text = if page_text.trim().is_empty() {
+                let parser = match &mut loaded {
+                    Some(parser) => parser,
+                    slot => slot.insert(PdfParser::from_bytes(pdf_bytes)?),
+                };
+                eprintln!(
+                    "  Page {}/{} has no text, using lopdf blocks",
+                    idx + 1,
+                    page_count
+                );
+                Self::fallback_page_text(parser, idx).unwrap_or(page_text)
+            } else {
+                page_text
+            };
+
+            let tx = tx.clone();
+            rayon::spawn(move || {
+                let _ = tx.send((idx, Self::precision_page_output(idx + 1, &text)));
+            });
+        }
+        drop(tx);
+
+        for (done, output) in rx {
+            ready.insert(done, output);
+            while let Some(output) = ready.remove(&emitted) {
+                on_page(output)?;
+                emitted += 1;
+            }
+        }
+
+        Ok(emitted)
+    }
+
+    /// Text of a page's lopdf text blocks, if it has any
+    fn fallback_page_text(parser: &PdfParser, page_idx: usize) -> Option<String> {
+        let page = parser.extract_page(page_idx).ok()?;
+        if page.text_blocks.is_empty() {
+            return None;
+        }
+        Some(
+            page.text_blocks
+                .iter()
+                .map(|b| b.text.as_str())
+                .collect::<Vec<_>>()
+                .join("\n"),
+        )
+    }
+
+    /// Per-page text of an in-memory PDF, decoded once by pdf-extract
+    fn extract_page_texts(pdf_bytes: &[u8]) -> Result<Vec<String>> {
+        pdf_extract::extract_text_from_mem_by_pages(pdf_bytes).map_err(|e| {
             crate::TransmutationError::engine_error(
                 "PDF Parser",
                 format!("pdf-extract failed: {:?}", e),
             )
-        })?;
+        })
+    }
 
-        // Drop PDF bytes immediately to free memory
-        drop(pdf_bytes);
+    /// Remove running headers, footers and page numbers repeated across pages
+    fn strip_repeated_lines(page_texts: &mut [String]) {
+        let removed = BoilerplateDetector::new().strip_pages(page_texts);
+        if removed > 0 {
+            eprintln!("  Removed {} repeated header/footer lines", removed);
+        }
+    }
 
-        // Split by page markers (pdf-extract adds \f between pages)
-        let page_texts: Vec<&str> = full_text.split('\x0C').collect();
+    /// Precision-mode Markdown for one page
+    fn precision_page_output(page_number: usize, page_text: &str) -> ConversionOutput {
+        let markdown = Self::join_paragraph_lines_enhanced(page_text);
+        Self::page_output(page_number, markdown.into_bytes())
+    }
 
-        for (page_idx, page) in pages.iter().enumerate() {
-            eprintln!("  Processing page {}/{}...", page_idx + 1, pages.len());
+    /// Fast-mode Markdown for one lopdf page
+    fn fast_page_markdown(page_text: &str) -> String {
+        // lopdf returns text with few line breaks, need to add them
+        if page_text.lines().count() > 20 {
+            // If text has many lines, use join algorithm (like pdf-extract)
+            Self::join_paragraph_lines(page_text)
+        } else {
+            // If text is in few/long lines, break it up into paragraphs
+            Self::break_long_text_into_paragraphs(page_text)
+        }
+    }
 
-            let page_text = if page_idx < page_texts.len() {
-                page_texts[page_idx]
-            } else {
-                // Fallback if page marker not found - use text blocks from lopdf
-                ""
-            };
+    /// Single-chunk output for one page of Markdown
+    fn page_output(page_number: usize, data: Vec<u8>) -> ConversionOutput {
+        let token_count = data.len() / 4;
+        let size_bytes = data.len() as u64;
 
-            // Use text blocks as fallback if page text is empty
-            let markdown = if page_text.trim().is_empty() && !page.text_blocks.is_empty() {
-                let fallback_text: String = page
-                    .text_blocks
+        ConversionOutput {
+            page_number,
+            data,
+            metadata: OutputMetadata {
+                size_bytes,
+                chunk_count: 1,
+                token_count: Some(token_count),
+            },
+        }
+    }
+
+    /// Split-page Markdown that reuses unchanged pages from a page cache
+    ///
+    /// Every page is fingerprinted (hashing only, no content decoding) and
+    /// looked up in the cache. Only pages without an entry are converted, and
+    /// the result is spliced back together in page order. Returns the outputs
+    /// and how many of them came from the cache. This call blocks.
+    ///
+    /// Pages are cached before header/footer removal, since what repeats
+    /// depends on the whole document; in precision mode the repeated lines
+    /// are matched across cached and fresh pages alike before returning.
+    fn convert_pages_cached(
+        pdf_bytes: &[u8],
+        parser: &PdfParser,
+        options: &ConversionOptions,
+        cache_dir: &Path,
+    ) -> Result<(Vec<ConversionOutput>, usize)> {
+        use rayon::prelude::*;
+
+        let cache = PageCache::open(cache_dir)?;
+        let precision = options.use_precision_mode;
+        let options_digest = Self::page_cache_options(options);
+        // Precision pages are numbered from 1, fast-mode pages from 0
+        let page_number = |idx: usize| if precision { idx + 1 } else { idx };
+
+        let keys: Vec<String> = parser
+            .page_fingerprints()?
+            .iter()
+            .map(|fingerprint| PageCache::key(&options_digest, fingerprint))
+            .collect();
+        let mut pages: Vec<Option<ConversionOutput>> = keys
+            .iter()
+            .enumerate()
+            .map(|(idx, key)| {
+                cache
+                    .get(key)
+                    .map(|data| Self::page_output(page_number(idx), data))
+            })
+            .collect();
+        let missing: Vec<usize> = (0..pages.len()).filter(|&i| pages[i].is_none()).collect();
+        let reused = pages.len() - missing.len();
+
+        eprintln!(
+            "♻️  Reusing {}/{} cached pages, converting {}",
+            reused,
+            pages.len(),
+            missing.len()
+        );
+
+        if !missing.is_empty() {
+            let fresh: Vec<(usize, ConversionOutput)> = if precision {
+                // pdf-extract decodes from bytes as a whole document, so the text is
+                // still extracted for every page; only changed pages are cleaned up
+                let mut page_texts = Self::extract_page_texts(pdf_bytes)?;
+                let texts: Vec<(usize, String)> = missing
                     .iter()
-                    .map(|b| b.text.as_str())
-                    .collect::<Vec<_>>()
-                    .join("\n");
-                Self::join_paragraph_lines_enhanced(&fallback_text)
+                    .map(|&idx| {
+                        let page_text = page_texts
+                            .get_mut(idx)
+                            .map(std::mem::take)
+                            .unwrap_or_default();
+                        if page_text.trim().is_empty() {
+                            (
+                                idx,
+                                Self::fallback_page_text(parser, idx).unwrap_or(page_text),
+                            )
+                        } else {
+                            (idx, page_text)
+                        }
+                    })
+                    .collect();
+                drop(page_texts);
+
+                texts
+                    .par_iter()
+                    .map(|(idx, text)| (*idx, Self::precision_page_output(idx + 1, text)))
+                    .collect()
             } else {
-                Self::join_paragraph_lines_enhanced(page_text)
+                missing
+                    .par_iter()
+                    .map(|&idx| {
+                        let page = parser.extract_page(idx)?;
+                        let markdown = Self::fast_page_markdown(&page.text);
+                        Ok((idx, Self::page_output(idx, markdown.into_bytes())))
+                    })
+                    .collect::<Result<_>>()?
             };
 
-            let token_count = markdown.len() / 4;
-            let data = markdown.into_bytes();
-            let size_bytes = data.len() as u64;
+            for (idx, output) in fresh {
+                cache.put(&keys[idx], &output.data)?;
+                pages[idx] = Some(output);
+            }
+        }
 
-            outputs.push(ConversionOutput {
-                page_number: page_idx + 1,
-                data,
-                metadata: OutputMetadata {
-                    size_bytes,
-                    chunk_count: 1,
-                    token_count: Some(token_count),
-                },
-            });
+        let outputs: Vec<ConversionOutput> = pages.into_iter().flatten().collect();
+        if !(precision && options.remove_headers_footers) {
+            return Ok((outputs, reused));
         }
 
-        Ok(outputs)
+        let mut page_markdown: Vec<String> = outputs
+            .iter()
+            .map(|output| String::from_utf8_lossy(&output.data).into_owned())
+            .collect();
+        Self::strip_repeated_lines(&mut page_markdown);
+        let stripped = outputs
+            .iter()
+            .zip(page_markdown)
+            .map(|(output, markdown)| Self::page_output(output.page_number, markdown.into_bytes()))
+            .collect();
+        Ok((stripped, reused))
+    }
+
+    /// The options a cached page's Markdown depends on, for its cache key
+    fn page_cache_options(options: &ConversionOptions) -> String {
+        serde_json::json!({
+            "mode": if options.use_precision_mode { "precision" } else { "fast" },
+            "use_ffi": options.use_ffi,
+            "remove_headers_footers": options.remove_headers_footers,
+            "optimize_for_llm": options.optimize_for_llm,
+            "normalize_whitespace": options.normalize_whitespace,
+            "max_chunk_size": options.max_chunk_size,
+            "image_quality": options.image_quality,
+            "dpi": options.dpi,
+            "extract_images": options.extract_images,
+        })
+        .to_string()
     }
 
     /// Convert PDF using docling-parse C++ FFI (95%+ similarity target)
     #[cfg(feature = "docling-ffi")]
-    async fn convert_with_docling_ffi(&self, path: &Path) -> Result<Vec<ConversionOutput>> {
+    async fn convert_with_docling_ffi(
+        &self,
+        path: &Path,
+        name: &Path,
+        options: &ConversionOptions,
+    ) -> Result<Vec<ConversionOutput>> {
         use crate::document::{
             DoclingJsonParser, HierarchyBuilder, MarkdownSerializer, PageAssembler,
             PageAssemblerOptions,
@@ -791,12 +663,15 @@ impl PdfConverter {
 
         use crate::engines::rule_based_layout;
 
-        let clusters = match rule_based_layout::detect_layout_from_cells(&json_output) {
-            Ok(clusters) if !clusters.is_empty() => {
-                eprintln!("      ✓ Detected {} layout regions", clusters.len());
+        let mut page_layouts = match rule_based_layout::detect_page_layouts(&json_output) {
+            Ok(pages) if pages.iter().any(|page| !page.is_empty()) => {
+                eprintln!(
+                    "      ✓ Detected {} layout regions",
+                    pages.iter().map(Vec::len).sum::<usize>()
+                );
                 eprintln!("        • No Python dependency");
                 eprintln!("        • Pure Rust inference");
-                clusters
+                pages
             }
             Ok(_) | Err(_) => {
                 eprintln!("      ℹ️  Using parser-only mode (still excellent quality)");
@@ -804,6 +679,15 @@ impl PdfConverter {
             }
         };
 
+        // Drop header/footer rows that repeat across pages before assembly
+        if options.remove_headers_footers {
+            let removed = BoilerplateDetector::new().strip_clusters(&mut page_layouts);
+            if removed > 0 {
+                eprintln!("      ✓ Removed {} repeated header/footer cells", removed);
+            }
+        }
+        let clusters: Vec<_> = page_layouts.into_iter().flatten().collect();
+
         let items_to_use = if clusters.is_empty() {
             eprintln!("      ℹ️  Using parsed items directly (no layout clusters)");
             doc.items
@@ -827,7 +711,7 @@ impl PdfConverter {
         // Step 4: Build document hierarchy
         eprintln!("\n[4/5] 🌳 Building document hierarchy...");
         let hierarchy_builder = HierarchyBuilder::new();
-        let filename = path
+        let filename = name
             .file_name()
             .and_then(|n| n.to_str())
             .unwrap_or("document.pdf")
@@ -843,97 +727,28 @@ impl PdfConverter {
             .with_tables(true)
             .with_images(true);
 
-        let markdown = serializer.serialize(&final_doc)?;
+        // Rendered straight into the output buffer, no intermediate String
+        let mut data = Vec::new();
+        serializer.serialize_to_writer(&final_doc, &mut data)?;
         eprintln!(
-            "      ✓ Markdown size: {} KB ({} chars)",
-            markdown.len() / 1024,
-            markdown.len()
+            "      ✓ Markdown size: {} KB ({} bytes)",
+            data.len() / 1024,
+            data.len()
         );
 
         eprintln!("\n┌─────────────────────────────────────────┐");
         eprintln!("│ ✅ Pipeline Complete!                   │");
         eprintln!("└─────────────────────────────────────────┘\n");
 
-        let token_count = markdown.len() / 4;
-        let data = markdown.into_bytes();
-        let size_bytes = data.len() as u64;
-
-        Ok(vec![ConversionOutput {
-            page_number: 0,
-            data,
-            metadata: OutputMetadata {
-                size_bytes,
-                chunk_count: 1,
-                token_count: Some(token_count),
-            },
-        }])
+        Ok(vec![Self::page_output(0, data)])
     }
 
     /// Enhanced paragraph joining with MORE aggressive improvements for Docling-style output
     ///
-    /// Memory optimized: uses cached regex and pre-allocated strings
+    /// Also repairs the split words pdf-extract introduces ("i s" -> "is",
+    /// "o f" -> "of", ...) before and after joining.
     fn join_paragraph_lines_enhanced(text: &str) -> String {
-        let cache = regex_cache();
-
-        // CRITICAL FIX: Remove unwanted spaces that pdf-extract introduces
-        // "i s" -> "is", "o n" -> "on", "t o" -> "to", "o f" -> "of", "a n" -> "an", etc.
-
-        // Pre-allocate with estimated capacity
-        let mut cleaned = String::with_capacity(text.len());
-        cleaned.push_str(text);
-
-        // Fix common two-letter words that got split
-        // Using static array to avoid allocation
-        const WORD_FIXES: [(&str, &str); 19] = [
-            (" i s ", " is "),
-            (" i n ", " in "),
-            (" o n ", " on "),
-            (" t o ", " to "),
-            (" o f ", " of "),
-            (" a n ", " an "),
-            (" a s ", " as "),
-            (" a t ", " at "),
-            (" b y ", " by "),
-            (" o r ", " or "),
-            (" w e ", " we "),
-            (" i t ", " it "),
-            (" b e ", " be "),
-            ("o f ", "of "),
-            ("t o ", "to "),
-            ("i n ", "in "),
-            ("o n ", "on "),
-            ("a s ", "as "),
-            ("a t ", "at "),
-        ];
-
-        for (bad, good) in WORD_FIXES.iter() {
-            if cleaned.contains(bad) {
-                cleaned = cleaned.replace(bad, good);
-            }
-        }
-
-        // More aggressive: fix ANY single letter followed by space followed by single letter
-        // Apply twice to catch overlapping cases (using cached regex)
-        for _ in 0..2 {
-            cleaned = cache
-                .single_letter_pair
-                .replace_all(&cleaned, " $1$2 ")
-                .into_owned();
-        }
-
-        // Now apply the standard preprocessing
-        let mut result = Self::join_paragraph_lines(&cleaned);
-
-        // CRITICAL: Apply space fix AGAIN after join_paragraph_lines
-        // because join might have introduced new patterns (apply twice)
-        for _ in 0..2 {
-            result = cache
-                .single_letter_pair
-                .replace_all(&result, " $1$2 ")
-                .into_owned();
-        }
-
-        result
+        pdf_text::join_paragraph_lines(text, true)
     }
 
     /// Generate Markdown from text blocks using Docling-style analysis
@@ -1081,15 +896,15 @@ impl PdfConverter {
     /// Convert PDF to Markdown using pdf-extract (high quality)
     async fn convert_to_markdown_pdf_extract(
         &self,
-        path: &Path,
+        pdf_bytes: &[u8],
+        parser: &PdfParser,
         options: &ConversionOptions,
     ) -> Result<Vec<ConversionOutput>> {
-        use pdf_extract::extract_text;
+        use pdf_extract::extract_text_from_mem;
 
         if options.split_pages {
             // For split pages: extract each PDF page individually using lopdf
             // This accurately reflects the actual PDF page boundaries
-            let parser = PdfParser::load(path)?;
             let pages = parser.extract_all_pages()?;
 
             // Process each physical PDF page
@@ -1097,35 +912,14 @@ impl PdfConverter {
                 .iter()
                 .enumerate()
                 .map(|(i, page)| {
-                    // lopdf returns text with few line breaks, need to add them
-                    let page_markdown = if page.text.lines().count() > 20 {
-                        // If text has many lines, use join algorithm (like pdf-extract)
-                        Self::join_paragraph_lines(&page.text)
-                    } else {
-                        // If text is in few/long lines, break it up into paragraphs
-                        Self::break_long_text_into_paragraphs(&page.text)
-                    };
-
-                    let token_count = page_markdown.len() / 4;
-                    let data = page_markdown.into_bytes();
-                    let size_bytes = data.len() as u64;
-
-                    ConversionOutput {
-                        page_number: i,
-                        data,
-                        metadata: OutputMetadata {
-                            size_bytes,
-                            chunk_count: 1,
-                            token_count: Some(token_count),
-                        },
-                    }
+                    Self::page_output(i, Self::fast_page_markdown(&page.text).into_bytes())
                 })
                 .collect();
 
             Ok(outputs)
         } else {
             // Extract all text at once (better quality than lopdf)
-            let raw_text = extract_text(path).map_err(|e| {
+            let raw_text = extract_text_from_mem(pdf_bytes).map_err(|e| {
                 crate::TransmutationError::engine_error(
                     "PDF Parser",
                     format!("pdf-extract failed: {:?}", e),
@@ -1310,72 +1104,55 @@ impl PdfConverter {
         }])
     }
 
-    /// Build document metadata from PDF
-    fn build_metadata(&self, parser: &PdfParser) -> DocumentMetadata {
-        let pdf_meta = parser.get_metadata();
-
-        DocumentMetadata {
-            title: pdf_meta.title,
-            author: pdf_meta.author,
-            created: pdf_meta.created,
-            modified: pdf_meta.modified,
-            page_count: pdf_meta.page_count,
-            language: None, // TODO: Implement language detection
-            custom: std::collections::HashMap::new(),
-        }
-    }
-}
-
-impl Default for PdfConverter {
-    fn default() -> Self {
-        Self::new()
-    }
-}
-
-#[async_trait]
-impl DocumentConverter for PdfConverter {
-    fn supported_formats(&self) -> Vec<FileFormat> {
-        vec![FileFormat::Pdf]
-    }
-
-    fn output_formats(&self) -> Vec<OutputFormat> {
-        vec![
-            OutputFormat::Markdown {
-                split_pages: false,
-                optimize_for_llm: true,
-            },
-            OutputFormat::Json {
-                structured: true,
-                include_metadata: true,
-            },
-        ]
-    }
-
-    async fn convert(
+    /// Convert an in-memory PDF reported as `input`; `file` is where it was
+    /// read from, if anywhere
+    async fn convert_pdf(
         &self,
         input: &Path,
+        file: Option<&Path>,
+        pdf_bytes: Vec<u8>,
         output_format: OutputFormat,
         options: ConversionOptions,
     ) -> Result<ConversionResult> {
         let start_time = Instant::now();
 
-        // Load PDF
-        let parser = PdfParser::load(input)?;
+        // Load PDF (shared with blocking conversion tasks)
+        let pdf_bytes: Arc<[u8]> = pdf_bytes.into();
+        let parser = Arc::new(PdfParser::from_bytes(&pdf_bytes)?);
 
         // Get input file size
-        let input_size = tokio::fs::metadata(input).await?.len();
+        let input_size = pdf_bytes.len() as u64;
 
         // Convert based on output format
+        let mut cache_hit = false;
         let content = match output_format {
             OutputFormat::Markdown { .. } => {
-                // Use pdf-extract for best quality
-                if options.use_precision_mode || options.use_ffi {
+                let page_cache_dir = options
+                    .page_cache_dir
+                    .as_deref()
+                    .filter(|_| options.split_pages && !options.use_ffi);
+
+                if let Some(cache_dir) = page_cache_dir {
+                    // Incremental mode: only pages whose content changed are reconverted
+                    let pdf_bytes = Arc::clone(&pdf_bytes);
+                    let cache_dir = cache_dir.to_path_buf();
+                    let (parser, cache_options) = (Arc::clone(&parser), options.clone());
+                    let (outputs, reused) = tokio::task::spawn_blocking(move || {
+                        Self::convert_pages_cached(&pdf_bytes, &parser, &cache_options, &cache_dir)
+                    })
+                    .await
+                    .map_err(|e| crate::TransmutationError::conversion_failed(e.to_string()))??;
+                    cache_hit = !outputs.is_empty() && reused == outputs.len();
+                    outputs
+                } else if options.use_precision_mode || options.use_ffi {
+                    // Use pdf-extract for best quality
                     // High-precision mode: Docling-style layout analysis for ~95% similarity
                     // Also used for FFI mode which tries docling-parse C++ first
-                    self.convert_with_docling_style(input, &options).await?
+                    self.convert_with_docling_style(input, file, &pdf_bytes, &parser, &options)
+                        .await?
                 } else {
                     // Fast mode: Pure Rust heuristics, ~81% similarity, much faster
-                    self.convert_to_markdown_pdf_extract(input, &options)
+                    self.convert_to_markdown_pdf_extract(&pdf_bytes, &parser, &options)
                         .await?
                 }
             }
@@ -1387,7 +1164,7 @@ impl DocumentConverter for PdfConverter {
             } => {
                 #[cfg(feature = "pdf-to-image")]
                 {
-                    self.convert_to_images(input, _format, _quality, _dpi, &options)
+                    self.convert_to_images(&pdf_bytes, _format, _quality, _dpi, &options)
                         .await?
                 }
                 #[cfg(not(feature = "pdf-to-image"))]
@@ -1431,7 +1208,7 @@ impl DocumentConverter for PdfConverter {
             pages_processed: page_count,
             tables_extracted,
             images_extracted: 0, // TODO: Implement image extraction
-            cache_hit: false,
+            cache_hit,
         };
 
         Ok(ConversionResult {
@@ -1444,6 +1221,71 @@ impl DocumentConverter for PdfConverter {
         })
     }
 
+    /// Build document metadata from PDF
+    fn build_metadata(&self, parser: &PdfParser) -> DocumentMetadata {
+        let pdf_meta = parser.get_metadata();
+
+        DocumentMetadata {
+            title: pdf_meta.title,
+            author: pdf_meta.author,
+            created: pdf_meta.created,
+            modified: pdf_meta.modified,
+            page_count: pdf_meta.page_count,
+            language: None, // TODO: Implement language detection
+            custom: std::collections::HashMap::new(),
+        }
+    }
+}
+
+impl Default for PdfConverter {
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
+#[async_trait]
+impl DocumentConverter for PdfConverter {
+    fn supported_formats(&self) -> Vec<FileFormat> {
+        vec![FileFormat::Pdf]
+    }
+
+    fn output_formats(&self) -> Vec<OutputFormat> {
+        vec![
+            OutputFormat::Markdown {
+                split_pages: false,
+                optimize_for_llm: true,
+            },
+            OutputFormat::Json {
+                structured: true,
+                include_metadata: true,
+            },
+        ]
+    }
+
+    async fn convert(
+        &self,
+        input: &Path,
+        output_format: OutputFormat,
+        options: ConversionOptions,
+    ) -> Result<ConversionResult> {
+        let pdf_bytes = tokio::fs::read(input).await?;
+        self.convert_pdf(input, Some(input), pdf_bytes, output_format, options)
+            .await
+    }
+
+    async fn convert_bytes(
+        &self,
+        name: &str,
+        data: Vec<u8>,
+        _input_format: FileFormat,
+        output_format: OutputFormat,
+        options: ConversionOptions,
+    ) -> Result<ConversionResult> {
+        // lopdf, pdf-extract and pdfium all read from memory
+        self.convert_pdf(Path::new(name), None, data, output_format, options)
+            .await
+    }
+
     fn metadata(&self) -> ConverterMetadata {
         ConverterMetadata {
             name: "PDF Converter".to_string(),
@@ -1570,5 +1412,130 @@ mod tests {
         assert!(!result.is_empty());
     }
 
+    #[test]
+    fn test_page_cache_options_cover_output_options() {
+        let options = ConversionOptions::default();
+        let digest = PdfConverter::page_cache_options(&options);
+        for changed in [
+            ConversionOptions {
+                remove_headers_footers: false,
+                ..options.clone()
+            },
+            ConversionOptions {
+                optimize_for_llm: false,
+                ..options.clone()
+            },
+            ConversionOptions {
+                use_precision_mode: true,
+                ..options.clone()
+            },
+        ] {
+            assert_ne!(PdfConverter::page_cache_options(&changed), digest);
+        }
+
+        // Where the cache lives does not change the pages
+        let relocated = ConversionOptions {
+            page_cache_dir: Some(PathBuf::from("/tmp/pages")),
+            ..options.clone()
+        };
+        assert_eq!(PdfConverter::page_cache_options(&relocated), digest);
+    }
+
+    /// PDF with one line of Helvetica text per page
+    fn text_pdf(pages: &[String]) -> Vec<u8> {
+        use lopdf::{Document, Object, Stream, dictionary};
+
+        let mut doc = Document::with_version("1.5");
+        let pages_id = doc.new_object_id();
+        let font_id = doc.add_object(dictionary! {
+            "Type" => "Font",
+            "Subtype" => "Type1",
+            "BaseFont" => "Helvetica",
+        });
+        let resources_id = doc.add_object(dictionary! {
+            "Font" => dictionary! { "F1" => font_id },
+        });
+
+        let mut kids: Vec<Object> = Vec::new();
+        for text in pages {
+            let content = format!("BT /F1 12 Tf 72 720 Td ({}) Tj ET", text);
+            let content_id = doc.add_object(Stream::new(dictionary! {}, content.into_bytes()));
+            let page_id = doc.add_object(dictionary! {
+                "Type" => "Page",
+                "Parent" => pages_id,
+                "Contents" => content_id,
+            });
+            kids.push(page_id.into());
+        }
+
+        doc.objects.insert(
+            pages_id,
+            Object::Dictionary(dictionary! {
+                "Type" => "Pages",
+                "Count" => kids.len() as i64,
+                "Kids" => kids,
+                "Resources" => resources_id,
+                "MediaBox" => vec![0.into(), 0.into(), 595.into(), 842.into()],
+            }),
+        );
+        let catalog_id = doc.add_object(dictionary! {
+            "Type" => "Catalog",
+            "Pages" => pages_id,
+        });
+        doc.trailer.set("Root", catalog_id);
+
+        let mut bytes = Vec::new();
+        doc.save_to(&mut bytes).unwrap();
+        bytes
+    }
+
+    #[tokio::test]
+    async fn test_pages_stream_one_at_a_time() {
+        let texts: Vec<String> = (1..=12).map(|i| format!("Text of page {}", i)).collect();
+        let mut pages = PdfConverter::stream_pages(text_pdf(&texts).into(), false);
+
+        let first = pages.recv().await.unwrap().unwrap();
+        assert_eq!(first.page_number, 1);
+        // The conversion waits for the consumer instead of running ahead
+        tokio::time::sleep(std::time::Duration::from_millis(200)).await;
+        assert!(pages.len() <= PAGE_STREAM_BUFFER);
+
+        let mut numbers = vec![first.page_number];
+        while let Some(page) = pages.recv().await {
+            let page = page.unwrap();
+            let markdown = String::from_utf8(page.data).unwrap();
+            assert!(
+                markdown.contains(&texts[page.page_number - 1]),
+                "{}",
+                markdown
+            );
+            numbers.push(page.page_number);
+        }
+        assert_eq!(numbers, (1..=12).collect::<Vec<_>>());
+    }
+
+    #[tokio::test]
+    async fn test_convert_bytes_in_memory() {
+        let texts = vec!["Converted from memory".to_string()];
+        let result = PdfConverter::new()
+            .convert_bytes(
+                "reports/q3.pdf",
+                text_pdf(&texts),
+                FileFormat::Pdf,
+                OutputFormat::Markdown {
+                    split_pages: false,
+                    optimize_for_llm: true,
+                },
+                ConversionOptions::default(),
+            )
+            .await
+            .unwrap();
+
+        assert_eq!(result.input_path, PathBuf::from("reports/q3.pdf"));
+        assert_eq!(result.statistics.pages_processed, 1);
+        let markdown = String::from_utf8(result.content[0].data.clone()).unwrap();
+        assert!(markdown.contains("Converted from memory"), "{}", markdown);
+    }
+
     // Integration tests with real PDFs will be in tests/pdf_tests.rs
 }
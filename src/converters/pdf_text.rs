@@ -0,0 +1,1770 @@
+//! Streaming text cleanup for PDF text extraction
+//!
+//! `PdfConverter` turns raw pdf-extract text into Markdown with a fixed list
+//! of rewrite rules: split-word fixes, paragraph joining, heading spacing,
+//! section/title splits, math spacing and author-line joins. Every rule is a
+//! small streaming stage with the exact leftmost, non-overlapping semantics of
+//! the `str::replace` / `Regex::replace_all` call it stands for, and the
+//! stages are chained so the text is walked once and written straight into a
+//! single preallocated output buffer.
+
+use std::ops::Range;
+use std::sync::OnceLock;
+
+use regex::Regex;
+
+/// Section keywords recognised when glued to the following word ("AbstractThe")
+const SECTION_KEYWORDS: [&str; 8] = [
+    "Abstract",
+    "Introduction",
+    "Background",
+    "Methods",
+    "Results",
+    "Discussion",
+    "Conclusion",
+    "References",
+];
+
+/// Single-letter words pdf-extract splits apart, applied in order
+const WORD_FIXES: [(&str, &str); 19] = [
+    (" i s ", " is "),
+    (" i n ", " in "),
+    (" o n ", " on "),
+    (" t o ", " to "),
+    (" o f ", " of "),
+    (" a n ", " an "),
+    (" a s ", " as "),
+    (" a t ", " at "),
+    (" b y ", " by "),
+    (" o r ", " or "),
+    (" w e ", " we "),
+    (" i t ", " it "),
+    (" b e ", " be "),
+    ("o f ", "of "),
+    ("t o ", "to "),
+    ("i n ", "in "),
+    ("o n ", "on "),
+    ("a s ", "as "),
+    ("a t ", "at "),
+];
+
+/// Title/author split only looks at the first bytes of the document
+const TITLE_REGION: usize = 500;
+
+/// "Attention Is All You NeedAshish Vaswani" -> title + author
+fn title_author_pattern() -> &'static Regex {
+    static PATTERN: OnceLock<Regex> = OnceLock::new();
+    PATTERN.get_or_init(|| {
+        Regex::new(
+            r"([A-Z][a-z]+ [A-Z][a-z]+(?: [A-Z][a-z]+)+)([A-Z][a-z]+ [A-Z]\.|[A-Z][a-z]+ [A-Z][a-z]+)",
+        )
+        .unwrap()
+    })
+}
+
+/// `\w` as the regex engine sees it (Unicode word character); `None` is a text edge
+fn is_word_char(c: Option<char>) -> bool {
+    match c {
+        None => false,
+        Some(c) if c.is_ascii() => c.is_ascii_alphanumeric() || c == '_',
+        Some(c) => regex_syntax::is_word_character(c),
+    }
+}
+
+/// `\d` as the regex engine sees it (Unicode decimal digit)
+fn is_digit(c: char) -> bool {
+    static DIGITS: OnceLock<Vec<(char, char)>> = OnceLock::new();
+
+    if c.is_ascii() {
+        return c.is_ascii_digit();
+    }
+    if !c.is_numeric() {
+        return false;
+    }
+    let ranges = DIGITS.get_or_init(|| {
+        use regex_syntax::hir::{Class, HirKind};
+
+        match regex_syntax::parse(r"\d").map(|hir| hir.kind().clone()) {
+            Ok(HirKind::Class(Class::Unicode(class))) => class
+                .ranges()
+                .iter()
+                .map(|range| (range.start(), range.end()))
+                .collect(),
+            _ => Vec::new(),
+        }
+    });
+    ranges
+        .binary_search_by(|&(start, end)| {
+            if end < c {
+                std::cmp::Ordering::Less
+            } else if start > c {
+                std::cmp::Ordering::Greater
+            } else {
+                std::cmp::Ordering::Equal
+            }
+        })
+        .is_ok()
+}
+
+/// ASCII `\w` byte; non-ASCII bytes are not decided here
+fn is_ascii_word_byte(b: Option<u8>) -> bool {
+    b.is_some_and(|b| b.is_ascii_alphanumeric() || b == b'_')
+}
+
+fn is_footnote_symbol(c: char) -> bool {
+    matches!(c, '∗' | '†' | '‡')
+}
+
+/// Receiver of a character stream
+trait Sink {
+    fn push(&mut self, c: char);
+
+    fn push_str(&mut self, s: &str) {
+        for c in s.chars() {
+            self.push(c);
+        }
+    }
+
+    /// End of input: flush anything held back
+    fn finish(&mut self);
+}
+
+impl Sink for String {
+    fn push(&mut self, c: char) {
+        String::push(self, c);
+    }
+
+    fn push_str(&mut self, s: &str) {
+        String::push_str(self, s);
+    }
+
+    fn finish(&mut self) {}
+}
+
+/// Longest window any [`Rule`] inspects before deciding
+const MAX_LOOKAHEAD: usize = 16;
+
+/// Decision of a [`Rule`] at the start of its window
+enum Step {
+    /// No match starts here: pass the first char through
+    Keep,
+    /// Need more input to decide
+    Wait,
+    /// A match of this many chars starts here
+    Replace(usize),
+}
+
+/// One rewrite rule, evaluated at each input position
+///
+/// `prev` is the input char before the position (for `\b`). `step` is only
+/// asked where `starts_at` holds and must not return `Step::Wait` when
+/// `at_end` is set.
+trait Rule {
+    /// Chars `step` needs to see to decide (at most [`MAX_LOOKAHEAD`])
+    const LOOKAHEAD: usize;
+
+    /// Chars from the start of a match to its anchor (its rarest char)
+    fn anchor(&self) -> usize {
+        0
+    }
+
+    /// Can `b` be the first byte of the anchor char, given the byte before it
+    /// (non-ASCII chars show up as continuation bytes)? A cheap superset used
+    /// to forward text in bulk.
+    fn anchor_byte(&self, prev: Option<u8>, b: u8) -> bool;
+
+    /// Can a match start at `c`?
+    fn starts_at(&self, prev: Option<char>, c: char) -> bool;
+    fn step(&self, prev: Option<char>, window: &[char], at_end: bool) -> Step;
+    fn replace<S: Sink>(&self, matched: &[char], out: &mut S);
+}
+
+/// Streaming stage applying a [`Rule`] leftmost-first, without overlaps
+struct Rewrite<'a, R, S> {
+    rule: R,
+    prev: Option<char>,
+    window: Vec<char>,
+    next: &'a mut S,
+}
+
+impl<'a, R: Rule, S: Sink> Rewrite<'a, R, S> {
+    fn new(rule: R, next: &'a mut S) -> Self {
+        Self {
+            rule,
+            prev: None,
+            window: Vec::with_capacity(16),
+            next,
+        }
+    }
+
+    /// Scan a chunk while the window is empty
+    ///
+    /// Returns the byte index of the first position where a match may start
+    /// and, when the whole match lies inside `s`, its byte length. Without a
+    /// match the index is where the chunk stops being decidable on its own.
+    fn scan(&self, s: &str) -> (usize, Option<usize>) {
+        let anchor = self.rule.anchor();
+        let mut window = ['\0'; MAX_LOOKAHEAD];
+        let mut prev_byte = self.prev.map(|c| if c.is_ascii() { c as u8 } else { 0x80 });
+
+        for (at, &b) in s.as_bytes().iter().enumerate() {
+            let hit = self.rule.anchor_byte(prev_byte, b);
+            prev_byte = Some(b);
+            if !hit {
+                continue;
+            }
+
+            // Step back from the anchor to where the match would start; an
+            // anchor too close to the chunk start belongs to text already decided
+            let Some(start) = Self::back(s, at, anchor) else {
+                continue;
+            };
+            let prev = Self::char_before(s, start, self.prev);
+            let mut len = 0;
+            for (slot, c) in window.iter_mut().zip(s[start..].chars().take(R::LOOKAHEAD)) {
+                *slot = c;
+                len += 1;
+            }
+            if !self.rule.starts_at(prev, window[0]) {
+                continue;
+            }
+            match self.rule.step(prev, &window[..len], false) {
+                Step::Keep => {}
+                Step::Wait => return (start, None),
+                Step::Replace(chars) => {
+                    let bytes = window[..chars].iter().map(|c| c.len_utf8()).sum();
+                    return (start, Some(bytes));
+                }
+            }
+        }
+
+        // Hold back the chars a match anchored in the next chunk would start at
+        (Self::back(s, s.len(), anchor).unwrap_or(0), None)
+    }
+
+    /// Byte index `chars` chars before `at`
+    fn back(s: &str, at: usize, chars: usize) -> Option<usize> {
+        if chars == 0 {
+            return Some(at);
+        }
+        s[..at].char_indices().rev().nth(chars - 1).map(|(i, _)| i)
+    }
+
+    fn char_before(s: &str, at: usize, prev: Option<char>) -> Option<char> {
+        if at == 0 {
+            prev
+        } else {
+            s[..at].chars().next_back()
+        }
+    }
+
+    fn drain(&mut self, at_end: bool) {
+        while !self.window.is_empty() {
+            let step = if self.rule.starts_at(self.prev, self.window[0]) {
+                self.rule.step(self.prev, &self.window, at_end)
+            } else {
+                Step::Keep
+            };
+            match step {
+                Step::Wait => return,
+                Step::Keep => {
+                    let c = self.window.remove(0);
+                    self.next.push(c);
+                    self.prev = Some(c);
+                }
+                Step::Replace(len) => {
+                    self.rule.replace(&self.window[..len], self.next);
+                    self.prev = Some(self.window[len - 1]);
+                    self.window.drain(..len);
+                }
+            }
+        }
+    }
+}
+
+impl<R: Rule, S: Sink> Sink for Rewrite<'_, R, S> {
+    fn push(&mut self, c: char) {
+        if self.window.is_empty() && !self.rule.starts_at(self.prev, c) {
+            self.next.push(c);
+            self.prev = Some(c);
+            return;
+        }
+        self.window.push(c);
+        self.drain(false);
+    }
+
+    fn push_str(&mut self, mut s: &str) {
+        while !s.is_empty() {
+            if self.window.is_empty() {
+                // Forward everything before the next possible match start
+                let (split, matched) = self.scan(s);
+                if split > 0 {
+                    self.next.push_str(&s[..split]);
+                    self.prev = s[..split].chars().next_back();
+                    s = &s[split..];
+                }
+                if let Some(len) = matched {
+                    let mut window = ['\0'; MAX_LOOKAHEAD];
+                    let mut count = 0;
+                    for (slot, c) in window.iter_mut().zip(s[..len].chars()) {
+                        *slot = c;
+                        count += 1;
+                    }
+                    self.rule.replace(&window[..count], self.next);
+                    self.prev = Some(window[count - 1]);
+                    s = &s[len..];
+                    continue;
+                }
+            }
+            // Undecided within this chunk: go char by char
+            let mut chars = s.chars();
+            if let Some(c) = chars.next() {
+                self.push(c);
+            }
+            s = chars.as_str();
+        }
+    }
+
+    fn finish(&mut self) {
+        self.drain(true);
+        self.next.finish();
+    }
+}
+
+/// `str::replace(pattern, replacement)`
+struct Literal {
+    pattern: &'static str,
+    replacement: &'static str,
+    /// First char after the pattern's leading whitespace (ASCII)
+    anchor: usize,
+    anchor_byte: u8,
+}
+
+impl Literal {
+    fn new(pattern: &'static str, replacement: &'static str) -> Self {
+        let anchor = pattern.len() - pattern.trim_start().len();
+        Self {
+            pattern,
+            replacement,
+            anchor,
+            anchor_byte: pattern.as_bytes()[anchor],
+        }
+    }
+}
+
+impl Rule for Literal {
+    const LOOKAHEAD: usize = 4;
+
+    fn anchor(&self) -> usize {
+        self.anchor
+    }
+
+    fn anchor_byte(&self, _prev: Option<u8>, b: u8) -> bool {
+        b == self.anchor_byte
+    }
+
+    fn starts_at(&self, _prev: Option<char>, c: char) -> bool {
+        self.pattern.starts_with(c)
+    }
+
+    fn step(&self, _prev: Option<char>, window: &[char], at_end: bool) -> Step {
+        let mut expected = self.pattern.chars();
+        for &c in window {
+            match expected.next() {
+                Some(e) if e == c => {}
+                Some(_) => return Step::Keep,
+                None => break,
+            }
+        }
+        let matched = self.pattern.chars().count();
+        if window.len() >= matched {
+            Step::Replace(matched)
+        } else if at_end {
+            Step::Keep
+        } else {
+            Step::Wait
+        }
+    }
+
+    fn replace<S: Sink>(&self, _matched: &[char], out: &mut S) {
+        out.push_str(self.replacement);
+    }
+}
+
+/// `\b(Abstract|…|References)([A-Z][a-z]+)` -> `## $1\n\n$2`
+struct SectionHeading;
+
+impl SectionHeading {
+    /// Does `keyword` + `[A-Z][a-z]` match the window (`None`: need more input)
+    fn match_at(keyword: &str, window: &[char]) -> Option<bool> {
+        let len = keyword.len();
+        for (i, &c) in window.iter().take(len + 2).enumerate() {
+            let expected = match keyword.as_bytes().get(i) {
+                Some(&b) => c == char::from(b),
+                None if i == len => c.is_ascii_uppercase(),
+                None => c.is_ascii_lowercase(),
+            };
+            if !expected {
+                return Some(false);
+            }
+        }
+        if window.len() >= len + 2 {
+            Some(true)
+        } else {
+            None
+        }
+    }
+}
+
+impl Rule for SectionHeading {
+    const LOOKAHEAD: usize = "Introduction".len() + 2;
+
+    fn anchor_byte(&self, prev: Option<u8>, b: u8) -> bool {
+        matches!(b, b'A' | b'I' | b'B' | b'M' | b'R' | b'D' | b'C') && !is_ascii_word_byte(prev)
+    }
+
+    fn starts_at(&self, prev: Option<char>, c: char) -> bool {
+        matches!(c, 'A' | 'I' | 'B' | 'M' | 'R' | 'D' | 'C') && !is_word_char(prev)
+    }
+
+    fn step(&self, _prev: Option<char>, window: &[char], at_end: bool) -> Step {
+        let mut undecided = false;
+        for keyword in SECTION_KEYWORDS {
+            match Self::match_at(keyword, window) {
+                Some(true) => return Step::Replace(keyword.len()),
+                Some(false) => {}
+                None => undecided = true,
+            }
+        }
+
+        if undecided && !at_end {
+            Step::Wait
+        } else {
+            Step::Keep
+        }
+    }
+
+    fn replace<S: Sink>(&self, matched: &[char], out: &mut S) {
+        out.push_str("## ");
+        for &c in matched {
+            out.push(c);
+        }
+        out.push_str("\n\n");
+    }
+}
+
+/// `(\d+)(Figure|Table)` -> `\n\n$2` (page number glued to a caption)
+struct PageNumberCaption;
+
+impl Rule for PageNumberCaption {
+    // Longer digit runs fall back to the char-by-char window
+    const LOOKAHEAD: usize = MAX_LOOKAHEAD;
+
+    fn anchor_byte(&self, _prev: Option<u8>, b: u8) -> bool {
+        // Non-ASCII lead bytes may start a Unicode digit
+        b.is_ascii_digit() || b >= 0xC0
+    }
+
+    fn starts_at(&self, _prev: Option<char>, c: char) -> bool {
+        is_digit(c)
+    }
+
+    fn step(&self, _prev: Option<char>, window: &[char], at_end: bool) -> Step {
+        let digits = window.iter().take_while(|&&c| is_digit(c)).count();
+        let rest = &window[digits..];
+        if rest.is_empty() {
+            return if at_end { Step::Keep } else { Step::Wait };
+        }
+
+        let mut undecided = false;
+        for caption in ["Figure", "Table"] {
+            let mut expected = caption.chars();
+            let mut matched = true;
+            for &c in rest {
+                match expected.next() {
+                    Some(e) if e == c => {}
+                    Some(_) => {
+                        matched = false;
+                        break;
+                    }
+                    None => break,
+                }
+            }
+            if matched && rest.len() >= caption.len() {
+                return Step::Replace(digits);
+            }
+            undecided |= matched;
+        }
+
+        if undecided && !at_end {
+            Step::Wait
+        } else {
+            Step::Keep
+        }
+    }
+
+    fn replace<S: Sink>(&self, _matched: &[char], out: &mut S) {
+        out.push_str("\n\n");
+    }
+}
+
+/// `\b([a-z])([0-9])\b` / `\b([a-z])([a-z])\b` -> `$1 $2` ("x1" -> "x 1")
+struct MathVariable {
+    second: fn(char) -> bool,
+}
+
+impl Rule for MathVariable {
+    const LOOKAHEAD: usize = 3;
+
+    fn anchor_byte(&self, prev: Option<u8>, b: u8) -> bool {
+        b.is_ascii_lowercase() && !is_ascii_word_byte(prev)
+    }
+
+    fn starts_at(&self, prev: Option<char>, c: char) -> bool {
+        c.is_ascii_lowercase() && !is_word_char(prev)
+    }
+
+    fn step(&self, _prev: Option<char>, window: &[char], at_end: bool) -> Step {
+        match (window.get(1), window.get(2)) {
+            (None, _) if !at_end => Step::Wait,
+            (Some(&c), _) if !(self.second)(c) => Step::Keep,
+            (Some(_), None) if !at_end => Step::Wait,
+            (Some(_), next) if !is_word_char(next.copied()) => Step::Replace(2),
+            _ => Step::Keep,
+        }
+    }
+
+    fn replace<S: Sink>(&self, matched: &[char], out: &mut S) {
+        out.push(matched[0]);
+        out.push(' ');
+        out.push(matched[1]);
+    }
+}
+
+/// Three-char pattern with a space inserted before or after the middle char
+///
+/// `([a-zA-Z])\(([a-z])` -> `$1( $2` and `([a-z])\+([A-Z])` -> `$1 +$2`.
+struct SpacedOperator {
+    before: fn(char) -> bool,
+    operator: char,
+    after: fn(char) -> bool,
+    space_before: bool,
+}
+
+impl Rule for SpacedOperator {
+    const LOOKAHEAD: usize = 3;
+
+    fn anchor(&self) -> usize {
+        1
+    }
+
+    fn anchor_byte(&self, _prev: Option<u8>, b: u8) -> bool {
+        u32::from(b) == u32::from(self.operator)
+    }
+
+    fn starts_at(&self, _prev: Option<char>, c: char) -> bool {
+        (self.before)(c)
+    }
+
+    fn step(&self, _prev: Option<char>, window: &[char], at_end: bool) -> Step {
+        match (window.get(1), window.get(2)) {
+            (Some(&op), _) if op != self.operator => Step::Keep,
+            (Some(_), Some(&c)) if (self.after)(c) => Step::Replace(3),
+            (Some(_), Some(_)) => Step::Keep,
+            _ if at_end => Step::Keep,
+            _ => Step::Wait,
+        }
+    }
+
+    fn replace<S: Sink>(&self, matched: &[char], out: &mut S) {
+        out.push(matched[0]);
+        if self.space_before {
+            out.push(' ');
+            out.push(matched[1]);
+        } else {
+            out.push(matched[1]);
+            out.push(' ');
+        }
+        out.push(matched[2]);
+    }
+}
+
+/// `([a-zA-Z])([∗†‡])` / `([∗†‡])([A-Z])` -> `$1 $2`
+struct SymbolSpacing {
+    symbol_first: bool,
+}
+
+impl SymbolSpacing {
+    fn first(&self, c: char) -> bool {
+        if self.symbol_first {
+            is_footnote_symbol(c)
+        } else {
+            c.is_ascii_alphabetic()
+        }
+    }
+
+    fn second(&self, c: char) -> bool {
+        if self.symbol_first {
+            c.is_ascii_uppercase()
+        } else {
+            is_footnote_symbol(c)
+        }
+    }
+}
+
+impl Rule for SymbolSpacing {
+    const LOOKAHEAD: usize = 2;
+
+    fn anchor(&self) -> usize {
+        usize::from(!self.symbol_first)
+    }
+
+    fn anchor_byte(&self, _prev: Option<u8>, b: u8) -> bool {
+        // Lead byte of ∗ (U+2217), † (U+2020) and ‡ (U+2021)
+        b == 0xE2
+    }
+
+    fn starts_at(&self, _prev: Option<char>, c: char) -> bool {
+        self.first(c)
+    }
+
+    fn step(&self, _prev: Option<char>, window: &[char], at_end: bool) -> Step {
+        match window.get(1) {
+            Some(&c) if self.second(c) => Step::Replace(2),
+            Some(_) => Step::Keep,
+            None if at_end => Step::Keep,
+            None => Step::Wait,
+        }
+    }
+
+    fn replace<S: Sink>(&self, matched: &[char], out: &mut S) {
+        out.push(matched[0]);
+        out.push(' ');
+        out.push(matched[1]);
+    }
+}
+
+/// `([.!?]) ([A-Z])` -> `$1\n\n$2`
+struct SentenceBreak;
+
+impl Rule for SentenceBreak {
+    const LOOKAHEAD: usize = 3;
+
+    fn anchor_byte(&self, _prev: Option<u8>, b: u8) -> bool {
+        matches!(b, b'.' | b'!' | b'?')
+    }
+
+    fn starts_at(&self, _prev: Option<char>, c: char) -> bool {
+        matches!(c, '.' | '!' | '?')
+    }
+
+    fn step(&self, _prev: Option<char>, window: &[char], at_end: bool) -> Step {
+        match (window.get(1), window.get(2)) {
+            (Some(' '), Some(c)) if c.is_ascii_uppercase() => Step::Replace(3),
+            (Some(' '), None) | (None, _) if !at_end => Step::Wait,
+            _ => Step::Keep,
+        }
+    }
+
+    fn replace<S: Sink>(&self, matched: &[char], out: &mut S) {
+        out.push(matched[0]);
+        out.push_str("\n\n");
+        out.push(matched[2]);
+    }
+}
+
+/// `"\n## "` -> `"\n\n## "`, unless the text itself starts with `"## "`
+struct HeadingGap<'a, S> {
+    head: String,
+    enabled: Option<bool>,
+    inner: Rewrite<'a, Literal, S>,
+}
+
+impl<'a, S: Sink> HeadingGap<'a, S> {
+    fn new(next: &'a mut S) -> Self {
+        Self {
+            head: String::new(),
+            enabled: None,
+            inner: Rewrite::new(Literal::new("\n## ", "\n\n## "), next),
+        }
+    }
+
+    fn decide(&mut self) {
+        self.enabled = Some(!self.head.starts_with("## "));
+        let head = std::mem::take(&mut self.head);
+        self.push_str(&head);
+    }
+}
+
+impl<S: Sink> Sink for HeadingGap<'_, S> {
+    fn push(&mut self, c: char) {
+        match self.enabled {
+            Some(true) => self.inner.push(c),
+            Some(false) => self.inner.next.push(c),
+            None => {
+                self.head.push(c);
+                if self.head.len() >= 3 {
+                    self.decide();
+                }
+            }
+        }
+    }
+
+    fn push_str(&mut self, s: &str) {
+        match self.enabled {
+            Some(true) => self.inner.push_str(s),
+            Some(false) => self.inner.next.push_str(s),
+            None => {
+                for c in s.chars() {
+                    self.push(c);
+                }
+            }
+        }
+    }
+
+    fn finish(&mut self) {
+        if self.enabled.is_none() {
+            self.decide();
+        }
+        self.inner.finish();
+    }
+}
+
+/// Title/author split, applied once within the first [`TITLE_REGION`] bytes
+struct TitleSplit<'a, S> {
+    head: Option<String>,
+    next: &'a mut S,
+}
+
+impl<'a, S: Sink> TitleSplit<'a, S> {
+    fn new(next: &'a mut S) -> Self {
+        Self {
+            head: Some(String::with_capacity(TITLE_REGION + 4)),
+            next,
+        }
+    }
+
+    fn flush(&mut self) {
+        let Some(head) = self.head.take() else {
+            return;
+        };
+        let pattern = title_author_pattern();
+
+        if head.len() > TITLE_REGION {
+            // Nearest char boundary at or before the region end
+            let mut idx = TITLE_REGION;
+            while idx > 0 && !head.is_char_boundary(idx) {
+                idx -= 1;
+            }
+            let (prefix, suffix) = head.split_at(idx);
+            self.next.push_str(&pattern.replace(prefix, "## $1\n\n$2"));
+            self.next.push_str(suffix);
+        } else {
+            self.next.push_str(&pattern.replace(&head, "## $1\n\n$2"));
+        }
+    }
+}
+
+impl<S: Sink> Sink for TitleSplit<'_, S> {
+    fn push(&mut self, c: char) {
+        match &mut self.head {
+            Some(head) => {
+                head.push(c);
+                if head.len() > TITLE_REGION {
+                    self.flush();
+                }
+            }
+            None => self.next.push(c),
+        }
+    }
+
+    fn push_str(&mut self, s: &str) {
+        if self.head.is_some() {
+            for c in s.chars() {
+                self.push(c);
+            }
+        } else {
+            self.next.push_str(s);
+        }
+    }
+
+    fn finish(&mut self) {
+        self.flush();
+        self.next.finish();
+    }
+}
+
+/// `trim_start_matches('\n')`
+struct TrimLeadingNewlines<'a, S> {
+    started: bool,
+    next: &'a mut S,
+}
+
+impl<S: Sink> Sink for TrimLeadingNewlines<'_, S> {
+    fn push(&mut self, c: char) {
+        if self.started || c != '\n' {
+            self.started = true;
+            self.next.push(c);
+        }
+    }
+
+    fn push_str(&mut self, s: &str) {
+        let s = if self.started {
+            s
+        } else {
+            s.trim_start_matches('\n')
+        };
+        if !s.is_empty() {
+            self.started = true;
+            self.next.push_str(s);
+        }
+    }
+
+    fn finish(&mut self) {
+        self.next.finish();
+    }
+}
+
+/// `str::trim`: whitespace is held back until something follows it
+struct Trim<'a, S> {
+    started: bool,
+    spaces: String,
+    next: &'a mut S,
+}
+
+impl<'a, S: Sink> Trim<'a, S> {
+    fn new(next: &'a mut S) -> Self {
+        Self {
+            started: false,
+            spaces: String::new(),
+            next,
+        }
+    }
+}
+
+impl<S: Sink> Sink for Trim<'_, S> {
+    fn push(&mut self, c: char) {
+        if c.is_whitespace() {
+            if self.started {
+                self.spaces.push(c);
+            }
+        } else {
+            self.started = true;
+            if !self.spaces.is_empty() {
+                self.next.push_str(&self.spaces);
+                self.spaces.clear();
+            }
+            self.next.push(c);
+        }
+    }
+
+    fn push_str(&mut self, s: &str) {
+        let Some(body_end) = s
+            .char_indices()
+            .rev()
+            .find(|(_, c)| !c.is_whitespace())
+            .map(|(i, c)| i + c.len_utf8())
+        else {
+            for c in s.chars() {
+                self.push(c);
+            }
+            return;
+        };
+        let body = if self.started {
+            &s[..body_end]
+        } else {
+            s[..body_end].trim_start()
+        };
+
+        self.started = true;
+        if !self.spaces.is_empty() {
+            self.next.push_str(&self.spaces);
+            self.spaces.clear();
+        }
+        self.next.push_str(body);
+        self.spaces.push_str(&s[body_end..]);
+    }
+
+    fn finish(&mut self) {
+        self.spaces.clear();
+        self.next.finish();
+    }
+}
+
+/// Repeated `"\n\n\n"` -> `"\n\n"` passes over each run of newlines
+struct CollapseNewlines<'a, S> {
+    passes: usize,
+    run: usize,
+    next: &'a mut S,
+}
+
+impl<S: Sink> CollapseNewlines<'_, S> {
+    fn flush(&mut self) {
+        let mut run = self.run;
+        for _ in 0..self.passes {
+            run = run / 3 * 2 + run % 3;
+        }
+        for _ in 0..run {
+            self.next.push('\n');
+        }
+        self.run = 0;
+    }
+}
+
+impl<S: Sink> Sink for CollapseNewlines<'_, S> {
+    fn push(&mut self, c: char) {
+        if c == '\n' {
+            self.run += 1;
+        } else {
+            self.flush();
+            self.next.push(c);
+        }
+    }
+
+    fn push_str(&mut self, mut s: &str) {
+        while !s.is_empty() {
+            match s.find('\n') {
+                Some(0) => {
+                    self.run += 1;
+                    s = &s[1..];
+                }
+                Some(i) => {
+                    self.flush();
+                    self.next.push_str(&s[..i]);
+                    s = &s[i..];
+                }
+                None => {
+                    self.flush();
+                    self.next.push_str(s);
+                    return;
+                }
+            }
+        }
+    }
+
+    fn finish(&mut self) {
+        self.flush();
+        self.next.finish();
+    }
+}
+
+/// Joins an author line ending in a footnote symbol with the email line after
+/// the blank line that follows it; otherwise re-emits `str::lines` joined by `\n`
+struct AuthorLines<'a, S> {
+    current: String,
+    lines: std::collections::VecDeque<String>,
+    spare: Vec<String>,
+    next: &'a mut S,
+}
+
+impl<'a, S: Sink> AuthorLines<'a, S> {
+    fn new(next: &'a mut S) -> Self {
+        Self {
+            current: String::new(),
+            lines: std::collections::VecDeque::with_capacity(3),
+            spare: Vec::new(),
+            next,
+        }
+    }
+
+    fn end_line(&mut self) {
+        let spare = self.spare.pop().unwrap_or_default();
+        let mut line = std::mem::replace(&mut self.current, spare);
+        if line.ends_with('\r') {
+            line.pop();
+        }
+        self.lines.push_back(line);
+        self.drain(false);
+    }
+
+    fn recycle(&mut self, mut line: String) {
+        line.clear();
+        self.spare.push(line);
+    }
+
+    /// Emit the front line once the two lines after it are known
+    fn drain(&mut self, at_end: bool) {
+        while self.lines.len() >= 3 || (at_end && !self.lines.is_empty()) {
+            let current = &self.lines[0];
+            let has_symbol = current.chars().next_back().is_some_and(is_footnote_symbol);
+            let should_join = has_symbol
+                && !current.contains('@')
+                && self.lines.len() > 2
+                && self.lines[1].is_empty()
+                && self.lines[2].contains('@');
+
+            if should_join {
+                self.next.push_str(&self.lines[0]);
+                self.next.push(' ');
+                self.next.push_str(&self.lines[2]);
+                self.next.push_str("\n\n");
+                for _ in 0..3 {
+                    if let Some(line) = self.lines.pop_front() {
+                        self.recycle(line);
+                    }
+                }
+            } else {
+                self.next.push_str(current);
+                self.next.push('\n');
+                if let Some(line) = self.lines.pop_front() {
+                    self.recycle(line);
+                }
+            }
+        }
+    }
+}
+
+impl<S: Sink> Sink for AuthorLines<'_, S> {
+    fn push(&mut self, c: char) {
+        if c == '\n' {
+            self.end_line();
+        } else {
+            self.current.push(c);
+        }
+    }
+
+    fn push_str(&mut self, mut s: &str) {
+        while let Some(i) = s.find('\n') {
+            self.current.push_str(&s[..i]);
+            self.end_line();
+            s = &s[i + 1..];
+        }
+        self.current.push_str(s);
+    }
+
+    fn finish(&mut self) {
+        // Same as `str::lines`: a final line without '\n' keeps a trailing '\r'
+        if !self.current.is_empty() {
+            let line = std::mem::take(&mut self.current);
+            self.lines.push_back(line);
+        }
+        self.drain(true);
+        self.next.finish();
+    }
+}
+
+/// Second round of single-letter joins, run on each `[a-z ]` run
+struct LetterRuns<'a, S> {
+    run: Vec<u8>,
+    next: &'a mut S,
+}
+
+impl<S: Sink> LetterRuns<'_, S> {
+    fn flush(&mut self) {
+        for _ in 0..2 {
+            join_letter_pairs(&mut self.run);
+        }
+        for &b in &self.run {
+            self.next.push(char::from(b));
+        }
+        self.run.clear();
+    }
+}
+
+impl<S: Sink> Sink for LetterRuns<'_, S> {
+    fn push(&mut self, c: char) {
+        if c == ' ' || c.is_ascii_lowercase() {
+            self.run.push(c as u8);
+        } else {
+            if !self.run.is_empty() {
+                self.flush();
+            }
+            self.next.push(c);
+        }
+    }
+
+    fn finish(&mut self) {
+        self.flush();
+        self.next.finish();
+    }
+}
+
+fn is_letter_run_byte(b: u8) -> bool {
+    b == b' ' || b.is_ascii_lowercase()
+}
+
+/// In-place `str::replace(pattern, replacement)` for a shorter replacement
+fn replace_shorter(run: &mut Vec<u8>, pattern: &[u8], replacement: &[u8]) {
+    let (mut read, mut write) = (0, 0);
+    while read < run.len() {
+        if run[read..].starts_with(pattern) {
+            run[write..write + replacement.len()].copy_from_slice(replacement);
+            write += replacement.len();
+            read += pattern.len();
+        } else {
+            run[write] = run[read];
+            write += 1;
+            read += 1;
+        }
+    }
+    run.truncate(write);
+}
+
+/// One in-place pass of `" ([a-z]) ([a-z]) "` -> `" $1$2 "`
+fn join_letter_pairs(run: &mut Vec<u8>) {
+    let (mut read, mut write) = (0, 0);
+    while read < run.len() {
+        let pair = run.get(read..read + 5).and_then(|w| match *w {
+            [b' ', a, b' ', b, b' '] if a.is_ascii_lowercase() && b.is_ascii_lowercase() => {
+                Some((a, b))
+            }
+            _ => None,
+        });
+        if let Some((a, b)) = pair {
+            run[write..write + 4].copy_from_slice(&[b' ', a, b, b' ']);
+            write += 4;
+            read += 5;
+        } else {
+            run[write] = run[read];
+            write += 1;
+            read += 1;
+        }
+    }
+    run.truncate(write);
+}
+
+/// Could any split-word rule match? Each needs "x y " (letter, space,
+/// letter, space) that is either preceded by a space or one of the
+/// unanchored [`WORD_FIXES`] pairs
+fn has_split_word(bytes: &[u8]) -> bool {
+    bytes.windows(4).enumerate().any(|(i, w)| {
+        w[0].is_ascii_lowercase()
+            && w[1] == b' '
+            && w[2].is_ascii_lowercase()
+            && w[3] == b' '
+            && ((i > 0 && bytes[i - 1] == b' ')
+                || matches!(
+                    [w[0], w[2]],
+                    [b'o', b'f']
+                        | [b't', b'o']
+                        | [b'i', b'n']
+                        | [b'o', b'n']
+                        | [b'a', b's']
+                        | [b'a', b't']
+                ))
+    })
+}
+
+/// Split-word fixes for one `[a-z ]` run: [`WORD_FIXES`] then two letter-pair passes
+fn fix_split_words(run: &mut Vec<u8>) {
+    if !has_split_word(run) {
+        return;
+    }
+    for (bad, good) in WORD_FIXES {
+        replace_shorter(run, bad.as_bytes(), good.as_bytes());
+    }
+    for _ in 0..2 {
+        join_letter_pairs(run);
+    }
+}
+
+/// Trimmed input lines, with footnote-symbol lines folded into the name before
+///
+/// All lines live in one buffer; a joined line simply extends the last range.
+struct LineTable {
+    text: String,
+    ranges: Vec<Range<usize>>,
+}
+
+impl LineTable {
+    fn new(input: &str, fix_words: bool) -> Self {
+        let mut table = Self {
+            text: String::with_capacity(input.len()),
+            ranges: Vec::new(),
+        };
+        let mut fixed = String::new();
+        let mut run = Vec::new();
+
+        for raw in input.lines() {
+            let line = if fix_words && has_split_word(raw.as_bytes()) {
+                fixed.clear();
+                let bytes = raw.as_bytes();
+                let mut start = 0;
+                while start < bytes.len() {
+                    let end = start
+                        + bytes[start..]
+                            .iter()
+                            .position(|&b| {
+                                is_letter_run_byte(b) != is_letter_run_byte(bytes[start])
+                            })
+                            .unwrap_or(bytes.len() - start);
+                    if is_letter_run_byte(bytes[start]) {
+                        run.clear();
+                        run.extend_from_slice(&bytes[start..end]);
+                        fix_split_words(&mut run);
+                        fixed.extend(run.iter().map(|&b| char::from(b)));
+                    } else {
+                        fixed.push_str(&raw[start..end]);
+                    }
+                    start = end;
+                }
+                fixed.as_str()
+            } else {
+                raw
+            };
+            table.push(line.trim());
+        }
+        table
+    }
+
+    fn push(&mut self, current: &str) {
+        // If a line starts with ∗/†/‡ and the previous line looks like a name
+        // (short, has capitals, no @), they belong together
+        if current.starts_with(is_footnote_symbol) {
+            if let Some(last) = self.ranges.last_mut() {
+                let prev = &self.text[last.clone()];
+                if prev.len() < 50
+                    && prev.len() > 5
+                    && !prev.contains('@')
+                    && prev.chars().filter(|c| c.is_uppercase()).count() >= 2
+                {
+                    self.text.push(' ');
+                    self.text.push_str(current);
+                    last.end = self.text.len();
+                    return;
+                }
+            }
+        }
+
+        let start = self.text.len();
+        self.text.push_str(current);
+        self.ranges.push(start..self.text.len());
+    }
+
+    fn lines(&self) -> Vec<&str> {
+        self.ranges.iter().map(|r| &self.text[r.clone()]).collect()
+    }
+}
+
+/// Front of the stage chain for the paragraph builder
+///
+/// Holds back the last char so a trailing hyphen can still be popped, and
+/// answers the `ends_with` questions the builder asks about its own output.
+struct ParagraphWriter<'a, S> {
+    next: &'a mut S,
+    /// Last two chars already passed on
+    sent: [Option<char>; 2],
+    held: Option<char>,
+    len: usize,
+}
+
+impl<'a, S: Sink> ParagraphWriter<'a, S> {
+    fn new(next: &'a mut S) -> Self {
+        Self {
+            next,
+            sent: [None, None],
+            held: None,
+            len: 0,
+        }
+    }
+
+    fn is_empty(&self) -> bool {
+        self.len == 0
+    }
+
+    fn tail(&self) -> [Option<char>; 2] {
+        match self.held {
+            Some(c) => [self.sent[1], Some(c)],
+            None => self.sent,
+        }
+    }
+
+    fn ends_with(&self, c: char) -> bool {
+        self.tail()[1] == Some(c)
+    }
+
+    fn ends_with_blank_line(&self) -> bool {
+        self.tail() == [Some('\n'), Some('\n')]
+    }
+
+    fn push(&mut self, c: char) {
+        if let Some(held) = self.held.replace(c) {
+            self.next.push(held);
+            self.sent = [self.sent[1], Some(held)];
+        }
+        self.len += c.len_utf8();
+    }
+
+    fn push_str(&mut self, s: &str) {
+        let Some(last) = s.chars().next_back() else {
+            return;
+        };
+        let body = &s[..s.len() - last.len_utf8()];
+        if !body.is_empty() {
+            if let Some(held) = self.held.take() {
+                self.next.push(held);
+                self.sent = [self.sent[1], Some(held)];
+            }
+            self.next.push_str(body);
+            let mut tail = body.chars().rev();
+            let (b1, b0) = (tail.next(), tail.next());
+            self.sent = [if b0.is_some() { b0 } else { self.sent[1] }, b1];
+            self.len += body.len();
+        }
+        self.push(last);
+    }
+
+    fn pop(&mut self) {
+        if let Some(held) = self.held.take() {
+            self.len -= held.len_utf8();
+        }
+    }
+
+    fn finish(&mut self) {
+        if let Some(held) = self.held.take() {
+            self.next.push(held);
+        }
+        self.next.finish();
+    }
+}
+
+/// Join lines that belong to the same paragraph (Docling-style)
+///
+/// With `fix_words` the split-word repairs for pdf-extract output run on the
+/// input lines and again on the result (the "enhanced" precision mode).
+pub(crate) fn join_paragraph_lines(text: &str, fix_words: bool) -> String {
+    let table = LineTable::new(text, fix_words);
+    let lines = table.lines();
+
+    let mut out = String::with_capacity(text.len() + text.len() / 5);
+    if fix_words {
+        let mut letters = LetterRuns {
+            run: Vec::new(),
+            next: &mut out,
+        };
+        write_paragraphs(&lines, &mut letters);
+    } else {
+        write_paragraphs(&lines, &mut out);
+    }
+    out
+}
+
+/// Build the paragraph text and stream it through the cleanup stages
+fn write_paragraphs<S: Sink>(lines: &[&str], sink: &mut S) {
+    let upper = |c: char| c.is_ascii_uppercase();
+    let letter = |c: char| c.is_ascii_alphabetic();
+
+    let mut trim = Trim::new(sink);
+    let mut authors = AuthorLines::new(&mut trim);
+    // "∗Equal" -> "∗ Equal"
+    let mut symbol_capital = Rewrite::new(SymbolSpacing { symbol_first: true }, &mut authors);
+    // "Vaswani∗" -> "Vaswani ∗"
+    let mut letter_symbol = Rewrite::new(
+        SymbolSpacing {
+            symbol_first: false,
+        },
+        &mut symbol_capital,
+    );
+    // "x+Sublayer" -> "x +Sublayer"
+    let mut plus_capital = Rewrite::new(
+        SpacedOperator {
+            before: |c| c.is_ascii_lowercase(),
+            operator: '+',
+            after: upper,
+            space_before: true,
+        },
+        &mut letter_symbol,
+    );
+    // "LayerNorm(x" -> "LayerNorm( x"
+    let mut func_paren = Rewrite::new(
+        SpacedOperator {
+            before: letter,
+            operator: '(',
+            after: |c| c.is_ascii_lowercase(),
+            space_before: false,
+        },
+        &mut plus_capital,
+    );
+    // "ht" -> "h t", "x1" -> "x 1"
+    let mut math_letter = Rewrite::new(
+        MathVariable {
+            second: |c| c.is_ascii_lowercase(),
+        },
+        &mut func_paren,
+    );
+    let mut math_number = Rewrite::new(
+        MathVariable {
+            second: |c| c.is_ascii_digit(),
+        },
+        &mut math_letter,
+    );
+    // "2Figure 1:" -> "\n\nFigure 1:"
+    let mut page_number = Rewrite::new(PageNumberCaption, &mut math_number);
+    let mut leading = TrimLeadingNewlines {
+        started: false,
+        next: &mut page_number,
+    };
+    let mut title = TitleSplit::new(&mut leading);
+    // "AbstractThe" -> "## Abstract\n\nThe"
+    let mut sections = Rewrite::new(SectionHeading, &mut title);
+    let mut heading_gap = HeadingGap::new(&mut sections);
+    let mut heading_space = Rewrite::new(Literal::new("##  ", "## "), &mut heading_gap);
+
+    let mut result = ParagraphWriter::new(&mut heading_space);
+    build_paragraphs(lines, &mut result);
+    result.finish();
+}
+
+/// Paragraph, heading and author-block decisions, line by line
+fn build_paragraphs<S: Sink>(lines: &[&str], result: &mut ParagraphWriter<'_, S>) {
+    let mut i = 0;
+
+    while i < lines.len() {
+        let line = lines[i];
+        let trimmed = line.trim();
+
+        // Skip empty lines (they will be added when needed)
+        if trimmed.is_empty() {
+            i += 1;
+            continue;
+        }
+
+        // Pre-compute line context
+        let prev_empty = i == 0
+            || lines
+                .get(i - 1)
+                .map(|l| l.trim().is_empty())
+                .unwrap_or(false);
+        let next_empty = i == lines.len() - 1
+            || lines
+                .get(i + 1)
+                .map(|l| l.trim().is_empty())
+                .unwrap_or(false);
+        let has_next = i + 1 < lines.len();
+
+        // GENERIC RULES - work for ANY academic/scientific document
+
+        // RULE 1: Common section keywords (standard in academic papers)
+        let common_sections = [
+            "Abstract",
+            "Introduction",
+            "Background",
+            "Methods",
+            "Results",
+            "Discussion",
+            "Conclusion",
+            "References",
+            "Acknowledgments",
+            "Appendix",
+            "Summary",
+        ];
+        let is_common_section = common_sections.contains(&trimmed);
+
+        // RULE 1b: Detect paper titles (short lines early in document that look like titles)
+        // Pattern: "Attention Is All You Need", "Transformer Architecture", etc.
+        let looks_like_title = trimmed.len() > 15 && trimmed.len() < 100 &&  // Reasonable length
+                              trimmed.split_whitespace().count() >= 3 &&  // Multiple words
+                              trimmed.split_whitespace().count() <= 10 &&  // Not too many words
+                              !trimmed.contains('@') &&  // Not an email
+                              !trimmed.contains('(') &&  // Not a citation
+                              !trimmed.contains("Provided") &&  // Not copyright
+                              !trimmed.ends_with('.') &&  // Titles don't end with period
+                              trimmed.chars().next().map(|c| c.is_uppercase()).unwrap_or(false); // Starts with capital
+
+        let is_likely_title =
+            i < 5 && looks_like_title && trimmed.chars().filter(|c| c.is_uppercase()).count() >= 3; // Multiple capitals
+
+        // RULE 2: Numbered sections: "1 Introduction", "2.1 Background", etc.
+        let is_numbered_section = trimmed.len() > 2
+            && trimmed
+                .chars()
+                .next()
+                .map(|c| c.is_numeric())
+                .unwrap_or(false)
+            && trimmed.contains(' ')
+            && trimmed.len() < 100;
+
+        // RULE 3: Footnote paragraph (starts with symbols ∗, †, ‡ and has content)
+        let is_footnote = trimmed.len() > 20 && trimmed.starts_with(is_footnote_symbol);
+
+        // RULE 4: Detect author metadata blocks (common in academic papers)
+        let has_email = trimmed.contains('@');
+        let has_symbol = trimmed.contains(is_footnote_symbol);
+        let is_author_metadata_region = i < 30 && trimmed.len() < 200;
+
+        // Author lines with complete info should stay together
+        // Pattern: "Name ∗ Affiliation email@domain.com" (all on one line)
+        let is_complete_author_line = is_author_metadata_region
+            && has_email
+            && has_symbol
+            && trimmed.split_whitespace().count() >= 4;
+
+        if is_complete_author_line {
+            if !result.is_empty() && !result.ends_with('\n') {
+                result.push('\n');
+            }
+            result.push_str(trimmed);
+            result.push_str("\n\n");
+            i += 1;
+            continue;
+        }
+
+        // Author name with symbol but no email - check if next line has email
+        let is_author_name_only = is_author_metadata_region
+            && has_symbol
+            && !has_email
+            && trimmed.split_whitespace().count() >= 2
+            && trimmed.split_whitespace().count() <= 4;
+
+        if is_author_name_only && has_next {
+            let next_line = lines[i + 1].trim();
+            let next_has_email = next_line.contains('@');
+
+            // If next line is just an email, DON'T join - keep separate
+            // This matches Docling's format where name+symbol is on one line, email on next
+            if next_has_email && next_line.split_whitespace().count() == 1 {
+                if !result.is_empty() && !result.ends_with('\n') {
+                    result.push('\n');
+                }
+                result.push_str(trimmed);
+                result.push_str("\n\n");
+                i += 1;
+                continue;
+            }
+        }
+
+        // RULE 5: Single email line (join with previous - part of author block)
+        let is_email_only = has_email && trimmed.split_whitespace().count() == 1 && !prev_empty;
+
+        // RULE 6: Standalone symbol line (early in doc, likely footnote reference)
+        let is_symbol_only = is_author_metadata_region
+            && trimmed.len() < 5
+            && matches!(trimmed, "∗" | "†" | "‡" | "∗ †" | "∗ ‡");
+
+        // Apply heading detection
+        if is_common_section || is_numbered_section || is_likely_title {
+            if !result.is_empty() && !result.ends_with_blank_line() {
+                result.push_str("\n\n");
+            }
+            result.push_str("## ");
+            result.push_str(trimmed);
+            result.push_str("\n\n");
+            i += 1;
+            continue;
+        }
+
+        // Apply footnote detection (separate paragraph)
+        if is_footnote {
+            if !result.is_empty() && !result.ends_with_blank_line() {
+                result.push_str("\n\n");
+            }
+            result.push_str(trimmed);
+            result.push_str("\n\n");
+            i += 1;
+            continue;
+        }
+
+        // Join standalone email with previous line
+        if is_email_only {
+            result.push(' ');
+            result.push_str(trimmed);
+            result.push_str("\n\n");
+            i += 1;
+            continue;
+        }
+
+        // Keep standalone symbol lines separate
+        if is_symbol_only {
+            if !result.is_empty() && !result.ends_with('\n') {
+                result.push('\n');
+            }
+            result.push_str(trimmed);
+            result.push_str("\n\n");
+            i += 1;
+            continue;
+        }
+
+        // Regular text - join with previous line if it's part of the same paragraph
+        if !result.is_empty() && !result.ends_with_blank_line() && !prev_empty {
+            // Remove trailing hyphen if present (word continuation)
+            if result.ends_with('-') {
+                result.pop();
+            } else if !result.ends_with(' ') {
+                result.push(' ');
+            }
+        }
+
+        result.push_str(trimmed);
+
+        // Check if this line ends a sentence (period, colon, etc.)
+        let ends_sentence = trimmed.ends_with(['.', ':', '!', '?']);
+
+        // Don't end paragraph on abbreviations
+        let is_abbreviation = trimmed.ends_with(" al.")
+            || trimmed.ends_with(" Fig.")
+            || trimmed.ends_with(" et.")
+            || trimmed.ends_with(" vs.");
+
+        // Add paragraph break if sentence ends and it's not an abbreviation
+        if ends_sentence && !is_abbreviation && next_empty {
+            result.push_str("\n\n");
+        }
+
+        i += 1;
+    }
+
+    // No `\n\n\n` collapse needed: the writer never emits more than two
+    // newlines in a row (every break is pushed only after checking the tail)
+}
+
+/// Break long single-line text (lopdf output) into paragraphs
+pub(crate) fn break_long_text_into_paragraphs(text: &str) -> String {
+    let mut out = String::with_capacity(text.len() + text.len() / 10);
+
+    let mut trim = Trim::new(&mut out);
+    let mut collapse = CollapseNewlines {
+        passes: 2,
+        run: 0,
+        next: &mut trim,
+    };
+    // Line breaks before headings
+    let mut h1 = Rewrite::new(Literal::new(" # ", "\n\n# "), &mut collapse);
+    let mut h2 = Rewrite::new(Literal::new(" ## ", "\n\n## "), &mut h1);
+    // ". A" -> ".\n\nA"
+    let mut sentences = Rewrite::new(SentenceBreak, &mut h2);
+    sentences.push_str(text);
+    sentences.finish();
+
+    out
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    /// Run one rule over `text`, fed in chunks of `chunk` chars
+    fn rewrite<R: Rule>(rule: R, text: &str, chunk: usize) -> String {
+        let mut out = String::new();
+        let mut stage = Rewrite::new(rule, &mut out);
+        let chars: Vec<char> = text.chars().collect();
+        for piece in chars.chunks(chunk) {
+            stage.push_str(&piece.iter().collect::<String>());
+        }
+        stage.finish();
+        out
+    }
+
+    fn assert_matches_regex<R: Rule>(
+        rule: impl Fn() -> R,
+        pattern: &str,
+        replacement: &str,
+        text: &str,
+    ) {
+        let expected = Regex::new(pattern).unwrap().replace_all(text, replacement);
+        for chunk in [1, 2, 3, 7, text.len().max(1)] {
+            assert_eq!(
+                rewrite(rule(), text, chunk),
+                expected,
+                "chunk {chunk} of {text:?}"
+            );
+        }
+    }
+
+    #[test]
+    fn test_rules_match_regex() {
+        let texts = [
+            "a(b(c LayerNorm(x) f(X)",
+            "x+Sublayer a+B+C +A ab+c",
+            "ht x1 is ab1 é1 a1b q9 z",
+            "Vaswani∗ ∗Equal †‡A a∗B",
+            "end. Next? yes! No. x.Y .  A",
+        ];
+        for text in texts {
+            assert_matches_regex(
+                || SpacedOperator {
+                    before: |c| c.is_ascii_alphabetic(),
+                    operator: '(',
+                    after: |c| c.is_ascii_lowercase(),
+                    space_before: false,
+                },
+                r"([a-zA-Z])\(([a-z])",
+                "$1( $2",
+                text,
+            );
+            assert_matches_regex(
+                || SpacedOperator {
+                    before: |c| c.is_ascii_lowercase(),
+                    operator: '+',
+                    after: |c| c.is_ascii_uppercase(),
+                    space_before: true,
+                },
+                r"([a-z])\+([A-Z])",
+                "$1 +$2",
+                text,
+            );
+            assert_matches_regex(
+                || MathVariable {
+                    second: |c| c.is_ascii_lowercase(),
+                },
+                r"\b([a-z])([a-z])\b",
+                "$1 $2",
+                text,
+            );
+            assert_matches_regex(
+                || SymbolSpacing {
+                    symbol_first: false,
+                },
+                r"([a-zA-Z])([∗†‡])",
+                "$1 $2",
+                text,
+            );
+            assert_matches_regex(
+                || SymbolSpacing { symbol_first: true },
+                r"([∗†‡])([A-Z])",
+                "$1 $2",
+                text,
+            );
+            assert_matches_regex(|| SentenceBreak, r"([.!?]) ([A-Z])", "$1\n\n$2", text);
+        }
+    }
+
+    #[test]
+    fn test_literal_matches_str_replace() {
+        for text in ["##   x", "## ##  y", "a ##  ##  b #"] {
+            for chunk in [1, 2, 5, text.len()] {
+                assert_eq!(
+                    rewrite(Literal::new("##  ", "## "), text, chunk),
+                    text.replace("##  ", "## ")
+                );
+            }
+        }
+    }
+
+    #[test]
+    fn test_section_heading_split() {
+        assert_eq!(
+            rewrite(SectionHeading, "AbstractThe model. xIntroductionWe", 4),
+            "## Abstract\n\nThe model. xIntroductionWe"
+        );
+    }
+
+    #[test]
+    fn test_collapse_newlines() {
+        let mut out = String::new();
+        let mut collapse = CollapseNewlines {
+            passes: 2,
+            run: 0,
+            next: &mut out,
+        };
+        collapse.push_str("a\n\n\n\n\n\n\nb\n\nc");
+        collapse.finish();
+
+        let mut expected = "a\n\n\n\n\n\n\nb\n\nc".to_string();
+        for _ in 0..2 {
+            expected = expected.replace("\n\n\n", "\n\n");
+        }
+        assert_eq!(out, expected);
+    }
+
+    #[test]
+    fn test_split_words_fixed() {
+        assert_eq!(
+            join_paragraph_lines("This i s a t est of the model", true),
+            "This is at est of the model"
+        );
+        assert_eq!(
+            join_paragraph_lines("This i s kept", false),
+            "This i s kept"
+        );
+    }
+}
@@ -1,6 +1,6 @@
 //! Converter trait definitions
 
-use std::path::Path;
+use std::path::{Path, PathBuf};
 
 use async_trait::async_trait;
 
@@ -29,10 +29,70 @@ pub trait DocumentConverter: Send + Sync {
         options: ConversionOptions,
     ) -> Result<ConversionResult>;
 
+    /// Convert a document whose input format has already been detected
+    ///
+    /// [`Converter`](crate::Converter) detects the format once and calls this,
+    /// so converters that report or branch on the input format override it
+    /// instead of sniffing the file again. The default ignores `input_format`.
+    async fn convert_detected(
+        &self,
+        input: &Path,
+        input_format: FileFormat,
+        output_format: OutputFormat,
+        options: ConversionOptions,
+    ) -> Result<ConversionResult> {
+        let _ = input_format;
+        self.convert(input, output_format, options).await
+    }
+
+    /// Convert a document held in memory, such as an archive member
+    ///
+    /// `name` is reported as the input path. The default writes `data` to a
+    /// temporary file (keeping the extension of `name`, which some external
+    /// tools rely on) and converts that; converters that can parse from
+    /// memory override it.
+    async fn convert_bytes(
+        &self,
+        name: &str,
+        data: Vec<u8>,
+        input_format: FileFormat,
+        output_format: OutputFormat,
+        options: ConversionOptions,
+    ) -> Result<ConversionResult> {
+        convert_bytes_via_file(self, name, data, input_format, output_format, options).await
+    }
+
     /// Get converter metadata
     fn metadata(&self) -> ConverterMetadata;
 }
 
+/// Convert in-memory `data` by writing it to a temporary file first
+///
+/// The default [`DocumentConverter::convert_bytes`]; overrides fall back to
+/// it for outputs that need a file, such as those rendered by LibreOffice.
+pub(crate) async fn convert_bytes_via_file<C: DocumentConverter + ?Sized>(
+    converter: &C,
+    name: &str,
+    data: Vec<u8>,
+    input_format: FileFormat,
+    output_format: OutputFormat,
+    options: ConversionOptions,
+) -> Result<ConversionResult> {
+    let suffix = Path::new(name)
+        .extension()
+        .and_then(|ext| ext.to_str())
+        .map(|ext| format!(".{}", ext))
+        .unwrap_or_default();
+    let file = tempfile::Builder::new().suffix(&suffix).tempfile()?;
+    tokio::fs::write(file.path(), data).await?;
+
+    let mut result = converter
+        .convert_detected(file.path(), input_format, output_format, options)
+        .await?;
+    result.input_path = PathBuf::from(name);
+    Ok(result)
+}
+
 /// Metadata about a converter
 #[derive(Debug, Clone)]
 pub struct ConverterMetadata {
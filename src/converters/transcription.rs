@@ -0,0 +1,626 @@
+//! Speech transcription through resident Whisper workers
+//!
+//! Loading a Whisper model takes longer than transcribing a short clip, so
+//! instead of running the `whisper` CLI per file, a small pool of worker
+//! processes keeps the model loaded and is fed over stdin/stdout (see
+//! `whisper_worker.py` for the protocol).
+//!
+//! FFmpeg decodes the input to 16 kHz mono PCM on a pipe. The stream is cut
+//! into segments at pauses in speech as it arrives, and the segments are
+//! transcribed concurrently by the pool while decoding continues.
+//!
+//! Workers are plain child processes talked to from blocking threads, so
+//! the process-wide pool is not tied to the runtime that started them. A
+//! worker that does not answer within the segment timeout is killed.
+//!
+//! Environment:
+//! - `TRANSMUTATION_WHISPER_WORKER`: worker command line (default: the
+//!   bundled Python worker on the interpreter that has `openai-whisper`)
+//! - `TRANSMUTATION_WHISPER_MODEL`: model of the bundled worker (`base`)
+//! - `TRANSMUTATION_WHISPER_WORKERS`: number of resident workers
+//! - `TRANSMUTATION_WHISPER_TIMEOUT`: seconds one segment may take
+
+use std::io::{BufRead, BufReader, Write};
+use std::path::{Path, PathBuf};
+use std::process::{self, Child, ChildStdin, ChildStdout, Stdio};
+use std::sync::{Arc, Mutex, OnceLock};
+use std::time::Duration;
+
+use serde::Deserialize;
+use tokio::io::{AsyncRead, AsyncReadExt};
+use tokio::process::Command;
+use tokio::sync::Semaphore;
+use tokio::task::JoinSet;
+
+use crate::{Result, TransmutationError};
+
+/// Python worker run by default
+const WORKER_SCRIPT: &str = include_str!("whisper_worker.py");
+
+/// PCM sample rate requested from FFmpeg (what Whisper expects)
+const SAMPLE_RATE: usize = 16_000;
+
+/// Bytes per second of 16-bit mono PCM
+const BYTES_PER_SECOND: usize = 2 * SAMPLE_RATE;
+
+/// Energy is measured over 30 ms frames
+const FRAME_BYTES: usize = BYTES_PER_SECOND * 30 / 1000;
+
+/// Segments are not cut before this length...
+const MIN_SEGMENT_BYTES: usize = 10 * BYTES_PER_SECOND;
+
+/// ...and always cut by this one, Whisper's context window
+const MAX_SEGMENT_BYTES: usize = 30 * BYTES_PER_SECOND;
+
+/// A pause is this many quiet frames in a row (300 ms)
+const PAUSE_FRAMES: usize = 10;
+
+/// RMS amplitude below which a frame is quiet (about -38 dBFS)
+const QUIET_RMS: f64 = 400.0;
+
+/// Default time one segment may take before its worker is killed (the
+/// first segment on a new worker also waits for the model to load)
+const SEGMENT_TIMEOUT: Duration = Duration::from_secs(300);
+
+/// Transcribe the audio track of `input` (any format FFmpeg reads)
+pub(crate) async fn transcribe_file(input: &Path, language: Option<&str>) -> Result<String> {
+    let mut ffmpeg = Command::new("ffmpeg")
+        .args(["-nostdin", "-loglevel", "error", "-i"])
+        .arg(input)
+        .args(["-vn", "-f", "s16le", "-acodec", "pcm_s16le", "-ac", "1"])
+        .args(["-ar", &SAMPLE_RATE.to_string(), "pipe:1"])
+        .stdin(Stdio::null())
+        .stdout(Stdio::piped())
+        .stderr(Stdio::piped())
+        .kill_on_drop(true)
+        .spawn()
+        .map_err(|e| {
+            TransmutationError::conversion_failed(format!(
+                "FFmpeg execution failed: {e}. Install: sudo apt-get install ffmpeg"
+            ))
+        })?;
+
+    let (Some(pcm), Some(mut stderr)) = (ffmpeg.stdout.take(), ffmpeg.stderr.take()) else {
+        return Err(TransmutationError::conversion_failed(
+            "FFmpeg pipes unavailable",
+        ));
+    };
+    let errors = tokio::spawn(async move {
+        let mut errors = String::new();
+        let _ = stderr.read_to_string(&mut errors).await;
+        errors
+    });
+
+    let transcript = transcribe_stream(WorkerPool::global(), pcm, language).await?;
+
+    let status = ffmpeg.wait().await?;
+    if !status.success() {
+        let errors = errors.await.unwrap_or_default();
+        return Err(TransmutationError::conversion_failed(format!(
+            "FFmpeg failed: {errors}"
+        )));
+    }
+    Ok(transcript)
+}
+
+/// Transcribe a stream of 16 kHz mono s16le PCM, one line per segment
+async fn transcribe_stream<R: AsyncRead + Unpin>(
+    pool: &Arc<WorkerPool>,
+    mut pcm: R,
+    language: Option<&str>,
+) -> Result<String> {
+    // Segments waiting for a worker are held in memory; bounding them also
+    // stops reading (and FFmpeg) when transcription falls behind
+    let in_flight = Arc::new(Semaphore::new(2 * pool.size));
+    let mut tasks = JoinSet::new();
+    let mut count = 0;
+
+    let mut segmenter = Segmenter::default();
+    let mut segments = Vec::new();
+    let mut buf = vec![0; 64 * 1024];
+    let mut eof = false;
+    while !eof {
+        let read = pcm.read(&mut buf).await?;
+        if read == 0 {
+            eof = true;
+            segments.extend(std::mem::take(&mut segmenter).finish());
+        } else {
+            segmenter.push(&buf[..read], &mut segments);
+        }
+
+        for segment in segments.drain(..) {
+            let permit = Arc::clone(&in_flight)
+                .acquire_owned()
+                .await
+                .map_err(|e| TransmutationError::conversion_failed(e.to_string()))?;
+            let (pool, language) = (Arc::clone(pool), language.map(str::to_string));
+            let index = count;
+            tasks.spawn(async move {
+                let text = pool.transcribe(segment, language).await;
+                drop(permit);
+                (index, text)
+            });
+            count += 1;
+        }
+    }
+
+    let mut texts = vec![String::new(); count];
+    while let Some(joined) = tasks.join_next().await {
+        let (index, text) =
+            joined.map_err(|e| TransmutationError::conversion_failed(e.to_string()))?;
+        texts[index] = text?;
+    }
+    texts.retain(|text| !text.is_empty());
+    Ok(texts.join("\n"))
+}
+
+/// Cuts a PCM stream into segments at pauses
+///
+/// A segment is cut in the middle of the first pause after
+/// [`MIN_SEGMENT_BYTES`], or at the quietest frame once it reaches
+/// [`MAX_SEGMENT_BYTES`]. Segments without any sound are dropped; Whisper
+/// tends to invent text for silence.
+#[derive(Debug, Default)]
+struct Segmenter {
+    /// PCM of the current segment
+    pcm: Vec<u8>,
+    /// Bytes of `pcm` already measured, a whole number of frames
+    scanned: usize,
+    /// Quiet frames in a row ending at `scanned`
+    quiet_run: usize,
+    /// RMS and middle offset of the quietest frame past the minimum length
+    /// (the latest of equally quiet ones)
+    quietest: Option<(f64, usize)>,
+}
+
+impl Segmenter {
+    /// Add PCM, appending the segments it completes to `segments`
+    fn push(&mut self, bytes: &[u8], segments: &mut Vec<Vec<u8>>) {
+        self.pcm.extend_from_slice(bytes);
+
+        while self.scanned + FRAME_BYTES <= self.pcm.len() {
+            let rms = rms(&self.pcm[self.scanned..self.scanned + FRAME_BYTES]);
+            self.scanned += FRAME_BYTES;
+            if rms < QUIET_RMS {
+                self.quiet_run += 1;
+            } else {
+                self.quiet_run = 0;
+            }
+            if self.scanned < MIN_SEGMENT_BYTES {
+                continue;
+            }
+
+            let middle = self.scanned - FRAME_BYTES / 2;
+            if self.quietest.is_none_or(|(quietest, _)| rms <= quietest) {
+                self.quietest = Some((rms, middle));
+            }
+
+            let cut = if self.quiet_run >= PAUSE_FRAMES {
+                let pause_middle = self.scanned - self.quiet_run * FRAME_BYTES / 2;
+                Some(pause_middle.max(MIN_SEGMENT_BYTES))
+            } else if self.scanned >= MAX_SEGMENT_BYTES {
+                self.quietest.map(|(_, at)| at)
+            } else {
+                None
+            };
+            if let Some(cut) = cut {
+                let rest = self.pcm.split_off(cut);
+                let segment = std::mem::replace(&mut self.pcm, rest);
+                if has_sound(&segment) {
+                    segments.push(segment);
+                }
+                self.scanned -= cut;
+                self.quiet_run = 0;
+                self.quietest = None;
+            }
+        }
+    }
+
+    /// The last segment, if it has any sound
+    fn finish(self) -> Option<Vec<u8>> {
+        has_sound(&self.pcm).then_some(self.pcm)
+    }
+}
+
+/// RMS amplitude of s16le samples
+fn rms(pcm: &[u8]) -> f64 {
+    let samples = pcm.len() / 2;
+    if samples == 0 {
+        return 0.0;
+    }
+    let sum: f64 = pcm
+        .chunks_exact(2)
+        .map(|s| f64::from(i16::from_le_bytes([s[0], s[1]])).powi(2))
+        .sum();
+    (sum / samples as f64).sqrt()
+}
+
+fn has_sound(pcm: &[u8]) -> bool {
+    pcm.chunks(FRAME_BYTES).any(|frame| rms(frame) >= QUIET_RMS)
+}
+
+/// Command line of a transcription worker
+#[derive(Debug, Clone)]
+struct WorkerCommand {
+    program: String,
+    args: Vec<String>,
+}
+
+impl WorkerCommand {
+    /// Worker from `TRANSMUTATION_WHISPER_WORKER`, or the bundled Python one
+    fn from_env() -> Self {
+        if let Ok(command) = std::env::var("TRANSMUTATION_WHISPER_WORKER") {
+            let mut parts = command.split_whitespace().map(str::to_string);
+            if let Some(program) = parts.next() {
+                return Self {
+                    program,
+                    args: parts.collect(),
+                };
+            }
+        }
+
+        let model =
+            std::env::var("TRANSMUTATION_WHISPER_MODEL").unwrap_or_else(|_| "base".to_string());
+        Self {
+            program: whisper_python(),
+            args: vec!["-c".to_string(), WORKER_SCRIPT.to_string(), model],
+        }
+    }
+}
+
+/// Python interpreter with `openai-whisper` installed: the pipx
+/// environment if there is one, else `python3`
+fn whisper_python() -> String {
+    let home = PathBuf::from(std::env::var("HOME").unwrap_or_default());
+    [".local/share/pipx/venvs", ".local/pipx/venvs"]
+        .iter()
+        .map(|venvs| home.join(venvs).join("openai-whisper/bin/python"))
+        .find(|python| python.exists())
+        .map_or_else(
+            || "python3".to_string(),
+            |python| python.display().to_string(),
+        )
+}
+
+/// Resident worker processes, started on demand and kept for reuse
+#[derive(Debug)]
+struct WorkerPool {
+    command: WorkerCommand,
+    size: usize,
+    timeout: Duration,
+    permits: Semaphore,
+    idle: Mutex<Vec<Worker>>,
+}
+
+impl WorkerPool {
+    fn new(command: WorkerCommand, size: usize, timeout: Duration) -> Arc<Self> {
+        let size = size.max(1);
+        Arc::new(Self {
+            command,
+            size,
+            timeout,
+            permits: Semaphore::new(size),
+            idle: Mutex::new(Vec::new()),
+        })
+    }
+
+    /// Process-wide pool, so the model stays loaded across conversions
+    fn global() -> &'static Arc<Self> {
+        static POOL: OnceLock<Arc<WorkerPool>> = OnceLock::new();
+        POOL.get_or_init(|| {
+            // Each worker holds a model and uses several cores itself
+            let size = std::env::var("TRANSMUTATION_WHISPER_WORKERS")
+                .ok()
+                .and_then(|n| n.parse().ok())
+                .unwrap_or_else(|| (num_cpus::get() / 4).clamp(1, 4));
+            let timeout = std::env::var("TRANSMUTATION_WHISPER_TIMEOUT")
+                .ok()
+                .and_then(|secs| secs.parse().ok())
+                .map_or(SEGMENT_TIMEOUT, Duration::from_secs);
+            Self::new(WorkerCommand::from_env(), size, timeout)
+        })
+    }
+
+    /// Transcribe one segment on an idle (or newly started) worker
+    async fn transcribe(&self, pcm: Vec<u8>, language: Option<String>) -> Result<String> {
+        let _permit = self
+            .permits
+            .acquire()
+            .await
+            .map_err(|e| TransmutationError::conversion_failed(e.to_string()))?;
+
+        let pcm: Arc<[u8]> = pcm.into();
+        let idle = self.idle.lock().ok().and_then(|mut idle| idle.pop());
+        let reply = match idle {
+            Some(worker) => match self.run(worker, &pcm, &language).await {
+                // An idle worker may have exited since its last segment; a
+                // segment that timed out would most likely time out again
+                Err(e) if !matches!(e, TransmutationError::Timeout(_)) => {
+                    eprintln!("⚠️  Whisper worker failed ({e}), retrying on a new one...");
+                    let worker = Worker::spawn(&self.command)?;
+                    self.run(worker, &pcm, &language).await?
+                }
+                reply => reply?,
+            },
+            None => {
+                let worker = Worker::spawn(&self.command)?;
+                self.run(worker, &pcm, &language).await?
+            }
+        };
+        reply.map_err(|e| TransmutationError::engine_error("whisper", e))
+    }
+
+    /// Send one segment to `worker` and return it to the idle list
+    ///
+    /// A worker that fails to answer is dropped (and killed); one that
+    /// reports an error is still usable.
+    async fn run(
+        &self,
+        mut worker: Worker,
+        pcm: &Arc<[u8]>,
+        language: &Option<String>,
+    ) -> Result<std::result::Result<String, String>> {
+        let reply = worker
+            .transcribe(Arc::clone(pcm), language.clone(), self.timeout)
+            .await?;
+        if let Ok(mut idle) = self.idle.lock() {
+            idle.push(worker);
+        }
+        Ok(reply)
+    }
+}
+
+/// One worker process; its pipes are lent to a blocking thread for each
+/// request
+#[derive(Debug)]
+struct Worker {
+    child: Child,
+    pipes: Option<WorkerPipes>,
+}
+
+#[derive(Debug)]
+struct WorkerPipes {
+    requests: ChildStdin,
+    replies: BufReader<ChildStdout>,
+}
+
+/// Reply line of a worker
+#[derive(Debug, Deserialize)]
+struct Reply {
+    text: Option<String>,
+    error: Option<String>,
+}
+
+impl Worker {
+    fn spawn(command: &WorkerCommand) -> Result<Self> {
+        eprintln!("🎤 Starting Whisper worker...");
+        let mut child = process::Command::new(&command.program)
+            .args(&command.args)
+            .stdin(Stdio::piped())
+            .stdout(Stdio::piped())
+            .spawn()
+            .map_err(|e| {
+                TransmutationError::conversion_failed(format!(
+                    "Whisper worker `{}` failed to start: {e}. Install: pip install openai-whisper",
+                    command.program
+                ))
+            })?;
+
+        let (Some(requests), Some(replies)) = (child.stdin.take(), child.stdout.take()) else {
+            return Err(TransmutationError::conversion_failed(
+                "Whisper worker pipes unavailable",
+            ));
+        };
+        Ok(Self {
+            child,
+            pipes: Some(WorkerPipes {
+                requests,
+                replies: BufReader::new(replies),
+            }),
+        })
+    }
+
+    /// Send one segment; the inner error is one the worker reported
+    ///
+    /// The exchange runs on a blocking thread. When it outlasts `limit`
+    /// the worker is killed, which also ends that thread's reads.
+    async fn transcribe(
+        &mut self,
+        pcm: Arc<[u8]>,
+        language: Option<String>,
+        limit: Duration,
+    ) -> Result<std::result::Result<String, String>> {
+        let Some(mut pipes) = self.pipes.take() else {
+            return Err(TransmutationError::conversion_failed(
+                "Whisper worker was abandoned mid-request",
+            ));
+        };
+        let exchange = tokio::task::spawn_blocking(move || {
+            let reply = pipes.exchange(&pcm, language.as_deref());
+            (pipes, reply)
+        });
+
+        match tokio::time::timeout(limit, exchange).await {
+            Ok(joined) => {
+                let (pipes, reply) =
+                    joined.map_err(|e| TransmutationError::conversion_failed(e.to_string()))?;
+                self.pipes = Some(pipes);
+                reply
+            }
+            Err(_) => {
+                eprintln!("⚠️  Whisper worker timed out, killing it...");
+                let _ = self.child.kill();
+                Err(TransmutationError::Timeout(limit))
+            }
+        }
+    }
+}
+
+impl Drop for Worker {
+    fn drop(&mut self) {
+        let _ = self.child.kill();
+        let _ = self.child.wait();
+    }
+}
+
+impl WorkerPipes {
+    fn exchange(
+        &mut self,
+        pcm: &[u8],
+        language: Option<&str>,
+    ) -> Result<std::result::Result<String, String>> {
+        let header = serde_json::json!({ "bytes": pcm.len(), "language": language });
+        self.requests.write_all(format!("{header}\n").as_bytes())?;
+        self.requests.write_all(pcm)?;
+        self.requests.flush()?;
+
+        let mut line = String::new();
+        if self.replies.read_line(&mut line)? == 0 {
+            return Err(TransmutationError::conversion_failed(
+                "Whisper worker exited. Install: pip install openai-whisper",
+            ));
+        }
+        let reply: Reply = serde_json::from_str(&line)?;
+        Ok(match reply {
+            Reply {
+                text: Some(text), ..
+            } => Ok(text),
+            Reply { error, .. } => Err(error.unwrap_or_else(|| "empty reply".to_string())),
+        })
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    /// `seconds` of a loud square wave, or of silence
+    fn pcm(seconds: f64, loud: bool) -> Vec<u8> {
+        let samples = (seconds * SAMPLE_RATE as f64) as usize;
+        (0..samples)
+            .flat_map(|i| {
+                let sample: i16 = match (loud, i % 40 < 20) {
+                    (false, _) => 0,
+                    (true, true) => 8000,
+                    (true, false) => -8000,
+                };
+                sample.to_le_bytes()
+            })
+            .collect()
+    }
+
+    fn segment(parts: &[(f64, bool)]) -> Vec<Vec<u8>> {
+        let stream: Vec<u8> = parts.iter().flat_map(|&(s, loud)| pcm(s, loud)).collect();
+        let mut segmenter = Segmenter::default();
+        let mut segments = Vec::new();
+        // Odd-sized reads, as from a pipe
+        for chunk in stream.chunks(12_345) {
+            segmenter.push(chunk, &mut segments);
+        }
+        segments.extend(segmenter.finish());
+        segments
+    }
+
+    #[test]
+    fn test_segmenter_cuts_at_pauses() {
+        let segments = segment(&[(12.0, true), (1.0, false), (5.0, true), (2.0, false)]);
+        let seconds: Vec<f64> = segments
+            .iter()
+            .map(|s| s.len() as f64 / BYTES_PER_SECOND as f64)
+            .collect();
+        assert_eq!(seconds.len(), 2, "{seconds:?}");
+        // Cut in the middle of the first 300 ms of the pause
+        assert!((seconds[0] - 12.15).abs() < 0.05, "{seconds:?}");
+        assert!((seconds[1] - 7.85).abs() < 0.05, "{seconds:?}");
+    }
+
+    #[test]
+    fn test_segmenter_bounds_segments_and_drops_silence() {
+        let segments = segment(&[(2.0, false), (70.0, true), (40.0, false)]);
+        assert_eq!(segments.len(), 3);
+        assert!(segments.iter().all(|s| s.len() <= MAX_SEGMENT_BYTES));
+        assert!(segments.iter().all(|s| s.len() % 2 == 0));
+    }
+
+    /// Worker speaking the protocol that runs `reply` once a segment's
+    /// bytes are read (`$bytes` holds their count)
+    #[cfg(unix)]
+    fn stub_worker(reply: &str) -> WorkerCommand {
+        WorkerCommand {
+            program: "sh".to_string(),
+            args: vec![
+                "-c".to_string(),
+                format!(
+                    r#"while IFS= read -r header; do
+                         bytes=${{header#*\"bytes\":}}; bytes=${{bytes%%,*}}
+                         head -c "$bytes" > /dev/null
+                         {reply}
+                       done"#
+                ),
+            ],
+        }
+    }
+
+    #[cfg(unix)]
+    #[tokio::test(flavor = "multi_thread")]
+    async fn test_transcribe_stream_with_stub_worker() {
+        // "Transcribes" a segment as its size
+        let stub = stub_worker(r#"echo "{\"text\": \"$bytes bytes\"}""#);
+        let pool = WorkerPool::new(stub, 2, SEGMENT_TIMEOUT);
+
+        let mut stream = Vec::new();
+        for _ in 0..3 {
+            stream.extend(pcm(11.0, true));
+            stream.extend(pcm(0.5, false));
+        }
+        stream.extend(pcm(3.0, true));
+        let transcript = transcribe_stream(&pool, &stream[..], None).await.unwrap();
+
+        let sizes: Vec<usize> = transcript
+            .lines()
+            .map(|line| line.trim_end_matches(" bytes").parse().unwrap())
+            .collect();
+        assert_eq!(sizes.len(), 4, "{transcript}");
+        assert_eq!(sizes.iter().sum::<usize>(), stream.len());
+        // Workers stay resident between segments
+        assert!(!pool.idle.lock().unwrap().is_empty());
+    }
+
+    #[cfg(unix)]
+    #[test]
+    fn test_pool_outlives_runtime() {
+        // Replies with its process id, so reuse is visible
+        let pool = WorkerPool::new(
+            stub_worker(r#"echo "{\"text\": \"$$\"}""#),
+            1,
+            SEGMENT_TIMEOUT,
+        );
+        let transcribe = || {
+            let runtime = tokio::runtime::Runtime::new().unwrap();
+            runtime
+                .block_on(pool.transcribe(pcm(1.0, true), None))
+                .unwrap()
+        };
+
+        let first = transcribe();
+        let second = transcribe();
+        assert_eq!(first, second);
+    }
+
+    #[cfg(unix)]
+    #[tokio::test]
+    async fn test_failed_idle_worker_is_retried_and_hung_one_killed() {
+        // Answers one segment, then exits
+        let once = stub_worker(r#"echo "{\"text\": \"$$\"}"; exit"#);
+        let pool = WorkerPool::new(once, 1, SEGMENT_TIMEOUT);
+        let first = pool.transcribe(pcm(1.0, true), None).await.unwrap();
+        let second = pool.transcribe(pcm(1.0, true), None).await.unwrap();
+        assert_ne!(first, second);
+
+        let hangs = stub_worker("exec sleep 30");
+        let pool = WorkerPool::new(hangs, 1, Duration::from_millis(500));
+        let error = pool.transcribe(pcm(1.0, true), None).await.unwrap_err();
+        assert!(matches!(error, TransmutationError::Timeout(_)), "{error}");
+        assert!(pool.idle.lock().unwrap().is_empty());
+    }
+}
@@ -4,7 +4,7 @@
 
 #![allow(clippy::unused_self, clippy::uninlined_format_args)]
 
-use std::path::Path;
+use std::path::{Path, PathBuf};
 
 use async_trait::async_trait;
 use tokio::fs;
@@ -54,6 +54,34 @@ impl TxtConverter {
 
         markdown
     }
+
+    /// Render text in the requested output format
+    fn render(&self, text_content: &str, output_format: &OutputFormat) -> Result<Vec<u8>> {
+        Ok(match output_format {
+            OutputFormat::Markdown { .. } => {
+                eprintln!("📝 Converting to Markdown...");
+                let markdown = self.txt_to_markdown(text_content);
+                markdown.into_bytes()
+            }
+            OutputFormat::Json { .. } => {
+                eprintln!("📝 Converting to JSON...");
+                let json = serde_json::json!({
+                    "text": {
+                        "content": text_content,
+                        "lines": text_content.lines().count(),
+                        "chars": text_content.len(),
+                    }
+                });
+                serde_json::to_string_pretty(&json)?.into_bytes()
+            }
+            _ => {
+                return Err(crate::TransmutationError::UnsupportedFormat(format!(
+                    "Output format {:?} not supported for TXT",
+                    output_format
+                )));
+            }
+        })
+    }
 }
 
 impl Default for TxtConverter {
@@ -95,30 +123,7 @@ impl DocumentConverter for TxtConverter {
         let text_content = fs::read_to_string(input).await?;
 
         // Convert to requested format
-        let output_data = match output_format {
-            OutputFormat::Markdown { .. } => {
-                eprintln!("📝 Converting to Markdown...");
-                let markdown = self.txt_to_markdown(&text_content);
-                markdown.into_bytes()
-            }
-            OutputFormat::Json { .. } => {
-                eprintln!("📝 Converting to JSON...");
-                let json = serde_json::json!({
-                    "text": {
-                        "content": text_content,
-                        "lines": text_content.lines().count(),
-                        "chars": text_content.len(),
-                    }
-                });
-                serde_json::to_string_pretty(&json)?.into_bytes()
-            }
-            _ => {
-                return Err(crate::TransmutationError::UnsupportedFormat(format!(
-                    "Output format {:?} not supported for TXT",
-                    output_format
-                )));
-            }
-        };
+        let output_data = self.render(&text_content, &output_format)?;
 
         let output_size = output_data.len() as u64;
         let input_size = fs::metadata(input).await?.len();
@@ -159,6 +164,27 @@ impl DocumentConverter for TxtConverter {
         })
     }
 
+    async fn convert_bytes(
+        &self,
+        name: &str,
+        data: Vec<u8>,
+        _input_format: FileFormat,
+        output_format: OutputFormat,
+        _options: ConversionOptions,
+    ) -> Result<ConversionResult> {
+        let input_size = data.len() as u64;
+        let text_content = String::from_utf8_lossy(&data);
+        let output_data = self.render(&text_content, &output_format)?;
+
+        Ok(ConversionResult::single(
+            PathBuf::from(name),
+            FileFormat::Txt,
+            output_format,
+            output_data,
+            input_size,
+        ))
+    }
+
     fn metadata(&self) -> ConverterMetadata {
         ConverterMetadata {
             name: "TXT Converter".to_string(),
@@ -193,4 +219,25 @@ mod tests {
         let meta = converter.metadata();
         assert_eq!(meta.name, "TXT Converter");
     }
+
+    #[tokio::test]
+    async fn test_txt_convert_bytes() {
+        let converter = TxtConverter::new();
+        let result = converter
+            .convert_bytes(
+                "notes/readme.txt",
+                b"Hello from memory".to_vec(),
+                FileFormat::Txt,
+                OutputFormat::Markdown {
+                    split_pages: false,
+                    optimize_for_llm: true,
+                },
+                ConversionOptions::default(),
+            )
+            .await
+            .unwrap();
+        assert_eq!(result.input_path, Path::new("notes/readme.txt"));
+        let markdown = String::from_utf8(result.content[0].data.clone()).unwrap();
+        assert!(markdown.contains("Hello from memory"));
+    }
 }
@@ -1,6 +1,7 @@
 //! Video converter with audio extraction and transcription
 //!
 //! Converts video files to text by extracting audio and using Whisper ASR.
+//! The audio is decoded to PCM on a pipe, never written to disk.
 
 #![allow(
     clippy::uninlined_format_args,
@@ -8,11 +9,9 @@
     clippy::unnecessary_literal_unwrap
 )]
 
-use std::path::{Path, PathBuf};
-use std::process::Command;
+use std::path::Path;
 
 use async_trait::async_trait;
-use tempfile::NamedTempFile;
 use tokio::fs;
 
 use super::traits::{ConverterMetadata, DocumentConverter};
@@ -31,179 +30,11 @@ impl VideoConverter {
         Self
     }
 
-    /// Check if ffmpeg is available
-    fn check_ffmpeg() -> bool {
-        Command::new("ffmpeg").arg("-version").output().is_ok()
-    }
-
-    /// Check if whisper is available
-    fn check_whisper() -> bool {
-        // Try whisper in PATH
-        if Command::new("whisper").arg("--help").output().is_ok() {
-            return true;
-        }
-
-        // Try common installation paths
-        let paths = vec![
-            format!(
-                "{}/.local/bin/whisper",
-                std::env::var("HOME").unwrap_or_default()
-            ),
-            "/usr/local/bin/whisper".to_string(),
-            "/usr/bin/whisper".to_string(),
-        ];
-
-        for path in paths {
-            if std::path::Path::new(&path).exists() {
-                return true;
-            }
-        }
-
-        false
-    }
-
-    /// Get whisper command path
-    fn get_whisper_cmd() -> String {
-        // Try common paths
-        let paths = vec![
-            format!(
-                "{}/.local/bin/whisper",
-                std::env::var("HOME").unwrap_or_default()
-            ),
-            "/usr/local/bin/whisper".to_string(),
-            "/usr/bin/whisper".to_string(),
-            "whisper".to_string(),
-        ];
-
-        for path in &paths {
-            if std::path::Path::new(path).exists() || path == "whisper" {
-                return path.clone();
-            }
-        }
-
-        "whisper".to_string()
-    }
-
-    /// Extract audio from video using FFmpeg
-    async fn extract_audio(&self, video_path: &Path) -> Result<PathBuf> {
-        if !Self::check_ffmpeg() {
-            return Err(crate::TransmutationError::conversion_failed(
-                "FFmpeg not found. Install: sudo apt-get install ffmpeg",
-            ));
-        }
-
-        // Create temporary audio file
-        let temp_audio = NamedTempFile::new().map_err(|e| {
-            crate::TransmutationError::conversion_failed(&format!(
-                "Failed to create temp file: {}",
-                e
-            ))
-        })?;
-
-        let audio_path = temp_audio.path().with_extension("wav");
-
-        eprintln!("🎬 Extracting audio with FFmpeg...");
-
-        // Extract audio to WAV format
-        let output = Command::new("ffmpeg")
-            .arg("-i")
-            .arg(video_path)
-            .arg("-vn") // No video
-            .arg("-acodec")
-            .arg("pcm_s16le") // WAV format
-            .arg("-ar")
-            .arg("16000") // 16kHz sample rate (Whisper default)
-            .arg("-ac")
-            .arg("1") // Mono
-            .arg("-y") // Overwrite
-            .arg(&audio_path)
-            .output()
-            .map_err(|e| {
-                crate::TransmutationError::conversion_failed(&format!(
-                    "FFmpeg execution failed: {}",
-                    e
-                ))
-            })?;
-
-        if !output.status.success() {
-            let stderr = String::from_utf8_lossy(&output.stderr);
-            return Err(crate::TransmutationError::conversion_failed(&format!(
-                "FFmpeg failed: {}",
-                stderr
-            )));
-        }
-
-        Ok(audio_path)
-    }
-
-    /// Transcribe audio using Whisper
-    async fn transcribe_audio(&self, audio_path: &Path, language: Option<&str>) -> Result<String> {
-        if !Self::check_whisper() {
-            return Err(crate::TransmutationError::conversion_failed(
-                "Whisper not found. Install: pip install openai-whisper",
-            ));
-        }
-
-        eprintln!("🎤 Running Whisper transcription...");
-
-        let whisper_cmd = Self::get_whisper_cmd();
-        let mut cmd = Command::new(&whisper_cmd);
-        cmd.arg(audio_path);
-        cmd.arg("--model").arg("base"); // Use base model
-        cmd.arg("--output_format").arg("txt");
-        cmd.arg("--output_dir").arg("/tmp");
-
-        if let Some(lang) = language {
-            cmd.arg("--language").arg(lang);
-        }
-
-        let output = cmd.output().map_err(|e| {
-            crate::TransmutationError::conversion_failed(&format!(
-                "Whisper execution failed: {}",
-                e
-            ))
-        })?;
-
-        if !output.status.success() {
-            let stderr = String::from_utf8_lossy(&output.stderr);
-            return Err(crate::TransmutationError::conversion_failed(&format!(
-                "Whisper failed: {}",
-                stderr
-            )));
-        }
-
-        // Read transcription
-        let audio_name = audio_path
-            .file_stem()
-            .and_then(|s| s.to_str())
-            .unwrap_or("audio");
-        let transcript_path = format!("/tmp/{}.txt", audio_name);
-
-        let transcript = tokio::fs::read_to_string(&transcript_path)
-            .await
-            .map_err(|e| {
-                crate::TransmutationError::conversion_failed(&format!(
-                    "Failed to read transcript: {}",
-                    e
-                ))
-            })?;
-
-        // Clean up
-        let _ = tokio::fs::remove_file(&transcript_path).await;
-
-        Ok(transcript)
-    }
-
     /// Convert video to Markdown
     async fn video_to_markdown(&self, video_path: &Path, language: Option<&str>) -> Result<String> {
-        // Extract audio
-        let audio_path = self.extract_audio(video_path).await?;
-
-        // Transcribe
-        let transcript = self.transcribe_audio(&audio_path, language).await?;
-
-        // Clean up audio file
-        let _ = tokio::fs::remove_file(&audio_path).await;
+        // FFmpeg pipes the audio track straight into transcription
+        eprintln!("🎬 Extracting audio with FFmpeg...");
+        let transcript = super::transcription::transcribe_file(video_path, language).await?;
 
         let mut markdown = String::new();
         markdown.push_str("# Video Transcription\n\n");
@@ -255,6 +86,18 @@ impl DocumentConverter for VideoConverter {
         &self,
         input: &Path,
         output_format: OutputFormat,
+        options: ConversionOptions,
+    ) -> Result<ConversionResult> {
+        let input_format = crate::utils::file_detect::detect_format(input).await?;
+        self.convert_detected(input, input_format, output_format, options)
+            .await
+    }
+
+    async fn convert_detected(
+        &self,
+        input: &Path,
+        input_format: FileFormat,
+        output_format: OutputFormat,
         _options: ConversionOptions,
     ) -> Result<ConversionResult> {
         eprintln!("🔄 Video Transcription (FFmpeg + Whisper)");
@@ -296,7 +139,7 @@ impl DocumentConverter for VideoConverter {
 
         Ok(ConversionResult {
             input_path: input.to_path_buf(),
-            input_format: crate::utils::file_detect::detect_format(input).await?,
+            input_format,
             output_format,
             content: vec![ConversionOutput {
                 page_number: 1,
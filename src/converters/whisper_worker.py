@@ -0,0 +1,46 @@
+"""Resident Whisper transcription worker.
+
+Loads the model once, then transcribes requests from stdin until EOF.
+Each request is a JSON header line, {"bytes": N, "language": "en" | null},
+followed by N bytes of 16 kHz mono s16le PCM. Each reply is one JSON line
+on stdout: {"text": "..."} or {"error": "..."}.
+
+Usage: python3 whisper_worker.py [model]
+"""
+
+import json
+import sys
+
+import numpy as np
+import whisper
+
+
+def main():
+    requests = sys.stdin.buffer
+    replies = sys.stdout
+    # Anything else printed (warnings, progress) must not corrupt replies
+    sys.stdout = sys.stderr
+
+    model = whisper.load_model(sys.argv[1] if len(sys.argv) > 1 else "base")
+    fp16 = model.device.type == "cuda"
+
+    while True:
+        header = requests.readline()
+        if not header:
+            break
+        request = json.loads(header)
+        pcm = requests.read(request["bytes"])
+
+        try:
+            audio = np.frombuffer(pcm, dtype=np.int16).astype(np.float32) / 32768.0
+            result = model.transcribe(audio, language=request.get("language"), fp16=fp16)
+            reply = {"text": result["text"].strip()}
+        except Exception as e:  # noqa: BLE001 - reported to the caller
+            reply = {"error": str(e)}
+
+        replies.write(json.dumps(reply) + "\n")
+        replies.flush()
+
+
+if __name__ == "__main__":
+    main()
@@ -8,20 +8,24 @@
 
 #![allow(clippy::unused_self, clippy::uninlined_format_args)]
 
-use std::path::Path;
+use std::io::Write;
+use std::path::{Path, PathBuf};
 
 use async_trait::async_trait;
 use tokio::fs;
 
+use super::ooxml_reader::ZipSource;
 use super::traits::{ConverterMetadata, DocumentConverter};
-use crate::Result;
+use super::xlsx_reader::{Sheet, XlsxReader};
 use crate::types::{
     ConversionOptions, ConversionOutput, ConversionResult, FileFormat, OutputFormat, OutputMetadata,
 };
+use crate::{Result, TransmutationError};
 
 /// XLSX to multiple formats converter
 ///
-/// Uses umya-spreadsheet for direct parsing (pure Rust, no LibreOffice)
+/// Streams the sheet XML parts directly (pure Rust, no LibreOffice): only
+/// cells holding a value are read, and blank rows are skipped.
 #[derive(Debug)]
 pub struct XlsxConverter;
 
@@ -31,145 +35,225 @@ impl XlsxConverter {
         Self
     }
 
-    /// Read XLSX file and extract sheets using umya-spreadsheet
-    fn read_xlsx(&self, path: &Path) -> Result<umya_spreadsheet::Spreadsheet> {
-        eprintln!("📊 Reading XLSX file (umya-spreadsheet)...");
+    /// Open XLSX file: sheet list and shared strings, no cell data yet
+    fn read_xlsx<'s, S: ZipSource + ?Sized>(&self, source: &'s S) -> Result<XlsxReader<'s, S>> {
+        eprintln!("📊 Reading XLSX file (streaming XML)...");
 
-        let book = umya_spreadsheet::reader::xlsx::read(path).map_err(|e| {
-            crate::TransmutationError::engine_error(
-                "xlsx-parser",
-                format!("Failed to read XLSX: {}", e),
-            )
-        })?;
+        let book = XlsxReader::open(source)?;
 
-        eprintln!("      ✓ Found {} sheets", book.get_sheet_count());
+        eprintln!("      ✓ Found {} sheets", book.sheet_count());
         Ok(book)
     }
 
     /// Convert XLSX to Markdown tables
-    fn to_markdown(&self, book: &umya_spreadsheet::Spreadsheet) -> String {
-        let mut markdown = String::new();
-        markdown.push_str("# Spreadsheet\n\n");
+    ///
+    /// Sheets are parsed and rendered in parallel, then written in order.
+    /// Output is incremental per sheet only: each sheet's rows and its
+    /// Markdown are held in memory until the sheet is written.
+    fn to_markdown<S: ZipSource + ?Sized, W: Write>(
+        &self,
+        book: &XlsxReader<'_, S>,
+        out: &mut W,
+    ) -> Result<()> {
+        out.write_all(b"# Spreadsheet\n\n")?;
+
+        let sheets = book.map_sheets(|idx, sheet| {
+            let mut markdown = Vec::new();
+            Self::write_markdown_sheet(idx, &sheet, &mut markdown)?;
+            Ok(markdown)
+        })?;
+        for markdown in sheets {
+            out.write_all(&markdown)?;
+        }
 
-        for (idx, sheet) in book.get_sheet_collection().iter().enumerate() {
-            let sheet_name = sheet.get_name();
-            markdown.push_str(&format!("## Sheet {}: {}\n\n", idx + 1, sheet_name));
+        Ok(())
+    }
+
+    /// One sheet as a Markdown table; its first row is the header
+    fn write_markdown_sheet<W: Write>(idx: usize, sheet: &Sheet, out: &mut W) -> Result<()> {
+        writeln!(out, "## Sheet {}: {}\n", idx + 1, sheet.name)?;
 
-            // Get sheet dimensions
-            let highest_row = sheet.get_highest_row();
-            let highest_col = sheet.get_highest_column();
+        if sheet.rows.is_empty() {
+            out.write_all(b"*(Empty sheet)*\n\n")?;
+            return Ok(());
+        }
 
-            if highest_row == 0 || highest_col == 0 {
-                markdown.push_str("*(Empty sheet)*\n\n");
-                continue;
+        for (i, row) in sheet.rows.iter().enumerate() {
+            out.write_all(b"|")?;
+            for value in row.values(sheet.width) {
+                out.write_all(b" ")?;
+                write_markdown_cell(value, out)?;
+                out.write_all(b" |")?;
             }
+            out.write_all(b"\n")?;
 
-            // Build table
-            for row in 1..=highest_row {
-                if row == 1 {
-                    // Header row
-                    markdown.push('|');
-                    for col in 1..=highest_col {
-                        let cell = sheet.get_cell((col, row));
-                        let value = cell.map(|c| c.get_value().to_string()).unwrap_or_default();
-                        markdown.push_str(&format!(" {} |", value));
-                    }
-                    markdown.push('\n');
-
-                    // Separator
-                    markdown.push('|');
-                    for _ in 1..=highest_col {
-                        markdown.push_str("---|");
-                    }
-                    markdown.push('\n');
-                } else {
-                    // Data rows
-                    markdown.push('|');
-                    for col in 1..=highest_col {
-                        let cell = sheet.get_cell((col, row));
-                        let value = cell.map(|c| c.get_value().to_string()).unwrap_or_default();
-                        markdown.push_str(&format!(" {} |", value));
-                    }
-                    markdown.push('\n');
+            if i == 0 {
+                // Separator
+                out.write_all(b"|")?;
+                for _ in 0..sheet.width {
+                    out.write_all(b"---|")?;
                 }
+                out.write_all(b"\n")?;
             }
-
-            markdown.push_str("\n---\n\n");
         }
 
-        markdown
+        out.write_all(b"\n---\n\n")?;
+        Ok(())
     }
 
     /// Convert XLSX to CSV (first sheet only)
-    fn to_csv(&self, book: &umya_spreadsheet::Spreadsheet, delimiter: char) -> String {
-        let mut csv = String::new();
-
-        // Get first sheet
-        if let Some(sheet) = book.get_sheet_collection().first() {
-            let highest_row = sheet.get_highest_row();
-            let highest_col = sheet.get_highest_column();
-
-            for row in 1..=highest_row {
-                let mut values = Vec::new();
-                for col in 1..=highest_col {
-                    let cell = sheet.get_cell((col, row));
-                    let value = cell.map(|c| c.get_value().to_string()).unwrap_or_default();
-
-                    // Quote values with commas
-                    if value.contains(delimiter) || value.contains('"') {
-                        values.push(format!("\"{}\"", value.replace('"', "\"\"")));
-                    } else {
-                        values.push(value);
-                    }
+    fn to_csv<S: ZipSource + ?Sized, W: Write>(
+        &self,
+        book: &XlsxReader<'_, S>,
+        delimiter: char,
+        out: &mut W,
+    ) -> Result<()> {
+        if book.sheet_count() == 0 {
+            return Ok(());
+        }
+
+        let sheet = book.read_sheet(0)?;
+        let mut separator = [0; 4];
+        let separator = delimiter.encode_utf8(&mut separator).as_bytes();
+
+        for row in &sheet.rows {
+            for (col, value) in row.values(sheet.width).enumerate() {
+                if col > 0 {
+                    out.write_all(separator)?;
+                }
+
+                // Quote values with delimiters, quotes or line breaks
+                if value.contains(delimiter) || value.contains(['"', '\n', '\r']) {
+                    write!(out, "\"{}\"", value.replace('"', "\"\""))?;
+                } else {
+                    out.write_all(value.as_bytes())?;
                 }
-                csv.push_str(&values.join(&delimiter.to_string()));
-                csv.push('\n');
             }
+            out.write_all(b"\n")?;
         }
 
-        csv
+        Ok(())
     }
 
     /// Convert XLSX to JSON
-    fn to_json(&self, book: &umya_spreadsheet::Spreadsheet) -> Result<String> {
+    fn to_json<S: ZipSource + ?Sized>(&self, book: &XlsxReader<'_, S>) -> Result<String> {
         use serde_json::json;
 
-        let mut sheets_json = Vec::new();
-
-        for sheet in book.get_sheet_collection() {
-            let sheet_name = sheet.get_name();
-            let highest_row = sheet.get_highest_row();
-            let highest_col = sheet.get_highest_column();
+        let sheets_json = book.map_sheets(|_, sheet| {
+            let rows: Vec<Vec<&str>> = sheet
+                .rows
+                .iter()
+                .map(|row| row.values(sheet.width).collect())
+                .collect();
 
-            let mut rows = Vec::new();
-
-            for row in 1..=highest_row {
-                let mut row_data = Vec::new();
-                for col in 1..=highest_col {
-                    let cell = sheet.get_cell((col, row));
-                    let value = cell.map(|c| c.get_value().to_string()).unwrap_or_default();
-                    row_data.push(value);
-                }
-                rows.push(row_data);
-            }
-
-            sheets_json.push(json!({
-                "name": sheet_name,
+            Ok(json!({
+                "name": sheet.name,
                 "rows": rows,
-                "row_count": highest_row,
-                "col_count": highest_col,
-            }));
-        }
+                "row_count": rows.len(),
+                "col_count": sheet.width,
+            }))
+        })?;
 
         let result = json!({
             "spreadsheet": {
                 "sheets": sheets_json,
-                "sheet_count": book.get_sheet_count(),
+                "sheet_count": book.sheet_count(),
             }
         });
 
         Ok(serde_json::to_string_pretty(&result)?)
     }
+
+    /// Render an opened workbook in `output_format`
+    fn render<S: ZipSource + ?Sized>(
+        &self,
+        book: &XlsxReader<'_, S>,
+        output_format: &OutputFormat,
+    ) -> Result<Vec<u8>> {
+        // Convert to requested format
+        Ok(match output_format {
+            OutputFormat::Markdown { .. } => {
+                eprintln!("📝 Converting to Markdown tables...");
+                let mut data = Vec::new();
+                self.to_markdown(book, &mut data)?;
+                data
+            }
+            &OutputFormat::Csv { delimiter, .. } => {
+                eprintln!("📝 Converting to CSV (delimiter: '{}')...", delimiter);
+                let mut data = Vec::new();
+                self.to_csv(book, delimiter, &mut data)?;
+                data
+            }
+            OutputFormat::Json { .. } => {
+                eprintln!("📝 Converting to JSON...");
+                self.to_json(book)?.into_bytes()
+            }
+            _ => {
+                return Err(TransmutationError::UnsupportedFormat(format!(
+                    "Output format {:?} not supported for XLSX",
+                    output_format
+                )));
+            }
+        })
+    }
+
+    /// Result holding the rendered workbook
+    fn conversion_result(
+        input_path: PathBuf,
+        output_format: OutputFormat,
+        output_data: Vec<u8>,
+        sheet_count: usize,
+        input_size: u64,
+    ) -> ConversionResult {
+        let output_size = output_data.len() as u64;
+
+        ConversionResult {
+            input_path,
+            input_format: FileFormat::Xlsx,
+            output_format,
+            content: vec![ConversionOutput {
+                page_number: 1,
+                data: output_data,
+                metadata: OutputMetadata {
+                    size_bytes: output_size,
+                    chunk_count: sheet_count,
+                    token_count: None,
+                },
+            }],
+            metadata: crate::types::DocumentMetadata {
+                title: None,
+                author: None,
+                created: None,
+                modified: None,
+                page_count: sheet_count,
+                language: None,
+                custom: std::collections::HashMap::new(),
+            },
+            statistics: crate::types::ConversionStatistics {
+                input_size_bytes: input_size,
+                output_size_bytes: output_size,
+                duration: std::time::Duration::from_secs(0),
+                pages_processed: sheet_count,
+                tables_extracted: sheet_count,
+                images_extracted: 0,
+                cache_hit: false,
+            },
+        }
+    }
+}
+
+/// Cell text that cannot break out of its table cell
+fn write_markdown_cell<W: Write>(value: &str, out: &mut W) -> std::io::Result<()> {
+    let mut rest = value;
+    while let Some(pos) = rest.find(['|', '\n', '\r']) {
+        out.write_all(rest[..pos].as_bytes())?;
+        out.write_all(match rest.as_bytes()[pos] {
+            b'|' => &b"\\|"[..],
+            _ => &b" "[..],
+        })?;
+        rest = &rest[pos + 1..];
+    }
+    out.write_all(rest.as_bytes())
 }
 
 impl Default for XlsxConverter {
@@ -211,65 +295,52 @@ impl DocumentConverter for XlsxConverter {
         eprintln!("   XLSX (ZIP) → XML Parsing → {:?}", output_format);
         eprintln!();
 
-        // Read XLSX file
-        let book = self.read_xlsx(input)?;
+        // Parsing and rendering are CPU-bound; keep them off the runtime
+        let path = input.to_path_buf();
+        let format = output_format.clone();
+        let (output_data, sheet_count) = tokio::task::spawn_blocking(move || -> Result<_> {
+            let converter = Self::new();
+            let book = converter.read_xlsx(path.as_path())?;
+            Ok((converter.render(&book, &format)?, book.sheet_count()))
+        })
+        .await
+        .map_err(|e| TransmutationError::conversion_failed(e.to_string()))??;
+        let input_size = fs::metadata(input).await?.len();
 
-        // Convert to requested format
-        let output_data = match output_format {
-            OutputFormat::Markdown { .. } => {
-                eprintln!("📝 Converting to Markdown tables...");
-                self.to_markdown(&book).into_bytes()
-            }
-            OutputFormat::Csv { delimiter, .. } => {
-                eprintln!("📝 Converting to CSV (delimiter: '{}')...", delimiter);
-                self.to_csv(&book, delimiter).into_bytes()
-            }
-            OutputFormat::Json { .. } => {
-                eprintln!("📝 Converting to JSON...");
-                self.to_json(&book)?.into_bytes()
-            }
-            _ => {
-                return Err(crate::TransmutationError::UnsupportedFormat(format!(
-                    "Output format {:?} not supported for XLSX",
-                    output_format
-                )));
-            }
-        };
+        Ok(Self::conversion_result(
+            input.to_path_buf(),
+            output_format,
+            output_data,
+            sheet_count,
+            input_size,
+        ))
+    }
 
-        let output_size = output_data.len() as u64;
+    async fn convert_bytes(
+        &self,
+        name: &str,
+        data: Vec<u8>,
+        _input_format: FileFormat,
+        output_format: OutputFormat,
+        _options: ConversionOptions,
+    ) -> Result<ConversionResult> {
+        let input_size = data.len() as u64;
+        let format = output_format.clone();
+        let (output_data, sheet_count) = tokio::task::spawn_blocking(move || -> Result<_> {
+            let converter = Self::new();
+            let book = converter.read_xlsx(&data[..])?;
+            Ok((converter.render(&book, &format)?, book.sheet_count()))
+        })
+        .await
+        .map_err(|e| TransmutationError::conversion_failed(e.to_string()))??;
 
-        Ok(ConversionResult {
-            input_path: input.to_path_buf(),
-            input_format: FileFormat::Xlsx,
+        Ok(Self::conversion_result(
+            PathBuf::from(name),
             output_format,
-            content: vec![ConversionOutput {
-                page_number: 1,
-                data: output_data,
-                metadata: OutputMetadata {
-                    size_bytes: output_size,
-                    chunk_count: book.get_sheet_count(),
-                    token_count: None,
-                },
-            }],
-            metadata: crate::types::DocumentMetadata {
-                title: None,
-                author: None,
-                created: None,
-                modified: None,
-                page_count: book.get_sheet_count(),
-                language: None,
-                custom: std::collections::HashMap::new(),
-            },
-            statistics: crate::types::ConversionStatistics {
-                input_size_bytes: fs::metadata(input).await?.len(),
-                output_size_bytes: output_size,
-                duration: std::time::Duration::from_secs(0),
-                pages_processed: book.get_sheet_count(),
-                tables_extracted: book.get_sheet_count(),
-                images_extracted: 0,
-                cache_hit: false,
-            },
-        })
+            output_data,
+            sheet_count,
+            input_size,
+        ))
     }
 
     fn metadata(&self) -> ConverterMetadata {
@@ -300,4 +371,75 @@ mod tests {
         let meta = converter.metadata();
         assert_eq!(meta.name, "XLSX Converter");
     }
+
+    #[test]
+    fn test_write_markdown_sheet() {
+        use super::super::xlsx_reader::Row;
+
+        let sheet = Sheet {
+            name: "Data".to_string(),
+            width: 3,
+            rows: vec![
+                Row {
+                    number: 1,
+                    cells: vec![(0, "Name".to_string()), (2, "Note".to_string())],
+                },
+                Row {
+                    number: 7,
+                    cells: vec![(0, "a|b".to_string()), (1, "1\n2".to_string())],
+                },
+            ],
+        };
+
+        let mut out = Vec::new();
+        XlsxConverter::write_markdown_sheet(0, &sheet, &mut out).unwrap();
+        assert_eq!(
+            String::from_utf8(out).unwrap(),
+            "## Sheet 1: Data\n\n| Name |  | Note |\n|---|---|---|\n| a\\|b | 1 2 |  |\n\n---\n\n"
+        );
+    }
+
+    #[tokio::test]
+    async fn test_convert_bytes_in_memory() {
+        use std::io::Cursor;
+
+        let mut zip = zip::ZipWriter::new(Cursor::new(Vec::new()));
+        for (name, xml) in [
+            (
+                "xl/workbook.xml",
+                r#"<workbook xmlns:r="r"><sheets><sheet name="Totals" r:id="rId1"/></sheets></workbook>"#,
+            ),
+            (
+                "xl/_rels/workbook.xml.rels",
+                r#"<Relationships><Relationship Id="rId1" Target="worksheets/sheet1.xml"/></Relationships>"#,
+            ),
+            (
+                "xl/worksheets/sheet1.xml",
+                r#"<worksheet><sheetData><row r="1"><c t="inlineStr"><is><t>Region</t></is></c><c t="inlineStr"><is><t>Sales</t></is></c></row><row r="2"><c t="inlineStr"><is><t>North</t></is></c><c><v>42</v></c></row></sheetData></worksheet>"#,
+            ),
+        ] {
+            zip.start_file(name, zip::write::SimpleFileOptions::default())
+                .unwrap();
+            zip.write_all(xml.as_bytes()).unwrap();
+        }
+        let workbook = zip.finish().unwrap().into_inner();
+
+        let result = XlsxConverter::new()
+            .convert_bytes(
+                "books/sales.xlsx",
+                workbook,
+                FileFormat::Xlsx,
+                OutputFormat::Csv {
+                    delimiter: ',',
+                    include_headers: true,
+                },
+                ConversionOptions::default(),
+            )
+            .await
+            .unwrap();
+
+        assert_eq!(result.input_path, PathBuf::from("books/sales.xlsx"));
+        assert_eq!(result.statistics.pages_processed, 1);
+        assert_eq!(result.content[0].data, b"Region,Sales\nNorth,42\n");
+    }
 }
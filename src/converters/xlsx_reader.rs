@@ -0,0 +1,458 @@
+//! Streaming XLSX reader
+//!
+//! Reads worksheets straight from the workbook's XML parts with a pull
+//! parser instead of building a full spreadsheet object model. Shared
+//! strings are resolved once into a table, only cells that hold a value are
+//! kept, and each sheet is parsed from its own ZIP handle so sheets can be
+//! processed in parallel. Workbooks are read from disk or from memory alike.
+
+use std::borrow::Cow;
+use std::io::{BufRead, BufReader};
+use std::path::Path;
+
+use quick_xml::Reader;
+use quick_xml::events::{BytesStart, Event};
+use rayon::prelude::*;
+use zip::ZipArchive;
+
+use super::ooxml_reader::ZipSource;
+use crate::{Result, TransmutationError};
+
+/// Workbook opened for streaming: sheet list and shared strings
+#[derive(Debug)]
+pub(crate) struct XlsxReader<'s, S: ZipSource + ?Sized = Path> {
+    source: &'s S,
+    sheets: Vec<SheetEntry>,
+    shared_strings: Vec<String>,
+}
+
+/// Sheet name and the ZIP part holding its XML
+#[derive(Debug, Clone, PartialEq)]
+struct SheetEntry {
+    name: String,
+    part: String,
+}
+
+/// Non-empty cells of one sheet
+#[derive(Debug, Default)]
+pub(crate) struct Sheet {
+    pub name: String,
+    /// Rows with at least one value, in sheet order
+    pub rows: Vec<Row>,
+    /// One past the rightmost column holding a value
+    pub width: usize,
+}
+
+/// Non-empty cells of one row
+#[derive(Debug, PartialEq)]
+pub(crate) struct Row {
+    /// 1-based row number
+    pub number: u32,
+    /// `(0-based column, value)` in column order
+    pub cells: Vec<(usize, String)>,
+}
+
+impl Row {
+    /// Values of columns `0..width`, empty where the row has no cell
+    pub fn values(&self, width: usize) -> impl Iterator<Item = &str> {
+        let mut cells = self.cells.iter().peekable();
+        (0..width).map(move |col| match cells.next_if(|(c, _)| *c == col) {
+            Some((_, value)) => value.as_str(),
+            None => "",
+        })
+    }
+}
+
+impl<'s, S: ZipSource + ?Sized> XlsxReader<'s, S> {
+    /// Open a workbook: reads the sheet list and the shared string table
+    pub fn open(source: &'s S) -> Result<Self> {
+        let mut archive = open_archive(source)?;
+
+        let rels = match archive.by_name("xl/_rels/workbook.xml.rels") {
+            Ok(part) => parse_relationships(BufReader::new(part))?,
+            Err(_) => Vec::new(),
+        };
+        let sheets = match archive.by_name("xl/workbook.xml") {
+            Ok(part) => parse_workbook(BufReader::new(part), &rels)?,
+            Err(e) => return Err(xlsx_error(format!("Missing xl/workbook.xml: {}", e))),
+        };
+        let shared_strings = match archive.by_name("xl/sharedStrings.xml") {
+            Ok(part) => parse_shared_strings(BufReader::new(part))?,
+            Err(_) => Vec::new(),
+        };
+
+        Ok(Self {
+            source,
+            sheets,
+            shared_strings,
+        })
+    }
+
+    /// Number of sheets in the workbook
+    pub fn sheet_count(&self) -> usize {
+        self.sheets.len()
+    }
+
+    /// Read one sheet by index, from its own ZIP handle
+    pub fn read_sheet(&self, index: usize) -> Result<Sheet> {
+        let mut archive = open_archive(self.source)?;
+        let entry = &self.sheets[index];
+        let mut sheet = match archive.by_name(&entry.part) {
+            Ok(part) => parse_sheet(BufReader::new(part), &self.shared_strings)?,
+            // Chartsheets and dangling relationships have no cells
+            Err(_) => Sheet::default(),
+        };
+        sheet.name.clone_from(&entry.name);
+        Ok(sheet)
+    }
+
+    /// Read every sheet in parallel and map it with `f`, in sheet order
+    ///
+    /// Each sheet is parsed from its own ZIP handle and dropped as soon as
+    /// `f` returns, so only the mapped results are held together.
+    pub fn map_sheets<T, F>(&self, f: F) -> Result<Vec<T>>
+    where
+        T: Send,
+        F: Fn(usize, Sheet) -> Result<T> + Sync,
+    {
+        (0..self.sheets.len())
+            .into_par_iter()
+            .map(|index| f(index, self.read_sheet(index)?))
+            .collect()
+    }
+}
+
+fn open_archive<S: ZipSource + ?Sized>(source: &S) -> Result<ZipArchive<S::Reader<'_>>> {
+    ZipArchive::new(source.open()?)
+        .map_err(|e| xlsx_error(format!("Failed to open XLSX as ZIP: {}", e)))
+}
+
+fn xlsx_error(message: String) -> TransmutationError {
+    TransmutationError::engine_error("xlsx-parser", message)
+}
+
+fn xml_error(e: quick_xml::Error) -> TransmutationError {
+    xlsx_error(format!("Invalid XLSX XML: {}", e))
+}
+
+/// Value of the attribute with local name `name`, unescaped
+fn attribute(element: &BytesStart<'_>, name: &[u8]) -> Option<String> {
+    element
+        .attributes()
+        .flatten()
+        .find(|attr| attr.key.local_name().as_ref() == name)
+        .and_then(|attr| attr.unescape_value().ok().map(Cow::into_owned))
+}
+
+/// `rId` → ZIP part of the workbook's relationships
+fn parse_relationships<R: BufRead>(source: R) -> Result<Vec<(String, String)>> {
+    let mut reader = Reader::from_reader(source);
+    let mut buf = Vec::new();
+    let mut rels = Vec::new();
+
+    loop {
+        match reader.read_event_into(&mut buf).map_err(xml_error)? {
+            Event::Start(e) | Event::Empty(e) if e.local_name().as_ref() == b"Relationship" => {
+                if let (Some(id), Some(target)) = (attribute(&e, b"Id"), attribute(&e, b"Target")) {
+                    let part = match target.strip_prefix('/') {
+                        Some(absolute) => absolute.to_string(),
+                        None => format!("xl/{}", target),
+                    };
+                    rels.push((id, part));
+                }
+            }
+            Event::Eof => break,
+            _ => {}
+        }
+        buf.clear();
+    }
+
+    Ok(rels)
+}
+
+/// Sheets listed in `xl/workbook.xml`, in workbook order
+fn parse_workbook<R: BufRead>(source: R, rels: &[(String, String)]) -> Result<Vec<SheetEntry>> {
+    let mut reader = Reader::from_reader(source);
+    let mut buf = Vec::new();
+    let mut sheets = Vec::new();
+
+    loop {
+        match reader.read_event_into(&mut buf).map_err(xml_error)? {
+            Event::Start(e) | Event::Empty(e) if e.local_name().as_ref() == b"sheet" => {
+                let name = attribute(&e, b"name").unwrap_or_default();
+                // Without relationships, fall back to the conventional part names
+                let part = attribute(&e, b"id")
+                    .and_then(|id| rels.iter().find(|(rid, _)| *rid == id))
+                    .map(|(_, part)| part.clone())
+                    .unwrap_or_else(|| format!("xl/worksheets/sheet{}.xml", sheets.len() + 1));
+                sheets.push(SheetEntry { name, part });
+            }
+            Event::Eof => break,
+            _ => {}
+        }
+        buf.clear();
+    }
+
+    Ok(sheets)
+}
+
+/// Shared string table: the text of every `<si>`, rich-text runs joined
+/// and phonetic hints (`<rPh>`) skipped
+fn parse_shared_strings<R: BufRead>(source: R) -> Result<Vec<String>> {
+    let mut reader = Reader::from_reader(source);
+    let mut buf = Vec::new();
+    let mut strings = Vec::new();
+    let mut current = String::new();
+    let mut in_text = false;
+    let mut in_phonetic = false;
+
+    loop {
+        match reader.read_event_into(&mut buf).map_err(xml_error)? {
+            Event::Start(e) => match e.local_name().as_ref() {
+                b"si" => current.clear(),
+                b"t" => in_text = !in_phonetic,
+                b"rPh" => in_phonetic = true,
+                _ => {}
+            },
+            Event::End(e) => match e.local_name().as_ref() {
+                b"si" => strings.push(std::mem::take(&mut current)),
+                b"t" => in_text = false,
+                b"rPh" => in_phonetic = false,
+                _ => {}
+            },
+            Event::Empty(e) if e.local_name().as_ref() == b"si" => strings.push(String::new()),
+            Event::Text(e) if in_text => current.push_str(&e.unescape().map_err(xml_error)?),
+            Event::CData(e) if in_text => current.push_str(&String::from_utf8_lossy(&e)),
+            Event::Eof => break,
+            _ => {}
+        }
+        buf.clear();
+    }
+
+    Ok(strings)
+}
+
+/// `"AB12"` → 0-based column of the cell reference
+fn column_index(reference: &str) -> Option<usize> {
+    let letters = reference
+        .bytes()
+        .take_while(u8::is_ascii_alphabetic)
+        .try_fold(0usize, |col, b| {
+            col.checked_mul(26)?
+                .checked_add(usize::from(b.to_ascii_uppercase() - b'A') + 1)
+        })?;
+    letters.checked_sub(1)
+}
+
+/// Cell being read: column, `t` attribute and value text
+struct OpenCell {
+    col: usize,
+    kind: Option<String>,
+    value: String,
+}
+
+/// Cells of a worksheet part, in a single forward pass
+fn parse_sheet<R: BufRead>(source: R, shared_strings: &[String]) -> Result<Sheet> {
+    let mut reader = Reader::from_reader(source);
+    let mut buf = Vec::new();
+    let mut sheet = Sheet::default();
+
+    let mut row: Option<Row> = None;
+    let mut next_row = 1;
+    let mut next_col = 0;
+    let mut cell: Option<OpenCell> = None;
+    // Inside <v>, or inside <is>…<t> outside phonetic hints
+    let mut in_value = false;
+    let mut in_inline = false;
+    let mut in_phonetic = false;
+
+    loop {
+        match reader.read_event_into(&mut buf).map_err(xml_error)? {
+            Event::Start(e) => match e.local_name().as_ref() {
+                b"row" => {
+                    let number = attribute(&e, b"r")
+                        .and_then(|r| r.parse().ok())
+                        .unwrap_or(next_row);
+                    next_row = number + 1;
+                    next_col = 0;
+                    row = Some(Row {
+                        number,
+                        cells: Vec::new(),
+                    });
+                }
+                b"c" => {
+                    let col = attribute(&e, b"r")
+                        .and_then(|r| column_index(&r))
+                        .unwrap_or(next_col);
+                    cell = Some(OpenCell {
+                        col,
+                        kind: attribute(&e, b"t"),
+                        value: String::new(),
+                    });
+                }
+                b"v" => in_value = cell.is_some(),
+                b"is" => in_inline = cell.is_some(),
+                b"t" => in_value = in_inline && !in_phonetic,
+                b"rPh" => in_phonetic = true,
+                _ => {}
+            },
+            Event::End(e) => match e.local_name().as_ref() {
+                b"row" => {
+                    if let Some(row) = row.take().filter(|row| !row.cells.is_empty()) {
+                        sheet.rows.push(row);
+                    }
+                }
+                b"c" => {
+                    if let Some(cell) = cell.take() {
+                        next_col = cell.col + 1;
+                        let value = cell_value(cell.kind.as_deref(), cell.value, shared_strings);
+                        if let (Some(row), false) = (row.as_mut(), value.is_empty()) {
+                            sheet.width = sheet.width.max(cell.col + 1);
+                            row.cells.push((cell.col, value));
+                        }
+                    }
+                }
+                b"v" | b"t" => in_value = false,
+                b"is" => in_inline = false,
+                b"rPh" => in_phonetic = false,
+                // Merged ranges, conditional formats etc. follow the cells
+                b"sheetData" => break,
+                _ => {}
+            },
+            Event::Empty(e) => match e.local_name().as_ref() {
+                b"row" => {
+                    next_row = attribute(&e, b"r")
+                        .and_then(|r| r.parse().ok())
+                        .unwrap_or(next_row)
+                        + 1;
+                }
+                b"c" => {
+                    next_col = attribute(&e, b"r")
+                        .and_then(|r| column_index(&r))
+                        .unwrap_or(next_col)
+                        + 1;
+                }
+                _ => {}
+            },
+            Event::Text(e) if in_value => {
+                if let Some(cell) = cell.as_mut() {
+                    cell.value.push_str(&e.unescape().map_err(xml_error)?);
+                }
+            }
+            Event::CData(e) if in_value => {
+                if let Some(cell) = cell.as_mut() {
+                    cell.value.push_str(&String::from_utf8_lossy(&e));
+                }
+            }
+            Event::Eof => break,
+            _ => {}
+        }
+        buf.clear();
+    }
+
+    // Cells in a row are normally in column order; keep lookups simple if not
+    for row in &mut sheet.rows {
+        if !row.cells.is_sorted_by_key(|(col, _)| *col) {
+            row.cells.sort_by_key(|(col, _)| *col);
+        }
+    }
+
+    Ok(sheet)
+}
+
+/// Display value of a cell from its type and raw `<v>`/`<is>` text
+fn cell_value(kind: Option<&str>, raw: String, shared_strings: &[String]) -> String {
+    match kind {
+        Some("s") => raw
+            .trim()
+            .parse::<usize>()
+            .ok()
+            .and_then(|idx| shared_strings.get(idx))
+            .cloned()
+            .unwrap_or_default(),
+        Some("b") => match raw.trim() {
+            "1" => "TRUE".to_string(),
+            "0" => "FALSE".to_string(),
+            _ => raw,
+        },
+        _ => raw,
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_column_index() {
+        assert_eq!(column_index("A1"), Some(0));
+        assert_eq!(column_index("z9"), Some(25));
+        assert_eq!(column_index("AA10"), Some(26));
+        assert_eq!(column_index("ZZ100000"), Some(701));
+        assert_eq!(column_index("12"), None);
+    }
+
+    #[test]
+    fn test_parse_workbook_and_shared_strings() {
+        let rels = br#"<Relationships xmlns="http://schemas.openxmlformats.org/package/2006/relationships">
+            <Relationship Id="rId2" Type="worksheet" Target="worksheets/sheet2.xml"/>
+            <Relationship Id="rId1" Type="worksheet" Target="/xl/worksheets/data.xml"/>
+        </Relationships>"#;
+        let workbook = br#"<workbook xmlns:r="http://schemas.openxmlformats.org/officeDocument/2006/relationships">
+            <sheets><sheet name="Data &amp; More" sheetId="1" r:id="rId1"/><sheet name="Two" sheetId="2" r:id="rId2"/></sheets>
+        </workbook>"#;
+        let rels = parse_relationships(&rels[..]).unwrap();
+        let sheets = parse_workbook(&workbook[..], &rels).unwrap();
+        assert_eq!(
+            sheets,
+            vec![
+                SheetEntry {
+                    name: "Data & More".to_string(),
+                    part: "xl/worksheets/data.xml".to_string(),
+                },
+                SheetEntry {
+                    name: "Two".to_string(),
+                    part: "xl/worksheets/sheet2.xml".to_string(),
+                },
+            ]
+        );
+
+        let shared = br#"<sst><si><t>plain</t></si><si/><si><r><t>rich </t></r><r><t xml:space="preserve">text</t></r><rPh><t>hint</t></rPh></si></sst>"#;
+        assert_eq!(
+            parse_shared_strings(&shared[..]).unwrap(),
+            vec!["plain", "", "rich text"]
+        );
+    }
+
+    #[test]
+    fn test_parse_sheet_sparse() {
+        let shared = vec!["Name".to_string(), "Value".to_string()];
+        let xml = br#"<worksheet><dimension ref="A1:ZZ100000"/><sheetData>
+            <row r="1"><c r="A1" t="s"><v>0</v></c><c r="B1" t="s"><v>1</v></c></row>
+            <row r="2"><c t="inlineStr"><is><t>a &lt; b</t></is></c><c><v>3.5</v></c><c r="D2" t="b"><v>1</v></c></row>
+            <row r="3"><c r="A3"/><c r="B3"><f>SUM(B2)</f></c></row>
+            <row><c r="C4" t="str"><v>x</v></c></row>
+            <row r="100000"><c r="ZZ100000"><v>stray</v></c></row>
+        </sheetData><mergeCells count="1"><mergeCell ref="A1:B1"/></mergeCells></worksheet>"#;
+
+        let sheet = parse_sheet(&xml[..], &shared).unwrap();
+        assert_eq!(sheet.width, 702);
+        assert_eq!(sheet.rows.len(), 4);
+        assert_eq!(
+            sheet.rows[1],
+            Row {
+                number: 2,
+                cells: vec![
+                    (0, "a < b".to_string()),
+                    (1, "3.5".to_string()),
+                    (3, "TRUE".to_string())
+                ],
+            }
+        );
+        assert_eq!(sheet.rows[2].number, 4);
+        assert_eq!(sheet.rows[3].cells, vec![(701, "stray".to_string())]);
+
+        let values: Vec<&str> = sheet.rows[1].values(5).collect();
+        assert_eq!(values, vec!["a < b", "3.5", "", "TRUE", ""]);
+    }
+}
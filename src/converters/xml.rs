@@ -1,24 +1,27 @@
 //! XML converter implementation
 //!
 //! Converts XML to JSON (structured) and Markdown (text content).
-//! Uses quick-xml for fast, memory-efficient parsing.
+//! Uses the quick-xml pull parser: events are written to the output as
+//! they are read, so memory stays bounded by the read buffer and the
+//! depth of the document. Element-path filters choose which subtrees are
+//! converted; skipped subtrees are read past without producing events.
 
-#![allow(
-    clippy::unused_self,
-    clippy::uninlined_format_args,
-    clippy::single_char_add_str
-)]
+#![allow(clippy::uninlined_format_args)]
 
-use std::path::Path;
+use std::fs::File;
+use std::io::{BufRead, BufReader, Write};
+use std::path::{Path, PathBuf};
 
 use async_trait::async_trait;
+use quick_xml::Reader;
+use quick_xml::events::{BytesStart, Event};
 use tokio::fs;
 
 use super::traits::{ConverterMetadata, DocumentConverter};
-use crate::Result;
 use crate::types::{
     ConversionOptions, ConversionOutput, ConversionResult, FileFormat, OutputFormat, OutputMetadata,
 };
+use crate::{Result, TransmutationError};
 
 /// XML to Markdown/JSON converter
 #[derive(Debug)]
@@ -29,75 +32,346 @@ impl XmlConverter {
     pub fn new() -> Self {
         Self
     }
+}
+
+impl Default for XmlConverter {
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
+/// Element path pattern: `/a/b` matches from the root, `a/b` at any depth,
+/// and `*` matches any single element
+#[derive(Debug, Clone, PartialEq, Eq)]
+struct PathPattern {
+    anchored: bool,
+    steps: Vec<Vec<u8>>,
+}
+
+impl PathPattern {
+    fn parse(pattern: &str) -> Option<Self> {
+        let steps: Vec<Vec<u8>> = pattern
+            .split('/')
+            .filter(|step| !step.is_empty())
+            .map(|step| step.as_bytes().to_vec())
+            .collect();
+        (!steps.is_empty()).then(|| Self {
+            anchored: pattern.starts_with('/'),
+            steps,
+        })
+    }
+
+    fn matches(&self, path: &ElementPath) -> bool {
+        let depth = path.depth();
+        if depth < self.steps.len() || (self.anchored && depth != self.steps.len()) {
+            return false;
+        }
+        path.names()
+            .skip(depth - self.steps.len())
+            .zip(&self.steps)
+            .all(|(name, step)| step == b"*" || step == name)
+    }
+}
 
-    /// Convert XML to JSON using quick-xml
-    fn xml_to_json(&self, xml: &str) -> Result<String> {
-        use quick_xml::de::from_str;
-        use serde_json::Value;
+/// Which subtrees of an XML document are converted
+#[derive(Debug, Clone, Default)]
+struct XmlFilter {
+    skip: Vec<PathPattern>,
+    select: Vec<PathPattern>,
+}
+
+impl XmlFilter {
+    /// Skip subtrees matching `skip`; when `select` is not empty, convert
+    /// only subtrees matching it
+    fn new(skip: &[String], select: &[String]) -> Self {
+        let parse = |patterns: &[String]| {
+            patterns
+                .iter()
+                .filter_map(|pattern| PathPattern::parse(pattern))
+                .collect()
+        };
+        Self {
+            skip: parse(skip),
+            select: parse(select),
+        }
+    }
 
-        // Parse XML to generic Value
-        let value: Value = from_str(xml).map_err(|e| {
-            crate::TransmutationError::engine_error(
-                "xml-parser",
-                format!("Failed to parse XML: {}", e),
-            )
-        })?;
+    fn skips(&self, path: &ElementPath) -> bool {
+        self.skip.iter().any(|pattern| pattern.matches(path))
+    }
 
-        // Convert to pretty JSON
-        Ok(serde_json::to_string_pretty(&value)?)
+    fn selects(&self, path: &ElementPath) -> bool {
+        self.select.is_empty() || self.select.iter().any(|pattern| pattern.matches(path))
     }
+}
+
+/// Names of the open elements, kept in one buffer
+#[derive(Debug, Default)]
+struct ElementPath {
+    names: Vec<u8>,
+    ends: Vec<usize>,
+}
 
-    /// Convert XML to Markdown (extract text content)
-    fn xml_to_markdown(&self, xml: &str) -> Result<String> {
-        use quick_xml::Reader;
-        use quick_xml::events::Event;
+impl ElementPath {
+    fn push(&mut self, name: &[u8]) {
+        self.names.extend_from_slice(name);
+        self.ends.push(self.names.len());
+    }
 
-        let mut reader = Reader::from_str(xml);
-        reader.config_mut().trim_text(true);
+    fn pop(&mut self) {
+        self.ends.pop();
+        self.names.truncate(self.ends.last().copied().unwrap_or(0));
+    }
 
-        let mut markdown = String::new();
-        markdown.push_str("# XML Document\n\n");
+    fn depth(&self) -> usize {
+        self.ends.len()
+    }
 
-        let mut current_element = String::new();
-        let mut text_parts = Vec::new();
-        let mut buf = Vec::new();
+    fn names(&self) -> impl Iterator<Item = &[u8]> {
+        let starts = std::iter::once(0).chain(self.ends.iter().copied());
+        starts
+            .zip(&self.ends)
+            .map(|(start, &end)| &self.names[start..end])
+    }
+}
 
-        loop {
-            match reader.read_event_into(&mut buf) {
-                Ok(Event::Start(e)) => {
-                    current_element = String::from_utf8_lossy(e.name().as_ref()).to_string();
-                }
-                Ok(Event::Text(e)) => {
-                    if let Ok(text) = e.unescape() {
-                        let content = text.trim();
-                        if !content.is_empty() && !current_element.is_empty() {
-                            text_parts.push(format!("**{}**: {}", current_element, content));
+/// Output being written by [`stream_xml`]
+#[derive(Debug)]
+enum XmlSink {
+    /// `**element**: text` paragraphs, as in the tree-based converter
+    Markdown { current: Vec<u8>, parts: usize },
+    /// Array of elements: `{"name", "attributes", "children"}` objects
+    /// with text children as strings. Each open element records whether
+    /// its `children` array has been started.
+    Json { open: Vec<bool>, roots: usize },
+}
+
+impl XmlSink {
+    fn begin<W: Write>(&self, out: &mut W) -> Result<()> {
+        match self {
+            XmlSink::Markdown { .. } => out.write_all(b"# XML Document\n\n")?,
+            XmlSink::Json { .. } => out.write_all(b"[")?,
+        }
+        Ok(())
+    }
+
+    fn start<W: Write>(&mut self, element: &BytesStart<'_>, out: &mut W) -> Result<()> {
+        match self {
+            XmlSink::Markdown { current, .. } => {
+                current.clear();
+                current.extend_from_slice(element.name().as_ref());
+            }
+            XmlSink::Json { .. } => {
+                self.json_child(out)?;
+                out.write_all(b"{\"name\":")?;
+                serde_json::to_writer(
+                    &mut *out,
+                    &*String::from_utf8_lossy(element.name().as_ref()),
+                )?;
+                let mut attributes = element.attributes().flatten().peekable();
+                if attributes.peek().is_some() {
+                    out.write_all(b",\"attributes\":{")?;
+                    for (idx, attr) in attributes.enumerate() {
+                        if idx > 0 {
+                            out.write_all(b",")?;
                         }
+                        serde_json::to_writer(
+                            &mut *out,
+                            &*String::from_utf8_lossy(attr.key.as_ref()),
+                        )?;
+                        out.write_all(b":")?;
+                        let value = attr.unescape_value().map_err(xml_error)?;
+                        serde_json::to_writer(&mut *out, &*value)?;
                     }
+                    out.write_all(b"}")?;
                 }
-                Ok(Event::Eof) => break,
-                Err(e) => {
-                    return Err(crate::TransmutationError::engine_error(
-                        "xml-parser",
-                        format!("XML parse error: {}", e),
-                    ));
+                if let XmlSink::Json { open, .. } = self {
+                    open.push(false);
                 }
-                _ => {}
             }
-            buf.clear();
         }
+        Ok(())
+    }
 
-        markdown.push_str(&text_parts.join("\n\n"));
-        markdown.push_str("\n");
+    /// Start an element with no content (`<a/>`)
+    fn empty<W: Write>(&mut self, element: &BytesStart<'_>, out: &mut W) -> Result<()> {
+        if let XmlSink::Json { .. } = self {
+            self.start(element, out)?;
+            self.end(out)?;
+        }
+        Ok(())
+    }
 
-        Ok(markdown)
+    fn end<W: Write>(&mut self, out: &mut W) -> Result<()> {
+        if let XmlSink::Json { open, .. } = self {
+            out.write_all(if open.pop() == Some(true) {
+                b"]}"
+            } else {
+                b"}"
+            })?;
+        }
+        Ok(())
+    }
+
+    fn text<W: Write>(&mut self, text: &str, out: &mut W) -> Result<()> {
+        let text = text.trim();
+        if text.is_empty() {
+            return Ok(());
+        }
+        match self {
+            XmlSink::Markdown { current, parts } => {
+                if current.is_empty() {
+                    return Ok(());
+                }
+                if *parts > 0 {
+                    out.write_all(b"\n\n")?;
+                }
+                out.write_all(b"**")?;
+                out.write_all(current)?;
+                write!(out, "**: {}", text)?;
+                *parts += 1;
+            }
+            XmlSink::Json { .. } => {
+                self.json_child(out)?;
+                serde_json::to_writer(&mut *out, text)?;
+            }
+        }
+        Ok(())
+    }
+
+    /// Separator before a new child of the innermost open element
+    fn json_child<W: Write>(&mut self, out: &mut W) -> Result<()> {
+        if let XmlSink::Json { open, roots } = self {
+            match open.last_mut() {
+                Some(started @ false) => {
+                    *started = true;
+                    out.write_all(b",\"children\":[")?;
+                }
+                Some(true) => out.write_all(b",")?,
+                None => {
+                    if *roots > 0 {
+                        out.write_all(b",")?;
+                    }
+                    *roots += 1;
+                }
+            }
+        }
+        Ok(())
+    }
+
+    fn finish<W: Write>(self, out: &mut W) -> Result<()> {
+        match self {
+            XmlSink::Markdown { .. } => out.write_all(b"\n")?,
+            XmlSink::Json { .. } => out.write_all(b"]")?,
+        }
+        Ok(())
     }
 }
 
-impl Default for XmlConverter {
-    fn default() -> Self {
-        Self::new()
+/// Convert XML from `source` into `out` event by event
+fn stream_xml<R: BufRead, W: Write>(
+    source: R,
+    filter: &XmlFilter,
+    json: bool,
+    out: &mut W,
+) -> Result<()> {
+    let mut reader = Reader::from_reader(source);
+    reader.config_mut().trim_text(true);
+
+    let mut sink = if json {
+        XmlSink::Json {
+            open: Vec::new(),
+            roots: 0,
+        }
+    } else {
+        XmlSink::Markdown {
+            current: Vec::new(),
+            parts: 0,
+        }
+    };
+    sink.begin(out)?;
+
+    let mut buf = Vec::new();
+    let mut skip_buf = Vec::new();
+    let mut path = ElementPath::default();
+    // Depth of the selected element being converted, if any
+    let mut selected: Option<usize> = None;
+
+    loop {
+        match reader.read_event_into(&mut buf).map_err(xml_error)? {
+            Event::Start(e) => {
+                path.push(e.name().as_ref());
+                if filter.skips(&path) {
+                    reader
+                        .read_to_end_into(e.name(), &mut skip_buf)
+                        .map_err(xml_error)?;
+                    skip_buf.clear();
+                    path.pop();
+                } else {
+                    if selected.is_none() && filter.selects(&path) {
+                        selected = Some(path.depth());
+                    }
+                    if selected.is_some() {
+                        sink.start(&e, out)?;
+                    }
+                }
+            }
+            Event::Empty(e) => {
+                path.push(e.name().as_ref());
+                if !filter.skips(&path) && (selected.is_some() || filter.selects(&path)) {
+                    sink.empty(&e, out)?;
+                }
+                path.pop();
+            }
+            Event::End(_) => {
+                if selected.is_some() {
+                    sink.end(out)?;
+                }
+                if selected == Some(path.depth()) {
+                    selected = None;
+                }
+                path.pop();
+            }
+            Event::Text(e) if selected.is_some() => match e.unescape() {
+                Ok(text) => sink.text(&text, out)?,
+                // Entities declared in a DTD (`&nbsp;`) are kept as written
+                Err(_) if !json => sink.text(&String::from_utf8_lossy(&e), out)?,
+                Err(e) => return Err(xml_error(e)),
+            },
+            Event::CData(e) if selected.is_some() => {
+                sink.text(&String::from_utf8_lossy(&e), out)?;
+            }
+            Event::Eof => break,
+            _ => {}
+        }
+        buf.clear();
     }
+
+    sink.finish(out)
+}
+
+/// Whether `output_format` asks for JSON (otherwise Markdown)
+fn json_output(output_format: &OutputFormat) -> Result<bool> {
+    Ok(match output_format {
+        OutputFormat::Markdown { .. } => {
+            eprintln!("📝 Converting to Markdown...");
+            false
+        }
+        OutputFormat::Json { .. } => {
+            eprintln!("📝 Converting to JSON...");
+            true
+        }
+        _ => {
+            return Err(TransmutationError::UnsupportedFormat(format!(
+                "Output format {:?} not supported for XML",
+                output_format
+            )));
+        }
+    })
+}
+
+fn xml_error(e: quick_xml::Error) -> TransmutationError {
+    TransmutationError::engine_error("xml-parser", format!("XML parse error: {}", e))
 }
 
 #[async_trait]
@@ -123,34 +397,27 @@ impl DocumentConverter for XmlConverter {
         &self,
         input: &Path,
         output_format: OutputFormat,
-        _options: ConversionOptions,
+        options: ConversionOptions,
     ) -> Result<ConversionResult> {
         eprintln!("🔄 XML Conversion (Pure Rust)");
-        eprintln!("   XML → Parsing → {:?}", output_format);
+        eprintln!("   XML → Streaming Parser → {:?}", output_format);
         eprintln!();
 
-        // Read XML file
-        let xml_content = fs::read_to_string(input).await?;
-
-        // Convert to requested format
-        let output_data = match output_format {
-            OutputFormat::Markdown { .. } => {
-                eprintln!("📝 Converting to Markdown...");
-                let markdown = self.xml_to_markdown(&xml_content)?;
-                markdown.into_bytes()
-            }
-            OutputFormat::Json { .. } => {
-                eprintln!("📝 Converting to JSON...");
-                let json = self.xml_to_json(&xml_content)?;
-                json.into_bytes()
-            }
-            _ => {
-                return Err(crate::TransmutationError::UnsupportedFormat(format!(
-                    "Output format {:?} not supported for XML",
-                    output_format
-                )));
-            }
-        };
+        let json = json_output(&output_format)?;
+        let filter = XmlFilter::new(&options.xml_skip_paths, &options.xml_select_paths);
+        let path = input.to_path_buf();
+        let output_data = tokio::task::spawn_blocking(move || -> Result<Vec<u8>> {
+            let mut output = Vec::new();
+            stream_xml(
+                BufReader::new(File::open(&path)?),
+                &filter,
+                json,
+                &mut output,
+            )?;
+            Ok(output)
+        })
+        .await
+        .map_err(|e| TransmutationError::conversion_failed(e.to_string()))??;
 
         let output_size = output_data.len() as u64;
         let input_size = fs::metadata(input).await?.len();
@@ -191,11 +458,39 @@ impl DocumentConverter for XmlConverter {
         })
     }
 
+    async fn convert_bytes(
+        &self,
+        name: &str,
+        data: Vec<u8>,
+        _input_format: FileFormat,
+        output_format: OutputFormat,
+        options: ConversionOptions,
+    ) -> Result<ConversionResult> {
+        let json = json_output(&output_format)?;
+        let filter = XmlFilter::new(&options.xml_skip_paths, &options.xml_select_paths);
+        let input_size = data.len() as u64;
+        let output_data = tokio::task::spawn_blocking(move || -> Result<Vec<u8>> {
+            let mut output = Vec::new();
+            stream_xml(&data[..], &filter, json, &mut output)?;
+            Ok(output)
+        })
+        .await
+        .map_err(|e| TransmutationError::conversion_failed(e.to_string()))??;
+
+        Ok(ConversionResult::single(
+            PathBuf::from(name),
+            FileFormat::Xml,
+            output_format,
+            output_data,
+            input_size,
+        ))
+    }
+
     fn metadata(&self) -> ConverterMetadata {
         ConverterMetadata {
             name: "XML Converter".to_string(),
             version: env!("CARGO_PKG_VERSION").to_string(),
-            description: "XML to Markdown/JSON converter (pure Rust)".to_string(),
+            description: "XML to Markdown/JSON streaming converter (pure Rust)".to_string(),
             external_deps: vec![],
         }
     }
@@ -205,6 +500,17 @@ impl DocumentConverter for XmlConverter {
 mod tests {
     use super::*;
 
+    fn render(xml: &str, json: bool, filter: &XmlFilter) -> Result<String> {
+        let mut out = Vec::new();
+        stream_xml(xml.as_bytes(), filter, json, &mut out)?;
+        Ok(String::from_utf8(out).unwrap())
+    }
+
+    fn filter(skip: &[&str], select: &[&str]) -> XmlFilter {
+        let owned = |paths: &[&str]| paths.iter().map(|p| p.to_string()).collect::<Vec<_>>();
+        XmlFilter::new(&owned(skip), &owned(select))
+    }
+
     #[test]
     fn test_xml_converter_creation() {
         let converter = XmlConverter::new();
@@ -213,12 +519,79 @@ mod tests {
 
     #[test]
     fn test_xml_to_json_basic() {
-        let converter = XmlConverter::new();
         let xml = "<root><item>test</item></root>";
-        let result = converter.xml_to_json(xml);
+        let result = render(xml, true, &XmlFilter::default());
         assert!(result.is_ok());
     }
 
+    #[test]
+    fn test_xml_to_json_structure() {
+        let xml = "<?xml version=\"1.0\"?><root id=\"r&amp;1\"><item>a &lt; b</item><br/>\
+                   <item><![CDATA[<raw>]]></item></root>";
+        let json: serde_json::Value =
+            serde_json::from_str(&render(xml, true, &XmlFilter::default()).unwrap()).unwrap();
+
+        assert_eq!(
+            json,
+            serde_json::json!([{
+                "name": "root",
+                "attributes": {"id": "r&1"},
+                "children": [
+                    {"name": "item", "children": ["a < b"]},
+                    {"name": "br"},
+                    {"name": "item", "children": ["<raw>"]},
+                ]
+            }])
+        );
+    }
+
+    #[test]
+    fn test_xml_to_markdown_text() {
+        let xml = "<doc><title>Report</title><body><p>One</p><p>Two</p></body></doc>";
+        assert_eq!(
+            render(xml, false, &XmlFilter::default()).unwrap(),
+            "# XML Document\n\n**title**: Report\n\n**p**: One\n\n**p**: Two\n"
+        );
+    }
+
+    #[test]
+    fn test_xml_to_markdown_undeclared_entity() {
+        let xml = "<doc><p>Before</p><p>a&nbsp;b</p><p>After</p></doc>";
+        assert_eq!(
+            render(xml, false, &XmlFilter::default()).unwrap(),
+            "# XML Document\n\n**p**: Before\n\n**p**: a&nbsp;b\n\n**p**: After\n"
+        );
+    }
+
+    #[test]
+    fn test_xml_path_filters() {
+        let xml = "<feed><meta><p>skip</p></meta><entry><id>1</id><meta>m</meta></entry>\
+                   <entry><id>2</id></entry><other><id>3</id></other></feed>";
+
+        let skipped = render(xml, false, &filter(&["meta"], &[])).unwrap();
+        assert!(!skipped.contains("skip") && !skipped.contains("**meta**"));
+        assert!(skipped.contains("**id**: 3"));
+
+        let selected = render(xml, true, &filter(&["/feed/entry/meta"], &["/feed/entry"])).unwrap();
+        let json: serde_json::Value = serde_json::from_str(&selected).unwrap();
+        assert_eq!(
+            json,
+            serde_json::json!([
+                {"name": "entry", "children": [{"name": "id", "children": ["1"]}]},
+                {"name": "entry", "children": [{"name": "id", "children": ["2"]}]},
+            ])
+        );
+
+        let wildcard = render(xml, false, &filter(&[], &["*/id"])).unwrap();
+        assert!(wildcard.contains("**id**: 1") && wildcard.contains("**id**: 3"));
+        assert!(!wildcard.contains("meta"));
+    }
+
+    #[test]
+    fn test_xml_parse_error() {
+        assert!(render("<a><b></a>", true, &XmlFilter::default()).is_err());
+    }
+
     #[test]
     fn test_xml_converter_metadata() {
         let converter = XmlConverter::new();
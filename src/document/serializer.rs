@@ -9,11 +9,15 @@
     clippy::uninlined_format_args
 )]
 
+use std::fmt::{self, Write};
+use std::io;
+
 use once_cell::sync::Lazy;
 use regex::Regex;
+use tokio::io::{AsyncWrite, AsyncWriteExt};
 
 use super::types::*;
-use crate::error::Result;
+use crate::error::{Result, TransmutationError};
 
 /// Pattern for detecting markdown special characters
 static MD_ESCAPE_PATTERN: Lazy<Regex> =
@@ -69,203 +73,250 @@ impl MarkdownSerializer {
         self
     }
 
+    /// Serialize the whole document into a `String`
     pub fn serialize(&self, doc: &DoclingDocument) -> Result<String> {
-        let mut parts = Vec::new();
+        let mut sink = MarkdownSink::default();
+        for (i, item) in doc.items.iter().enumerate() {
+            self.write_separated(&mut sink, i, item)?;
+        }
+        Ok(sink.out)
+    }
 
-        for item in &doc.items {
-            if let Some(text) = self.serialize_item(item) {
-                parts.push(text);
+    /// Serialize into an `io::Write` (file, socket, ...) without building
+    /// the document in memory
+    ///
+    /// Items are rendered straight into a small buffer that is handed to
+    /// `writer` every `FLUSH_BYTES`, so memory stays flat however large the
+    /// document is. Produces exactly the bytes of [`Self::serialize`].
+    pub fn serialize_to_writer<W: io::Write>(
+        &self,
+        doc: &DoclingDocument,
+        mut writer: W,
+    ) -> Result<()> {
+        let mut sink = MarkdownSink::default();
+        for (i, item) in doc.items.iter().enumerate() {
+            self.write_separated(&mut sink, i, item)?;
+            if sink.out.len() >= FLUSH_BYTES {
+                writer.write_all(sink.out.as_bytes())?;
+                sink.out.clear();
             }
         }
+        writer.write_all(sink.out.as_bytes())?;
+        writer.flush()?;
+        Ok(())
+    }
 
-        let mut output = parts.join("\n\n");
-
-        // Clean up excessive newlines
-        while output.contains("\n\n\n") {
-            output = output.replace("\n\n\n", "\n\n");
+    /// Async counterpart of [`Self::serialize_to_writer`] for tokio writers
+    pub async fn serialize_to_async_writer<W: AsyncWrite + Unpin>(
+        &self,
+        doc: &DoclingDocument,
+        mut writer: W,
+    ) -> Result<()> {
+        let mut sink = MarkdownSink::default();
+        for (i, item) in doc.items.iter().enumerate() {
+            self.write_separated(&mut sink, i, item)?;
+            if sink.out.len() >= FLUSH_BYTES {
+                writer.write_all(sink.out.as_bytes()).await?;
+                sink.out.clear();
+            }
         }
+        writer.write_all(sink.out.as_bytes()).await?;
+        writer.flush().await?;
+        Ok(())
+    }
 
-        Ok(output.trim().to_string())
+    /// Write one item, preceded by a blank line unless it is the first
+    fn write_separated(&self, sink: &mut MarkdownSink, index: usize, item: &DocItem) -> Result<()> {
+        let written = if index == 0 {
+            self.write_item(sink, item)
+        } else {
+            sink.write_str("\n\n")
+                .and_then(|()| self.write_item(sink, item))
+        };
+        written.map_err(|_| TransmutationError::conversion_failed("Markdown serialization failed"))
     }
 
-    fn serialize_item(&self, item: &DocItem) -> Option<String> {
+    fn write_item(&self, out: &mut impl Write, item: &DocItem) -> fmt::Result {
         match item {
-            DocItem::Title(text_item) => Some(self.serialize_title(text_item)),
-            DocItem::SectionHeader(header) => Some(self.serialize_section_header(header)),
-            DocItem::Paragraph(text_item) => Some(self.serialize_paragraph(text_item)),
-            DocItem::ListItem(list_item) => Some(self.serialize_list_item(list_item)),
-            DocItem::Table(table) => Some(self.serialize_table(table)),
-            DocItem::Picture(picture) => Some(self.serialize_picture(picture)),
-            DocItem::Code(code) => Some(self.serialize_code(code)),
-            DocItem::Formula(formula) => Some(self.serialize_formula(formula)),
+            DocItem::Title(text_item) => self.write_title(out, text_item),
+            DocItem::SectionHeader(header) => self.write_section_header(out, header),
+            DocItem::Paragraph(text_item) => self.write_paragraph(out, text_item),
+            DocItem::ListItem(list_item) => self.write_list_item(out, list_item),
+            DocItem::Table(table) => self.write_table(out, table),
+            DocItem::Picture(picture) => self.write_picture(out, picture),
+            DocItem::Code(code) => self.write_code(out, code),
+            DocItem::Formula(formula) => self.write_formula(out, formula),
         }
     }
 
     fn serialize_title(&self, item: &TextItem) -> String {
-        let text = self.apply_formatting(&item.text, item.formatting.as_ref());
-        format!("# {}", text)
+        render(|out| self.write_title(out, item))
+    }
+
+    fn write_title(&self, out: &mut impl Write, item: &TextItem) -> fmt::Result {
+        out.write_str("# ")?;
+        self.write_formatted(out, "", &item.text, item.formatting.as_ref())
     }
 
     fn serialize_section_header(&self, item: &SectionHeaderItem) -> String {
-        let text = self.apply_formatting(&item.text, item.formatting.as_ref());
-        let hashes = "#".repeat(item.level + 1);
-        format!("{} {}", hashes, text)
+        render(|out| self.write_section_header(out, item))
     }
 
-    fn serialize_paragraph(&self, item: &TextItem) -> String {
-        let mut text = item.text.clone();
+    fn write_section_header(&self, out: &mut impl Write, item: &SectionHeaderItem) -> fmt::Result {
+        for _ in 0..=item.level {
+            out.write_char('#')?;
+        }
+        out.write_char(' ')?;
+        self.write_formatted(out, "", &item.text, item.formatting.as_ref())
+    }
 
+    fn write_paragraph(&self, out: &mut impl Write, item: &TextItem) -> fmt::Result {
         // Handle checkboxes
-        text = match item.label {
-            DocItemLabel::CheckboxSelected => format!("- [x] {}", text),
-            DocItemLabel::CheckboxUnselected => format!("- [ ] {}", text),
-            _ => text,
+        let checkbox = match item.label {
+            DocItemLabel::CheckboxSelected => "- [x] ",
+            DocItemLabel::CheckboxUnselected => "- [ ] ",
+            _ => "",
         };
 
-        self.apply_formatting(&text, item.formatting.as_ref())
+        self.write_formatted(out, checkbox, &item.text, item.formatting.as_ref())
     }
 
-    fn serialize_list_item(&self, item: &ListItemData) -> String {
-        let indent_str = " ".repeat(item.level * self.indent);
-        let marker = if item.enumerated {
-            "1.".to_string()
-        } else {
-            item.marker.clone()
-        };
-
-        format!("{}{} {}", indent_str, marker, item.text)
+    fn write_list_item(&self, out: &mut impl Write, item: &ListItemData) -> fmt::Result {
+        let marker = if item.enumerated { "1." } else { &item.marker };
+        write!(
+            out,
+            "{:indent$}{} {}",
+            "",
+            marker,
+            item.text,
+            indent = item.level * self.indent
+        )
     }
 
-    fn serialize_table(&self, table: &TableItem) -> String {
-        let mut output = String::new();
-
+    fn write_table(&self, out: &mut impl Write, table: &TableItem) -> fmt::Result {
         // Add caption if present
         if let Some(caption) = &table.caption {
-            output.push_str(caption);
-            output.push_str("\n\n");
+            out.write_str(caption)?;
+            out.write_str("\n\n")?;
         }
 
         // Serialize table using GitHub-flavored markdown
-        if table.data.grid.is_empty() {
-            return output;
-        }
+        let Some((header, rows)) = table.data.grid.split_first() else {
+            return Ok(());
+        };
 
         // Header row
-        let header = &table.data.grid[0];
-        output.push('|');
+        out.write_char('|')?;
         for cell in header {
-            output.push(' ');
-            output.push_str(&cell.text.replace('\n', " "));
-            output.push_str(" |");
+            out.write_char(' ')?;
+            write_single_line(out, &cell.text)?;
+            out.write_str(" |")?;
         }
-        output.push('\n');
 
         // Separator row
-        output.push('|');
+        out.write_str("\n|")?;
         for _ in header {
-            output.push_str(" --- |");
+            out.write_str(" --- |")?;
         }
-        output.push('\n');
 
         // Data rows
-        for row in &table.data.grid[1..] {
-            output.push('|');
+        for row in rows {
+            out.write_str("\n|")?;
             for cell in row {
-                output.push(' ');
-                output.push_str(&cell.text.replace('\n', " "));
-                output.push_str(" |");
+                out.write_char(' ')?;
+                write_single_line(out, &cell.text)?;
+                out.write_str(" |")?;
             }
-            output.push('\n');
         }
 
-        output.trim_end().to_string()
+        Ok(())
     }
 
-    fn serialize_picture(&self, picture: &PictureItem) -> String {
-        let mut output = String::new();
-
+    fn write_picture(&self, out: &mut impl Write, picture: &PictureItem) -> fmt::Result {
         if let Some(caption) = &picture.caption {
-            output.push_str(caption);
-            output.push_str("\n\n");
+            out.write_str(caption)?;
+            out.write_str("\n\n")?;
         }
 
-        output.push_str(&picture.placeholder);
-        output
+        out.write_str(&picture.placeholder)
     }
 
-    fn serialize_code(&self, code: &CodeItem) -> String {
-        if let Some(lang) = &code.language {
-            format!("```{}\n{}\n```", lang, code.text)
-        } else {
-            format!("```\n{}\n```", code.text)
-        }
+    fn write_code(&self, out: &mut impl Write, code: &CodeItem) -> fmt::Result {
+        let lang = code.language.as_deref().unwrap_or("");
+        write!(out, "```{}\n{}\n```", lang, code.text)
     }
 
-    fn serialize_formula(&self, formula: &FormulaItem) -> String {
+    fn write_formula(&self, out: &mut impl Write, formula: &FormulaItem) -> fmt::Result {
         if formula.is_inline {
-            format!("${}$", formula.text)
+            write!(out, "${}$", formula.text)
         } else {
-            format!("$${}$$", formula.text)
+            write!(out, "$${}$$", formula.text)
         }
     }
 
     fn apply_formatting(&self, text: &str, formatting: Option<&Formatting>) -> String {
-        let mut result = self.escape_markdown_chars(text);
-
-        // Apply formatting
-        if let Some(fmt) = formatting {
-            // Apply in order: bold, italic, strikethrough
-            // For combined formatting: ***text*** = bold + italic
-            if fmt.bold && fmt.italic {
-                result = format!("***{}***", result);
-            } else if fmt.bold {
-                result = format!("**{}**", result);
-            } else if fmt.italic {
-                result = format!("*{}*", result);
-            }
+        render(|out| self.write_formatted(out, "", text, formatting))
+    }
 
-            if fmt.underline {
-                // Markdown doesn't have native underline, use HTML
-                result = format!("<u>{}</u>", result);
-            }
-        }
+    /// Write `prefix` followed by `text`, escaped and wrapped in formatting markers
+    fn write_formatted(
+        &self,
+        out: &mut impl Write,
+        prefix: &str,
+        text: &str,
+        formatting: Option<&Formatting>,
+    ) -> fmt::Result {
+        // For combined formatting: ***text*** = bold + italic
+        let marker = match formatting {
+            Some(fmt) if fmt.bold && fmt.italic => "***",
+            Some(fmt) if fmt.bold => "**",
+            Some(fmt) if fmt.italic => "*",
+            _ => "",
+        };
+        // Markdown doesn't have native underline, use HTML
+        let underline = formatting.is_some_and(|fmt| fmt.underline);
 
-        result
+        if underline {
+            out.write_str("<u>")?;
+        }
+        out.write_str(marker)?;
+        self.write_escaped(out, prefix, text)?;
+        out.write_str(marker)?;
+        if underline {
+            out.write_str("</u>")?;
+        }
+        Ok(())
     }
 
     // Note: Extended formatting (strikethrough, subscript, superscript) will be added later
     // when the Formatting struct is expanded to include these fields
 
-    /// Escape markdown special characters
-    fn escape_markdown_chars(&self, text: &str) -> String {
-        if !self.escape_special_chars {
-            return text.to_string();
-        }
-
-        // Don't escape inside URLs
-        if URL_PATTERN.is_match(text) {
-            return text.to_string();
+    /// Escape markdown special characters of `prefix` followed by `text`
+    ///
+    /// The rules look at the combined text; `prefix` is empty or a checkbox
+    /// marker ending in a space, so no URL or link can span the two.
+    fn write_escaped(&self, out: &mut impl Write, prefix: &str, text: &str) -> fmt::Result {
+        let first = prefix.chars().chain(text.chars()).next();
+        let last = text
+            .chars()
+            .next_back()
+            .or_else(|| prefix.chars().next_back());
+
+        let verbatim = !self.escape_special_chars
+            // Don't escape inside URLs
+            || URL_PATTERN.is_match(prefix)
+            || URL_PATTERN.is_match(text)
+            // Don't escape if already in code block
+            || (first == Some('`') && last == Some('`'));
+        if verbatim {
+            out.write_str(prefix)?;
+            return out.write_str(text);
         }
 
-        // Don't escape if already in code block
-        if text.starts_with('`') && text.ends_with('`') {
-            return text.to_string();
-        }
-
-        // Escape special markdown characters
-        let mut result = text.to_string();
-
         // Only escape underscores if not in links
-        if self.escape_underscores && !text.contains("](") {
-            result = result.replace('_', r"\_");
-        }
-
-        // Escape other special chars selectively
-        result = result.replace('*', r"\*");
-        result = result.replace('[', r"\[");
-        result = result.replace(']', r"\]");
-
-        result
+        let underscores = self.escape_underscores && !prefix.contains("](") && !text.contains("](");
+        write_escaped_chars(out, prefix, underscores)?;
+        write_escaped_chars(out, text, underscores)
     }
 
     /// Format text with hyperlink
@@ -279,6 +330,101 @@ impl MarkdownSerializer {
     }
 }
 
+/// Rendered bytes buffered before a streaming serializer hands them to its writer
+const FLUSH_BYTES: usize = 64 * 1024;
+
+/// Output stage applying the document-level cleanup while streaming
+///
+/// Leading and trailing whitespace is dropped and runs of three or more
+/// newlines collapse to a blank line: the result of joining items and then
+/// running the `\n\n\n` replace loop and `trim` over the whole string.
+#[derive(Debug, Default)]
+struct MarkdownSink {
+    out: String,
+    /// Whitespace not yet known to be followed by more text
+    held: String,
+    started: bool,
+}
+
+impl MarkdownSink {
+    fn flush_held(&mut self) {
+        if self.started {
+            let mut newlines = 0;
+            for c in self.held.chars() {
+                if c == '\n' {
+                    newlines += 1;
+                    continue;
+                }
+                push_newlines(&mut self.out, newlines);
+                newlines = 0;
+                self.out.push(c);
+            }
+            push_newlines(&mut self.out, newlines);
+        }
+        self.held.clear();
+        self.started = true;
+    }
+}
+
+impl Write for MarkdownSink {
+    fn write_str(&mut self, mut s: &str) -> fmt::Result {
+        while !s.is_empty() {
+            let text_start = s.find(|c: char| !c.is_whitespace()).unwrap_or(s.len());
+            self.held.push_str(&s[..text_start]);
+            s = &s[text_start..];
+            if s.is_empty() {
+                break;
+            }
+
+            let text_end = s.find(char::is_whitespace).unwrap_or(s.len());
+            self.flush_held();
+            self.out.push_str(&s[..text_end]);
+            s = &s[text_end..];
+        }
+        Ok(())
+    }
+}
+
+/// Push a run of `count` newlines, at most a blank line's worth
+fn push_newlines(out: &mut String, count: usize) {
+    for _ in 0..count.min(2) {
+        out.push('\n');
+    }
+}
+
+/// Render into a fresh `String`
+fn render(write: impl FnOnce(&mut String) -> fmt::Result) -> String {
+    let mut out = String::new();
+    // Writing into a String cannot fail
+    let _ = write(&mut out);
+    out
+}
+
+/// Write `text` with newlines turned into spaces (table cells)
+fn write_single_line(out: &mut impl Write, text: &str) -> fmt::Result {
+    for (i, line) in text.split('\n').enumerate() {
+        if i > 0 {
+            out.write_char(' ')?;
+        }
+        out.write_str(line)?;
+    }
+    Ok(())
+}
+
+/// Write `text` with `*`, `[`, `]` (and `_` if `underscores`) backslash-escaped
+fn write_escaped_chars(out: &mut impl Write, text: &str, underscores: bool) -> fmt::Result {
+    let mut last = 0;
+    for (i, c) in
+        text.match_indices(|c: char| matches!(c, '*' | '[' | ']') || (underscores && c == '_'))
+    {
+        out.write_str(&text[last..i])?;
+        out.write_char('\\')?;
+        out.write_str(c)?;
+        last = i + c.len();
+    }
+    out.write_str(&text[last..])
+}
+
 #[cfg(test)]
 mod tests {
     use super::*;
@@ -337,4 +483,78 @@ mod tests {
             "*   *   **text****"
         );
     }
+
+    fn sample_document() -> DoclingDocument {
+        let cell = |text: &str| TableCell {
+            text: text.to_string(),
+            row_span: 1,
+            col_span: 1,
+        };
+
+        let mut doc = DoclingDocument::new("sample.pdf".to_string());
+        doc.add_item(DocItem::Paragraph(TextItem {
+            text: "\n  Intro_text *bold*  ".to_string(),
+            formatting: None,
+            label: DocItemLabel::Paragraph,
+        }));
+        doc.add_item(DocItem::Code(CodeItem {
+            text: "fn main() {}\n\n\n\n}".to_string(),
+            language: Some("rust".to_string()),
+        }));
+        doc.add_item(DocItem::ListItem(ListItemData {
+            text: "item".to_string(),
+            marker: "-".to_string(),
+            enumerated: false,
+            level: 1,
+        }));
+        doc.add_item(DocItem::Table(TableItem {
+            data: TableData {
+                num_rows: 2,
+                num_cols: 2,
+                grid: vec![vec![cell("A"), cell("B\nC")], vec![cell("1"), cell("2")]],
+            },
+            caption: None,
+        }));
+        doc.add_item(DocItem::Paragraph(TextItem {
+            text: "done".to_string(),
+            formatting: None,
+            label: DocItemLabel::CheckboxSelected,
+        }));
+        doc
+    }
+
+    #[test]
+    fn test_serialize_document() {
+        let markdown = MarkdownSerializer::new()
+            .serialize(&sample_document())
+            .unwrap();
+        assert_eq!(
+            markdown,
+            "Intro\\_text \\*bold\\*  \n\n```rust\nfn main() {}\n\n}\n```\n\n    - item\n\n\
+             | A | B C |\n| --- | --- |\n| 1 | 2 |\n\n- \\[x\\] done"
+        );
+    }
+
+    #[test]
+    fn test_serialize_to_writer_matches_serialize() {
+        let serializer = MarkdownSerializer::new();
+        let doc = sample_document();
+
+        let mut streamed = Vec::new();
+        serializer.serialize_to_writer(&doc, &mut streamed).unwrap();
+        assert_eq!(streamed, serializer.serialize(&doc).unwrap().into_bytes());
+    }
+
+    #[tokio::test]
+    async fn test_serialize_to_async_writer_matches_serialize() {
+        let serializer = MarkdownSerializer::new();
+        let doc = sample_document();
+
+        let mut streamed = Vec::new();
+        serializer
+            .serialize_to_async_writer(&doc, &mut streamed)
+            .await
+            .unwrap();
+        assert_eq!(streamed, serializer.serialize(&doc).unwrap().into_bytes());
+    }
 }
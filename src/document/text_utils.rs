@@ -4,17 +4,11 @@
 
 #![allow(missing_docs, clippy::unused_self)]
 
+use std::collections::HashMap;
+
 use once_cell::sync::Lazy;
 use regex::Regex;
-
-/// Hyphen patterns for joining across line breaks
-static HYPHEN_PATTERN: Lazy<Regex> = Lazy::new(|| Regex::new(r"(\w+)-\s*\n\s*(\w+)").unwrap());
-
-/// Multiple whitespace pattern
-static MULTI_SPACE_PATTERN: Lazy<Regex> = Lazy::new(|| Regex::new(r"\s{2,}").unwrap());
-
-/// Line break pattern for joining
-static LINE_BREAK_PATTERN: Lazy<Regex> = Lazy::new(|| Regex::new(r"([^\n])\n([^\n])").unwrap());
+use regex_syntax::is_word_character;
 
 /// Character normalization map (Unicode → ASCII/common forms)
 /// Reference: docling/models/page_assemble_model.py lines 34-65
@@ -195,6 +189,20 @@ const CHAR_NORMALIZATION_MAP: &[(&str, &str)] = &[
     ("€", "EUR"),
 ];
 
+/// `CHAR_NORMALIZATION_MAP` keyed by character. Every key is a single
+/// character and the first entry for a key wins, which is what applying the
+/// map as sequential `str::replace` calls did.
+static CHAR_NORMALIZATION: Lazy<HashMap<char, &'static str>> = Lazy::new(|| {
+    let mut map = HashMap::with_capacity(CHAR_NORMALIZATION_MAP.len());
+    for (from, to) in CHAR_NORMALIZATION_MAP {
+        let mut chars = from.chars();
+        if let (Some(c), None) = (chars.next(), chars.next()) {
+            map.entry(c).or_insert(*to);
+        }
+    }
+    map
+});
+
 /// Text sanitizer for document text
 #[derive(Debug)]
 pub struct TextSanitizer {
@@ -231,56 +239,228 @@ impl TextSanitizer {
     }
 
     /// Sanitize text with all configured options
+    ///
+    /// All transformations run in one forward scan: character normalization,
+    /// joining `word-\nword` across line breaks, joining single line breaks
+    /// with a space, collapsing whitespace runs and trimming. Runs of plain
+    /// ASCII (no whitespace runs, hyphens or line breaks) are copied in bulk;
+    /// only the bytes around them go through the per-character state machine.
     pub fn sanitize(&self, text: &str) -> String {
-        let mut result = text.to_string();
+        let mut scan = Scan::new(self, text.len());
+        let bytes = text.as_bytes();
+        let mut pos = 0;
+
+        while pos < bytes.len() {
+            if scan.is_idle() && bytes[pos] != b' ' {
+                let end = pos + plain_ascii_run(&bytes[pos..]);
+                if end > pos {
+                    scan.push_plain(&text[pos..end]);
+                    pos = end;
+                    continue;
+                }
+            }
+
+            let c = text[pos..].chars().next().unwrap_or_default();
+            pos += c.len_utf8();
+            match CHAR_NORMALIZATION.get(&c) {
+                Some(to) if self.normalize_chars => to.chars().for_each(|c| scan.hyphen(c)),
+                _ => scan.hyphen(c),
+            }
+        }
+
+        scan.finish()
+    }
+}
 
-        if self.normalize_chars {
-            result = self.normalize_characters(&result);
+/// Streaming state of [`TextSanitizer::sanitize`]
+///
+/// Each stage mirrors one of the original regex passes, with the same
+/// leftmost, non-overlapping match semantics:
+/// - hyphen: `(\w+)-\s*\n\s*(\w+)` → `$1$2`
+/// - line: `([^\n])\n([^\n])` → `$1 $2`
+/// - space: `\s{2,}` → `" "`, followed by `trim()`
+struct Scan<'a> {
+    options: &'a TextSanitizer,
+    out: String,
+    /// Previous character is a word character that can start a hyphen join
+    prev_word: bool,
+    /// Inside the word that completed a hyphen join; it cannot start another
+    joined: bool,
+    /// `-` plus the whitespace after it, waiting for the next character
+    held_hyphen: String,
+    held_newline: bool,
+    /// Previous character can be `$1` of a line join
+    prev_line: bool,
+    pending_newline: bool,
+    /// Whitespace run waiting for the next non-whitespace character
+    held_space: String,
+    started: bool,
+}
+
+impl<'a> Scan<'a> {
+    fn new(options: &'a TextSanitizer, capacity: usize) -> Self {
+        Self {
+            options,
+            out: String::with_capacity(capacity),
+            prev_word: false,
+            joined: false,
+            held_hyphen: String::new(),
+            held_newline: false,
+            prev_line: false,
+            pending_newline: false,
+            held_space: String::new(),
+            started: false,
         }
+    }
+
+    /// No stage is holding characters back
+    fn is_idle(&self) -> bool {
+        self.held_hyphen.is_empty() && !self.pending_newline && self.held_space.is_empty()
+    }
 
-        if self.join_hyphens {
-            result = self.join_hyphenated_words(&result);
+    /// Copy a run from [`plain_ascii_run`] straight to the output. Every stage
+    /// passes such a run through unchanged, so only their state is updated.
+    fn push_plain(&mut self, run: &str) {
+        let bytes = run.as_bytes();
+        let is_word = |b: u8| b.is_ascii_alphanumeric() || b == b'_';
+
+        self.joined = self.joined && bytes.iter().all(|&b| is_word(b));
+        self.prev_word = bytes.last().is_some_and(|&b| is_word(b)) && !self.joined;
+        self.prev_line = true;
+        self.started = true;
+        self.out.push_str(run);
+    }
+
+    fn hyphen(&mut self, c: char) {
+        if !self.options.join_hyphens {
+            return self.line(c);
         }
 
-        if self.join_lines {
-            result = self.join_lines_with_space(&result);
+        if !self.held_hyphen.is_empty() {
+            if c.is_whitespace() {
+                self.held_newline |= c == '\n';
+                self.held_hyphen.push(c);
+                return;
+            }
+
+            let join = self.held_newline && is_word_character(c);
+            self.held_newline = false;
+            if join {
+                self.held_hyphen.clear();
+                self.joined = true;
+                self.prev_word = false;
+                return self.line(c);
+            }
+            self.flush_hyphen();
         }
 
-        if self.normalize_whitespace {
-            result = self.normalize_whitespace_chars(&result);
+        if c == '-' && self.prev_word {
+            self.held_hyphen.push(c);
+            return;
         }
 
-        result.trim().to_string()
+        let word = is_word_character(c);
+        self.joined &= word;
+        self.prev_word = word && !self.joined;
+        self.line(c);
     }
 
-    /// Join hyphenated words across line breaks
-    /// "word-\nword" → "wordword"
-    fn join_hyphenated_words(&self, text: &str) -> String {
-        HYPHEN_PATTERN.replace_all(text, "$1$2").to_string()
+    fn flush_hyphen(&mut self) {
+        // `-` and whitespace are not word characters
+        self.prev_word = false;
+        self.joined = false;
+        for c in std::mem::take(&mut self.held_hyphen).chars() {
+            self.line(c);
+        }
     }
 
-    /// Join lines with spaces (but preserve paragraph breaks)
-    /// "line1\nline2" → "line1 line2"
-    /// But "line1\n\nline2" stays as is
-    fn join_lines_with_space(&self, text: &str) -> String {
-        LINE_BREAK_PATTERN.replace_all(text, "$1 $2").to_string()
+    fn line(&mut self, c: char) {
+        if !self.options.join_lines {
+            return self.space(c);
+        }
+
+        if self.pending_newline {
+            self.pending_newline = false;
+            if c != '\n' {
+                self.space(' ');
+                self.space(c);
+                self.prev_line = false;
+                return;
+            }
+            self.space('\n');
+            self.prev_line = false;
+        }
+
+        if c == '\n' && self.prev_line {
+            self.pending_newline = true;
+            return;
+        }
+        self.prev_line = c != '\n';
+        self.space(c);
     }
 
-    /// Normalize special characters to common forms
-    fn normalize_characters(&self, text: &str) -> String {
-        let mut result = text.to_string();
+    fn space(&mut self, c: char) {
+        if c.is_whitespace() {
+            self.held_space.push(c);
+            return;
+        }
 
-        for (from, to) in CHAR_NORMALIZATION_MAP {
-            result = result.replace(from, to);
+        if !self.held_space.is_empty() {
+            if self.started {
+                let single = self.held_space.chars().nth(1).is_none();
+                if single || !self.options.normalize_whitespace {
+                    self.out.push_str(&self.held_space);
+                } else {
+                    self.out.push(' ');
+                }
+            }
+            self.held_space.clear();
         }
+        self.started = true;
+        self.out.push(c);
+    }
 
-        result
+    /// Flush held characters; trailing whitespace is dropped by the trim
+    fn finish(mut self) -> String {
+        if !self.held_hyphen.is_empty() {
+            self.flush_hyphen();
+        }
+        if self.pending_newline {
+            self.space('\n');
+        }
+        self.out
     }
+}
 
-    /// Normalize multiple whitespace to single space
-    fn normalize_whitespace_chars(&self, text: &str) -> String {
-        MULTI_SPACE_PATTERN.replace_all(text, " ").to_string()
+/// Length of the leading run of `bytes` that no sanitizer stage changes:
+/// printable ASCII other than `-`, with single spaces between them.
+///
+/// Whole 16-byte blocks are checked with branch-free compares so the loop
+/// vectorizes; the remainder is scanned byte by byte.
+fn plain_ascii_run(bytes: &[u8]) -> usize {
+    const BLOCK: usize = 16;
+    let plain = |b: u8| (b > b' ' && b < 0x7F && b != b'-') || b == b' ';
+
+    let mut end = 0;
+    while let Some(block) = bytes.get(end..end + BLOCK + 1) {
+        let all_plain = block.iter().fold(true, |ok, &b| ok & plain(b));
+        let double_space = block
+            .windows(2)
+            .fold(false, |d, w| d | (w[0] == b' ' && w[1] == b' '));
+        if !all_plain || double_space {
+            break;
+        }
+        end += BLOCK;
     }
+
+    while let Some(&b) = bytes.get(end) {
+        let next_plain = bytes.get(end + 1).is_some_and(|&n| n != b' ' && plain(n));
+        if !plain(b) || (b == b' ' && !next_plain) {
+            break;
+        }
+        end += 1;
+    }
+    end
 }
 
 impl Default for TextSanitizer {
@@ -472,4 +652,37 @@ mod tests {
         let result = sanitizer.sanitize(text);
         assert_eq!(result, "file with ligatures: ff, fi, fl");
     }
+
+    #[test]
+    fn test_sanitize_match_semantics() {
+        let sanitizer = TextSanitizer::new();
+        // Matches do not overlap: the word or line that completed a join
+        // cannot start the next one
+        assert_eq!(sanitizer.sanitize("a-\nb-\nc"), "ab- c");
+        assert_eq!(sanitizer.sanitize("a\nb\nc"), "a b\nc");
+        assert_eq!(sanitizer.sanitize("para\n\n\nnext"), "para next");
+        // Normalized characters take part in the later stages
+        assert_eq!(
+            sanitizer.sanitize("co\u{2013}\n  op 90°"),
+            "coop 90 degrees"
+        );
+        assert_eq!(sanitizer.sanitize("\t kept\ttab  "), "kept\ttab");
+
+        let raw = TextSanitizer::with_options(false, false, false, false);
+        assert_eq!(raw.sanitize("  a-\n b  —\n"), "a-\n b  —");
+    }
+
+    #[test]
+    fn test_plain_ascii_run() {
+        assert_eq!(plain_ascii_run(b"abc def"), 7);
+        assert_eq!(plain_ascii_run(b"abc  def"), 3);
+        assert_eq!(plain_ascii_run(b"abc \ndef"), 3);
+        assert_eq!(plain_ascii_run(b"well-known"), 4);
+        assert_eq!(plain_ascii_run("caf\u{e9}".as_bytes()), 3);
+
+        let long = "lorem ipsum dolor sit amet ".repeat(8);
+        assert_eq!(plain_ascii_run(long.as_bytes()), long.len() - 1);
+        let long = format!("{}\n", "x".repeat(40));
+        assert_eq!(plain_ascii_run(long.as_bytes()), 40);
+    }
 }
@@ -4,6 +4,7 @@ use std::collections::HashMap;
 use serde_json::Value;
 
 use crate::error::Result;
+use crate::utils::whitespace;
 
 /// Parse docling-parse JSON and convert to Markdown
 pub fn parse_docling_json_to_markdown(json_str: &str) -> Result<String> {
@@ -80,11 +81,10 @@ pub fn parse_docling_json_to_markdown(json_str: &str) -> Result<String> {
     }
 
     // Clean up extra newlines
-    while markdown.contains("\n\n\n") {
-        markdown = markdown.replace("\n\n\n", "\n\n");
-    }
+    whitespace::collapse_blank_lines(&mut markdown);
+    whitespace::trim_in_place(&mut markdown);
 
-    Ok(markdown.trim().to_string())
+    Ok(markdown)
 }
 
 /// Extract table of contents
@@ -0,0 +1,291 @@
+//! Shared geometry kernels for detected regions
+//!
+//! Boxes are `(l, t, r, b)` tuples, the same layout returned by
+//! `BoundingBox::as_tuple`. Provides:
+//! - scalar IoU / intersection-over-self
+//! - `BoxArray`: structure-of-arrays boxes with batched IoU (auto-vectorized)
+//! - `BoxIndex`: R-tree overlap queries
+//! - `non_max_suppression`: greedy NMS that only visits overlapping candidates
+
+#![allow(missing_docs)]
+
+use rstar::{AABB, RTree, RTreeObject};
+
+/// Axis-aligned box as `(l, t, r, b)`
+pub type Rect = (f64, f64, f64, f64);
+
+/// Below this many boxes a vectorized linear scan beats building an R-tree
+const LINEAR_SCAN_LIMIT: usize = 64;
+
+fn rect_area(rect: &Rect) -> f64 {
+    (rect.2 - rect.0).abs() * (rect.3 - rect.1).abs()
+}
+
+fn intersection_area(a: &Rect, b: &Rect) -> f64 {
+    let w = a.2.min(b.2) - a.0.max(b.0);
+    let h = a.3.min(b.3) - a.1.max(b.1);
+    if w <= 0.0 || h <= 0.0 { 0.0 } else { w * h }
+}
+
+/// Intersection over union of two boxes
+pub fn iou(a: &Rect, b: &Rect) -> f64 {
+    let inter = intersection_area(a, b);
+    if inter == 0.0 {
+        return 0.0;
+    }
+    let union = rect_area(a) + rect_area(b) - inter;
+    if union > 0.0 { inter / union } else { 0.0 }
+}
+
+/// Fraction of `a` covered by `b`
+pub fn intersection_over_self(a: &Rect, b: &Rect) -> f64 {
+    let inter = intersection_area(a, b);
+    let area = rect_area(a);
+    if inter > 0.0 && area > 0.0 {
+        inter / area
+    } else {
+        0.0
+    }
+}
+
+/// Boxes stored as structure-of-arrays for batched kernels
+#[derive(Debug, Clone, Default)]
+pub struct BoxArray {
+    l: Vec<f64>,
+    t: Vec<f64>,
+    r: Vec<f64>,
+    b: Vec<f64>,
+    area: Vec<f64>,
+}
+
+impl BoxArray {
+    pub fn from_rects<I: IntoIterator<Item = Rect>>(rects: I) -> Self {
+        let mut boxes = Self::default();
+        for rect in rects {
+            boxes.l.push(rect.0);
+            boxes.t.push(rect.1);
+            boxes.r.push(rect.2);
+            boxes.b.push(rect.3);
+            boxes.area.push(rect_area(&rect));
+        }
+        boxes
+    }
+
+    pub fn len(&self) -> usize {
+        self.l.len()
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.l.is_empty()
+    }
+
+    pub fn rect(&self, i: usize) -> Rect {
+        (self.l[i], self.t[i], self.r[i], self.b[i])
+    }
+
+    /// IoU of `query` against every box, written to `out`
+    ///
+    /// The loop body is branch-free over plain slices so LLVM vectorizes it.
+    pub fn iou_into(&self, query: &Rect, out: &mut Vec<f64>) {
+        let (ql, qt, qr, qb) = *query;
+        let q_area = rect_area(query);
+
+        out.clear();
+        out.extend(
+            self.l
+                .iter()
+                .zip(&self.t)
+                .zip(&self.r)
+                .zip(&self.b)
+                .zip(&self.area)
+                .map(|((((&l, &t), &r), &b), &area)| {
+                    let w = (r.min(qr) - l.max(ql)).max(0.0);
+                    let h = (b.min(qb) - t.max(qt)).max(0.0);
+                    let inter = w * h;
+                    let union = area + q_area - inter;
+                    if union > 0.0 { inter / union } else { 0.0 }
+                }),
+        );
+    }
+}
+
+#[derive(Debug, Clone)]
+struct IndexedRect {
+    index: usize,
+    envelope: AABB<[f64; 2]>,
+}
+
+impl RTreeObject for IndexedRect {
+    type Envelope = AABB<[f64; 2]>;
+
+    fn envelope(&self) -> Self::Envelope {
+        self.envelope
+    }
+}
+
+/// R-tree over a set of boxes, answering overlap queries by index
+#[derive(Debug)]
+pub struct BoxIndex {
+    rtree: RTree<IndexedRect>,
+}
+
+impl BoxIndex {
+    pub fn new<I: IntoIterator<Item = Rect>>(rects: I) -> Self {
+        let items = rects
+            .into_iter()
+            .enumerate()
+            .map(|(index, rect)| IndexedRect {
+                index,
+                envelope: Self::envelope_of(&rect),
+            })
+            .collect();
+
+        Self {
+            rtree: RTree::bulk_load(items),
+        }
+    }
+
+    fn envelope_of(rect: &Rect) -> AABB<[f64; 2]> {
+        AABB::from_corners([rect.0, rect.1], [rect.2, rect.3])
+    }
+
+    /// Indices of all boxes whose envelope intersects (or touches) `rect`
+    pub fn intersecting(&self, rect: &Rect) -> impl Iterator<Item = usize> + '_ {
+        self.rtree
+            .locate_in_envelope_intersecting(&Self::envelope_of(rect))
+            .map(|item| item.index)
+    }
+}
+
+/// Greedy non-maximum suppression
+///
+/// Returns the indices of the kept boxes in descending score order. A box is
+/// suppressed when its IoU with an already kept, higher-scored box exceeds
+/// `iou_threshold` — the same result as the all-pairs scan, but each kept box
+/// is only compared with boxes it actually overlaps.
+pub fn non_max_suppression(rects: &[Rect], scores: &[f32], iou_threshold: f64) -> Vec<usize> {
+    let n = rects.len().min(scores.len());
+
+    // Stable sort keeps ties in input order
+    let mut order: Vec<usize> = (0..n).collect();
+    order.sort_by(|&a, &b| scores[b].total_cmp(&scores[a]));
+
+    let mut suppressed = vec![false; n]; // indexed by rank
+    let mut keep = Vec::new();
+
+    if n <= LINEAR_SCAN_LIMIT {
+        let boxes = BoxArray::from_rects(order.iter().map(|&i| rects[i]));
+        let mut ious = Vec::with_capacity(n);
+
+        for rank in 0..n {
+            if suppressed[rank] {
+                continue;
+            }
+            keep.push(order[rank]);
+
+            boxes.iou_into(&boxes.rect(rank), &mut ious);
+            for (later, &overlap) in ious.iter().enumerate().skip(rank + 1) {
+                if overlap > iou_threshold {
+                    suppressed[later] = true;
+                }
+            }
+        }
+    } else {
+        let mut rank_of = vec![0; n];
+        for (rank, &i) in order.iter().enumerate() {
+            rank_of[i] = rank;
+        }
+
+        let index = BoxIndex::new(rects[..n].iter().copied());
+
+        for rank in 0..n {
+            if suppressed[rank] {
+                continue;
+            }
+            let i = order[rank];
+            keep.push(i);
+
+            for j in index.intersecting(&rects[i]) {
+                let other = rank_of[j];
+                if other > rank && !suppressed[other] && iou(&rects[i], &rects[j]) > iou_threshold {
+                    suppressed[other] = true;
+                }
+            }
+        }
+    }
+
+    keep
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    /// Deterministic pseudo-random boxes (xorshift)
+    fn random_rects(count: usize, seed: u64) -> Vec<Rect> {
+        let mut state = seed;
+        let mut next = move || {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            (state % 1000) as f64
+        };
+        (0..count)
+            .map(|_| {
+                let (l, t) = (next(), next());
+                (l, t, l + next() / 10.0 + 1.0, t + next() / 10.0 + 1.0)
+            })
+            .collect()
+    }
+
+    fn brute_force_nms(rects: &[Rect], scores: &[f32], threshold: f64) -> Vec<usize> {
+        let mut order: Vec<usize> = (0..rects.len()).collect();
+        order.sort_by(|&a, &b| scores[b].total_cmp(&scores[a]));
+        let mut suppressed = vec![false; rects.len()];
+        let mut keep = Vec::new();
+        for (pos, &i) in order.iter().enumerate() {
+            if suppressed[pos] {
+                continue;
+            }
+            keep.push(i);
+            for (later, &j) in order.iter().enumerate().skip(pos + 1) {
+                if iou(&rects[i], &rects[j]) > threshold {
+                    suppressed[later] = true;
+                }
+            }
+        }
+        keep
+    }
+
+    #[test]
+    fn test_batched_iou_matches_scalar() {
+        let rects = random_rects(100, 7);
+        let boxes = BoxArray::from_rects(rects.iter().copied());
+        let mut out = Vec::new();
+        boxes.iou_into(&rects[3], &mut out);
+
+        for (rect, batched) in rects.iter().zip(&out) {
+            assert!((iou(&rects[3], rect) - batched).abs() < 1e-12);
+        }
+    }
+
+    #[test]
+    fn test_nms_matches_all_pairs_scan() {
+        for (count, seed) in [(10, 1), (64, 2), (500, 3)] {
+            let rects = random_rects(count, seed);
+            let scores: Vec<f32> = (0..count).map(|i| ((i * 37) % 101) as f32).collect();
+
+            assert_eq!(
+                non_max_suppression(&rects, &scores, 0.3),
+                brute_force_nms(&rects, &scores, 0.3)
+            );
+        }
+    }
+
+    #[test]
+    fn test_index_overlap_query() {
+        let index = BoxIndex::new([(0.0, 0.0, 10.0, 10.0), (20.0, 20.0, 30.0, 30.0)]);
+        let hits: Vec<usize> = index.intersecting(&(5.0, 5.0, 8.0, 8.0)).collect();
+        assert_eq!(hits, vec![0]);
+    }
+}
@@ -11,10 +11,9 @@
 
 use std::collections::{HashMap, HashSet};
 
-use rstar::{AABB, RTree};
-
 use crate::document::types::DocItemLabel;
-use crate::document::types_extended::{BoundingBox, Cluster};
+use crate::document::types_extended::{BoundingBox, Cluster, CoordOrigin};
+use crate::engines::geometry::{self, BoxIndex, Rect};
 use crate::error::{Result, TransmutationError};
 
 /// Union-Find data structure for grouping overlapping clusters
@@ -80,54 +79,6 @@ impl UnionFind {
     }
 }
 
-/// Spatial indexing for efficient overlap detection
-struct SpatialIndex {
-    rtree: RTree<ClusterRect>,
-}
-
-#[derive(Debug, Clone)]
-struct ClusterRect {
-    id: usize,
-    bbox: BoundingBox,
-}
-
-impl rstar::RTreeObject for ClusterRect {
-    type Envelope = AABB<[f64; 2]>;
-
-    fn envelope(&self) -> Self::Envelope {
-        AABB::from_corners([self.bbox.l, self.bbox.t], [self.bbox.r, self.bbox.b])
-    }
-}
-
-impl SpatialIndex {
-    fn new(clusters: &[Cluster]) -> Self {
-        let rects: Vec<ClusterRect> = clusters
-            .iter()
-            .map(|c| ClusterRect {
-                id: c.id,
-                bbox: c.bbox,
-            })
-            .collect();
-
-        let rtree = RTree::bulk_load(rects);
-
-        Self { rtree }
-    }
-
-    fn find_overlapping(&self, bbox: &BoundingBox, threshold: f64) -> Vec<usize> {
-        let envelope = AABB::from_corners([bbox.l, bbox.t], [bbox.r, bbox.b]);
-
-        self.rtree
-            .locate_in_envelope_intersecting(&envelope)
-            .filter(|rect| {
-                let iou = rect.bbox.intersection_over_union(bbox);
-                iou >= threshold
-            })
-            .map(|rect| rect.id)
-            .collect()
-    }
-}
-
 /// Options for layout postprocessing
 #[derive(Debug, Clone)]
 pub struct LayoutPostprocessorOptions {
@@ -135,6 +86,9 @@ pub struct LayoutPostprocessorOptions {
     pub merge_containment_threshold: f64,
     pub deduplicate_threshold: f64,
     pub enable_reading_order: bool,
+    /// Narrowest vertical whitespace strip (page units) taken as a column
+    /// gutter when ordering
+    pub column_gutter_threshold: f64,
 }
 
 impl Default for LayoutPostprocessorOptions {
@@ -144,6 +98,7 @@ impl Default for LayoutPostprocessorOptions {
             merge_containment_threshold: 0.8,
             deduplicate_threshold: 0.9,
             enable_reading_order: true,
+            column_gutter_threshold: 10.0,
         }
     }
 }
@@ -189,28 +144,31 @@ impl LayoutPostprocessor {
         let mut uf = UnionFind::new(&ids);
 
         // Find overlapping pairs
-        let spatial_index = SpatialIndex::new(&clusters);
+        let spatial_index = BoxIndex::new(clusters.iter().map(|c| c.bbox.as_tuple()));
 
         for cluster in &clusters {
-            let overlapping =
-                spatial_index.find_overlapping(&cluster.bbox, self.options.merge_overlap_threshold);
-
-            for &other_id in &overlapping {
-                if other_id != cluster.id {
-                    uf.union(cluster.id, other_id);
+            let rect = cluster.bbox.as_tuple();
+            for other in spatial_index.intersecting(&rect) {
+                let other = &clusters[other];
+                if other.id != cluster.id
+                    && geometry::iou(&other.bbox.as_tuple(), &rect)
+                        >= self.options.merge_overlap_threshold
+                {
+                    uf.union(cluster.id, other.id);
                 }
             }
         }
 
         // Group clusters by root
         let groups = uf.get_groups();
+        let by_id: HashMap<usize, &Cluster> = clusters.iter().map(|c| (c.id, c)).collect();
 
         // Merge each group
         let mut merged_clusters = Vec::new();
         for (_root_id, group_ids) in groups {
             let group_clusters: Vec<&Cluster> = group_ids
                 .iter()
-                .filter_map(|&id| clusters.iter().find(|c| c.id == id))
+                .filter_map(|id| by_id.get(id).copied())
                 .collect();
 
             let merged = self.merge_cluster_group(&group_clusters)?;
@@ -300,106 +258,210 @@ impl LayoutPostprocessor {
     }
 
     /// Remove duplicate clusters (one completely contained in another)
-    fn remove_duplicate_clusters(&self, mut clusters: Vec<Cluster>) -> Result<Vec<Cluster>> {
-        let mut to_remove = HashSet::new();
+    ///
+    /// Only clusters whose envelopes intersect can contain each other, so
+    /// candidates come from an R-tree query instead of an all-pairs scan.
+    fn remove_duplicate_clusters(&self, clusters: Vec<Cluster>) -> Result<Vec<Cluster>> {
+        let rects: Vec<_> = clusters.iter().map(|c| c.bbox.as_tuple()).collect();
+        let spatial_index = BoxIndex::new(rects.iter().copied());
+
+        let to_remove: Vec<bool> = rects
+            .iter()
+            .enumerate()
+            .map(|(i, rect)| {
+                spatial_index.intersecting(rect).any(|j| {
+                    // Cluster i is contained in j, remove i
+                    j != i
+                        && geometry::intersection_over_self(rect, &rects[j])
+                            >= self.options.deduplicate_threshold
+                })
+            })
+            .collect();
 
-        for i in 0..clusters.len() {
-            for j in 0..clusters.len() {
-                if i == j || to_remove.contains(&i) {
-                    continue;
-                }
+        Ok(clusters
+            .into_iter()
+            .zip(to_remove)
+            .filter(|(_, remove)| !remove)
+            .map(|(c, _)| c)
+            .collect())
+    }
+
+    /// Sort clusters in reading order using recursive XY-cut
+    ///
+    /// Each region is split at every whitespace gap of one projection
+    /// profile of the cluster boxes at once. Column gutters (x gaps of at
+    /// least `column_gutter_threshold`) take precedence over y gaps, since
+    /// paragraph spacing inside columns can be wider than the gutter.
+    /// Full-width headers and figures block the gutter in the x-projection,
+    /// so they are cut off first along y; the columns between them are then
+    /// separated along x and read one after another. Regions that cannot be
+    /// cut further are read top-to-bottom, left-to-right.
+    fn sort_reading_order(&self, clusters: Vec<Cluster>) -> Result<Vec<Cluster>> {
+        if clusters.len() < 2 {
+            return Ok(clusters);
+        }
 
-                let containment = clusters[i].bbox.intersection_over_self(&clusters[j].bbox);
+        let rects: Vec<Rect> = clusters.iter().map(|c| reading_rect(&c.bbox)).collect();
+        let order = xy_cut_order(&rects, self.options.column_gutter_threshold);
 
-                if containment >= self.options.deduplicate_threshold {
-                    // Cluster i is contained in j, remove i
-                    to_remove.insert(i);
-                }
-            }
+        let mut slots: Vec<Option<Cluster>> = clusters.into_iter().map(Some).collect();
+        Ok(order.into_iter().filter_map(|i| slots[i].take()).collect())
+    }
+}
+
+/// Box in top-down page coordinates `(x0, y0, x1, y1)` for reading order
+fn reading_rect(bbox: &BoundingBox) -> Rect {
+    let (x0, x1) = (bbox.l.min(bbox.r), bbox.l.max(bbox.r));
+    match bbox.origin {
+        CoordOrigin::TopLeft => (x0, bbox.t.min(bbox.b), x1, bbox.t.max(bbox.b)),
+        // Flip so that y grows downwards like in TopLeft coordinates
+        CoordOrigin::BottomLeft => (x0, -bbox.t.max(bbox.b), x1, -bbox.t.min(bbox.b)),
+    }
+}
+
+/// Gaps in the projection profile of `items` onto one axis
+///
+/// `span` maps an item to its `[start, end]` interval on the axis. Sorts
+/// `items` by start and returns `(from, to, index)` for every empty run
+/// `[from, to]` between items, where every item before `items[index]` ends
+/// before the gap. Sweeping the running end is equivalent to scanning the
+/// projection histogram for empty runs.
+fn projection_gaps(
+    items: &mut [usize],
+    span: impl Fn(usize) -> (f64, f64),
+) -> Vec<(f64, f64, usize)> {
+    items.sort_by(|&a, &b| span(a).0.total_cmp(&span(b).0));
+
+    let mut gaps = Vec::new();
+    let Some(&first) = items.first() else {
+        return gaps;
+    };
+    let mut covered_to = span(first).1;
+
+    for (index, &item) in items.iter().enumerate().skip(1) {
+        let (start, end) = span(item);
+        if start > covered_to {
+            gaps.push((covered_to, start, index));
         }
+        covered_to = covered_to.max(end);
+    }
 
-        clusters = clusters
-            .into_iter()
-            .enumerate()
-            .filter(|(i, _)| !to_remove.contains(i))
-            .map(|(_, c)| c)
-            .collect();
+    gaps
+}
 
-        Ok(clusters)
+/// Split `items`, sorted along the axis `gaps` were found on, at all gaps
+fn split_at_gaps(mut items: Vec<usize>, gaps: &[(f64, f64, usize)]) -> Vec<Vec<usize>> {
+    let mut parts = Vec::with_capacity(gaps.len() + 1);
+    for &(_, _, index) in gaps.iter().rev() {
+        parts.push(items.split_off(index));
     }
+    parts.push(items);
+    parts.reverse();
+    parts
+}
 
-    /// Sort clusters in reading order (top-to-bottom, left-to-right)
-    fn sort_reading_order(&self, mut clusters: Vec<Cluster>) -> Result<Vec<Cluster>> {
-        // Detect columns (groups with similar X range)
-        let columns = self.detect_columns(&clusters);
-
-        if columns.len() <= 1 {
-            // Single column - simple sort
-            clusters.sort_by(|a, b| {
-                let y_cmp = a.bbox.t.partial_cmp(&b.bbox.t).unwrap();
-                if y_cmp == std::cmp::Ordering::Equal {
-                    a.bbox.l.partial_cmp(&b.bbox.l).unwrap()
-                } else {
-                    y_cmp
-                }
-            });
+/// Column gutters `(from, to)` of a region, in ascending x
+type Gutters = Vec<(f64, f64)>;
+
+/// Overlaps of two ascending lists of gutters that are still `min_width`
+/// wide
+fn shared_gutters(a: &[(f64, f64)], b: &[(f64, f64)], min_width: f64) -> Gutters {
+    let (mut i, mut j) = (0, 0);
+    let mut shared = Vec::new();
+    while i < a.len() && j < b.len() {
+        let (from, to) = (a[i].0.max(b[j].0), a[i].1.min(b[j].1));
+        if to - from >= min_width {
+            shared.push((from, to));
+        }
+        if a[i].1 < b[j].1 {
+            i += 1;
         } else {
-            // Multi-column - sort within each column, then by column order
-            clusters.sort_by(|a, b| {
-                let col_a = self.get_column_index(&columns, &a.bbox);
-                let col_b = self.get_column_index(&columns, &b.bbox);
-
-                if col_a != col_b {
-                    col_a.cmp(&col_b)
-                } else {
-                    // Same column - sort by Y then X
-                    let y_cmp = a.bbox.t.partial_cmp(&b.bbox.t).unwrap();
-                    if y_cmp == std::cmp::Ordering::Equal {
-                        a.bbox.l.partial_cmp(&b.bbox.l).unwrap()
-                    } else {
-                        y_cmp
-                    }
-                }
-            });
+            j += 1;
         }
-
-        Ok(clusters)
     }
+    shared
+}
 
-    /// Detect columns based on X-coordinate clustering
-    fn detect_columns(&self, clusters: &[Cluster]) -> Vec<(f64, f64)> {
-        // Simplified column detection - group by X ranges
-        // TODO: Implement more sophisticated algorithm
+/// Reading order of `rects` (indices) by recursive XY-cut
+///
+/// A region is cut at all of its column gutters (x gaps of at least
+/// `min_gutter`) at once. Without one it is cut into horizontal bands at
+/// all y gaps, and consecutive bands sharing a gutter are regrouped: they
+/// are one stretch of columns whose paragraph spacing happens to line up,
+/// while a spanning header or figure has no gutter and stands alone.
+/// Narrower x gaps are only cut when nothing else is left.
+fn xy_cut_order(rects: &[Rect], min_gutter: f64) -> Vec<usize> {
+    let x_span = |i: usize| (rects[i].0, rects[i].2);
+    let y_span = |i: usize| (rects[i].1, rects[i].3);
+    let gutters = |items: &mut [usize]| -> Gutters {
+        projection_gaps(items, x_span)
+            .into_iter()
+            .filter(|&(from, to, _)| to - from >= min_gutter)
+            .map(|(from, to, _)| (from, to))
+            .collect()
+    };
+    let mut order = Vec::with_capacity(rects.len());
 
-        if clusters.is_empty() {
-            return Vec::new();
+    // Explicit stack (last = next region to read) to avoid deep recursion;
+    // regions are pushed in reverse so the top/left one is read first
+    let mut stack: Vec<Vec<usize>> = vec![(0..rects.len()).collect()];
+
+    while let Some(mut items) = stack.pop() {
+        if items.len() < 2 {
+            order.extend(items);
+            continue;
         }
 
-        // For now, assume single column
-        let min_x = clusters.iter().map(|c| c.bbox.l).fold(f64::MAX, f64::min);
-        let max_x = clusters.iter().map(|c| c.bbox.r).fold(f64::MIN, f64::max);
+        let mut columns = projection_gaps(&mut items, x_span);
+        columns.retain(|&(from, to, _)| to - from >= min_gutter);
+        if !columns.is_empty() {
+            stack.extend(split_at_gaps(items, &columns).into_iter().rev());
+            continue;
+        }
 
-        vec![(min_x, max_x)]
-    }
+        let bands = projection_gaps(&mut items, y_span);
+        if bands.is_empty() {
+            let narrow = projection_gaps(&mut items, x_span);
+            if !narrow.is_empty() {
+                stack.extend(split_at_gaps(items, &narrow).into_iter().rev());
+                continue;
+            }
 
-    /// Get column index for a bounding box
-    fn get_column_index(&self, columns: &[(f64, f64)], bbox: &BoundingBox) -> usize {
-        let center_x = (bbox.l + bbox.r) / 2.0;
+            // Uncuttable block: top-to-bottom, then left-to-right
+            items.sort_by(|&a, &b| {
+                rects[a]
+                    .1
+                    .total_cmp(&rects[b].1)
+                    .then(rects[a].0.total_cmp(&rects[b].0))
+            });
+            order.extend(items);
+            continue;
+        }
 
-        for (i, (col_l, col_r)) in columns.iter().enumerate() {
-            if center_x >= *col_l && center_x <= *col_r {
-                return i;
+        // The whole region has no gutter, so a merged group never covers
+        // all bands and every pass makes progress
+        let mut groups: Vec<(Vec<usize>, Gutters)> = Vec::new();
+        for mut band in split_at_gaps(items, &bands) {
+            let band_gutters = gutters(&mut band);
+            if let Some((group, shared)) = groups.last_mut() {
+                let common = shared_gutters(shared, &band_gutters, min_gutter);
+                if !common.is_empty() {
+                    group.extend(band);
+                    *shared = common;
+                    continue;
+                }
             }
+            groups.push((band, band_gutters));
         }
-
-        0 // Default to first column
+        stack.extend(groups.into_iter().rev().map(|(group, _)| group));
     }
+
+    order
 }
 
 #[cfg(test)]
 mod tests {
     use super::*;
-    use crate::document::types_extended::CoordOrigin;
 
     #[test]
     fn test_union_find() {
@@ -441,4 +503,80 @@ mod tests {
         // Should be merged into one cluster
         assert_eq!(result.len(), 1);
     }
+
+    fn text_cluster(id: usize, l: f64, t: f64, r: f64, b: f64) -> Cluster {
+        Cluster {
+            id,
+            label: DocItemLabel::Text,
+            bbox: BoundingBox::new(l, t, r, b, CoordOrigin::TopLeft),
+            cells: Vec::new(),
+            confidence: 0.9,
+        }
+    }
+
+    #[test]
+    fn test_reading_order_two_columns_with_header() {
+        let postprocessor = LayoutPostprocessor::new(LayoutPostprocessorOptions::default());
+
+        // Full-width title, two columns whose paragraphs interleave in y,
+        // then a full-width figure and one more paragraph per column
+        let clusters = vec![
+            text_cluster(0, 300.0, 100.0, 500.0, 200.0), // right col, p1
+            text_cluster(1, 50.0, 110.0, 250.0, 190.0),  // left col, p1
+            text_cluster(2, 50.0, 20.0, 500.0, 60.0),    // title
+            text_cluster(3, 300.0, 210.0, 500.0, 300.0), // right col, p2
+            text_cluster(4, 50.0, 200.0, 250.0, 320.0),  // left col, p2
+            text_cluster(5, 50.0, 350.0, 500.0, 450.0),  // spanning figure
+            text_cluster(6, 300.0, 470.0, 500.0, 600.0), // right col, p3
+            text_cluster(7, 50.0, 480.0, 250.0, 590.0),  // left col, p3
+        ];
+
+        let ordered = postprocessor.sort_reading_order(clusters).unwrap();
+        let ids: Vec<usize> = ordered.iter().map(|c| c.id).collect();
+
+        assert_eq!(ids, vec![2, 1, 4, 0, 3, 5, 7, 6]);
+    }
+
+    #[test]
+    fn test_reading_order_columns_with_wide_paragraph_spacing() {
+        let postprocessor = LayoutPostprocessor::new(LayoutPostprocessorOptions::default());
+
+        // Paragraphs sit at the same heights in both columns and are
+        // further apart (80) than the gutter is wide (30)
+        let clusters = vec![
+            text_cluster(0, 50.0, 20.0, 530.0, 60.0), // title
+            text_cluster(1, 300.0, 100.0, 530.0, 200.0),
+            text_cluster(2, 50.0, 100.0, 270.0, 200.0),
+            text_cluster(3, 300.0, 280.0, 530.0, 380.0),
+            text_cluster(4, 50.0, 280.0, 270.0, 380.0),
+            text_cluster(5, 50.0, 460.0, 270.0, 560.0),
+            text_cluster(6, 300.0, 460.0, 530.0, 560.0),
+        ];
+
+        let ordered = postprocessor.sort_reading_order(clusters).unwrap();
+        let ids: Vec<usize> = ordered.iter().map(|c| c.id).collect();
+
+        assert_eq!(ids, vec![0, 2, 4, 5, 1, 3, 6]);
+    }
+
+    #[test]
+    fn test_reading_order_bottom_left_origin() {
+        let postprocessor = LayoutPostprocessor::new(LayoutPostprocessorOptions::default());
+
+        // In PDF coordinates the first line has the larger y
+        let clusters = vec![
+            Cluster {
+                bbox: BoundingBox::new(50.0, 100.0, 500.0, 80.0, CoordOrigin::BottomLeft),
+                ..text_cluster(0, 0.0, 0.0, 0.0, 0.0)
+            },
+            Cluster {
+                bbox: BoundingBox::new(50.0, 700.0, 500.0, 680.0, CoordOrigin::BottomLeft),
+                ..text_cluster(1, 0.0, 0.0, 0.0, 0.0)
+            },
+        ];
+
+        let ordered = postprocessor.sort_reading_order(clusters).unwrap();
+        assert_eq!(ordered[0].id, 1);
+        assert_eq!(ordered[1].id, 0);
+    }
 }
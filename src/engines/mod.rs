@@ -14,6 +14,9 @@ pub mod docling_parse_ffi;
 #[cfg(feature = "docling-ffi")]
 pub mod docling_json_parser;
 
+#[cfg(feature = "docling-ffi")]
+pub mod geometry;
+
 #[cfg(feature = "docling-ffi")]
 pub mod rule_based_layout;
 
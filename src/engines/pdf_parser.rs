@@ -13,17 +13,22 @@
     clippy::uninlined_format_args
 )]
 
+use std::collections::HashMap;
 use std::path::Path;
 
-use lopdf::Document;
+use lopdf::{Document, ObjectId};
+use rayon::prelude::*;
 
 use crate::engines::table_detector::{DetectedTable, TableDetector};
+use crate::utils::whitespace;
 use crate::{Result, TransmutationError};
 
 /// PDF parser for text extraction
 #[derive(Debug)]
 pub struct PdfParser {
     document: Document,
+    /// Page table resolved once at load: (page number, page object id) in page order
+    pages: Vec<(u32, ObjectId)>,
     table_detector: TableDetector,
 }
 
@@ -64,10 +69,7 @@ impl PdfParser {
             TransmutationError::engine_error_with_source("PDF Parser", "Failed to load PDF", e)
         })?;
 
-        Ok(Self {
-            document,
-            table_detector: TableDetector::new(),
-        })
+        Ok(Self::from_document(document))
     }
 
     /// Load a PDF from bytes
@@ -80,35 +82,41 @@ impl PdfParser {
             )
         })?;
 
-        Ok(Self {
+        Ok(Self::from_document(document))
+    }
+
+    /// Wrap a loaded document, walking its page tree once
+    fn from_document(document: Document) -> Self {
+        // get_pages() walks the whole page tree, so resolve it once here
+        // instead of on every per-page call
+        let pages = document.get_pages().into_iter().collect();
+
+        Self {
             document,
+            pages,
             table_detector: TableDetector::new(),
-        })
+        }
     }
 
     /// Get the number of pages in the PDF
     pub fn page_count(&self) -> usize {
-        self.document.get_pages().len()
+        self.pages.len()
     }
 
     /// Get page IDs (returns page numbers as u32)
     fn get_page_ids(&self) -> Vec<u32> {
-        self.document.get_pages().into_keys().collect()
+        self.pages.iter().map(|&(number, _)| number).collect()
     }
 
     /// Extract text from a specific page (0-indexed)
     pub fn extract_text(&self, page_num: usize) -> Result<String> {
-        let page_ids = self.get_page_ids();
-
-        if page_num >= page_ids.len() {
+        let Some(&(page_id, _)) = self.pages.get(page_num) else {
             return Err(TransmutationError::InvalidOptions(format!(
                 "Page {} does not exist (total pages: {})",
                 page_num,
-                page_ids.len()
+                self.pages.len()
             )));
-        }
-
-        let page_id = page_ids[page_num];
+        };
 
         // Extract text from page
         let text = self.document.extract_text(&[page_id]).map_err(|e| {
@@ -207,8 +215,7 @@ impl PdfParser {
         }
 
         // Clean up extra whitespace
-        result = result.replace("\n\n\n\n", "\n\n");
-        result = result.replace("\n\n\n", "\n\n");
+        whitespace::collapse_blank_lines(&mut result);
 
         // Handle subsections like 3.1, 3.2, etc.
         for major in 1..10 {
@@ -304,31 +311,21 @@ impl PdfParser {
 
     /// Get page size (width, height) in points
     pub fn get_page_size(&self, page_num: usize) -> Result<(f32, f32)> {
-        let page_ids = self.get_page_ids();
-
-        if page_num >= page_ids.len() {
+        let Some(&(_, page_ref)) = self.pages.get(page_num) else {
             return Err(TransmutationError::InvalidOptions(format!(
                 "Page {} does not exist",
                 page_num
             )));
-        }
-
-        let page_id = page_ids[page_num];
-        let pages = self.document.get_pages();
+        };
 
-        if let Some(&(page_obj_num, page_obj_generation)) = pages.get(&page_id) {
-            if let Ok(page_dict) = self
-                .document
-                .get_object((page_obj_num, page_obj_generation))
-            {
-                if let Ok(page) = page_dict.as_dict() {
-                    if let Ok(media_box) = page.get(b"MediaBox") {
-                        if let Ok(media_box_array) = media_box.as_array() {
-                            if media_box_array.len() >= 4 {
-                                let width = media_box_array[2].as_float().unwrap_or(612.0);
-                                let height = media_box_array[3].as_float().unwrap_or(792.0);
-                                return Ok((width, height));
-                            }
+        if let Ok(page_dict) = self.document.get_object(page_ref) {
+            if let Ok(page) = page_dict.as_dict() {
+                if let Ok(media_box) = page.get(b"MediaBox") {
+                    if let Ok(media_box_array) = media_box.as_array() {
+                        if media_box_array.len() >= 4 {
+                            let width = media_box_array[2].as_float().unwrap_or(612.0);
+                            let height = media_box_array[3].as_float().unwrap_or(792.0);
+                            return Ok((width, height));
                         }
                     }
                 }
@@ -359,23 +356,13 @@ impl PdfParser {
     }
 
     /// Extract text blocks with positioning and font information
-    fn extract_text_blocks(&self, _page_num: usize) -> Result<Vec<TextBlock>> {
-        let page_ids = self.get_page_ids();
-        if _page_num >= page_ids.len() {
+    fn extract_text_blocks(&self, page_num: usize) -> Result<Vec<TextBlock>> {
+        let Some(&(_, page_ref)) = self.pages.get(page_num) else {
             return Ok(Vec::new());
-        }
-
-        let page_id = page_ids[_page_num];
-
-        // Get page content
-        let pages = self.document.get_pages();
-        let page_ref = match pages.get(&page_id) {
-            Some(r) => r,
-            None => return Ok(Vec::new()),
         };
 
         // Parse content stream
-        let content = match self.document.get_and_decode_page_content(*page_ref) {
+        let content = match self.document.get_and_decode_page_content(page_ref) {
             Ok(c) => c,
             Err(_) => return Ok(Vec::new()),
         };
@@ -386,22 +373,14 @@ impl PdfParser {
     /// OLD UNUSED CODE - keeping for reference
     #[allow(non_snake_case)]
     fn extract_text_blocks_OLD(&self, _page_num: usize) -> Result<Vec<TextBlock>> {
-        let page_ids = self.get_page_ids();
-        if _page_num >= page_ids.len() {
-            return Ok(Vec::new());
-        }
-
-        let page_id = page_ids[_page_num];
         let blocks = Vec::new();
 
         // Get page content
-        let pages = self.document.get_pages();
-        let page_ref = match pages.get(&page_id) {
-            Some(r) => r,
-            None => return Ok(blocks),
+        let Some(&(_, page_ref)) = self.pages.get(_page_num) else {
+            return Ok(blocks);
         };
 
-        let page_obj = match self.document.get_object(*page_ref) {
+        let page_obj = match self.document.get_object(page_ref) {
             Ok(obj) => obj,
             Err(_) => return Ok(blocks),
         };
@@ -632,15 +611,177 @@ impl PdfParser {
     }
 
     /// Extract all pages with detailed information
+    ///
+    /// Pages are decoded and extracted in parallel; the result keeps page order.
     pub fn extract_all_pages(&self) -> Result<Vec<PdfPage>> {
-        let page_count = self.page_count();
-        let mut pages = Vec::with_capacity(page_count);
+        (0..self.page_count())
+            .into_par_iter()
+            .map(|i| self.extract_page(i))
+            .collect()
+    }
+
+    /// Fingerprint of everything that determines a page's rendering
+    ///
+    /// Hashes the page dictionary (content streams included), the inheritable
+    /// attributes of its ancestors and every object reachable from them, by
+    /// value rather than by object id. A page that is unchanged between two
+    /// revisions of a document keeps its fingerprint even when the file is
+    /// rewritten and objects are renumbered.
+    pub fn page_fingerprint(&self, page_num: usize) -> Result<[u8; 32]> {
+        let Some(&(_, page_ref)) = self.pages.get(page_num) else {
+            return Err(TransmutationError::InvalidOptions(format!(
+                "Page {} does not exist (total pages: {})",
+                page_num,
+                self.pages.len()
+            )));
+        };
+
+        let page = self.document.get_dictionary(page_ref).map_err(|e| {
+            TransmutationError::engine_error_with_source("PDF Parser", "Failed to read page", e)
+        })?;
+
+        // Resources, MediaBox, CropBox and Rotate may be inherited from the page tree
+        let mut ancestors = Vec::new();
+        let mut parent = page
+            .get(b"Parent")
+            .and_then(lopdf::Object::as_reference)
+            .ok();
+        while let Some(id) = parent {
+            let Ok(node) = self.document.get_dictionary(id) else {
+                break;
+            };
+            if id == page_ref || ancestors.iter().any(|&(seen, _)| seen == id) {
+                break;
+            }
+            ancestors.push((id, node));
+            parent = node
+                .get(b"Parent")
+                .and_then(lopdf::Object::as_reference)
+                .ok();
+        }
 
-        for i in 0..page_count {
-            pages.push(self.extract_page(i)?);
+        // Mark the page and its tree nodes as seen up front: a back reference
+        // (an annotation's /P) must not pull in the sibling pages under /Kids
+        let mut visited = HashMap::new();
+        visited.insert(page_ref, 0);
+        for &(id, _) in &ancestors {
+            visited.insert(id, visited.len());
         }
 
-        Ok(pages)
+        let mut hasher = blake3::Hasher::new();
+        self.hash_dictionary(page, &[b"Parent"], &mut hasher, &mut visited);
+        for (_, node) in ancestors {
+            for key in [&b"Resources"[..], b"MediaBox", b"CropBox", b"Rotate"] {
+                if let Ok(value) = node.get(key) {
+                    Self::hash_bytes(key, &mut hasher);
+                    self.hash_object(value, &mut hasher, &mut visited);
+                }
+            }
+        }
+
+        Ok(*hasher.finalize().as_bytes())
+    }
+
+    /// Fingerprints of all pages, in page order
+    pub fn page_fingerprints(&self) -> Result<Vec<[u8; 32]>> {
+        (0..self.page_count())
+            .into_par_iter()
+            .map(|i| self.page_fingerprint(i))
+            .collect()
+    }
+
+    /// Hash an object by value, following references
+    ///
+    /// `visited` maps each object already hashed to its visit order, so
+    /// cycles (annotations pointing back at their page) terminate and repeated
+    /// references hash the same way regardless of object numbering.
+    fn hash_object(
+        &self,
+        object: &lopdf::Object,
+        hasher: &mut blake3::Hasher,
+        visited: &mut HashMap<ObjectId, usize>,
+    ) {
+        use lopdf::Object;
+
+        match object {
+            Object::Null => {
+                hasher.update(b"n");
+            }
+            Object::Boolean(value) => {
+                hasher.update(if *value { b"T" } else { b"F" });
+            }
+            Object::Integer(value) => {
+                hasher.update(b"i");
+                hasher.update(&value.to_le_bytes());
+            }
+            Object::Real(value) => {
+                hasher.update(b"r");
+                hasher.update(&value.to_le_bytes());
+            }
+            Object::Name(name) => {
+                hasher.update(b"/");
+                Self::hash_bytes(name, hasher);
+            }
+            Object::String(bytes, _) => {
+                hasher.update(b"s");
+                Self::hash_bytes(bytes, hasher);
+            }
+            Object::Array(items) => {
+                hasher.update(b"[");
+                hasher.update(&(items.len() as u64).to_le_bytes());
+                for item in items {
+                    self.hash_object(item, hasher, visited);
+                }
+            }
+            Object::Dictionary(dict) => self.hash_dictionary(dict, &[], hasher, visited),
+            Object::Stream(stream) => {
+                hasher.update(b"S");
+                self.hash_dictionary(&stream.dict, &[b"Length"], hasher, visited);
+                Self::hash_bytes(&stream.content, hasher);
+            }
+            Object::Reference(id) => {
+                if let Some(&order) = visited.get(id) {
+                    hasher.update(b"R");
+                    hasher.update(&(order as u64).to_le_bytes());
+                    return;
+                }
+                visited.insert(*id, visited.len());
+                match self.document.get_object(*id) {
+                    Ok(target) => self.hash_object(target, hasher, visited),
+                    Err(_) => {
+                        hasher.update(b"n");
+                    }
+                }
+            }
+        }
+    }
+
+    /// Hash a dictionary with sorted keys, leaving out `skip`
+    fn hash_dictionary(
+        &self,
+        dict: &lopdf::Dictionary,
+        skip: &[&[u8]],
+        hasher: &mut blake3::Hasher,
+        visited: &mut HashMap<ObjectId, usize>,
+    ) {
+        let mut entries: Vec<_> = dict
+            .iter()
+            .filter(|(key, _)| !skip.contains(&key.as_slice()))
+            .collect();
+        entries.sort_unstable_by(|a, b| a.0.cmp(b.0));
+
+        hasher.update(b"<");
+        hasher.update(&(entries.len() as u64).to_le_bytes());
+        for (key, value) in entries {
+            Self::hash_bytes(key, hasher);
+            self.hash_object(value, hasher, visited);
+        }
+    }
+
+    /// Length-prefixed bytes, so adjacent fields cannot run together
+    fn hash_bytes(bytes: &[u8], hasher: &mut blake3::Hasher) {
+        hasher.update(&(bytes.len() as u64).to_le_bytes());
+        hasher.update(bytes);
     }
 
     /// Get PDF metadata
@@ -725,17 +866,16 @@ impl PdfParser {
 
     /// Extract tables from all pages
     pub fn extract_all_tables(&self) -> Result<Vec<(usize, Vec<DetectedTable>)>> {
-        let page_count = self.page_count();
-        let mut all_tables = Vec::new();
-
-        for page_num in 0..page_count {
-            let tables = self.extract_tables(page_num)?;
-            if !tables.is_empty() {
-                all_tables.push((page_num, tables));
-            }
-        }
-
-        Ok(all_tables)
+        let per_page: Vec<Vec<DetectedTable>> = (0..self.page_count())
+            .into_par_iter()
+            .map(|page_num| self.extract_tables(page_num))
+            .collect::<Result<_>>()?;
+
+        Ok(per_page
+            .into_iter()
+            .enumerate()
+            .filter(|(_, tables)| !tables.is_empty())
+            .collect())
     }
 }
 
@@ -797,6 +937,67 @@ mod tests {
         assert_eq!(page.width, 612.0);
     }
 
+    /// Two-page document sharing one inherited resource dictionary
+    fn two_page_parser(first: &str, second: &str) -> PdfParser {
+        use lopdf::{Object, Stream, dictionary};
+
+        let mut doc = Document::with_version("1.5");
+        let pages_id = doc.new_object_id();
+        let font_id = doc.add_object(dictionary! {
+            "Type" => "Font",
+            "Subtype" => "Type1",
+            "BaseFont" => "Helvetica",
+        });
+        let resources_id = doc.add_object(dictionary! {
+            "Font" => dictionary! { "F1" => font_id },
+        });
+
+        let mut kids: Vec<Object> = Vec::new();
+        for text in [first, second] {
+            let content = format!("BT /F1 12 Tf 72 720 Td ({}) Tj ET", text);
+            let content_id = doc.add_object(Stream::new(dictionary! {}, content.into_bytes()));
+            let page_id = doc.add_object(dictionary! {
+                "Type" => "Page",
+                "Parent" => pages_id,
+                "Contents" => content_id,
+            });
+            kids.push(page_id.into());
+        }
+
+        doc.objects.insert(
+            pages_id,
+            Object::Dictionary(dictionary! {
+                "Type" => "Pages",
+                "Kids" => kids,
+                "Count" => 2,
+                "Resources" => resources_id,
+                "MediaBox" => vec![0.into(), 0.into(), 595.into(), 842.into()],
+            }),
+        );
+        let catalog_id = doc.add_object(dictionary! {
+            "Type" => "Catalog",
+            "Pages" => pages_id,
+        });
+        doc.trailer.set("Root", catalog_id);
+
+        PdfParser::from_document(doc)
+    }
+
+    #[test]
+    fn test_page_fingerprint_by_content() {
+        let parser = two_page_parser("Same", "Same");
+        let fingerprints = parser.page_fingerprints().unwrap();
+        // Different object ids, same content
+        assert_eq!(fingerprints[0], fingerprints[1]);
+
+        let amended = two_page_parser("Same", "Amended");
+        let changed = amended.page_fingerprints().unwrap();
+        assert_eq!(changed[0], fingerprints[0]);
+        assert_ne!(changed[1], fingerprints[1]);
+
+        assert!(parser.page_fingerprint(2).is_err());
+    }
+
     // Integration tests require actual PDF files
     // These will be added in tests/pdf_parser_tests.rs with fixtures
 }
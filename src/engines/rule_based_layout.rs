@@ -14,17 +14,28 @@ use crate::error::Result;
 ///
 /// Tries ML model first (if available), falls back to rule-based
 pub fn detect_layout_from_cells(json_str: &str) -> Result<Vec<Cluster>> {
+    Ok(detect_page_layouts(json_str)?
+        .into_iter()
+        .flatten()
+        .collect())
+}
+
+/// Detect layout regions like [`detect_layout_from_cells`], grouped by page
+///
+/// Pages without any text cells get an empty entry, so the outer index is
+/// the page index.
+pub fn detect_page_layouts(json_str: &str) -> Result<Vec<Vec<Cluster>>> {
     // Try ML model first (100% Rust ONNX inference)
     #[cfg(feature = "docling-ffi")]
     {
         eprintln!("      🔍 Attempting ML-based layout detection...");
         match detect_layout_with_ml(json_str) {
-            Ok(clusters) if !clusters.is_empty() => {
+            Ok(pages) if pages.iter().any(|page| !page.is_empty()) => {
                 eprintln!(
                     "      ✅ Using ML model (LayoutLMv3 ONNX) - {} regions",
-                    clusters.len()
+                    pages.iter().map(Vec::len).sum::<usize>()
                 );
-                return Ok(clusters);
+                return Ok(pages);
             }
             Ok(_) => {
                 eprintln!("      ⚠️  ML model returned empty, using rule-based");
@@ -46,7 +57,7 @@ pub fn detect_layout_from_cells(json_str: &str) -> Result<Vec<Cluster>> {
 
 /// Try to detect layout using ML model (ONNX)
 #[cfg(feature = "docling-ffi")]
-fn detect_layout_with_ml(json_str: &str) -> Result<Vec<Cluster>> {
+fn detect_layout_with_ml(json_str: &str) -> Result<Vec<Vec<Cluster>>> {
     use std::path::Path;
 
     use crate::ml::layout_model::LayoutModel;
@@ -68,7 +79,7 @@ fn detect_layout_with_ml(json_str: &str) -> Result<Vec<Cluster>> {
         return Ok(Vec::new());
     };
 
-    let mut all_clusters = Vec::new();
+    let mut page_layouts = Vec::with_capacity(pages.len());
     let mut cluster_id = 0;
 
     for (page_idx, page) in pages.iter().enumerate() {
@@ -92,6 +103,7 @@ fn detect_layout_with_ml(json_str: &str) -> Result<Vec<Cluster>> {
 
         if cells.is_empty() {
             eprintln!("      ⚠️  No cells found on page {}", page_idx + 1);
+            page_layouts.push(Vec::new());
             continue;
         }
 
@@ -116,16 +128,15 @@ fn detect_layout_with_ml(json_str: &str) -> Result<Vec<Cluster>> {
         let page_clusters =
             cluster_cells_geometrically(&cells, &mut cluster_id, page_width, page_height)?;
 
-        all_clusters.extend(page_clusters);
-
         eprintln!(
             "      ✅ Found {} regions on page {}",
-            all_clusters.len() - cluster_id,
+            page_clusters.len(),
             page_idx + 1
         );
+        page_layouts.push(page_clusters);
     }
 
-    Ok(all_clusters)
+    Ok(page_layouts)
 }
 
 /// Extract text cells from page for ML processing
@@ -375,21 +386,20 @@ fn create_cluster_from_cells(cells: Vec<&TextCell>, id: usize, label: DocItemLab
 }
 
 /// Detect layout using geometric rules (fallback)
-fn detect_layout_with_rules(json_str: &str) -> Result<Vec<Cluster>> {
+fn detect_layout_with_rules(json_str: &str) -> Result<Vec<Vec<Cluster>>> {
     let json: Value = serde_json::from_str(json_str)?;
 
-    let mut clusters = Vec::new();
+    let mut page_layouts = Vec::new();
     let mut cluster_id = 0;
 
     // Process each page
     if let Some(pages) = json["pages"].as_array() {
         for (page_idx, page) in pages.iter().enumerate() {
-            let page_clusters = detect_page_layout(page, page_idx, &mut cluster_id)?;
-            clusters.extend(page_clusters);
+            page_layouts.push(detect_page_layout(page, page_idx, &mut cluster_id)?);
         }
     }
 
-    Ok(clusters)
+    Ok(page_layouts)
 }
 
 fn detect_page_layout(
@@ -144,7 +144,7 @@ impl ConversionBuilder {
     pub async fn execute(self) -> Result<ConversionResult> {
         use crate::utils::detect_format;
 
-        // Detect input format
+        // Detect input format once; converters receive it instead of re-reading the file
         let input_format = detect_format(&self.input).await?;
 
         // Get output format (default to Markdown)
@@ -154,148 +154,17 @@ impl ConversionBuilder {
         });
 
         // Select appropriate converter
-
-        // Core formats (always enabled)
-        if input_format == FileFormat::Pdf {
-            use crate::converters::pdf::PdfConverter;
-            let converter = PdfConverter::new();
-            return converter
-                .convert(&self.input, output_format, self.options)
-                .await;
-        }
-
-        if input_format == FileFormat::Html {
-            use crate::converters::html::HtmlConverter;
-            let converter = HtmlConverter::new();
-            return converter
-                .convert(&self.input, output_format, self.options)
-                .await;
-        }
-
-        if input_format == FileFormat::Xml {
-            use crate::converters::xml::XmlConverter;
-            let converter = XmlConverter::new();
-            return converter
-                .convert(&self.input, output_format, self.options)
-                .await;
-        }
-
-        if input_format == FileFormat::Zip
-            || input_format == FileFormat::Tar
-            || input_format == FileFormat::TarGz
-            || input_format == FileFormat::TarBz2
-            || input_format == FileFormat::SevenZ
-        {
-            use crate::converters::archive::ArchiveConverter;
-            let converter = ArchiveConverter::new();
-            return converter
-                .convert(&self.input, output_format, self.options)
-                .await;
-        }
-
-        // Office formats (optional feature)
-        #[cfg(feature = "office")]
-        if input_format == FileFormat::Docx {
-            use crate::converters::docx::DocxConverter;
-            let converter = DocxConverter::new();
-            return converter
-                .convert(&self.input, output_format, self.options)
-                .await;
-        }
-
-        #[cfg(feature = "office")]
-        if input_format == FileFormat::Xlsx {
-            use crate::converters::xlsx::XlsxConverter;
-            let converter = XlsxConverter::new();
-            return converter
-                .convert(&self.input, output_format, self.options)
-                .await;
-        }
-
-        #[cfg(feature = "office")]
-        if input_format == FileFormat::Pptx {
-            use crate::converters::pptx::PptxConverter;
-            let converter = PptxConverter::new();
-            return converter
-                .convert(&self.input, output_format, self.options)
-                .await;
-        }
-
-        // Text formats (always enabled)
-        if input_format == FileFormat::Txt {
-            use crate::converters::txt::TxtConverter;
-            let converter = TxtConverter::new();
-            return converter
-                .convert(&self.input, output_format, self.options)
-                .await;
+        match crate::converters::converter_for(input_format) {
+            Some(converter) => {
+                converter
+                    .convert_detected(&self.input, input_format, output_format, self.options)
+                    .await
+            }
+            // Format not supported or feature not enabled
+            None => Err(TransmutationError::UnsupportedFormat(format!(
+                "Format {input_format:?} is not supported or feature not enabled"
+            ))),
         }
-
-        if input_format == FileFormat::Csv {
-            use crate::converters::csv::CsvConverter;
-            let converter = CsvConverter::new();
-            return converter
-                .convert(&self.input, output_format, self.options)
-                .await;
-        }
-
-        if input_format == FileFormat::Tsv {
-            use crate::converters::csv::CsvConverter;
-            let converter = CsvConverter::new_tsv();
-            return converter
-                .convert(&self.input, output_format, self.options)
-                .await;
-        }
-
-        if input_format == FileFormat::Rtf {
-            use crate::converters::rtf::RtfConverter;
-            let converter = RtfConverter::new();
-            return converter
-                .convert(&self.input, output_format, self.options)
-                .await;
-        }
-
-        if input_format == FileFormat::Odt {
-            use crate::converters::odt::OdtConverter;
-            let converter = OdtConverter::new();
-            return converter
-                .convert(&self.input, output_format, self.options)
-                .await;
-        }
-
-        // Image formats (with OCR if feature enabled)
-        #[cfg(feature = "image-ocr")]
-        if input_format.is_image() {
-            use crate::converters::image::ImageConverter;
-            let converter = ImageConverter::new();
-            return converter
-                .convert(&self.input, output_format, self.options)
-                .await;
-        }
-
-        // Audio formats (with Whisper if feature enabled)
-        #[cfg(feature = "audio")]
-        if input_format.is_audio() {
-            use crate::converters::audio::AudioConverter;
-            let converter = AudioConverter::new();
-            return converter
-                .convert(&self.input, output_format, self.options)
-                .await;
-        }
-
-        // Video formats (with FFmpeg + Whisper if feature enabled)
-        #[cfg(feature = "video")]
-        if input_format.is_video() {
-            use crate::converters::video::VideoConverter;
-            let converter = VideoConverter::new();
-            return converter
-                .convert(&self.input, output_format, self.options)
-                .await;
-        }
-
-        // Format not supported or feature not enabled
-        Err(TransmutationError::UnsupportedFormat(format!(
-            "Format {input_format:?} is not supported or feature not enabled"
-        )))
     }
 }
 
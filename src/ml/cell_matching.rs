@@ -4,7 +4,10 @@
 
 #![allow(missing_docs, clippy::unused_self)]
 
+use std::ops::Range;
+
 use crate::document::types_extended::{BoundingBox, TextCell};
+use crate::engines::geometry::{self, BoxIndex, Rect};
 use crate::error::Result;
 use crate::ml::table_structure_model::TableCell;
 
@@ -28,53 +31,72 @@ impl CellMatcher {
 
     /// Match text cells to table cells
     ///
-    /// For each table cell, finds all text cells that overlap with it
-    /// and concatenates their text in reading order
+    /// For each table cell, finds all text cells that overlap with it and
+    /// concatenates their text in reading order into one shared buffer.
+    /// Text cells are indexed once in an R-tree and each table cell is only
+    /// compared against the text cells it overlaps, instead of all of them.
     pub fn match_cells(
         &self,
         table_cells: &[TableCell],
         text_cells: &[TextCell],
-    ) -> Result<Vec<MatchedCell>> {
-        let mut matched = Vec::new();
-
-        for table_cell in table_cells {
-            let table_bbox = self.table_cell_to_bbox(table_cell);
+    ) -> Result<MatchedCells> {
+        let text_rects: Vec<Rect> = text_cells.iter().map(|c| c.bbox.as_tuple()).collect();
+        let index = BoxIndex::new(text_rects.iter().copied());
 
-            // Find all text cells that overlap with this table cell
-            let mut matching_texts = Vec::new();
-
-            for text_cell in text_cells {
-                let iou = table_bbox.intersection_over_union(&text_cell.bbox);
+        let mut matched = MatchedCells {
+            text: String::new(),
+            cells: Vec::with_capacity(table_cells.len()),
+        };
+        let mut matching_texts: Vec<(usize, f64)> = Vec::new();
 
+        for table_cell in table_cells {
+            let table_rect = self.table_cell_to_bbox(table_cell).as_tuple();
+
+            // Find all text cells that overlap with this table cell. A
+            // non-positive threshold also accepts disjoint cells, so only
+            // then is the full list scanned.
+            matching_texts.clear();
+            let mut consider = |i: usize| {
+                let iou = geometry::iou(&table_rect, &text_rects[i]);
                 if iou >= self.iou_threshold {
-                    matching_texts.push((text_cell, iou));
+                    matching_texts.push((i, iou));
                 }
+            };
+            if self.iou_threshold > 0.0 {
+                index.intersecting(&table_rect).for_each(&mut consider);
+            } else {
+                (0..text_cells.len()).for_each(&mut consider);
             }
 
-            // Sort by position (top-to-bottom, left-to-right) then by IoU
-            matching_texts.sort_by(|a, b| {
-                let y_cmp = a.0.bbox.t.partial_cmp(&b.0.bbox.t).unwrap();
-                if y_cmp == std::cmp::Ordering::Equal {
-                    a.0.bbox.l.partial_cmp(&b.0.bbox.l).unwrap()
-                } else {
-                    y_cmp
-                }
+            // Sort by position (top-to-bottom, left-to-right), ties in input order
+            matching_texts.sort_by(|&(a, _), &(b, _)| {
+                let (a_rect, b_rect) = (&text_rects[a], &text_rects[b]);
+                a_rect
+                    .1
+                    .total_cmp(&b_rect.1)
+                    .then(a_rect.0.total_cmp(&b_rect.0))
+                    .then(a.cmp(&b))
             });
 
-            // Concatenate text from matching cells
-            let text = matching_texts
-                .iter()
-                .map(|(cell, _)| cell.text.trim())
-                .filter(|t| !t.is_empty())
-                .collect::<Vec<_>>()
-                .join(" ");
+            // Concatenate text from matching cells into the shared buffer
+            let start = matched.text.len();
+            for &(i, _) in &matching_texts {
+                let text = text_cells[i].text.trim();
+                if text.is_empty() {
+                    continue;
+                }
+                if matched.text.len() > start {
+                    matched.text.push(' ');
+                }
+                matched.text.push_str(text);
+            }
 
-            matched.push(MatchedCell {
+            matched.cells.push(MatchedCellSpan {
                 row: table_cell.row,
                 col: table_cell.col,
                 row_span: table_cell.row_span,
                 col_span: table_cell.col_span,
-                text,
+                text: start..matched.text.len(),
                 is_header: table_cell.is_header,
                 confidence: self.calculate_match_confidence(&matching_texts),
             });
@@ -96,7 +118,7 @@ impl CellMatcher {
     }
 
     /// Calculate confidence of cell matching
-    fn calculate_match_confidence(&self, matches: &[(&TextCell, f64)]) -> f32 {
+    fn calculate_match_confidence(&self, matches: &[(usize, f64)]) -> f32 {
         if matches.is_empty() {
             return 0.0;
         }
@@ -117,41 +139,57 @@ impl Default for CellMatcher {
     }
 }
 
-/// Cell with matched text content
+/// Matched table cells whose text lives in one shared buffer
+#[derive(Debug, Clone, Default)]
+pub struct MatchedCells {
+    /// Concatenated text of all cells
+    pub text: String,
+    /// Cells referencing their text by byte range into `text`
+    pub cells: Vec<MatchedCellSpan>,
+}
+
+/// Matched cell whose text is a range into `MatchedCells::text`
 #[derive(Debug, Clone)]
 #[allow(missing_docs)]
-pub struct MatchedCell {
+pub struct MatchedCellSpan {
     pub row: usize,
     pub col: usize,
     pub row_span: usize,
     pub col_span: usize,
-    pub text: String,
+    pub text: Range<usize>,
     pub is_header: bool,
     pub confidence: f32,
 }
 
-impl MatchedCell {
-    /// Convert to TableData grid format
-    pub fn to_table_data(cells: Vec<MatchedCell>) -> crate::document::types::TableData {
-        if cells.is_empty() {
-            return crate::document::types::TableData {
-                num_rows: 0,
-                num_cols: 0,
-                grid: Vec::new(),
-            };
-        }
+impl MatchedCells {
+    /// Text of a matched cell
+    pub fn cell_text(&self, cell: &MatchedCellSpan) -> &str {
+        &self.text[cell.text.clone()]
+    }
 
+    /// Convert to TableData grid format
+    pub fn to_table_data(&self) -> crate::document::types::TableData {
         // Find dimensions
-        let num_rows = cells.iter().map(|c| c.row + c.row_span).max().unwrap_or(0);
-        let num_cols = cells.iter().map(|c| c.col + c.col_span).max().unwrap_or(0);
+        let num_rows = self
+            .cells
+            .iter()
+            .map(|c| c.row + c.row_span)
+            .max()
+            .unwrap_or(0);
+        let num_cols = self
+            .cells
+            .iter()
+            .map(|c| c.col + c.col_span)
+            .max()
+            .unwrap_or(0);
 
         // Build grid
         let mut grid = vec![Vec::new(); num_rows];
 
-        for cell in cells {
+        for cell in &self.cells {
             if cell.row < num_rows {
                 grid[cell.row].push(crate::document::types::TableCell {
-                    text: cell.text,
+                    text: self.cell_text(cell).to_string(),
                     row_span: cell.row_span,
                     col_span: cell.col_span,
                 });
@@ -196,9 +234,9 @@ mod tests {
 
         let matched = matcher.match_cells(&table_cells, &text_cells).unwrap();
 
-        assert_eq!(matched.len(), 1);
-        assert_eq!(matched[0].text, "Cell A");
-        assert!(matched[0].is_header);
+        assert_eq!(matched.cells.len(), 1);
+        assert_eq!(matched.cell_text(&matched.cells[0]), "Cell A");
+        assert!(matched.cells[0].is_header);
     }
 
     #[test]
@@ -237,43 +275,69 @@ mod tests {
 
         let matched = matcher.match_cells(&table_cells, &text_cells).unwrap();
 
-        assert_eq!(matched.len(), 1);
-        assert_eq!(matched[0].text, "Part 1 Part 2");
+        assert_eq!(matched.cells.len(), 1);
+        assert_eq!(matched.cell_text(&matched.cells[0]), "Part 1 Part 2");
     }
 
     #[test]
-    fn test_to_table_data() {
-        let cells = vec![
-            MatchedCell {
-                row: 0,
-                col: 0,
-                row_span: 1,
-                col_span: 1,
-                text: "A".to_string(),
-                is_header: true,
-                confidence: 0.9,
-            },
-            MatchedCell {
+    fn test_cell_matcher_shared_buffer() {
+        let matcher = CellMatcher::new();
+
+        let table_cells: Vec<TableCell> = (0..3)
+            .map(|col| TableCell {
                 row: 0,
-                col: 1,
+                col,
                 row_span: 1,
                 col_span: 1,
-                text: "B".to_string(),
-                is_header: true,
-                confidence: 0.9,
-            },
-            MatchedCell {
-                row: 1,
-                col: 0,
-                row_span: 1,
-                col_span: 1,
-                text: "1".to_string(),
+                bbox: (col as f32 * 10.0, 0.0, col as f32 * 10.0 + 10.0, 10.0),
                 is_header: false,
-                confidence: 0.8,
-            },
-        ];
+            })
+            .collect();
+
+        // One text cell in the first and last column, none in the middle
+        let text_cells: Vec<TextCell> = [(1.0, "left"), (21.0, "right")]
+            .iter()
+            .enumerate()
+            .map(|(index, &(x, text))| TextCell {
+                index,
+                text: text.to_string(),
+                bbox: BoundingBox::new(x, 1.0, x + 8.0, 9.0, CoordOrigin::TopLeft),
+                font_name: None,
+                font_size: None,
+                confidence: 1.0,
+                from_ocr: false,
+            })
+            .collect();
+
+        let matched = matcher.match_cells(&table_cells, &text_cells).unwrap();
+
+        assert_eq!(matched.text, "leftright");
+        let texts: Vec<&str> = matched.cells.iter().map(|c| matched.cell_text(c)).collect();
+        assert_eq!(texts, vec!["left", "", "right"]);
+        assert_eq!(matched.cells[1].confidence, 0.0);
+    }
 
-        let table_data = MatchedCell::to_table_data(cells);
+    #[test]
+    fn test_to_table_data() {
+        let cell = |row, col, text: Range<usize>, is_header| MatchedCellSpan {
+            row,
+            col,
+            row_span: 1,
+            col_span: 1,
+            text,
+            is_header,
+            confidence: 0.9,
+        };
+        let matched = MatchedCells {
+            text: "AB1".to_string(),
+            cells: vec![
+                cell(0, 0, 0..1, true),
+                cell(0, 1, 1..2, true),
+                cell(1, 0, 2..3, false),
+            ],
+        };
+
+        let table_data = matched.to_table_data();
 
         assert_eq!(table_data.num_rows, 2);
         assert_eq!(table_data.num_cols, 2);
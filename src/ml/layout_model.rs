@@ -12,13 +12,14 @@ use ndarray::Array4;
 #[cfg(feature = "docling-ffi")]
 use ort::{
     session::{Session, builder::SessionBuilder},
-    value::Tensor,
+    value::TensorRef,
 };
 
 /// Layout detection model using ONNX
 ///
 /// Detects document regions: text, tables, figures, headers, etc.
 /// Based on docling's LayoutModel (docling_ibm_models)
+use crate::engines::geometry::{Rect, non_max_suppression};
 use crate::error::{Result, TransmutationError};
 use crate::ml::{DocumentModel, preprocessing};
 
@@ -58,6 +59,157 @@ pub struct LayoutPrediction {
     pub page_height: u32,
 }
 
+/// Mask probability above which a pixel belongs to a region
+const MASK_THRESHOLD: f32 = 0.5;
+
+/// Minimum bbox extent (in mask pixels) for a region to be kept
+const MIN_REGION_SIZE: u32 = 5;
+
+/// Statistics accumulated for one connected component while labeling
+#[derive(Debug, Clone, Copy)]
+struct ComponentStats {
+    min_x: u32,
+    min_y: u32,
+    max_x: u32,
+    max_y: u32,
+    pixels: u32,
+    score_sum: f32,
+}
+
+impl ComponentStats {
+    fn new(x: u32, y: u32) -> Self {
+        Self {
+            min_x: x,
+            min_y: y,
+            max_x: x,
+            max_y: y,
+            pixels: 0,
+            score_sum: 0.0,
+        }
+    }
+
+    fn merge(&mut self, other: &Self) {
+        self.min_x = self.min_x.min(other.min_x);
+        self.min_y = self.min_y.min(other.min_y);
+        self.max_x = self.max_x.max(other.max_x);
+        self.max_y = self.max_y.max(other.max_y);
+        self.pixels += other.pixels;
+        self.score_sum += other.score_sum;
+    }
+
+    /// Mean mask probability over the component's pixels
+    fn mean_score(&self) -> f32 {
+        if self.pixels > 0 {
+            self.score_sum / self.pixels as f32
+        } else {
+            0.0
+        }
+    }
+}
+
+/// Two-pass union-find connected-components labeler (4-connectivity)
+///
+/// The first pass assigns provisional labels from the left/up neighbours,
+/// records label equivalences and accumulates bbox, pixel count and score
+/// sum per provisional label. The second pass runs over the (much smaller)
+/// label table only, folding each label's stats into its root, so pixels
+/// are visited exactly once. Buffers are kept between planes.
+#[derive(Debug, Default)]
+struct ComponentLabeler {
+    labels: Vec<u32>,
+    parent: Vec<u32>,
+    stats: Vec<ComponentStats>,
+}
+
+impl ComponentLabeler {
+    /// Find the root label (with path halving)
+    fn find(&mut self, mut label: u32) -> u32 {
+        while self.parent[label as usize] != label {
+            let grandparent = self.parent[self.parent[label as usize] as usize];
+            self.parent[label as usize] = grandparent;
+            label = grandparent;
+        }
+        label
+    }
+
+    /// Merge two label sets, keeping the smaller (earlier) label as root
+    fn union(&mut self, a: u32, b: u32) {
+        let (ra, rb) = (self.find(a), self.find(b));
+        if ra != rb {
+            self.parent[ra.max(rb) as usize] = ra.min(rb);
+        }
+    }
+
+    /// Label one `[H, W]` mask plane, returning its components in raster
+    /// order of their first pixel
+    fn label_plane(
+        &mut self,
+        plane: &[f32],
+        width: usize,
+        height: usize,
+        threshold: f32,
+    ) -> Vec<ComponentStats> {
+        self.labels.clear();
+        self.labels.resize(width * height, 0);
+        self.parent.clear();
+        self.parent.push(0); // label 0 = background
+        self.stats.clear();
+        self.stats.push(ComponentStats::new(0, 0));
+
+        for y in 0..height {
+            let row = y * width;
+            for x in 0..width {
+                let i = row + x;
+                let score = plane[i];
+                if score <= threshold {
+                    continue;
+                }
+
+                let left = if x > 0 { self.labels[i - 1] } else { 0 };
+                let up = if y > 0 { self.labels[i - width] } else { 0 };
+                let label = match (left, up) {
+                    (0, 0) => {
+                        let next = self.parent.len() as u32;
+                        self.parent.push(next);
+                        self.stats.push(ComponentStats::new(x as u32, y as u32));
+                        next
+                    }
+                    (l, 0) | (0, l) => l,
+                    (l, u) => {
+                        if l != u {
+                            self.union(l, u);
+                        }
+                        l
+                    }
+                };
+                self.labels[i] = label;
+
+                // Rows are scanned top-down, so min_y is fixed at creation
+                let stats = &mut self.stats[label as usize];
+                stats.min_x = stats.min_x.min(x as u32);
+                stats.max_x = stats.max_x.max(x as u32);
+                stats.max_y = y as u32;
+                stats.pixels += 1;
+                stats.score_sum += score;
+            }
+        }
+
+        // Resolve equivalences over the label table
+        for label in 1..self.parent.len() as u32 {
+            let root = self.find(label);
+            if root != label {
+                let stats = self.stats[label as usize];
+                self.stats[root as usize].merge(&stats);
+            }
+        }
+
+        (1..self.parent.len())
+            .filter(|&label| self.parent[label] as usize == label)
+            .map(|label| self.stats[label])
+            .collect()
+    }
+}
+
 /// ONNX-based layout detection model
 #[derive(Debug)]
 pub struct LayoutModel {
@@ -98,33 +250,30 @@ impl LayoutModel {
     }
 
     /// Run inference on preprocessed image
+    ///
+    /// The preprocessed tensor is bound to ORT as a borrowed view and the
+    /// output masks are post-processed straight out of the session outputs,
+    /// so no full-size copy of either tensor is made.
     #[cfg(feature = "docling-ffi")]
     fn run_inference(&mut self, input: &Array4<f32>) -> Result<Vec<DetectedRegion>> {
-        // Convert ndarray to ONNX tensor (ort v2 API)
-        // Extract shape and data as Vec for compatibility with OwnedTensorArrayData
-        let shape = input.shape().to_vec();
-        let data = input.iter().copied().collect::<Vec<f32>>();
-        let input_tensor = Tensor::from_array((shape, data))?;
-
-        // Run inference (ort v2 requires mutable session)
-        // Extract outputs in a separate scope to end mutable borrow
-        let (output_data, output_shape) = {
-            let outputs = self.session.run(ort::inputs![input_tensor])?;
-            let output_value = &outputs[0];
-            let (shape, data) = output_value.try_extract_tensor::<f32>()?;
-            (data.to_vec(), shape.to_vec())
-        };
-
-        // Now process with immutable borrow
-        self.post_process_output_from_data(&output_shape, &output_data)
+        // Preprocessing always yields a standard-layout array, so this is a
+        // no-op borrow; only exotic strided inputs fall back to a copy
+        let input = input.as_standard_layout();
+        let input_data = input.as_slice().ok_or_else(|| {
+            TransmutationError::engine_error("layout-model", "Input tensor is not contiguous")
+        })?;
+        let input_tensor = TensorRef::from_array_view((input.shape().to_vec(), input_data))?;
+
+        // Run inference (ort v2 requires mutable session). Post-processing
+        // does not touch `self`, so it can borrow the output buffer directly.
+        let outputs = self.session.run(ort::inputs![input_tensor])?;
+        let (output_shape, output_data) = outputs[0].try_extract_tensor::<f32>()?;
+
+        Self::post_process_output_from_data(&output_shape[..], output_data)
     }
 
     #[cfg(feature = "docling-ffi")]
-    fn post_process_output_from_data(
-        &self,
-        shape: &[i64],
-        data: &[f32],
-    ) -> Result<Vec<DetectedRegion>> {
+    fn post_process_output_from_data(shape: &[i64], data: &[f32]) -> Result<Vec<DetectedRegion>> {
         // Extract segmentation masks from ONNX output
         // Output format: [batch, num_classes, height, width]
         if shape.len() != 4 {
@@ -139,225 +288,80 @@ impl LayoutModel {
         let height = shape[2] as usize;
         let width = shape[3] as usize;
 
-        // Reconstruct ndarray from shape and data for easier manipulation
-        use ndarray::Array4;
-        let masks_array = Array4::from_shape_vec((1, num_classes, height, width), data.to_vec())
-            .map_err(|e| crate::TransmutationError::EngineError {
+        let plane_len = height * width;
+        if plane_len == 0 {
+            return Ok(Vec::new());
+        }
+        if data.len() < num_classes * plane_len {
+            return Err(crate::TransmutationError::EngineError {
                 engine: "layout-model".to_string(),
-                message: format!("Failed to reshape tensor: {e}"),
+                message: format!(
+                    "Output tensor has {} values, expected {}",
+                    data.len(),
+                    num_classes * plane_len
+                ),
                 source: None,
-            })?;
-
-        // Process each class mask
-        let mut all_regions = Vec::new();
-
-        for class_id in 0..num_classes {
-            // Extract mask for this class
-            let class_mask = masks_array.slice(ndarray::s![0, class_id, .., ..]);
-
-            // Convert mask to regions using connected components
-            let regions = self.mask_to_regions(&class_mask, class_id, width, height)?;
-            all_regions.extend(regions);
-        }
-
-        // Apply Non-Maximum Suppression to remove overlapping detections
-        let filtered_regions = self.apply_nms(all_regions, 0.5)?;
-
-        Ok(filtered_regions)
-    }
-
-    /// Convert binary mask to bounding box regions using connected components
-    #[cfg(feature = "docling-ffi")]
-    fn mask_to_regions(
-        &self,
-        mask: &ndarray::ArrayView2<f32>,
-        class_id: usize,
-        width: usize,
-        height: usize,
-    ) -> Result<Vec<DetectedRegion>> {
-        let threshold = 0.5; // Confidence threshold
-        let mut regions = Vec::new();
-
-        // Simple threshold-based approach
-        // For production, use connected components algorithm
-        let mut visited = vec![vec![false; width]; height];
-
-        for y in 0..height {
-            for x in 0..width {
-                if mask[[y, x]] > threshold && !visited[y][x] {
-                    // Start a new region
-                    let bbox =
-                        self.flood_fill_bbox(mask, &mut visited, x, y, width, height, threshold);
-
-                    if let Some((x0, y0, x1, y1)) = bbox {
-                        // Map class_id to LayoutLabel
-                        if let Some(label) = self.class_id_to_label(class_id) {
-                            // Calculate confidence (average of mask values in bbox)
-                            let confidence = self.calculate_region_confidence(mask, x0, y0, x1, y1);
-
-                            regions.push(DetectedRegion {
-                                label,
-                                bbox: (x0 as f32, y0 as f32, x1 as f32, y1 as f32),
-                                confidence,
-                            });
-                        }
-                    }
-                }
-            }
-        }
-
-        Ok(regions)
-    }
-
-    /// Flood fill to find connected component bounding box
-    #[cfg(feature = "docling-ffi")]
-    fn flood_fill_bbox(
-        &self,
-        mask: &ndarray::ArrayView2<f32>,
-        visited: &mut Vec<Vec<bool>>,
-        start_x: usize,
-        start_y: usize,
-        width: usize,
-        height: usize,
-        threshold: f32,
-    ) -> Option<(usize, usize, usize, usize)> {
-        let mut stack = vec![(start_x, start_y)];
-        let mut min_x = start_x;
-        let mut min_y = start_y;
-        let mut max_x = start_x;
-        let mut max_y = start_y;
-
-        while let Some((x, y)) = stack.pop() {
-            if x >= width || y >= height || visited[y][x] || mask[[y, x]] <= threshold {
-                continue;
-            }
-
-            visited[y][x] = true;
-
-            // Update bounding box
-            min_x = min_x.min(x);
-            min_y = min_y.min(y);
-            max_x = max_x.max(x);
-            max_y = max_y.max(y);
-
-            // Add neighbors (4-connectivity)
-            if x > 0 {
-                stack.push((x - 1, y));
-            }
-            if x + 1 < width {
-                stack.push((x + 1, y));
-            }
-            if y > 0 {
-                stack.push((x, y - 1));
-            }
-            if y + 1 < height {
-                stack.push((x, y + 1));
-            }
-        }
-
-        // Filter out very small regions
-        if (max_x - min_x) < 5 || (max_y - min_y) < 5 {
-            return None;
-        }
-
-        Some((min_x, min_y, max_x, max_y))
-    }
-
-    /// Calculate average confidence in region
-    #[cfg(feature = "docling-ffi")]
-    fn calculate_region_confidence(
-        &self,
-        mask: &ndarray::ArrayView2<f32>,
-        x0: usize,
-        y0: usize,
-        x1: usize,
-        y1: usize,
-    ) -> f32 {
-        let mut sum = 0.0;
-        let mut count = 0;
-
-        for y in y0..=y1 {
-            for x in x0..=x1 {
-                if y < mask.shape()[0] && x < mask.shape()[1] {
-                    sum += mask[[y, x]];
-                    count += 1;
-                }
-            }
+            });
         }
 
-        if count > 0 { sum / count as f32 } else { 0.0 }
-    }
+        // Label every class plane of the (batch 0) output in one sweep,
+        // reusing the same label/union-find buffers across classes
+        let mut labeler = ComponentLabeler::default();
+        let mut all_regions = Vec::new();
 
-    /// Apply Non-Maximum Suppression to filter overlapping regions
-    #[cfg(feature = "docling-ffi")]
-    fn apply_nms(
-        &self,
-        mut regions: Vec<DetectedRegion>,
-        iou_threshold: f32,
-    ) -> Result<Vec<DetectedRegion>> {
-        // Sort by confidence (descending)
-        regions.sort_by(|a, b| b.confidence.partial_cmp(&a.confidence).unwrap());
-
-        let mut keep = Vec::new();
-        let mut suppressed = vec![false; regions.len()];
-
-        for i in 0..regions.len() {
-            if suppressed[i] {
+        for (class_id, plane) in data.chunks_exact(plane_len).take(num_classes).enumerate() {
+            let Some(label) = Self::class_id_to_label(class_id) else {
                 continue;
-            }
-
-            keep.push(regions[i].clone());
+            };
 
-            // Suppress overlapping regions
-            for j in (i + 1)..regions.len() {
-                if suppressed[j] {
+            for component in labeler.label_plane(plane, width, height, MASK_THRESHOLD) {
+                // Filter out very small regions
+                if component.max_x - component.min_x < MIN_REGION_SIZE
+                    || component.max_y - component.min_y < MIN_REGION_SIZE
+                {
                     continue;
                 }
 
-                let iou = self.calculate_iou(&regions[i].bbox, &regions[j].bbox);
-                if iou > iou_threshold {
-                    suppressed[j] = true;
-                }
+                all_regions.push(DetectedRegion {
+                    label,
+                    bbox: (
+                        component.min_x as f32,
+                        component.min_y as f32,
+                        component.max_x as f32,
+                        component.max_y as f32,
+                    ),
+                    confidence: component.mean_score(),
+                });
             }
         }
 
-        Ok(keep)
+        // Apply Non-Maximum Suppression to remove overlapping detections
+        let filtered_regions = Self::apply_nms(all_regions, 0.5)?;
+
+        Ok(filtered_regions)
     }
 
-    /// Calculate Intersection over Union (IoU)
+    /// Apply Non-Maximum Suppression to filter overlapping regions
     #[cfg(feature = "docling-ffi")]
-    fn calculate_iou(&self, bbox1: &(f32, f32, f32, f32), bbox2: &(f32, f32, f32, f32)) -> f32 {
-        let (x1_min, y1_min, x1_max, y1_max) = bbox1;
-        let (x2_min, y2_min, x2_max, y2_max) = bbox2;
-
-        // Calculate intersection
-        let inter_x_min = x1_min.max(*x2_min);
-        let inter_y_min = y1_min.max(*y2_min);
-        let inter_x_max = x1_max.min(*x2_max);
-        let inter_y_max = y1_max.min(*y2_max);
-
-        if inter_x_max <= inter_x_min || inter_y_max <= inter_y_min {
-            return 0.0;
-        }
-
-        let inter_area = (inter_x_max - inter_x_min) * (inter_y_max - inter_y_min);
+    fn apply_nms(regions: Vec<DetectedRegion>, iou_threshold: f32) -> Result<Vec<DetectedRegion>> {
+        let rects: Vec<Rect> = regions
+            .iter()
+            .map(|r| {
+                let (x0, y0, x1, y1) = r.bbox;
+                (f64::from(x0), f64::from(y0), f64::from(x1), f64::from(y1))
+            })
+            .collect();
+        let scores: Vec<f32> = regions.iter().map(|r| r.confidence).collect();
 
-        // Calculate union
-        let area1 = (x1_max - x1_min) * (y1_max - y1_min);
-        let area2 = (x2_max - x2_min) * (y2_max - y2_min);
-        let union_area = area1 + area2 - inter_area;
+        let keep = non_max_suppression(&rects, &scores, f64::from(iou_threshold));
 
-        if union_area > 0.0 {
-            inter_area / union_area
-        } else {
-            0.0
-        }
+        Ok(keep.into_iter().map(|i| regions[i].clone()).collect())
     }
 
     /// Map class ID to LayoutLabel
     /// Based on docling's class definitions
     #[cfg(feature = "docling-ffi")]
-    fn class_id_to_label(&self, class_id: usize) -> Option<LayoutLabel> {
+    fn class_id_to_label(class_id: usize) -> Option<LayoutLabel> {
         match class_id {
             0 => Some(LayoutLabel::Text),
             1 => Some(LayoutLabel::Title),
@@ -412,4 +416,45 @@ mod tests {
         let _result = LayoutModel::new("models/layout_model.onnx");
         // Will fail if model doesn't exist, which is expected
     }
+
+    #[test]
+    fn test_post_process_borrowed_output() {
+        // [1, 12, 32, 32] output with a single 10x10 "Table" blob
+        let (classes, h, w) = (12usize, 32usize, 32usize);
+        let mut data = vec![0.0f32; classes * h * w];
+        for y in 4..14 {
+            for x in 6..16 {
+                data[8 * h * w + y * w + x] = 0.9;
+            }
+        }
+
+        let shape = [1, classes as i64, h as i64, w as i64];
+        let regions = LayoutModel::post_process_output_from_data(&shape, &data).unwrap();
+        assert_eq!(regions.len(), 1);
+        assert_eq!(regions[0].label, LayoutLabel::Table);
+        assert_eq!(regions[0].bbox, (6.0, 4.0, 15.0, 13.0));
+        assert!((regions[0].confidence - 0.9).abs() < 1e-6);
+    }
+
+    #[test]
+    fn test_labeler_merges_u_shape() {
+        // Two vertical bars joined at the bottom get provisional labels 1
+        // and 2 that must be merged into a single component
+        #[rustfmt::skip]
+        let plane = [
+            1.0, 0.0, 1.0,
+            1.0, 0.0, 1.0,
+            1.0, 1.0, 1.0,
+            0.0, 0.0, 0.0,
+            0.0, 0.8, 0.0,
+        ];
+        let components = ComponentLabeler::default().label_plane(&plane, 3, 5, 0.5);
+
+        assert_eq!(components.len(), 2);
+        let u = components[0];
+        assert_eq!((u.min_x, u.min_y, u.max_x, u.max_y), (0, 0, 2, 2));
+        assert_eq!(u.pixels, 7);
+        assert_eq!(components[1].pixels, 1);
+        assert!((components[1].mean_score() - 0.8).abs() < 1e-6);
+    }
 }
@@ -27,7 +27,7 @@ pub mod model_cache;
 pub mod cell_matching;
 
 #[cfg(feature = "docling-ffi")]
-pub use cell_matching::{CellMatcher, MatchedCell};
+pub use cell_matching::{CellMatcher, MatchedCellSpan, MatchedCells};
 #[cfg(feature = "docling-ffi")]
 pub use layout_model::LayoutModel;
 #[cfg(feature = "docling-ffi")]
@@ -2,11 +2,11 @@
 
 use std::path::Path;
 
-use ndarray::Array4;
+use ndarray::{Array4, ArrayViewD, IxDyn};
 #[cfg(feature = "docling-ffi")]
 use ort::{
     session::{Session, builder::SessionBuilder},
-    value::Tensor,
+    value::TensorRef,
 };
 
 /// Table structure recognition model using ONNX
@@ -89,45 +89,52 @@ impl TableStructureModel {
     }
 
     /// Run inference on table region
+    ///
+    /// Like `LayoutModel`, the input tensor is bound as a borrowed view and
+    /// the row/column/cell logits are post-processed in place from the ORT
+    /// output buffers instead of being copied out first.
     #[cfg(feature = "docling-ffi")]
     fn run_inference(&mut self, input: &Array4<f32>) -> Result<TableStructure> {
-        // Convert ndarray to ONNX tensor (ort v2 API)
-        // Extract shape and data as Vec for compatibility with OwnedTensorArrayData
-        let shape = input.shape().to_vec();
-        let data = input.iter().copied().collect::<Vec<f32>>();
-        let input_tensor = Tensor::from_array((shape, data))?;
+        let input = input.as_standard_layout();
+        let input_data = input.as_slice().ok_or_else(|| {
+            TransmutationError::engine_error(
+                "table-structure-model",
+                "Input tensor is not contiguous",
+            )
+        })?;
+        let input_tensor = TensorRef::from_array_view((input.shape().to_vec(), input_data))?;
 
         // Run inference (ort v2 requires mutable session)
-        // Extract outputs in a separate scope to end mutable borrow
-        let (row_data, row_shape, col_data, col_shape, cell_data, cell_shape) = {
-            let outputs = self.session.run(ort::inputs![input_tensor])?;
-            let (rs, rd) = outputs[0].try_extract_tensor::<f32>()?;
-            let (cs, cd) = outputs[1].try_extract_tensor::<f32>()?;
-            let (cells, celld) = outputs[2].try_extract_tensor::<f32>()?;
-            (
-                rd.to_vec(),
-                rs.to_vec(),
-                cd.to_vec(),
-                cs.to_vec(),
-                celld.to_vec(),
-                cells.to_vec(),
-            )
-        };
-
-        // Now process with immutable borrow
-        self.post_process_from_data(
-            &row_shape,
-            &row_data,
-            &col_shape,
-            &col_data,
-            &cell_shape,
-            &cell_data,
+        let outputs = self.session.run(ort::inputs![input_tensor])?;
+        let (row_shape, row_data) = outputs[0].try_extract_tensor::<f32>()?;
+        let (col_shape, col_data) = outputs[1].try_extract_tensor::<f32>()?;
+        let (cell_shape, cell_data) = outputs[2].try_extract_tensor::<f32>()?;
+
+        Self::post_process_from_data(
+            &row_shape[..],
+            row_data,
+            &col_shape[..],
+            col_data,
+            &cell_shape[..],
+            cell_data,
         )
     }
 
+    /// Borrow a flat ORT output buffer as a dynamically shaped ndarray view
+    #[cfg(feature = "docling-ffi")]
+    fn tensor_view<'a>(shape: &[i64], data: &'a [f32], name: &str) -> Result<ArrayViewD<'a, f32>> {
+        let dims = shape.iter().map(|&d| d as usize).collect::<Vec<_>>();
+        ArrayViewD::from_shape(IxDyn(&dims), data).map_err(|e| {
+            crate::TransmutationError::EngineError {
+                engine: "table-structure-model".to_string(),
+                message: format!("Failed to reshape {name} tensor: {e}"),
+                source: None,
+            }
+        })
+    }
+
     #[cfg(feature = "docling-ffi")]
     fn post_process_from_data(
-        &self,
         row_shape: &[i64],
         row_data: &[f32],
         col_shape: &[i64],
@@ -135,62 +142,16 @@ impl TableStructureModel {
         cell_shape: &[i64],
         cell_data: &[f32],
     ) -> Result<TableStructure> {
-        // Reconstruct ndarrays from shape and data
-        use ndarray::{ArrayD, IxDyn};
-        let row_logits_array = ArrayD::from_shape_vec(
-            IxDyn(
-                row_shape
-                    .iter()
-                    .map(|&d| d as usize)
-                    .collect::<Vec<_>>()
-                    .as_slice(),
-            ),
-            row_data.to_vec(),
-        )
-        .map_err(|e| crate::TransmutationError::EngineError {
-            engine: "table-structure-model".to_string(),
-            message: format!("Failed to reshape row tensor: {e}"),
-            source: None,
-        })?;
-
-        let col_logits_array = ArrayD::from_shape_vec(
-            IxDyn(
-                col_shape
-                    .iter()
-                    .map(|&d| d as usize)
-                    .collect::<Vec<_>>()
-                    .as_slice(),
-            ),
-            col_data.to_vec(),
-        )
-        .map_err(|e| crate::TransmutationError::EngineError {
-            engine: "table-structure-model".to_string(),
-            message: format!("Failed to reshape col tensor: {e}"),
-            source: None,
-        })?;
-
-        let cell_logits_array = ArrayD::from_shape_vec(
-            IxDyn(
-                cell_shape
-                    .iter()
-                    .map(|&d| d as usize)
-                    .collect::<Vec<_>>()
-                    .as_slice(),
-            ),
-            cell_data.to_vec(),
-        )
-        .map_err(|e| crate::TransmutationError::EngineError {
-            engine: "table-structure-model".to_string(),
-            message: format!("Failed to reshape cell tensor: {e}"),
-            source: None,
-        })?;
+        let row_logits = Self::tensor_view(row_shape, row_data, "row")?;
+        let col_logits = Self::tensor_view(col_shape, col_data, "col")?;
+        let cell_logits = Self::tensor_view(cell_shape, cell_data, "cell")?;
 
         // Parse row and column structure
-        let rows = self.parse_structure_logits(&row_logits_array.view())?;
-        let cols = self.parse_structure_logits(&col_logits_array.view())?;
+        let rows = Self::parse_structure_logits(&row_logits)?;
+        let cols = Self::parse_structure_logits(&col_logits)?;
 
         // Build cell grid
-        let cells = self.build_cell_grid(&rows, &cols, &cell_logits_array.view())?;
+        let cells = Self::build_cell_grid(&rows, &cols, &cell_logits)?;
 
         Ok(TableStructure {
             cells,
@@ -202,7 +163,6 @@ impl TableStructureModel {
     /// Parse structure logits to extract row/column positions
     #[cfg(feature = "docling-ffi")]
     fn parse_structure_logits(
-        &self,
         logits: &ndarray::ArrayView<f32, ndarray::Dim<ndarray::IxDynImpl>>,
     ) -> Result<Vec<f32>> {
         // logits shape: [batch, sequence_length]
@@ -238,7 +198,6 @@ impl TableStructureModel {
     /// Build cell grid from row and column structure
     #[cfg(feature = "docling-ffi")]
     fn build_cell_grid(
-        &self,
         rows: &[f32],
         cols: &[f32],
         cell_logits: &ndarray::ArrayView<f32, ndarray::Dim<ndarray::IxDynImpl>>,
@@ -263,7 +222,7 @@ impl TableStructureModel {
 
                 // Detect spans (simplified - could be enhanced with cell_logits)
                 let (row_span, col_span) =
-                    self.detect_cell_spans(row, col, num_rows, num_cols, cell_logits);
+                    Self::detect_cell_spans(row, col, num_rows, num_cols, cell_logits);
 
                 // Detect if this is a header cell (first row typically)
                 let is_header = row == 0;
@@ -285,7 +244,6 @@ impl TableStructureModel {
     /// Detect cell spans using cell logits
     #[cfg(feature = "docling-ffi")]
     fn detect_cell_spans(
-        &self,
         _row: usize,
         _col: usize,
         _num_rows: usize,
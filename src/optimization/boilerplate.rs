@@ -0,0 +1,354 @@
+//! Cross-page header/footer detection
+//!
+//! Running headers, footers and page numbers repeat at the top and bottom
+//! of most pages. Instead of guessing per page, the first and last few lines
+//! of every page are normalized (case, whitespace, digits masked so "Page 3"
+//! and "Page 14" match) and hashed, the hashes are counted across the whole
+//! document, and band lines that repeat on enough pages are dropped. Hashing
+//! and stripping run page-parallel; counting is a single pass, so the whole
+//! pass is linear in the number of lines.
+
+use std::collections::{HashMap, HashSet};
+use std::hash::{DefaultHasher, Hash, Hasher};
+
+use rayon::prelude::*;
+
+use crate::document::types_extended::Cluster;
+
+/// Lines longer than this are body text, never running headers
+const MAX_LINE_LEN: usize = 200;
+
+/// `(cluster, cell)` positions of the cells in one band row, plus its key
+type BandRow = (Vec<(usize, usize)>, u64);
+
+/// Detects lines repeated in the header/footer bands of many pages
+#[derive(Debug, Clone)]
+pub struct BoilerplateDetector {
+    band_lines: usize,
+    min_pages: usize,
+    min_ratio: f64,
+}
+
+/// Header or footer band of a page
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Hash)]
+enum Band {
+    Top,
+    Bottom,
+}
+
+impl BoilerplateDetector {
+    /// Create a detector looking at 3 lines per band, dropping lines found on
+    /// at least 3 pages and 40% of the pages (alternating even/odd headers
+    /// each cover about half of them)
+    pub fn new() -> Self {
+        Self {
+            band_lines: 3,
+            min_pages: 3,
+            min_ratio: 0.4,
+        }
+    }
+
+    /// Number of lines at the top and at the bottom of a page to consider
+    pub fn with_band_lines(mut self, lines: usize) -> Self {
+        self.band_lines = lines;
+        self
+    }
+
+    /// Minimum number of pages a line must repeat on
+    pub fn with_min_pages(mut self, pages: usize) -> Self {
+        self.min_pages = pages.max(2);
+        self
+    }
+
+    /// Minimum fraction of the pages a line must repeat on
+    pub fn with_min_ratio(mut self, ratio: f64) -> Self {
+        self.min_ratio = ratio.clamp(0.0, 1.0);
+        self
+    }
+
+    /// Remove repeated header/footer lines from plain-text pages
+    ///
+    /// Everything except the removed lines is kept byte for byte. Returns
+    /// the number of lines removed.
+    pub fn strip_pages(&self, pages: &mut [String]) -> usize {
+        if pages.len() < self.min_pages {
+            return 0;
+        }
+
+        let keys: Vec<Vec<(usize, u64)>> = pages
+            .par_iter()
+            .map(|page| {
+                let lines: Vec<&str> = page.split_inclusive('\n').collect();
+                let non_blank: Vec<usize> = (0..lines.len())
+                    .filter(|&i| !lines[i].trim().is_empty())
+                    .collect();
+                self.band_keys(non_blank.len(), |n, band| {
+                    let idx = non_blank[n];
+                    line_key(band, lines[idx]).map(|key| (idx, key))
+                })
+            })
+            .collect();
+
+        let repeated = self.repeated_keys(keys.iter().map(|page| page.iter().map(|&(_, key)| key)));
+        if repeated.is_empty() {
+            return 0;
+        }
+
+        pages
+            .par_iter_mut()
+            .zip(&keys)
+            .map(|(page, keys)| {
+                let drop: HashSet<usize> = keys
+                    .iter()
+                    .filter(|(_, key)| repeated.contains(key))
+                    .map(|&(idx, _)| idx)
+                    .collect();
+                if !drop.is_empty() {
+                    *page = page
+                        .split_inclusive('\n')
+                        .enumerate()
+                        .filter(|(idx, _)| !drop.contains(idx))
+                        .map(|(_, line)| line)
+                        .collect();
+                }
+                drop.len()
+            })
+            .sum()
+    }
+
+    /// Remove repeated header/footer rows from per-page layout clusters
+    ///
+    /// Cells are grouped into rows by their vertical position; a row's text
+    /// is its cells from left to right. Cells of repeated rows are taken out
+    /// of their clusters and clusters left without cells are dropped.
+    /// Returns the number of cells removed.
+    pub fn strip_clusters(&self, pages: &mut [Vec<Cluster>]) -> usize {
+        if pages.len() < self.min_pages {
+            return 0;
+        }
+
+        let rows: Vec<Vec<BandRow>> = pages
+            .par_iter()
+            .map(|clusters| {
+                let mut cells: Vec<(i64, f64, usize, usize)> =
+                    clusters
+                        .iter()
+                        .enumerate()
+                        .flat_map(|(ci, cluster)| {
+                            cluster.cells.iter().enumerate().map(move |(i, cell)| {
+                                (cell.bbox.t.round() as i64, cell.bbox.l, ci, i)
+                            })
+                        })
+                        .collect();
+                cells.sort_by(|a, b| a.0.cmp(&b.0).then(a.1.total_cmp(&b.1)));
+
+                let page_rows: Vec<&[(i64, f64, usize, usize)]> =
+                    cells.chunk_by(|a, b| a.0 == b.0).collect();
+                self.band_keys(page_rows.len(), |n, band| {
+                    let row = page_rows[n];
+                    let text = row
+                        .iter()
+                        .map(|&(_, _, ci, i)| clusters[ci].cells[i].text.as_str())
+                        .collect::<Vec<_>>()
+                        .join(" ");
+                    let cells = row.iter().map(|&(_, _, ci, i)| (ci, i)).collect();
+                    line_key(band, &text).map(|key| (cells, key))
+                })
+            })
+            .collect();
+
+        let repeated = self.repeated_keys(rows.iter().map(|page| page.iter().map(|(_, key)| *key)));
+        if repeated.is_empty() {
+            return 0;
+        }
+
+        pages
+            .par_iter_mut()
+            .zip(&rows)
+            .map(|(clusters, rows)| {
+                let drop: HashSet<(usize, usize)> = rows
+                    .iter()
+                    .filter(|(_, key)| repeated.contains(key))
+                    .flat_map(|(cells, _)| cells.iter().copied())
+                    .collect();
+                if !drop.is_empty() {
+                    for (ci, cluster) in clusters.iter_mut().enumerate() {
+                        let mut i = 0;
+                        cluster.cells.retain(|_| {
+                            i += 1;
+                            !drop.contains(&(ci, i - 1))
+                        });
+                    }
+                    clusters.retain(|cluster| !cluster.cells.is_empty());
+                }
+                drop.len()
+            })
+            .sum()
+    }
+
+    /// Keys of the top and bottom band entries of one page with `len`
+    /// entries; `key(n, band)` hashes the `n`-th entry. Pages shorter than
+    /// both bands together are split between them.
+    fn band_keys<T>(&self, len: usize, mut key: impl FnMut(usize, Band) -> Option<T>) -> Vec<T> {
+        let top = self.band_lines.min(len);
+        let bottom = self.band_lines.min(len - top);
+
+        let mut keys = Vec::with_capacity(top + bottom);
+        keys.extend((0..top).filter_map(|n| key(n, Band::Top)));
+        keys.extend((len - bottom..len).filter_map(|n| key(n, Band::Bottom)));
+        keys
+    }
+
+    /// Keys found on enough pages to count as boilerplate
+    fn repeated_keys<P>(&self, pages: impl Iterator<Item = P>) -> HashSet<u64>
+    where
+        P: Iterator<Item = u64>,
+    {
+        let mut counts: HashMap<u64, usize> = HashMap::new();
+        let mut page_count = 0;
+        for page in pages {
+            page_count += 1;
+            let mut seen: Vec<u64> = page.collect();
+            seen.sort_unstable();
+            seen.dedup();
+            for key in seen {
+                *counts.entry(key).or_insert(0) += 1;
+            }
+        }
+
+        let min_pages = self
+            .min_pages
+            .max((self.min_ratio * page_count as f64).ceil() as usize);
+        counts
+            .into_iter()
+            .filter(|&(_, count)| count >= min_pages)
+            .map(|(key, _)| key)
+            .collect()
+    }
+}
+
+impl Default for BoilerplateDetector {
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
+/// Hash of a band line, normalized so that lines differing only in case,
+/// spacing or numbers match; `None` for blank or overlong lines
+fn line_key(band: Band, line: &str) -> Option<u64> {
+    let line = line.trim();
+    if line.is_empty() || line.len() > MAX_LINE_LEN {
+        return None;
+    }
+
+    let mut hasher = DefaultHasher::new();
+    band.hash(&mut hasher);
+    let mut prev = ' ';
+    for c in line.chars() {
+        let c = if c.is_whitespace() {
+            ' '
+        } else if c.is_ascii_digit() {
+            '#'
+        } else {
+            c
+        };
+        // Whitespace and digit runs count once
+        if (c == ' ' || c == '#') && c == prev {
+            continue;
+        }
+        prev = c;
+        for lower in c.to_lowercase() {
+            hasher.write_u32(lower as u32);
+        }
+    }
+    Some(hasher.finish())
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::document::types::DocItemLabel;
+    use crate::document::types_extended::{BoundingBox, CoordOrigin, TextCell};
+
+    fn report_pages(count: usize) -> Vec<String> {
+        (1..=count)
+            .map(|n| {
+                format!(
+                    "ACME Corp  Annual Report\n\nBody text about {topic}.\nMore on {topic}.\n\nPage {n} of {count}\n",
+                    topic = char::from(b'a' + n as u8)
+                )
+            })
+            .collect()
+    }
+
+    #[test]
+    fn test_strip_pages_removes_running_lines() {
+        let mut pages = report_pages(12);
+        let removed = BoilerplateDetector::new().strip_pages(&mut pages);
+
+        assert_eq!(removed, 24);
+        assert_eq!(pages[4], "\nBody text about f.\nMore on f.\n\n");
+    }
+
+    #[test]
+    fn test_strip_pages_keeps_unique_and_short_documents() {
+        let mut pages: Vec<String> = (0..6).map(|n| format!("Chapter {n}\nText\n")).collect();
+        pages[0] = "Preface\nIntro\n".to_string();
+        // "Chapter #" and "Text" repeat on 5 of 6 pages
+        assert_eq!(BoilerplateDetector::new().strip_pages(&mut pages), 10);
+        assert_eq!(pages[0], "Preface\nIntro\n");
+
+        let mut pages = report_pages(2);
+        assert_eq!(BoilerplateDetector::new().strip_pages(&mut pages), 0);
+    }
+
+    #[test]
+    fn test_strip_clusters_removes_header_rows() {
+        let cell = |text: &str, l: f64, t: f64| TextCell {
+            index: 0,
+            text: text.to_string(),
+            bbox: BoundingBox::new(l, t, l + 50.0, t + 10.0, CoordOrigin::TopLeft),
+            font_name: None,
+            font_size: None,
+            confidence: 1.0,
+            from_ocr: false,
+        };
+        let mut pages: Vec<Vec<Cluster>> = (0..4)
+            .map(|n| {
+                vec![
+                    Cluster {
+                        id: 0,
+                        label: DocItemLabel::PageHeader,
+                        bbox: BoundingBox::new(0.0, 0.0, 200.0, 10.0, CoordOrigin::TopLeft),
+                        cells: vec![cell("Report", 0.0, 10.0), cell("2024", 60.0, 10.2)],
+                        confidence: 1.0,
+                    },
+                    Cluster {
+                        id: 1,
+                        label: DocItemLabel::Paragraph,
+                        bbox: BoundingBox::new(0.0, 100.0, 200.0, 110.0, CoordOrigin::TopLeft),
+                        cells: vec![cell(&format!("Unique body {}", "x".repeat(n)), 0.0, 100.0)],
+                        confidence: 1.0,
+                    },
+                ]
+            })
+            .collect();
+
+        assert_eq!(BoilerplateDetector::new().strip_clusters(&mut pages), 8);
+        assert!(pages.iter().all(|page| page.len() == 1));
+        assert_eq!(pages[2][0].cells[0].text, "Unique body xx");
+    }
+
+    #[test]
+    fn test_line_key_masks_digits_and_spacing() {
+        assert_eq!(
+            line_key(Band::Bottom, "Page 3 of 120"),
+            line_key(Band::Bottom, "  page  17 of 9 ")
+        );
+        assert_ne!(
+            line_key(Band::Top, "Page 3"),
+            line_key(Band::Bottom, "Page 3")
+        );
+        assert_eq!(line_key(Band::Top, "   "), None);
+    }
+}
@@ -1,5 +1,6 @@
 //! Output optimization strategies
 
+pub mod boilerplate;
 pub mod text;
 
 // TODO: Implement other optimizations
@@ -7,4 +8,5 @@ pub mod text;
 // pub mod quality;
 // pub mod llm;
 
+pub use boilerplate::BoilerplateDetector;
 pub use text::TextOptimizer;
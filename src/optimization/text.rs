@@ -7,6 +7,8 @@
 
 use regex::Regex;
 
+use crate::utils::whitespace;
+
 /// Text optimizer for cleaning and normalizing extracted text
 #[derive(Debug)]
 pub struct TextOptimizer {
@@ -77,20 +79,14 @@ impl TextOptimizer {
 
     /// Normalize whitespace
     fn normalize_whitespace_impl(&self, text: &str) -> String {
-        let mut result = text.to_string();
-
         // Replace multiple spaces with single space (but not at line start)
-        let re = Regex::new(r"([^\n]) {2,}").unwrap();
-        result = re.replace_all(&result, "$1 ").to_string();
+        let result = whitespace::collapse_inner_space_runs(text);
 
         // Replace tabs with spaces
-        result = result.replace('\t', "    ");
+        let result = whitespace::expand_tabs(&result);
 
         // Normalize line endings
-        result = result.replace("\r\n", "\n");
-        result = result.replace('\r', "\n");
-
-        result
+        whitespace::normalize_line_endings(&result).into_owned()
     }
 
     /// Remove headers and footers (heuristic)
@@ -178,13 +174,12 @@ impl Default for TextOptimizer {
 
 /// Remove excessive whitespace from text
 pub fn remove_excessive_whitespace(text: &str) -> String {
-    let re = Regex::new(r"\s{3,}").unwrap();
-    re.replace_all(text, "  ").to_string()
+    whitespace::replace_whitespace_runs(text, 3, "  ").into_owned()
 }
 
 /// Normalize line breaks
 pub fn normalize_line_breaks(text: &str) -> String {
-    text.replace("\r\n", "\n").replace('\r', "\n")
+    whitespace::normalize_line_endings(text).into_owned()
 }
 
 /// Remove page numbers
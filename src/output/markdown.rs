@@ -2,8 +2,11 @@
 //!
 //! This module converts extracted text to clean, LLM-optimized Markdown format.
 
+use std::borrow::Cow;
+
 use crate::engines::layout_analyzer::{AnalyzedBlock, BlockType};
 use crate::types::ConversionOptions;
+use crate::utils::whitespace;
 
 /// Markdown generator
 #[derive(Debug)]
@@ -264,30 +267,28 @@ impl MarkdownGenerator {
         }
 
         // Remove excessive newlines (more than 2 consecutive)
-        let re = regex::Regex::new(r"\n{3,}").unwrap();
-        self.buffer = re.replace_all(&self.buffer, "\n\n").to_string();
+        whitespace::collapse_blank_lines(&mut self.buffer);
 
         // Trim trailing whitespace from each line
-        self.buffer = self
-            .buffer
-            .lines()
-            .map(|line| line.trim_end())
-            .collect::<Vec<_>>()
-            .join("\n");
+        self.buffer = whitespace::trim_line_ends(&self.buffer);
 
         // Ensure document ends with single newline
-        self.buffer = self.buffer.trim_end().to_string();
+        let end = self.buffer.trim_end().len();
+        self.buffer.truncate(end);
         self.buffer.push('\n');
     }
 
     /// Normalize whitespace
     fn normalize_whitespace(&mut self) {
         // Replace multiple spaces with single space
-        let re = regex::Regex::new(r" {2,}").unwrap();
-        self.buffer = re.replace_all(&self.buffer, " ").to_string();
+        if let Cow::Owned(collapsed) = whitespace::collapse_space_runs(&self.buffer) {
+            self.buffer = collapsed;
+        }
 
         // Replace tabs with spaces
-        self.buffer = self.buffer.replace('\t', "    ");
+        if let Cow::Owned(expanded) = whitespace::expand_tabs(&self.buffer) {
+            self.buffer = expanded;
+        }
     }
 
     /// Get the generated Markdown
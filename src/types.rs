@@ -218,7 +218,11 @@ pub enum ImageQuality {
 }
 
 /// Conversion options
+///
+/// Fields missing when deserializing take their default values, so options
+/// saved by an older release still load.
 #[derive(Debug, Clone, Serialize, Deserialize)]
+#[serde(default)]
 pub struct ConversionOptions {
     // Output control
     /// Split output by pages
@@ -265,6 +269,65 @@ pub struct ConversionOptions {
     /// Use docling-parse C++ FFI for maximum precision (95%+ similarity)
     /// Requires compilation with --features docling-ffi
     pub use_ffi: bool,
+
+    // Incremental conversion
+    /// Directory of per-page outputs reused across conversions of revised
+    /// documents (PDF to Markdown with `split_pages`). Pages whose content
+    /// fingerprint is unchanged are read from here instead of reconverted.
+    pub page_cache_dir: Option<PathBuf>,
+
+    // JSON output
+    /// Embed the raw source document in JSON output (HTML). Disable to
+    /// stream the conversion without holding the input in memory.
+    pub embed_source: bool,
+
+    // XML filtering
+    /// Element paths whose subtrees XML conversion skips without reading
+    /// them into memory: `/root/a` from the root, `a/b` at any depth, `*`
+    /// for any one element
+    pub xml_skip_paths: Vec<String>,
+    /// Element paths XML conversion is limited to (same syntax); empty
+    /// converts the whole document
+    pub xml_select_paths: Vec<String>,
+
+    // Archive members
+    /// Convert the documents inside archives (in memory, in parallel)
+    /// instead of listing them; nested archives are converted recursively
+    pub convert_archive_members: bool,
+    /// Count, size and nesting limits for archive member conversion
+    pub archive_limits: ArchiveLimits,
+}
+
+/// Limits applied when converting the members of an archive
+///
+/// Members are decompressed into memory, so these bound both the work and
+/// the memory one archive can cause (decompression bombs included).
+#[derive(Debug, Clone, Serialize, Deserialize)]
+#[serde(default)]
+pub struct ArchiveLimits {
+    /// Maximum number of members converted
+    pub max_members: usize,
+    /// Members larger than this (uncompressed) are skipped
+    pub max_member_bytes: u64,
+    /// Maximum uncompressed bytes read from the archive, nested archives
+    /// included
+    pub max_total_bytes: u64,
+    /// How many levels of archives inside archives are opened
+    pub max_depth: usize,
+    /// Members converted at the same time
+    pub max_parallel: usize,
+}
+
+impl Default for ArchiveLimits {
+    fn default() -> Self {
+        Self {
+            max_members: 10_000,
+            max_member_bytes: 256 * 1024 * 1024,
+            max_total_bytes: 2 * 1024 * 1024 * 1024,
+            max_depth: 3,
+            max_parallel: num_cpus::get(),
+        }
+    }
 }
 
 impl Default for ConversionOptions {
@@ -286,6 +349,12 @@ impl Default for ConversionOptions {
             normalize_whitespace: true,
             use_precision_mode: false, // Fast mode by default (pure Rust, 250x faster)
             use_ffi: false,            // C++ FFI disabled by default
+            page_cache_dir: None,
+            embed_source: true,
+            xml_skip_paths: Vec::new(),
+            xml_select_paths: Vec::new(),
+            convert_archive_members: false,
+            archive_limits: ArchiveLimits::default(),
         }
     }
 }
@@ -308,6 +377,44 @@ pub struct ConversionResult {
 }
 
 impl ConversionResult {
+    /// Result with a single output holding the whole converted document
+    pub(crate) fn single(
+        input_path: PathBuf,
+        input_format: FileFormat,
+        output_format: OutputFormat,
+        data: Vec<u8>,
+        input_size: u64,
+    ) -> Self {
+        let output_size = data.len() as u64;
+        Self {
+            input_path,
+            input_format,
+            output_format,
+            content: vec![ConversionOutput {
+                page_number: 1,
+                data,
+                metadata: OutputMetadata {
+                    size_bytes: output_size,
+                    chunk_count: 1,
+                    token_count: None,
+                },
+            }],
+            metadata: DocumentMetadata {
+                page_count: 1,
+                ..Default::default()
+            },
+            statistics: ConversionStatistics {
+                input_size_bytes: input_size,
+                output_size_bytes: output_size,
+                duration: Duration::from_secs(0),
+                pages_processed: 1,
+                tables_extracted: 0,
+                images_extracted: 0,
+                cache_hit: false,
+            },
+        }
+    }
+
     /// Get the number of pages/items converted
     pub fn page_count(&self) -> usize {
         self.content.len()
@@ -490,6 +597,38 @@ mod tests {
         assert_eq!(opts.dpi, 150);
     }
 
+    #[test]
+    fn test_conversion_options_missing_fields_default() {
+        // Options as serialized before page caching, JSON embedding, XML
+        // filtering and archive member conversion existed
+        let mut json = serde_json::to_value(ConversionOptions::default()).unwrap();
+        let fields = json.as_object_mut().unwrap();
+        for field in [
+            "page_cache_dir",
+            "embed_source",
+            "xml_skip_paths",
+            "xml_select_paths",
+            "convert_archive_members",
+            "archive_limits",
+        ] {
+            assert!(fields.remove(field).is_some(), "{field}");
+        }
+        fields.insert("dpi".to_string(), 300.into());
+
+        let opts: ConversionOptions = serde_json::from_value(json).unwrap();
+        assert_eq!(opts.dpi, 300);
+        assert!(opts.page_cache_dir.is_none());
+        assert!(opts.embed_source);
+        assert!(opts.xml_skip_paths.is_empty() && opts.xml_select_paths.is_empty());
+        assert!(!opts.convert_archive_members);
+        assert_eq!(opts.archive_limits.max_depth, 3);
+
+        // Partial limits keep the other defaults
+        let limits: ArchiveLimits = serde_json::from_str(r#"{"max_members": 5}"#).unwrap();
+        assert_eq!(limits.max_members, 5);
+        assert_eq!(limits.max_depth, 3);
+    }
+
     #[test]
     fn test_output_format() {
         let md = OutputFormat::Markdown {
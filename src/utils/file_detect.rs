@@ -1,11 +1,25 @@
 //! File type detection utilities
 
+use std::io::{Cursor, Read, Seek};
 use std::path::Path;
 
+use tokio::io::AsyncReadExt;
+
 use crate::types::FileFormat;
 use crate::{Result, TransmutationError};
 
+/// Bytes read from the start of a file for magic byte detection
+///
+/// Every signature we map lives well inside this window (TAR's is at 257,
+/// ISO-BMFF `ftyp` boxes at 4), so inputs are never read in full to be
+/// identified.
+const SNIFF_BYTES: u64 = 8 * 1024;
+
 /// Detect file format from path
+///
+/// Only a bounded prefix of the file is read, plus the ZIP central directory
+/// for ZIP-based formats. Detect once and pass the result on, e.g. through
+/// [`DocumentConverter::convert_detected`](crate::converters::DocumentConverter::convert_detected).
 pub async fn detect_format<P: AsRef<Path>>(path: P) -> Result<FileFormat> {
     let path = path.as_ref();
 
@@ -18,30 +32,51 @@ pub async fn detect_format<P: AsRef<Path>>(path: P) -> Result<FileFormat> {
     detect_by_extension(path)
 }
 
+/// Detect the format of a document held in memory, such as an archive member
+///
+/// Same rules as [`detect_format`]: magic bytes first, then the extension of
+/// `name`.
+pub fn detect_format_from_bytes(name: &str, data: &[u8]) -> Result<FileFormat> {
+    let prefix = &data[..data.len().min(SNIFF_BYTES as usize)];
+    match format_from_magic_bytes(prefix) {
+        Ok(FileFormat::Zip) => office_format_from_zip(Cursor::new(data)),
+        Ok(format) => Ok(format),
+        Err(_) => detect_by_extension(Path::new(name)),
+    }
+}
+
 /// Detect if a ZIP file is actually an Office document (DOCX/PPTX/XLSX)
+///
+/// Only the central directory is read: `ZipArchive::new` seeks to it from
+/// the end of the file and the marker lookups never touch member data.
 async fn detect_office_format_from_zip(path: &Path) -> Result<FileFormat> {
-    use std::fs::File;
-    use std::io::BufReader;
+    let path = path.to_path_buf();
+
+    tokio::task::spawn_blocking(move || {
+        let file = std::fs::File::open(&path)?;
+        office_format_from_zip(std::io::BufReader::new(file))
+    })
+    .await
+    .map_err(|e| TransmutationError::conversion_failed(e.to_string()))?
+}
 
+fn office_format_from_zip<R: Read + Seek>(reader: R) -> Result<FileFormat> {
     use zip::ZipArchive;
 
     // Open ZIP and check for Office-specific files
-    let file = File::open(path)?;
-    let reader = BufReader::new(file);
-
-    if let Ok(mut archive) = ZipArchive::new(reader) {
+    if let Ok(archive) = ZipArchive::new(reader) {
         // Check for Word document marker
-        if archive.by_name("word/document.xml").is_ok() {
+        if archive.index_for_name("word/document.xml").is_some() {
             return Ok(FileFormat::Docx);
         }
 
         // Check for PowerPoint marker
-        if archive.by_name("ppt/presentation.xml").is_ok() {
+        if archive.index_for_name("ppt/presentation.xml").is_some() {
             return Ok(FileFormat::Pptx);
         }
 
         // Check for Excel marker
-        if archive.by_name("xl/workbook.xml").is_ok() {
+        if archive.index_for_name("xl/workbook.xml").is_some() {
             return Ok(FileFormat::Xlsx);
         }
     }
@@ -50,12 +85,30 @@ async fn detect_office_format_from_zip(path: &Path) -> Result<FileFormat> {
     Ok(FileFormat::Zip)
 }
 
+/// First [`SNIFF_BYTES`] bytes of a file (all of it if shorter)
+async fn read_prefix(path: &Path) -> Result<Vec<u8>> {
+    let file = tokio::fs::File::open(path).await?;
+    let mut prefix = Vec::with_capacity(SNIFF_BYTES as usize);
+    file.take(SNIFF_BYTES).read_to_end(&mut prefix).await?;
+    Ok(prefix)
+}
+
 /// Detect format by reading magic bytes
 async fn detect_by_magic_bytes(path: &Path) -> Result<FileFormat> {
+    let data = read_prefix(path).await?;
+    match format_from_magic_bytes(&data)? {
+        // DOCX/PPTX/XLSX are ZIP files - need to inspect content
+        FileFormat::Zip => detect_office_format_from_zip(path).await,
+        format => Ok(format),
+    }
+}
+
+/// Format named by the magic bytes at the start of a file; Office
+/// documents without their own signature come back as [`FileFormat::Zip`]
+fn format_from_magic_bytes(data: &[u8]) -> Result<FileFormat> {
     use file_format::FileFormat as FFFormat;
 
-    let data = tokio::fs::read(path).await?;
-    let ff_format = FFFormat::from_bytes(&data);
+    let ff_format = FFFormat::from_bytes(data);
 
     let format = match ff_format.media_type() {
         "application/pdf" => FileFormat::Pdf,
@@ -66,10 +119,7 @@ async fn detect_by_magic_bytes(path: &Path) -> Result<FileFormat> {
             FileFormat::Pptx
         }
         "application/vnd.openxmlformats-officedocument.spreadsheetml.sheet" => FileFormat::Xlsx,
-        // DOCX/PPTX/XLSX are ZIP files - need to inspect content
-        "application/zip" => {
-            return detect_office_format_from_zip(path).await;
-        }
+        "application/zip" => FileFormat::Zip,
         "text/html" => FileFormat::Html,
         "text/xml" | "application/xml" => FileFormat::Xml,
         "text/plain" => FileFormat::Txt,
@@ -218,4 +268,43 @@ mod tests {
         let result = detect_by_extension(&path);
         assert!(result.is_err());
     }
+
+    #[tokio::test]
+    async fn test_read_prefix_is_bounded() {
+        let dir = tempfile::tempdir().unwrap();
+        let path = dir.path().join("large.pdf");
+        let mut data = b"%PDF-1.7\n".to_vec();
+        data.resize(3 * SNIFF_BYTES as usize, b' ');
+        std::fs::write(&path, &data).unwrap();
+
+        assert_eq!(
+            read_prefix(&path).await.unwrap().len(),
+            SNIFF_BYTES as usize
+        );
+        assert_eq!(detect_format(&path).await.unwrap(), FileFormat::Pdf);
+    }
+
+    #[test]
+    fn test_detect_format_from_bytes() {
+        use std::io::Write;
+
+        let mut zip = zip::ZipWriter::new(Cursor::new(Vec::new()));
+        zip.start_file(
+            "word/document.xml",
+            zip::write::SimpleFileOptions::default(),
+        )
+        .unwrap();
+        zip.write_all(b"<w:document/>").unwrap();
+        let docx = zip.finish().unwrap().into_inner();
+
+        assert_eq!(
+            detect_format_from_bytes("member", &docx).unwrap(),
+            FileFormat::Docx
+        );
+        assert_eq!(
+            detect_format_from_bytes("doc.pdf", b"%PDF-1.7\n").unwrap(),
+            FileFormat::Pdf
+        );
+        assert!(detect_format_from_bytes("data.xyz", &[0, 1, 2, 3]).is_err());
+    }
 }
@@ -1,6 +1,7 @@
 //! Utility functions
 
 pub mod file_detect;
+pub mod whitespace;
 
 // TODO: Implement utilities
 // pub mod metadata;
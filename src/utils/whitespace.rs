@@ -0,0 +1,282 @@
+//! Linear-time whitespace and newline normalization
+//!
+//! Converters used to collapse blank lines with
+//! `while s.contains("\n\n\n") { s = s.replace(..) }`, which rescans and
+//! reallocates the whole text once per pass and goes quadratic on long runs of
+//! empty lines. Every helper here makes a single memchr-driven pass, returns
+//! the input borrowed when there is nothing to change, and works in place on
+//! owned `String`s where it can.
+
+use std::borrow::Cow;
+
+use memchr::{memchr, memchr_iter, memmem};
+
+/// Collapse every run of three or more newlines to a blank line, in place
+///
+/// Same result as repeating `replace("\n\n\n", "\n\n")` until no triple is left.
+pub fn collapse_blank_lines(text: &mut String) {
+    let Some(first) = memmem::find(text.as_bytes(), b"\n\n\n") else {
+        return;
+    };
+
+    let mut bytes = std::mem::take(text).into_bytes();
+    let finder = memmem::Finder::new(b"\n\n\n");
+    let mut write = first + 2;
+    let mut read = first + 2;
+
+    loop {
+        // Drop the rest of the current run
+        while bytes.get(read) == Some(&b'\n') {
+            read += 1;
+        }
+
+        // Move everything up to and including the next run's first two newlines
+        let end = finder
+            .find(&bytes[read..])
+            .map_or(bytes.len(), |i| read + i + 2);
+        bytes.copy_within(read..end, write);
+        write += end - read;
+        read = end;
+
+        if read == bytes.len() {
+            break;
+        }
+    }
+
+    bytes.truncate(write);
+    *text = String::from_utf8(bytes).expect("only ASCII newlines were removed");
+}
+
+/// Trim leading and trailing whitespace without reallocating
+pub fn trim_in_place(text: &mut String) {
+    let end = text.trim_end().len();
+    text.truncate(end);
+    let start = text.len() - text.trim_start().len();
+    text.drain(..start);
+}
+
+/// Replace every run of two or more spaces with one space (`/ {2,}/ -> " "`)
+pub fn collapse_space_runs(text: &str) -> Cow<'_, str> {
+    collapse_spaces(text, |_| 1)
+}
+
+/// Collapse space runs inside lines, keeping up to two spaces of indentation
+///
+/// A run of two or more spaces after another character becomes one space;
+/// at the start of a line it becomes two. Same result as replacing
+/// `/([^\n]) {2,}/` with `"$1 "`.
+pub fn collapse_inner_space_runs(text: &str) -> Cow<'_, str> {
+    collapse_spaces(text, |before| match before {
+        Some(b) if b != b'\n' => 1,
+        _ => 2,
+    })
+}
+
+/// Shared space-run pass; `keep` gets the byte before the run
+fn collapse_spaces(text: &str, keep: impl Fn(Option<u8>) -> usize) -> Cow<'_, str> {
+    let bytes = text.as_bytes();
+    let finder = memmem::Finder::new(b"  ");
+    let Some(first) = finder.find(bytes) else {
+        return Cow::Borrowed(text);
+    };
+
+    let mut out = String::with_capacity(text.len());
+    let mut pos = 0;
+    let mut start = first;
+    loop {
+        let mut end = start + 2;
+        while bytes.get(end) == Some(&b' ') {
+            end += 1;
+        }
+
+        let kept = keep(start.checked_sub(1).map(|i| bytes[i])).min(end - start);
+        out.push_str(&text[pos..start + kept]);
+        pos = end;
+
+        match finder.find(&bytes[pos..]) {
+            Some(i) => start = pos + i,
+            None => break,
+        }
+    }
+    out.push_str(&text[pos..]);
+
+    Cow::Owned(out)
+}
+
+/// Replace every run of at least `min_run` whitespace characters with
+/// `replacement` (`/\s{min_run,}/`, Unicode whitespace)
+pub fn replace_whitespace_runs<'a>(
+    text: &'a str,
+    min_run: usize,
+    replacement: &str,
+) -> Cow<'a, str> {
+    let mut out: Option<String> = None;
+    let mut pos = 0;
+    let mut chars = text.char_indices().peekable();
+
+    while let Some((start, c)) = chars.next() {
+        if !c.is_whitespace() {
+            continue;
+        }
+
+        let mut end = start + c.len_utf8();
+        let mut run = 1;
+        while let Some(&(i, next)) = chars.peek() {
+            if !next.is_whitespace() {
+                break;
+            }
+            end = i + next.len_utf8();
+            run += 1;
+            chars.next();
+        }
+
+        if run >= min_run {
+            let out = out.get_or_insert_with(|| String::with_capacity(text.len()));
+            out.push_str(&text[pos..start]);
+            out.push_str(replacement);
+            pos = end;
+        }
+    }
+
+    match out {
+        Some(mut out) => {
+            out.push_str(&text[pos..]);
+            Cow::Owned(out)
+        }
+        None => Cow::Borrowed(text),
+    }
+}
+
+/// Turn `\r\n` and lone `\r` line endings into `\n`
+pub fn normalize_line_endings(text: &str) -> Cow<'_, str> {
+    let bytes = text.as_bytes();
+    if memchr(b'\r', bytes).is_none() {
+        return Cow::Borrowed(text);
+    }
+
+    let mut out = String::with_capacity(text.len());
+    let mut pos = 0;
+    for cr in memchr_iter(b'\r', bytes) {
+        if cr < pos {
+            continue;
+        }
+        out.push_str(&text[pos..cr]);
+        out.push('\n');
+        pos = if bytes.get(cr + 1) == Some(&b'\n') {
+            cr + 2
+        } else {
+            cr + 1
+        };
+    }
+    out.push_str(&text[pos..]);
+
+    Cow::Owned(out)
+}
+
+/// Replace each tab with four spaces
+pub fn expand_tabs(text: &str) -> Cow<'_, str> {
+    if memchr(b'\t', text.as_bytes()).is_none() {
+        Cow::Borrowed(text)
+    } else {
+        Cow::Owned(text.replace('\t', "    "))
+    }
+}
+
+/// Strip trailing whitespace from every line
+pub fn trim_line_ends(text: &str) -> String {
+    let mut out = String::with_capacity(text.len());
+    let mut start = 0;
+    for nl in memchr_iter(b'\n', text.as_bytes()) {
+        out.push_str(text[start..nl].trim_end());
+        out.push('\n');
+        start = nl + 1;
+    }
+    out.push_str(text[start..].trim_end());
+    out
+}
+
+#[cfg(test)]
+mod tests {
+    use regex::Regex;
+
+    use super::*;
+
+    const SAMPLES: &[&str] = &[
+        "",
+        "plain",
+        "a\n\nb",
+        "a\n\n\nb",
+        "\n\n\n\n\n\n\nx\n\n\n\n",
+        "a\n\n\n\n\nb\n\n\nc\nd\n\n",
+        "  lead   mid  \n   next\n  two\ta  \t  b   ",
+        "\r\n\r\rx\r\n\n\r",
+        "é\u{a0}\u{a0}\u{a0}ü \u{2003}\n\n\t  end",
+    ];
+
+    #[test]
+    fn test_collapse_blank_lines_matches_replace_loop() {
+        for sample in SAMPLES {
+            let mut expected = sample.to_string();
+            while expected.contains("\n\n\n") {
+                expected = expected.replace("\n\n\n", "\n\n");
+            }
+
+            let mut text = sample.to_string();
+            collapse_blank_lines(&mut text);
+            assert_eq!(text, expected, "{sample:?}");
+        }
+    }
+
+    #[test]
+    fn test_space_runs_match_regex() {
+        let spaces = Regex::new(r" {2,}").unwrap();
+        let inner = Regex::new(r"([^\n]) {2,}").unwrap();
+        let whitespace = Regex::new(r"\s{3,}").unwrap();
+
+        for sample in SAMPLES {
+            assert_eq!(collapse_space_runs(sample), spaces.replace_all(sample, " "));
+            assert_eq!(
+                collapse_inner_space_runs(sample),
+                inner.replace_all(sample, "$1 ")
+            );
+            assert_eq!(
+                replace_whitespace_runs(sample, 3, "  "),
+                whitespace.replace_all(sample, "  ")
+            );
+        }
+    }
+
+    #[test]
+    fn test_line_helpers() {
+        for sample in SAMPLES {
+            assert_eq!(
+                normalize_line_endings(sample),
+                sample.replace("\r\n", "\n").replace('\r', "\n")
+            );
+            assert_eq!(expand_tabs(sample), sample.replace('\t', "    "));
+            assert_eq!(
+                trim_line_ends(sample).trim_end(),
+                sample
+                    .lines()
+                    .map(str::trim_end)
+                    .collect::<Vec<_>>()
+                    .join("\n")
+                    .trim_end()
+            );
+
+            let mut trimmed = sample.to_string();
+            trim_in_place(&mut trimmed);
+            assert_eq!(trimmed, sample.trim());
+        }
+    }
+
+    #[test]
+    fn test_unchanged_text_is_borrowed() {
+        assert!(matches!(collapse_space_runs("a b c"), Cow::Borrowed(_)));
+        assert!(matches!(normalize_line_endings("a\nb"), Cow::Borrowed(_)));
+        assert!(matches!(
+            replace_whitespace_runs("a  b", 3, " "),
+            Cow::Borrowed(_)
+        ));
+    }
+}